@@ -24,5 +24,10 @@
  *
  */
 
+#include "Core/Memory.h"
+
+#define FAST_OBJ_REALLOC        CountedRealloc
+#define FAST_OBJ_FREE           CountedFree
+
 #define FAST_OBJ_IMPLEMENTATION
 #include "fast_obj.h"
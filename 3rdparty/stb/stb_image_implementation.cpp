@@ -1,2 +1,8 @@
+#include "Core/Memory.h"
+
+#define STBI_MALLOC(sz)         CountedMalloc(sz)
+#define STBI_REALLOC(p, newsz)  CountedRealloc(p, newsz)
+#define STBI_FREE(p)            CountedFree(p)
+
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "GltfLoader.h"
 #include "3rdparty/cgltf/cgltf.h"
+#include "Core/Memory.h"
 #include "Math/Transformation.h"
 
 #include <string.h>
@@ -17,6 +18,8 @@ static cgltf_data* Open(const char* Path)
 {
     cgltf_data*    Result;
     cgltf_options   LoadOptions = {};
+    LoadOptions.memory.alloc_func   = CountedMallocCallback;
+    LoadOptions.memory.free_func    = CountedFreeCallback;
 
     cgltf_result CallResult = cgltf_parse_file(&LoadOptions, Path, &Result);
 
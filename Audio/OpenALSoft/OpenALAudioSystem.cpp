@@ -2,6 +2,15 @@
 #include "Core/Debug.h"
 #include "Utils/AudioLoader.h"
 
+static i32 OpenALSoundFormat(u32 Channels, u32 BytesPerSample)
+{
+    if (BytesPerSample == sizeof(real32)) {
+        return Channels == 1 ? AL_FORMAT_MONO_FLOAT32 : AL_FORMAT_STEREO_FLOAT32;
+    }
+
+    return Channels == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
+}
+
 Statuses AudioSystemInit(AudioSystem* AudioSys, void* SystemBuffer, u64 SystemBufferSize)
 {
     ALCdevice *Device;
@@ -32,12 +41,20 @@ Statuses AudioSystemInit(AudioSystem* AudioSys, void* SystemBuffer, u64 SystemBu
     AudioSys->Device                = Device;
     AudioSys->Context               = Context;
 
+    Assert(SystemBufferSize >= AUDIO_STREAMER_MEMORY_SIZE);
+
     AudioSys->SystemBuffer          = SystemBuffer;
-    AudioSys->SystemBufferSize      = SystemBufferSize;
+    AudioSys->SystemBufferSize      = SystemBufferSize - AUDIO_STREAMER_MEMORY_SIZE;
 
     AudioSys->FloatFormatPresent    = alIsExtensionPresent("AL_EXT_FLOAT32");
     AudioSys->EFXPresent            = alIsExtensionPresent("ALC_EXT_EFX");
 
+    for (i32 Stream = 0; Stream < AUDIO_STREAMER_MAX_STREAMS; ++Stream) {
+        AudioSys->Streams[Stream] = {};
+    }
+
+    AudioStreamerInit(&AudioSys->Streamer, (u8*)SystemBuffer + AudioSys->SystemBufferSize, AUDIO_STREAMER_MEMORY_SIZE);
+
     return Statuses::Success;
 }
 
@@ -52,6 +69,14 @@ Statuses AudioSystemReinit(AudioSystem*)
 
 void AudioDestroy(AudioSystem *AudioSys)
 {
+    for (i32 Stream = 0; Stream < AUDIO_STREAMER_MAX_STREAMS; ++Stream) {
+        if (AudioSys->Streams[Stream].Playing) {
+            StopStream(AudioSys, Stream);
+        }
+    }
+
+    AudioStreamerShutdown(&AudioSys->Streamer);
+
     if (AudioSys->Context) {
         alcDestroyContext(AudioSys->Context);
     }
@@ -74,7 +99,8 @@ SFX LoadSFX(AudioSystem *AudioSys, const char *FileName, AudioFormat Fmt)
     }
 
     alGenBuffers(1, &Result.BufferHandle);
-    alBufferData(Result.BufferHandle, SoundFile.SoundFormat, SoundFile.Buffer, SoundFile.Size, SoundFile.SampleRate);
+    alBufferData(Result.BufferHandle, OpenALSoundFormat(SoundFile.Channels, SoundFile.BytesPerSample),
+                 SoundFile.Buffer, SoundFile.Size, SoundFile.SampleRate);
 
     Err = alGetError();
     if(Err != AL_NO_ERROR) {
@@ -121,4 +147,124 @@ void PlaySFX(AudioSource Source, SFX Sound)
         // TODO error handling
         Assert(false);
     }
-}
\ No newline at end of file
+}
+
+i32 PlayStream(AudioSystem *AudioSys, const char *FileName, AudioFormat Fmt, bool32 Loop)
+{
+    i32 Stream = AudioStreamOpen(&AudioSys->Streamer, FileName, Fmt, AudioSys->FloatFormatPresent, Loop);
+
+    if (Stream < 0) {
+        return -1;
+    }
+
+    AudioStreamOutput*  Output  = &AudioSys->Streams[Stream];
+    AudioDecoder*       Decoder = &AudioSys->Streamer.Streams[Stream].Decoder;
+
+    *Output = {};
+
+    Output->SoundFormat = OpenALSoundFormat(Decoder->Channels, AudioSys->FloatFormatPresent ? sizeof(real32) : sizeof(i16));
+    Output->SampleRate  = Decoder->SampleRate;
+
+    // NOTE(ismail): drop error left by earlier calls so it isn't blamed on this stream
+    alGetError();
+
+    alGenSources(1, &Output->SourceHandle);
+
+    if (alGetError() != AL_NO_ERROR) {
+        AudioStreamClose(&AudioSys->Streamer, Stream);
+
+        *Output = {};
+
+        return -1;
+    }
+
+    alGenBuffers(AUDIO_STREAM_CHUNKS, Output->Buffers);
+
+    if (alGetError() != AL_NO_ERROR) {
+        alDeleteSources(1, &Output->SourceHandle);
+        AudioStreamClose(&AudioSys->Streamer, Stream);
+
+        *Output = {};
+
+        return -1;
+    }
+
+    for (i32 Buffer = 0; Buffer < AUDIO_STREAM_CHUNKS; ++Buffer) {
+        Output->FreeBuffers[Buffer] = Output->Buffers[Buffer];
+    }
+
+    Output->FreeBuffersAmount   = AUDIO_STREAM_CHUNKS;
+    Output->Playing             = 1;
+
+    return Stream;
+}
+
+void StopStream(AudioSystem *AudioSys, i32 Stream)
+{
+    AudioStreamOutput* Output = &AudioSys->Streams[Stream];
+
+    Assert(Output->Playing);
+
+    // NOTE(ismail): stopped source marks all queued buffers processed, detaching buffer unqueues them
+    alSourceStop(Output->SourceHandle);
+    alSourcei(Output->SourceHandle, AL_BUFFER, 0);
+
+    alDeleteSources(1, &Output->SourceHandle);
+    alDeleteBuffers(AUDIO_STREAM_CHUNKS, Output->Buffers);
+
+    AudioStreamClose(&AudioSys->Streamer, Stream);
+
+    *Output = {};
+}
+
+void AudioSystemUpdate(AudioSystem *AudioSys)
+{
+    for (i32 Stream = 0; Stream < AUDIO_STREAMER_MAX_STREAMS; ++Stream) {
+        AudioStreamOutput* Output = &AudioSys->Streams[Stream];
+
+        if (!Output->Playing) {
+            continue;
+        }
+
+        ALint Processed = 0;
+        alGetSourcei(Output->SourceHandle, AL_BUFFERS_PROCESSED, &Processed);
+
+        while (Processed-- > 0) {
+            u32 Buffer;
+            alSourceUnqueueBuffers(Output->SourceHandle, 1, &Buffer);
+
+            Output->FreeBuffers[Output->FreeBuffersAmount++] = Buffer;
+        }
+
+        AudioStreamChunk* Chunk;
+
+        while (Output->FreeBuffersAmount > 0 && !Output->EndQueued &&
+               (Chunk = AudioStreamPeek(&AudioSys->Streamer, Stream)) != NULL) {
+            if (Chunk->Frames) {
+                u32 Buffer = Output->FreeBuffers[--Output->FreeBuffersAmount];
+
+                alBufferData(Buffer, Output->SoundFormat, Chunk->Data, Chunk->Size, Output->SampleRate);
+                alSourceQueueBuffers(Output->SourceHandle, 1, &Buffer);
+            }
+
+            Output->EndQueued = Chunk->Last;
+
+            AudioStreamPop(&AudioSys->Streamer, Stream);
+        }
+
+        ALint State     = 0;
+        ALint Queued    = 0;
+        alGetSourcei(Output->SourceHandle, AL_SOURCE_STATE, &State);
+        alGetSourcei(Output->SourceHandle, AL_BUFFERS_QUEUED, &Queued);
+
+        if (State != AL_PLAYING) {
+            // NOTE(ismail): first start, or audio thread fell behind and source ran out of queued buffers
+            if (Queued > 0) {
+                alSourcePlay(Output->SourceHandle);
+            }
+            else if (Output->EndQueued) {
+                StopStream(AudioSys, Stream);
+            }
+        }
+    }
+}
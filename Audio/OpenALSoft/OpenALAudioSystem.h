@@ -7,11 +7,24 @@
 
 #include "Core/Types.h"
 #include "Utils/AudioLoader.h"
+#include "Utils/AudioStreamer.h"
 
 #ifndef AUDIO_COMPONENTS_MAX_SFX_BUFFER
     #define AUDIO_COMPONENTS_MAX_SFX_BUFFER 20
 #endif
 
+// NOTE(ismail): source of one streamed track, its buffers go back and forth between OpenAL queue and Free list
+struct AudioStreamOutput {
+    u32         SourceHandle;
+    u32         Buffers[AUDIO_STREAM_CHUNKS];
+    u32         FreeBuffers[AUDIO_STREAM_CHUNKS];
+    i32         FreeBuffersAmount;
+    i32         SoundFormat;
+    u32         SampleRate;
+    bool32      Playing;
+    bool32      EndQueued;
+};
+
 struct AudioSystem {
     ALCdevice   *Device;
     ALCcontext  *Context;
@@ -21,6 +34,9 @@ struct AudioSystem {
 
     bool32      FloatFormatPresent  : 1;
     bool32      EFXPresent          : 1;
+
+    AudioStreamer       Streamer;   // NOTE(ismail): its chunk memory is tail of SystemBuffer
+    AudioStreamOutput   Streams[AUDIO_STREAMER_MAX_STREAMS];
 };
 
 struct SFX {
@@ -34,7 +50,7 @@ struct AudioSource {
 // init OpenAL open device and create context and fill AudioSystem struct
 Statuses AudioSystemInit(AudioSystem* AudioSys, void* SystemBuffer, u64 SystemBufferSize);
 Statuses AudioSystemReinit(AudioSystem* AudioSys);
-// free Device and Context
+// stop audio thread and streams, free Device and Context
 void AudioDestroy(AudioSystem *AudioSys);
 
 // load audio file and generate al buffer for them
@@ -46,4 +62,13 @@ AudioSource AudioSourceInit();
 
 void PlaySFX(AudioSource Source, SFX Sound);
 
+// start long track (music, ambience) without decoding it whole, memory doesn't depend on its length
+// returns stream index or -1 when file can't be opened, all streams are busy or OpenAL can't give source and buffers,
+// playback begins on next AudioSystemUpdate
+i32 PlayStream(AudioSystem *AudioSys, const char *FileName, AudioFormat Fmt, bool32 Loop);
+void StopStream(AudioSystem *AudioSys, i32 Stream);
+
+// queue chunks decoded by audio thread to playing streams, call it once per frame on main thread
+void AudioSystemUpdate(AudioSystem *AudioSys);
+
 #endif
\ No newline at end of file
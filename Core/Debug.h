@@ -4,7 +4,8 @@
 #if TEARA_DEBUG
     #define Assert(Expression)  ((Expression) ? (1) : *((int*)0))
 #else
-    #define Assert(Expression)
+    // NOTE(ismail): expression is not evaluated, but variables checked only by asserts still count as used in release
+    #define Assert(Expression)  ((void)sizeof((Expression) ? 1 : 0))
 #endif
 
 #endif
\ No newline at end of file
@@ -21,6 +21,19 @@ typedef TEARA_PLATFORM_READ_FILE(*TEARA_PlatformReadFile);
 #define TEARA_PLATFORM_FREE_FILE_DATA(Name) void (Name)(File *FileData)
 typedef TEARA_PLATFORM_FREE_FILE_DATA(*TEARA_PlatformFreeFileData);
 
+// NOTE(ismail): read only view of the whole file, pages are loaded on first touch. Data stays valid until UnmapFile
+#define TEARA_PLATFORM_MAP_FILE(Name) File (Name)(const char *FileName)
+typedef TEARA_PLATFORM_MAP_FILE(*TEARA_PlatformMapFile);
+
+#define TEARA_PLATFORM_UNMAP_FILE(Name) void (Name)(File *FileData)
+typedef TEARA_PLATFORM_UNMAP_FILE(*TEARA_PlatformUnmapFile);
+
+// NOTE(ismail): returns monotonic time in seconds, only differences make sense
+#define TEARA_PLATFORM_GET_WALL_CLOCK(Name) real64 (Name)()
+typedef TEARA_PLATFORM_GET_WALL_CLOCK(*TEARA_PlatformGetWallClock);
+
+struct JobSystem;
+
 enum KeyState {
     Released    = 0,
     Pressed     = 1,
@@ -77,7 +90,7 @@ enum MouseCursorState { Lock, Unlock };
 
 struct Platform {
     ScreenOptions                   ScreenOpt;
-    Input                           Input;
+    ::Input                         Input;
     bool32                          Running;
     bool32                          CursorSwitched;
     MouseCursorState                CursorState;
@@ -86,6 +99,11 @@ struct Platform {
     TEARA_PlatformReleaseMemory     ReleaseMem;
     TEARA_PlatformReadFile          ReadFile;
     TEARA_PlatformFreeFileData      FreeFileData;
+    TEARA_PlatformMapFile           MapFile;
+    TEARA_PlatformUnmapFile         UnmapFile;
+    TEARA_PlatformGetWallClock      GetWallClock;
+
+    JobSystem*                      Jobs; // NOTE(ismail): 0 means everything runs on the calling thread
 };
 
 #endif
\ No newline at end of file
@@ -3,13 +3,15 @@
 #include "Math/Transformation.h"
 #include "Debug.h"
 #include "Utils/AssetsLoader.h"
+#include "Utils/CookedMesh.h"
+#include "Utils/AssetStreamer.h"
 #include "3rdparty/ufbx/ufbx.h"
 #include "3rdparty/cgltf/cgltf.h"
 #include "EnginePlatform.h"
 #include "Game.h"
 #include "Rendering/OpenGL/TGL.h"
-#include "3rdparty/stb/stb_image.h"
 #include "Assets/GltfLoader.h"
+#include "GameSimulation.cpp"
 
 ShaderProgram ShadersProgramsCache[ShaderProgramsTypeMax];
 
@@ -159,37 +161,6 @@ u32 CreateShaderProgram(Platform *Platform, const char *VertexShaderName, const
     return FinalShaderProgram;
 }
 
-struct TextureFile {
-    i32 Width;
-    i32 Height;
-    i32 Channels;
-    u8* Data;
-};
-
-Statuses LoadTextureFile(const char *Path, TextureFile *ReadedFile, bool32 VerticalFlip)
-{
-    stbi_set_flip_vertically_on_load_thread(VerticalFlip);
-
-    u8* ImageData = stbi_load(Path, &ReadedFile->Width, &ReadedFile->Height, &ReadedFile->Channels, STBI_default);
-
-    if (!ImageData) {
-        // TODO (ismail): diagnostic and write to log some info
-        Assert(ImageData);
-        return Statuses::FileLoadFailed;
-    }
-
-    ReadedFile->Data = ImageData;
-
-    return Statuses::Success;
-}
-
-void FreeTextureFile(TextureFile *ReadedFile)
-{
-    stbi_image_free(ReadedFile->Data);
-
-    ReadedFile->Data = 0;
-}
-
 struct ShadersName {
     const char *VertexShaderName;
     const char *FragmentShaderName;
@@ -357,7 +328,118 @@ void InitShaderProgramsCache(Platform *Platform)
     }
 }
 
-void LoadTerrain(Platform *Platform, Terrain *ToLoad, const char *TerrainTerxtureName)
+// NOTE(ismail): same file streamed for different uses becomes different GPU textures, texture cache keys on this
+enum GameTextureVariant {
+    GameTextureTerrain,
+    GameTextureDiffuse,
+    GameTextureSpecular,
+};
+
+// NOTE(ismail): cooked texture brings its whole mip chain in GPU format, decoded one is sent as is and mips are made by driver
+static void UploadTextureFile(TextureFile *Texture, GLenum DecodedFormat, bool32 GenerateMips)
+{
+    if (!Texture->MipsCount) {
+        glTexImage2D(GL_TEXTURE_2D, 0, DecodedFormat, Texture->Width, Texture->Height, 0, DecodedFormat, GL_UNSIGNED_BYTE, Texture->Data);
+
+        if (GenerateMips) {
+            tglGenerateMipmap(GL_TEXTURE_2D);
+        }
+
+        return;
+    }
+
+    // NOTE(ismail): R8 rows of small mips are not 4 byte aligned
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, Texture->MipsCount - 1);
+
+    for (i32 MipIndex = 0; MipIndex < Texture->MipsCount; ++MipIndex) {
+        TextureMip* Mip = &Texture->Mips[MipIndex];
+
+        switch (Texture->Format) {
+            case TextureFormatR8: {
+                glTexImage2D(GL_TEXTURE_2D, MipIndex, GL_RED, Mip->Width, Mip->Height, 0, GL_RED, GL_UNSIGNED_BYTE, Mip->Data);
+            } break;
+
+            case TextureFormatRGBA8: {
+                glTexImage2D(GL_TEXTURE_2D, MipIndex, GL_RGBA8, Mip->Width, Mip->Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, Mip->Data);
+            } break;
+
+            case TextureFormatBC1: {
+                tglCompressedTexImage2D(GL_TEXTURE_2D, MipIndex, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, Mip->Width, Mip->Height, 0, (GLsizei)Mip->Size, Mip->Data);
+            } break;
+
+            case TextureFormatBC3: {
+                tglCompressedTexImage2D(GL_TEXTURE_2D, MipIndex, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, Mip->Width, Mip->Height, 0, (GLsizei)Mip->Size, Mip->Data);
+            } break;
+
+            default: {
+                Assert(false);
+            } break;
+        }
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+static TEARA_TEXTURE_CREATE(CreateGameTexture)
+{
+    u32 TextureHandle;
+
+    glGenTextures(1, &TextureHandle);
+    glBindTexture(GL_TEXTURE_2D, TextureHandle);
+
+    switch (Variant) {
+        case GameTextureTerrain: {
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+            UploadTextureFile(Texture, GL_RGB, 1);
+        } break;
+
+        case GameTextureDiffuse: {
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+            UploadTextureFile(Texture, GL_RGB, 1);
+        } break;
+
+        case GameTextureSpecular: {
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+            UploadTextureFile(Texture, GL_RED, 0);
+        } break;
+
+        default: {
+            Assert(false);
+        } break;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    return TextureHandle;
+}
+
+static TEARA_TEXTURE_DESTROY(DestroyGameTexture)
+{
+    glDeleteTextures(1, &Handle);
+}
+
+static TEARA_TEXTURE_BIND(BindTerrainTexture)
+{
+    Terrain* ToLoad = (Terrain*)Target;
+
+    ToLoad->TextureHandle = Handle;
+}
+
+// NOTE(ismail): mesh is generated here, texture is streamed and terrain draws untextured until it is uploaded
+void LoadTerrain(Platform *Platform, TextureCache *Textures, Terrain *ToLoad, const char *TerrainTerxtureName)
 {
     TerrainLoadFile TerrainFile = {};
 
@@ -375,49 +457,51 @@ void LoadTerrain(Platform *Platform, Terrain *ToLoad, const char *TerrainTerxtur
     GenerateTerrainMesh(&TerrainFile, 4.0f, 200.0f, BATTLE_AREA_GRID_VERT_AMOUNT);
     LoadTerrainFile(ToLoad, &TerrainFile);
 
-    TextureFile TerrainTexture = {};
-    if (LoadTextureFile(TerrainTerxtureName, &TerrainTexture, 0) != Statuses::Success) {
+    ToLoad->IndicesAmount   = TerrainFile.IndicesAmount;
+    ToLoad->TextureHandle   = 0;
+
+    if (!TextureCacheRequest(Textures, TerrainTerxtureName, GameTextureTerrain, 0, &BindTerrainTexture, ToLoad, 0)) {
         Assert(false);
     }
+}
 
-    u32 TerrainTextureHandle;
-
-    glGenTextures(1, &TerrainTextureHandle);
-    glBindTexture(GL_TEXTURE_2D, TerrainTextureHandle);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, TerrainTexture.Width, TerrainTexture.Height, 0, GL_RGB, GL_UNSIGNED_BYTE, TerrainTexture.Data);
-    tglGenerateMipmap(GL_TEXTURE_2D);
-
-    ToLoad->IndicesAmount   = TerrainFile.IndicesAmount;
-    ToLoad->TextureHandle   = TerrainTextureHandle;
+enum MaterialTextureSlot {
+    MaterialDiffuseTexture,
+    MaterialSpecularTexture,
+};
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+static TEARA_TEXTURE_BIND(BindMaterialTexture)
+{
+    MeshMaterial* Material = (MeshMaterial*)Target;
 
-    FreeTextureFile(&TerrainTexture);
+    if (TargetSlot == MaterialDiffuseTexture) {
+        Material->TextureHandle = Handle;
+        Material->HaveTexture   = 1;
+    }
+    else {
+        Material->SpecularExponentMapTextureHandle  = Handle;
+        Material->HaveSpecularExponent              = 1;
+    }
 }
 
-void AllocateDebugObjFile(ObjFile *File)
+// NOTE(ismail): material is drawn with its colors only until texture is bound, bind sets HaveTexture / HaveSpecularExponent.
+// Materials using the same file share one GPU texture
+static void StreamMaterialTexture(TextureCache *Textures, MeshMaterial *Material, MaterialTextureSlot TextureSlot,
+                                  const char *Path, bool32 VerticalFlip)
 {
-    File->Meshes        = (Mesh*)   VirtualAlloc(0, sizeof(Mesh) *     10,   MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
-    File->Positions     = (vec3*)   VirtualAlloc(0, sizeof(vec3) * 140000,   MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
-    File->Normals       = (vec3*)   VirtualAlloc(0, sizeof(vec3) * 140000,   MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
-    File->TextureCoord  = (vec2*)   VirtualAlloc(0, sizeof(vec2) * 140000,   MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
-    File->Indices       = (u32*)    VirtualAlloc(0, sizeof(u32)  * 140000,   MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    GameTextureVariant Variant = TextureSlot == MaterialDiffuseTexture ? GameTextureDiffuse : GameTextureSpecular;
+
+    if (!TextureCacheRequest(Textures, Path, Variant, VerticalFlip, &BindMaterialTexture, Material, TextureSlot)) {
+        Assert(false);
+    }
 }
 
-void InitMeshComponent(Platform *Platform, MeshComponent *ToLoad, ObjFileLoaderFlags  LoadFlags)
+static TEARA_ASSET_UPLOAD(UploadStreamedMesh)
 {
-    u32*                Buffers     = ToLoad->BuffersHandler;
-    ObjFile             LoadFile    = {};
-
-    AllocateDebugObjFile(&LoadFile);
-
-    LoadObjFile(ToLoad->ObjectPath, &LoadFile, LoadFlags);
+    MeshComponent*  ToLoad      = (MeshComponent*)Asset->Target;
+    ObjFile&        LoadFile    = Asset->MeshFile;
+    u32*            Buffers     = ToLoad->BuffersHandler;
+    TextureCache*   Textures    = &((GameContext*)Streamer->UserData)->Textures;
 
     MeshComponentObjects* ComponentObjects = (MeshComponentObjects*)VirtualAlloc(0, sizeof(MeshComponentObjects) * LoadFile.MeshesCount, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
 
@@ -459,52 +543,11 @@ void InitMeshComponent(Platform *Platform, MeshComponent *ToLoad, ObjFileLoaderF
         CurrentComponentObject->NumIndices      = CurrentMesh->IndicesAmount;
     
         if (CurrentMeshMaterial->HaveTexture) {
-            TextureFile Texture = {};
-
-            if (LoadTextureFile(CurrentMeshMaterial->TextureFilePath, &Texture, 1) != Statuses::Success) {
-                Assert(false);
-            }
-
-            CurrentComponentMaterial->HaveTexture = 1;
-    
-            glGenTextures(1, &CurrentComponentMaterial->TextureHandle);
-            glBindTexture(GL_TEXTURE_2D, CurrentComponentMaterial->TextureHandle);
-        
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, Texture.Width, Texture.Height, 0, GL_RGB, GL_UNSIGNED_BYTE, Texture.Data);
-            tglGenerateMipmap(GL_TEXTURE_2D);
-        
-            FreeTextureFile(&Texture);
-    
-            glBindTexture(GL_TEXTURE_2D, 0);
+            StreamMaterialTexture(Textures, CurrentComponentMaterial, MaterialDiffuseTexture, CurrentMeshMaterial->TextureFilePath, 1);
         }
 
         if (CurrentMeshMaterial->HaveSpecularExponent) {
-            TextureFile SpecularTexture = {};
-
-            if (LoadTextureFile(CurrentMeshMaterial->SpecularExpFilePath, &SpecularTexture, 1) != Statuses::Success) {
-                Assert(false);
-            }
-
-            CurrentComponentMaterial->HaveSpecularExponent = 1;
-    
-            glGenTextures(1, &CurrentComponentMaterial->SpecularExponentMapTextureHandle);
-            glBindTexture(GL_TEXTURE_2D, CurrentComponentMaterial->SpecularExponentMapTextureHandle);
-        
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, SpecularTexture.Width, SpecularTexture.Height, 0, GL_RED, GL_UNSIGNED_BYTE, SpecularTexture.Data);
-        
-            FreeTextureFile(&SpecularTexture);
-    
-            glBindTexture(GL_TEXTURE_2D, 0);
+            StreamMaterialTexture(Textures, CurrentComponentMaterial, MaterialSpecularTexture, CurrentMeshMaterial->SpecularExpFilePath, 1);
         }
 
         CurrentComponentMaterial->AmbientColor  = CurrentMeshMaterial->AmbientColor;
@@ -516,7 +559,27 @@ void InitMeshComponent(Platform *Platform, MeshComponent *ToLoad, ObjFileLoaderF
     ToLoad->MeshesInfo      = ComponentObjects;
 }
 
-void InitParticleSystem(ParticleSystem *Sys)
+// NOTE(ismail): component stays empty (MeshesAmount 0) until streamer uploads it. Fails when all streamer slots are busy
+Statuses InitMeshComponent(AssetStreamer *Streamer, MeshComponent *ToLoad, ObjFileLoaderFlags LoadFlags)
+{
+    ToLoad->MeshesAmount    = 0;
+    ToLoad->MeshesInfo      = 0;
+
+    AssetStreamRequest Request = {};
+    Request.Kind        = AssetStreamMesh;
+    Request.Path        = ToLoad->ObjectPath;
+    Request.Upload      = &UploadStreamedMesh;
+    Request.Target      = ToLoad;
+    Request.MeshFlags   = LoadFlags;
+
+    if (!AssetStreamerSubmit(Streamer, &Request)) {
+        return Statuses::Failed;
+    }
+
+    return Statuses::Success;
+}
+
+void InitParticleRenderer(ParticleRenderer *Sys)
 {
     vec3 ParticleSquareAppearance[4] {
         {  0.5f,  0.5f, 0.0f },
@@ -645,39 +708,6 @@ const MeshLoaderNode SceneObjectsName[] = {
     }
 };
 
-struct SerialaizedAnimations {
-    i32         AnimId;
-    const char* Path;
-};
-
-struct DynamicSceneObjectLoader {
-    SkeletalCharacters      SkeletCharId;
-    SerialaizedAnimations   Mesh;
-    SerialaizedAnimations   Animations[MAX_CHARACTER_ANIMATIONS];
-    i32                     Amount;
-};
-
-DynamicSceneObjectLoader DynamicSceneObjectsName[] = {
-    {
-        SkeletalCharacters::CharacterPlayer,
-        {
-            PLayerAnimations::IdleDynamic,
-            "data/obj/Idle.gltf"
-        },
-        {
-            {
-                PLayerAnimations::WalkDefault,
-                "data/obj/Walk.gltf"
-            },
-            {
-                PLayerAnimations::RunDefault,
-                "data/obj/Run.gltf"
-            }
-        },
-        2
-    },
-};
-
 void SetupDirectionalLight(DirectionalLight* Light, ShaderProgramsType ShaderType)
 {
     ShaderProgramVariablesStorage *VarStorage = &ShadersProgramsCache[ShaderType].ProgramVarsStorage;
@@ -752,28 +782,6 @@ void SetupSpotLights(SpotLight* Lights, u32 LightAmount, ShaderProgramsType Shad
     tglUniform1i(VarStorage->Light.SpotLightsAmountLocation, LightAmount);
 }
 
-struct ivec4 {
-    i32 x, y, z, w;
-};
-
-struct uvec4 {
-    union {
-        struct {
-            u32 x, y, z, w;
-        };
-        u32 ValueHolder[4];   
-    };
-};
-
-struct u8vec4 {
-    union {
-        struct {
-            u8 x, y, z, w;
-        };
-        u32 ValueHolder;   
-    };
-};
-
 inline void Ufbxvec3Convert(ufbx_vec3 *From, vec3 *To)
 {
     To->x = From->x;
@@ -781,428 +789,6 @@ inline void Ufbxvec3Convert(ufbx_vec3 *From, vec3 *To)
     To->z = From->z;
 }
 
-struct glTF2Primitives {
-    Material    MeshMaterial;
-    vec3*       Positions;
-    vec3*       Normals;
-    vec2*       TextureCoord;
-    vec4*       BoneWeights;
-    ivec4*      BoneIds;
-    u32*        Indices;
-    u32         PositionsCount;
-    u32         NormalsCount;
-    u32         TexturesCount;
-    u32         BoneWeightsCount;
-    u32         BoneIdsCount;
-    u32         IndicesCount;
-};
-
-struct glTF2Mesh {
-    glTF2Primitives MeshPrimitives[MAX_MESH_PRIMITIVES];
-    i32             PrimitivesAmount;
-};
-
-struct glTF2File {
-    Skinning*           Skelet;
-    AnimationsArray*    Animations;
-    glTF2Mesh           Meshes[MAX_MESHES];
-    i32                 MeshesAmount;
-};
-
-void ReadJointNode(Skinning* Skin, cgltf_node* Joint, JointsInfo* ParentJoint, i32& Index, cgltf_node** RootJoints, i32 Len)
-{
-    if (!Joint) {
-        return;
-    }
-
-    JointsInfo* CurrentJointInfo    = &Skin->Joints[Index];
-    std::string BoneName            = Joint->name;
-
-    cgltf_float*    Translation = Joint->translation;
-    cgltf_float*    Scale       = Joint->scale;
-    quat            Rotation    = Joint->rotation;
-
-    mat4 InverseTranslationMatrix = {};
-    mat4 InverseScaleMatrix       = {};
-    mat4 InverseRotationMatrix    = {};
-    mat4 ParentMatrix             = !ParentJoint ? Identity4 : ParentJoint->InverseBindMatrix;
-
-    InverseTranslationFromArr(Translation, InverseTranslationMatrix);
-    InverseScaleFromArr(Scale, InverseScaleMatrix);
-    Rotation.UprightToObject(InverseRotationMatrix);
-
-    i32 ChildreJointsAmount = (i32)Joint->children_count;
-
-    if (ParentJoint) {
-        i32 ChildrenIndex = ParentJoint->ChildrenAmount;
-
-        Assert(ChildrenIndex <= MAX_JOINT_CHILDREN_AMOUNT);
-
-        ++ParentJoint->ChildrenAmount;
-
-        ParentJoint->Children[ChildrenIndex] = CurrentJointInfo;
-    }
-
-    CurrentJointInfo->BoneName.resize(BoneName.size());
-
-    CurrentJointInfo->BoneName              = BoneName;
-    CurrentJointInfo->Parent                = ParentJoint;
-    CurrentJointInfo->InverseBindMatrix     = InverseScaleMatrix * InverseRotationMatrix * InverseTranslationMatrix * ParentMatrix;
-    CurrentJointInfo->DefaultScale          = { Scale[_x_], Scale[_y_], Scale[_z_] };
-    CurrentJointInfo->DefaultRotation       = Rotation;
-    CurrentJointInfo->DefaultTranslation    = { Translation[_x_], Translation[_y_], Translation[_z_] };
-
-    i32 OriginalID = -1;
-    for (i32 RootJointID = 0; RootJointID < Len; ++RootJointID) {
-        cgltf_node** OriginalJoint = &RootJoints[RootJointID];
-
-        if (*OriginalJoint == Joint) {
-            OriginalID = OriginalJoint - RootJoints;
-
-            break;
-        }
-    }
-
-    Assert(OriginalID != -1);
-
-    BoneIDs& Ids = Skin->Bones[BoneName];
-
-    Ids.BoneID          = Index;
-    Ids.OriginalBoneID  = OriginalID;
-
-    ++Index;
-
-    for (i32 ChildrenJointIndex = 0; ChildrenJointIndex < ChildreJointsAmount; ++ChildrenJointIndex) {
-        ReadJointNode(Skin, Joint->children[ChildrenJointIndex], CurrentJointInfo, Index, RootJoints, Len);
-    }
-}
-
-#define DEFAULT_BUFFER_SIZE 80000
-
-void glTFReadAnimations(cgltf_animation* Animations, i32 AnimationsCount, AnimationsArray& AnimArray, Skinning& Skin)
-{
-    Assert(AnimationsCount == 1); // TODO(ismail): restrictions for now in future we should handle that case
-
-    for (i32 AnimationIndex = 0, AnimationArrayIndex = AnimArray.AnimsAmount; 
-            AnimationIndex < AnimationsCount; 
-            ++AnimationIndex, ++AnimationArrayIndex) {
-            cgltf_animation&    CurrentAnimation    = Animations[AnimationIndex];
-            Animation&          AnimationNode       = AnimArray.Anims[AnimationArrayIndex];
-
-            i32                             ChannelsCount   = (i32)CurrentAnimation.channels_count;
-            cgltf_animation_channel*        Channels        = CurrentAnimation.channels;
-            std::map<std::string, BoneIDs>& Bones           = Skin.Bones;
-
-            real32          AnimationDuration   = 0.0f;
-            i32             BoneIndex           = 0;
-            cgltf_node*     LastTargetNode      = 0;
-            AnimationFrame* Frame               = 0;
-
-            for (i32 ChannelIndex = 0; ChannelIndex < ChannelsCount; ++ChannelIndex) {
-                cgltf_animation_channel*    CurrentChannel  = &Channels[ChannelIndex];
-                cgltf_animation_sampler*    CurrentSampler  = CurrentChannel->sampler;
-                cgltf_node*                 TargetNode      = CurrentChannel->target_node;
-
-                bool32 BoneFind = Bones.find(TargetNode->name) != Bones.end();
-                if (!BoneFind) {
-                    // TODO(Ismail): now we just continue but need to handle that case
-                    Assert(false);
-                }
-
-                if (LastTargetNode != TargetNode) {
-                    Frame           = &AnimationNode.PerBonesFrame[BoneIndex++];
-                    LastTargetNode  = TargetNode;
-
-                    BoneIDs&    Ids = Bones.at(TargetNode->name);
-
-                    Frame->Target           = Ids.BoneID;
-                    Frame->OriginalBoneID   = Ids.OriginalBoneID;
-                }
-
-                cgltf_animation_path_type   ChannelType         = CurrentChannel->target_path;
-                cgltf_interpolation_type    InterpalationType   = CurrentSampler->interpolation;
-
-                Assert(ChannelType != cgltf_animation_path_type::cgltf_animation_path_type_invalid &&
-                       ChannelType != cgltf_animation_path_type::cgltf_animation_path_type_weights);
-
-                Assert(CurrentSampler->input->count == CurrentSampler->output->count);
-
-                AnimationTransformation* Transform;
-                switch(ChannelType) {
-                    case cgltf_animation_path_type::cgltf_animation_path_type_translation: {
-                        Transform = &Frame->Transformations[ATranslation];
-
-                        cgltf_accessor* TransformAccessor   = CurrentSampler->output;
-                        i32             TransformsCount     = TransformAccessor->count;
-                        for (i32 TransformIndex = 0; TransformIndex < TransformsCount; ++TransformIndex) {
-                            vec3 Elem = {};
-                            cgltf_accessor_read_float(TransformAccessor, TransformIndex, Elem.vec, sizeof(Elem));
-
-                            Transform->Transforms[TransformIndex].Translation = Elem;
-                        }
-                    } break;
-
-                    case cgltf_animation_path_type::cgltf_animation_path_type_rotation: {
-                        Transform = &Frame->Transformations[ARotation];
-
-                        cgltf_accessor* TransformAccessor   = CurrentSampler->output;
-                        i32             TransformsCount     = TransformAccessor->count;
-                        for (i32 TransformIndex = 0; TransformIndex < TransformsCount; ++TransformIndex) {
-                            real32 Elem[4] = {};
-                            cgltf_accessor_read_float(TransformAccessor, TransformIndex, Elem, sizeof(Elem));
-
-                            quat *Rot = &Transform->Transforms[TransformIndex].Rotation;
-                            Rot->w = Elem[_w_];
-                            Rot->x = Elem[_x_];
-                            Rot->y = Elem[_y_];
-                            Rot->z = Elem[_z_];
-                        }
-                    } break;
-
-                    case cgltf_animation_path_type::cgltf_animation_path_type_scale: {
-                        Transform = &Frame->Transformations[AScale];
-
-                        cgltf_accessor* TransformAccessor   = CurrentSampler->output;
-                        i32             TransformsCount     = TransformAccessor->count;
-                        for (i32 TransformIndex = 0; TransformIndex < TransformsCount; ++TransformIndex) {
-                            vec3 Elem = {};
-                            cgltf_accessor_read_float(TransformAccessor, TransformIndex, Elem.vec, sizeof(Elem));
-
-                            Transform->Transforms[TransformIndex].Scale = Elem;
-                        }
-                    } break;
-                }
-
-                i32 KeyframesAmount = (i32)CurrentSampler->input->count;
-
-                Assert(KeyframesAmount <= MAX_KEYFRAMES);
-
-                for (i32 KeyframeIndex = 0; KeyframeIndex < KeyframesAmount; ++KeyframeIndex) {
-                    real32 Keyframe = 0.0f;
-                    cgltf_accessor_read_float(CurrentSampler->input, KeyframeIndex, &Keyframe, sizeof(Keyframe));
-
-                    Transform->Keyframes[KeyframeIndex] = Keyframe;
-
-                    if (Keyframe > AnimationDuration) {
-                        AnimationDuration = Keyframe;
-                    }
-                }
-                
-                Transform->Amount   = KeyframesAmount;
-                Transform->IType    = InterpalationType == cgltf_interpolation_type::cgltf_interpolation_type_linear ? ILinear : IStep;
-                Transform->Valid    = 1;
-            }
-
-            AnimationNode.MaxDuration  = AnimationDuration;
-            AnimationNode.FramesAmount = BoneIndex;
-        }
-
-        AnimArray.AnimsAmount += AnimationsCount;
-}
-
-void glTFLoadFile(const char *Path, cgltf_data** Mesh)
-{
-    cgltf_options   LoadOptions = {};
-
-    cgltf_result CallResult = cgltf_parse_file(&LoadOptions, Path, Mesh);
-
-    if (CallResult != cgltf_result::cgltf_result_success) {
-        Assert(false);
-    }
-
-    CallResult = cgltf_load_buffers(&LoadOptions, *Mesh, Path);
-
-    if (CallResult != cgltf_result::cgltf_result_success) {
-        Assert(false);
-    }
-}
-
-void glTFReadAnimations(const char* Path, AnimationsArray* AnimArray, Skinning* Skin)
-{
-    cgltf_data* Mesh = 0;
-
-    glTFLoadFile(Path, &Mesh);
-
-    cgltf_animation*    Animations      = Mesh->animations;
-    i32                 AnimationsCount = Mesh->animations_count;
-
-    glTFReadAnimations(Animations, AnimationsCount, *AnimArray, *Skin);
-
-    cgltf_free(Mesh);
-}
-
-void glTFRead(const char *Path, Platform* Platform, glTF2File *FileOut)
-{
-    u32             IndicesRead;
-    u32             PositionsRead;
-    u32             NormalsRead;
-    u32             TexturesCoordRead;
-    u32             BoneWeightsRead;
-    u32             BoneIdsRead;
-
-    const cgltf_accessor* AccessorPositions;
-    const cgltf_accessor* AccessorNormals;
-    const cgltf_accessor* AccessorTexturesCoord;
-    const cgltf_accessor* AccessorWeights;
-    const cgltf_accessor* AccessorJoints;
-
-    cgltf_options   LoadOptions = {};
-    cgltf_data*     Mesh        = NULL;
-
-    glTFLoadFile(Path, &Mesh);
-
-    i32         MeshesCount = (i32)Mesh->meshes_count;
-    glTF2Mesh*  MeshesOut   = FileOut->Meshes;
-
-    Assert(MeshesCount <= MAX_MESHES);
-
-    for (i32 MeshIndex = 0; MeshIndex < MeshesCount; ++MeshIndex) {
-        cgltf_mesh* CurrentMesh     = &Mesh->meshes[MeshIndex];
-        glTF2Mesh*  CurrentMeshOut  = &MeshesOut[MeshIndex];
-
-        i32                 PrimitivesAmount    = (i32)CurrentMesh->primitives_count;
-        cgltf_primitive*    PrimitivesBase      = CurrentMesh->primitives;
-        glTF2Primitives*    MeshPrimitivesOut   = CurrentMeshOut->MeshPrimitives;
-
-        Assert(PrimitivesAmount <= MAX_MESH_PRIMITIVES);
-        
-        for (i32 PrimitiveIndex = 0; PrimitiveIndex < PrimitivesAmount; ++PrimitiveIndex) {
-            cgltf_primitive*    CurrentMeshPrimitive            = &PrimitivesBase[PrimitiveIndex];
-            cgltf_material*     CurrentMeshPrimitiveMaterial    = CurrentMeshPrimitive->material;
-            glTF2Primitives*    CurrentPrimitiveOut             = &MeshPrimitivesOut[PrimitiveIndex];
-            Material*           CurrentPrimitiveMaterial        = &CurrentPrimitiveOut->MeshMaterial;
-
-            vec3*    Positions      = (vec3*)   Platform->AllocMem(sizeof(*CurrentPrimitiveOut->Positions)      * DEFAULT_BUFFER_SIZE);
-            vec3*    Normals        = (vec3*)   Platform->AllocMem(sizeof(*CurrentPrimitiveOut->Normals)        * DEFAULT_BUFFER_SIZE);
-            vec2*    TextureCoords  = (vec2*)   Platform->AllocMem(sizeof(*CurrentPrimitiveOut->TextureCoord)   * DEFAULT_BUFFER_SIZE);
-            ivec4*   BoneIDs        = (ivec4*)  Platform->AllocMem(sizeof(*CurrentPrimitiveOut->BoneIds)        * DEFAULT_BUFFER_SIZE);
-            vec4*    BoneWeights    = (vec4*)   Platform->AllocMem(sizeof(*CurrentPrimitiveOut->BoneWeights)    * DEFAULT_BUFFER_SIZE);
-            u32*     Indices        = (u32*)    Platform->AllocMem(sizeof(*CurrentPrimitiveOut->Indices)        * DEFAULT_BUFFER_SIZE * 2);
-
-            Assert(CurrentMeshPrimitive->type == cgltf_primitive_type::cgltf_primitive_type_triangles);
-
-            AccessorPositions     = cgltf_find_accessor(CurrentMeshPrimitive, cgltf_attribute_type::cgltf_attribute_type_position,    0);
-            AccessorNormals       = cgltf_find_accessor(CurrentMeshPrimitive, cgltf_attribute_type::cgltf_attribute_type_normal,      0);
-            AccessorTexturesCoord = cgltf_find_accessor(CurrentMeshPrimitive, cgltf_attribute_type::cgltf_attribute_type_texcoord,    0);
-            AccessorWeights       = cgltf_find_accessor(CurrentMeshPrimitive, cgltf_attribute_type::cgltf_attribute_type_weights,     0);
-            AccessorJoints        = cgltf_find_accessor(CurrentMeshPrimitive, cgltf_attribute_type::cgltf_attribute_type_joints,      0);
-
-            Assert(AccessorPositions->component_type    == cgltf_component_type::cgltf_component_type_r_32f && 
-                   AccessorPositions->type              == cgltf_type::cgltf_type_vec3 &&
-                   AccessorPositions->stride            == 12);
-            Assert(AccessorNormals->component_type  == cgltf_component_type::cgltf_component_type_r_32f && 
-                   AccessorNormals->type            == cgltf_type::cgltf_type_vec3 &&
-                   AccessorNormals->stride          == 12);
-            Assert(AccessorTexturesCoord->component_type    == cgltf_component_type::cgltf_component_type_r_32f && 
-                   AccessorTexturesCoord->type              == cgltf_type::cgltf_type_vec2 &&
-                   AccessorTexturesCoord->stride            == 8);
-            Assert(AccessorWeights->component_type  == cgltf_component_type::cgltf_component_type_r_32f &&
-                   AccessorWeights->type            == cgltf_type_vec4 &&
-                   AccessorWeights->stride          == 16);
-            Assert(AccessorJoints->component_type   == cgltf_component_type::cgltf_component_type_r_8u &&
-                   AccessorJoints->type             == cgltf_type_vec4 &&
-                   AccessorJoints->stride           == 4);
-
-            const cgltf_accessor* NextJoints    = cgltf_find_accessor(CurrentMeshPrimitive, cgltf_attribute_type::cgltf_attribute_type_joints,      1);
-            const cgltf_accessor* NextWeights   = cgltf_find_accessor(CurrentMeshPrimitive, cgltf_attribute_type::cgltf_attribute_type_weights,     1);
-
-            Assert(NextJoints == NULL && NextWeights == NULL);
-            
-            PositionsRead       = (u32)cgltf_accessor_unpack_floats(AccessorPositions,     (real32*)Positions,     DEFAULT_BUFFER_SIZE);
-            NormalsRead         = (u32)cgltf_accessor_unpack_floats(AccessorNormals,       (real32*)Normals,       DEFAULT_BUFFER_SIZE);
-            TexturesCoordRead   = (u32)cgltf_accessor_unpack_floats(AccessorTexturesCoord, (real32*)TextureCoords, DEFAULT_BUFFER_SIZE);
-            BoneWeightsRead     = (u32)cgltf_accessor_unpack_floats(AccessorWeights,       (real32*)BoneWeights,   DEFAULT_BUFFER_SIZE);
-
-            BoneIdsRead = (u32)cgltf_accessor_unpack_indices_32bit_package(AccessorJoints, BoneIDs, DEFAULT_BUFFER_SIZE);
-
-            IndicesRead = (u32)cgltf_accessor_unpack_indices(CurrentMeshPrimitive->indices, Indices, sizeof(*Indices), DEFAULT_BUFFER_SIZE * 2);
-
-            CurrentPrimitiveOut->Positions      = Positions;
-            CurrentPrimitiveOut->Normals        = Normals;
-            CurrentPrimitiveOut->TextureCoord   = TextureCoords;
-            CurrentPrimitiveOut->BoneIds        = BoneIDs;
-            CurrentPrimitiveOut->BoneWeights    = BoneWeights;
-            CurrentPrimitiveOut->Indices        = Indices;
-
-            CurrentPrimitiveOut->PositionsCount   = AccessorPositions->count;
-            CurrentPrimitiveOut->NormalsCount     = AccessorNormals->count;
-            CurrentPrimitiveOut->TexturesCount    = AccessorTexturesCoord->count;
-            CurrentPrimitiveOut->BoneWeightsCount = AccessorWeights->count;
-            CurrentPrimitiveOut->BoneIdsCount     = AccessorJoints->count;
-            CurrentPrimitiveOut->IndicesCount     = CurrentMeshPrimitive->indices->count;
-
-            Assert(CurrentMeshPrimitiveMaterial->has_pbr_metallic_roughness);
-
-            CurrentPrimitiveMaterial->AmbientColor = { 1.0f, 1.0f, 1.0f };
-
-            cgltf_pbr_metallic_roughness* Diffuse = &CurrentMeshPrimitiveMaterial->pbr_metallic_roughness;
-
-            char* DiffuseTextureFileName = Diffuse->base_color_texture.texture->image->uri;
-
-            memcpy_s(CurrentPrimitiveMaterial->TextureFilePath, 
-                     sizeof(CurrentPrimitiveMaterial->TextureFilePath), 
-                     DiffuseTextureFileName, 
-                     strlen(DiffuseTextureFileName));
-            
-            CurrentPrimitiveMaterial->DiffuseColor = { Diffuse->base_color_factor[_x_], Diffuse->base_color_factor[_y_], Diffuse->base_color_factor[_z_] };
-            CurrentPrimitiveMaterial->HaveTexture = 1;
-
-            if (CurrentMeshPrimitiveMaterial->has_specular) {
-                cgltf_specular* Specular = &CurrentMeshPrimitiveMaterial->specular;
-
-                char *SpecularTextureFileName = Specular->specular_texture.texture->image->uri;
-                memcpy_s(CurrentPrimitiveMaterial->SpecularExpFilePath, 
-                         sizeof(CurrentPrimitiveMaterial->SpecularExpFilePath), 
-                         SpecularTextureFileName, 
-                         strlen(SpecularTextureFileName));
-
-                CurrentPrimitiveMaterial->SpecularColor = { 
-                    0.1f, //Specular->specular_color_factor[_x_], 
-                    0.1f, //Specular->specular_color_factor[_y_], 
-                    0.1f  //Specular->specular_color_factor[_z_] 
-                };
-                CurrentPrimitiveMaterial->HaveSpecularExponent  = 1;
-            }
-        }
-
-        CurrentMeshOut->PrimitivesAmount = PrimitivesAmount;
-    }
-
-    FileOut->MeshesAmount = MeshesCount;
-
-    if (Mesh->skins_count > 0) {
-
-        Assert(Mesh->skins_count == 1);
-
-        // TODO(Ismail): use already created inverse_bind_matrix in CurrentSkin
-        cgltf_skin* CurrentSkin = &Mesh->skins[0];
-        Skinning*   Skelet      = FileOut->Skelet;
-
-        u32             JointsCount = (u32)CurrentSkin->joints_count;
-        cgltf_node**    Joints      = CurrentSkin->joints;
-        cgltf_node*     RootJoint   = Joints[0];
-
-        Skelet->Joints = (JointsInfo*)Platform->AllocMem(sizeof(*Skelet->Joints) * JointsCount);
-
-        i32 IndexCounter = 0;
-
-        ReadJointNode(Skelet, *Joints, NULL, IndexCounter, Joints, (i32)JointsCount);
-
-        FileOut->Skelet->JointsAmount = JointsCount;
-
-        i32 AnimationsCount = (i32)Mesh->animations_count;
-
-        Assert(AnimationsCount == 1);
-
-        cgltf_animation*    Animations  = Mesh->animations;
-        AnimationsArray*    AnimArray   = FileOut->Animations;
-
-        glTFReadAnimations(Animations, AnimationsCount, *AnimArray, *Skelet);
-    }
-
-    cgltf_free(Mesh);
-}
-
 const char *ResourceFolderLocation = "data/obj/";
 
 void InitSkeletalMeshComponent(Platform *Platform, GameContext* Cntx, SkeletalMeshComponent *SkeletalMesh,  DynamicSceneObjectLoader& Loader)
@@ -1210,21 +796,9 @@ void InitSkeletalMeshComponent(Platform *Platform, GameContext* Cntx, SkeletalMe
     char                FullFileName[500]   = {};
     glTF2File           LoadFile            = {};
 
-    AnimationSystem& AnimSys = Cntx->AnimSystem;
-
-    SkeletalComponent& NewComponent = AnimSys.RegisterNewSkin(SkeletalCharacters::CharacterPlayer);
+    TemporaryMemory LoadMemory = BeginTemporaryMemory(&Cntx->FrameArena);
 
-    LoadFile.Animations = &NewComponent.Animations;
-    LoadFile.Skelet     = &NewComponent.Skin;
-
-    glTFRead(Loader.Mesh.Path, Platform, &LoadFile);
-
-    i32 AnimCount = Loader.Amount;
-    for (i32 AnimIndex = 0; AnimIndex < AnimCount; ++AnimIndex) {
-        SerialaizedAnimations& SerialaizedAnims = Loader.Animations[AnimIndex];
-
-        glTFReadAnimations(SerialaizedAnims.Path, LoadFile.Animations, LoadFile.Skelet);
-    }
+    LoadSkeletalCharacter(Platform, Cntx, Loader, &LoadFile);
 
     i32         MeshesAmount    = LoadFile.MeshesAmount;
     glTF2Mesh*  Meshes          = LoadFile.Meshes;
@@ -1278,56 +852,15 @@ void InitSkeletalMeshComponent(Platform *Platform, GameContext* Cntx, SkeletalMe
             tglBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
             if (CurrentPrimitiveMat->HaveTexture) {
-                TextureFile Texture = {};
-
                 snprintf(FullFileName, sizeof(FullFileName), "%s%s", ResourceFolderLocation, CurrentPrimitiveMat->TextureFilePath);
 
-                if (LoadTextureFile(FullFileName, &Texture, 0) != Statuses::Success) {
-                    Assert(false);
-                }
-
-                CurrentPrimitiveOutMat->HaveTexture = 1;
-
-                glGenTextures(1, &CurrentPrimitiveOutMat->TextureHandle);
-                glBindTexture(GL_TEXTURE_2D, CurrentPrimitiveOutMat->TextureHandle);
-
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, Texture.Width, Texture.Height, 0, GL_RGB, GL_UNSIGNED_BYTE, Texture.Data);
-                tglGenerateMipmap(GL_TEXTURE_2D);
-
-                FreeTextureFile(&Texture);
-    
-                glBindTexture(GL_TEXTURE_2D, 0);
+                StreamMaterialTexture(&Cntx->Textures, CurrentPrimitiveOutMat, MaterialDiffuseTexture, FullFileName, 0);
             }
 
             if (CurrentPrimitiveMat->HaveSpecularExponent) {
-                TextureFile SpecularTexture = {};
-
                 snprintf(FullFileName, sizeof(FullFileName), "%s%s", ResourceFolderLocation, CurrentPrimitiveMat->SpecularExpFilePath);
 
-                if (LoadTextureFile(FullFileName, &SpecularTexture, 1) != Statuses::Success) {
-                    Assert(false);
-                }
-
-                CurrentPrimitiveOutMat->HaveSpecularExponent = 1;
-
-                glGenTextures(1, &CurrentPrimitiveOutMat->SpecularExponentMapTextureHandle);
-                glBindTexture(GL_TEXTURE_2D, CurrentPrimitiveOutMat->SpecularExponentMapTextureHandle);
-
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, SpecularTexture.Width, SpecularTexture.Height, 0, GL_RED, GL_UNSIGNED_BYTE, SpecularTexture.Data);
-
-                FreeTextureFile(&SpecularTexture);
-            
-                glBindTexture(GL_TEXTURE_2D, 0);
+                StreamMaterialTexture(&Cntx->Textures, CurrentPrimitiveOutMat, MaterialSpecularTexture, FullFileName, 1);
             }
 
             CurrentPrimitiveOutMat->AmbientColor  = CurrentPrimitiveMat->AmbientColor;
@@ -1339,6 +872,10 @@ void InitSkeletalMeshComponent(Platform *Platform, GameContext* Cntx, SkeletalMe
 
         SkeletalMesh->PrimitivesAmount = PrimitivesAmount;
     }
+
+    CloseCookedMesh(Platform, &LoadFile.Cooked);
+
+    EndTemporaryMemory(LoadMemory);
 }
 
 /*
@@ -1492,11 +1029,6 @@ void AssimpFbxTestRead(Platform *Platform)
 }
 */
 
-inline real32 CalcT(real32 t, real32 StartKeyframe, real32 EndKeyframe)
-{
-    return 1.0f - ((EndKeyframe - t) / (EndKeyframe - StartKeyframe));
-}
-
 static void PrepareShadowPass(GameContext* Cntx)
 {
     tglGenFramebuffers(1, &Cntx->DepthFbo);
@@ -1531,6 +1063,13 @@ static void PrepareShadowPass(GameContext* Cntx)
 
 void PrepareFrame(Platform *Platform, GameContext *Cntx)
 {
+    InitGameMemory(Platform, Cntx);
+
+    AssetStreamerInit(&Cntx->Streamer, Platform, ASSET_STREAMER_DEFAULT_BUDGET_BYTES, ASSET_STREAMER_DEFAULT_BUDGET_MS);
+    TextureCacheInit(&Cntx->Textures, &Cntx->Streamer, &CreateGameTexture, &DestroyGameTexture);
+
+    Cntx->Streamer.UserData = Cntx;
+
     /*
     vec3 n = {
         0.0f,
@@ -1665,7 +1204,12 @@ void PrepareFrame(Platform *Platform, GameContext *Cntx)
         Object->Transform.Position  = { 0.0f, 0.0f, Index == 1 ? 0.0f : Position };
         Object->Transform.Scale     = CurrentMeshNode->InitialScale;
 
-        InitMeshComponent(Platform, &Object->ObjMesh, CurrentMeshNode->Flags);
+        // NOTE(ismail): flush frees every slot, so second submit can't fail
+        if (InitMeshComponent(&Cntx->Streamer, &Object->ObjMesh, CurrentMeshNode->Flags) != Statuses::Success) {
+            AssetStreamerFlush(&Cntx->Streamer);
+
+            InitMeshComponent(&Cntx->Streamer, &Object->ObjMesh, CurrentMeshNode->Flags);
+        }
 
         Position += 10.0f;
     }
@@ -1690,67 +1234,18 @@ void PrepareFrame(Platform *Platform, GameContext *Cntx)
 
     AnimationSystem& AnimSys = Cntx->AnimSystem;
 
-    AnimationTrack& PlayerTrack = AnimSys.RegisterNewAnimationTrack();
-
-    PlayerTrack.Id      = 0;
-    PlayerTrack.SkinId  = SkeletalCharacters::CharacterPlayer;
-
-    AnimationTask& PlayerWalkTask = PlayerTrack.AnimationTasks[0];
-    PlayerWalkTask.MaxX         = 1.5f;
-    PlayerWalkTask.Mode         = TaskMode::_1D;
-    PlayerWalkTask.Loop         = 1;
-    PlayerWalkTask.StackAmount  = 3;
-
-    Animation* IdleAnim = AnimSys.GetAnimationById(SkeletalCharacters::CharacterPlayer, PLayerAnimations::IdleDynamic);
-    AnimationStack& IdleStack = PlayerWalkTask.Stack[PLayerAnimations::IdleDynamic];
-    IdleStack                   = {};
-    IdleStack.Speed             = 1.0f;
-    IdleStack.StackPositionX    = 0.0f;
-    IdleStack.MaxDuration       = IdleAnim->MaxDuration;
-    IdleStack.Animation         = IdleAnim;
-
-    Animation* WalkAnim = AnimSys.GetAnimationById(SkeletalCharacters::CharacterPlayer, PLayerAnimations::WalkDefault);    
-    AnimationStack& WalkStack = PlayerWalkTask.Stack[PLayerAnimations::WalkDefault];
-    WalkStack                   = {};
-    WalkStack.Speed             = 1.0f;
-    WalkStack.StackPositionX    = 0.75f;
-    WalkStack.MaxDuration       = WalkAnim->MaxDuration;
-    WalkStack.Animation         = WalkAnim;
-
-    Animation* RunAnim = AnimSys.GetAnimationById(SkeletalCharacters::CharacterPlayer, PLayerAnimations::RunDefault);    
-    AnimationStack& RunStack = PlayerWalkTask.Stack[PLayerAnimations::RunDefault];
-    RunStack                   = {};
-    RunStack.Speed             = 1.0f;
-    RunStack.StackPositionX    = 1.5f;
-    RunStack.MaxDuration       = RunAnim->MaxDuration;
-    RunStack.Animation         = RunAnim;
-
-    PlayerTrack.AnimationTasksAmount = 1;
+    AnimationTrack& PlayerTrack = PreparePlayerAnimationTrack(Cntx);
 
     Cntx->TestSceneObjects[1].Nesting.Parent            = &Cntx->TestDynamocSceneObjects[0];
     Cntx->TestSceneObjects[1].Nesting.AttachedToBone    = "mixamorig5:LeftHand";
+    Cntx->TestSceneObjects[1].Nesting.AttachedToBoneID  = AnimSys.GetBoneID(PlayerTrack.Id, Cntx->TestSceneObjects[1].Nesting.AttachedToBone.c_str());
 
-    Particle *SceneParticles = Cntx->SceneParticles;
-    for (i32 Index = 0; Index < PARTICLES_MAX; ++Index) {
-        Particle*       Particle            = &SceneParticles[Index];
-        WorldTransform* ParticleTransform   = &Particle->Transform;
-
-        *ParticleTransform = {};
-
-        ParticleTransform->Scale    = { 5.0f, 5.0f, 5.0f };
-        ParticleTransform->Position = { 0.0f,  0.0f, 2.0f };
-
-        Particle->Velocity      = { 0.0f, 25.0f, 0.0f };
-        Particle->Damping       = 0.8f;
-        Particle->InverseMass   = 1.0f / 2.0f;
-
-        Particle->Acceleration  = GRAVITY;
-    }
+    PrepareParticles(Cntx, 0.0f);
 
-    InitParticleSystem(&Cntx->ParticleSystem);
+    InitParticleRenderer(&Cntx->ParticleRender);
 
     Terrain& Terra = Cntx->Terrain;
-    LoadTerrain(Platform, &Terra, "data/textures/grass_texture.jpg");
+    LoadTerrain(Platform, &Cntx->Textures, &Terra, "data/textures/grass_texture.jpg");
 
     Terra.AmbientColor    = { 0.6f, 0.6f, 0.6f };
     Terra.DiffuseColor    = { 0.8f, 0.8f, 0.8f };
@@ -1762,420 +1257,6 @@ void PrepareFrame(Platform *Platform, GameContext *Cntx)
     Cntx->RotationDelta = 0.1f;
 }
 
-struct KeyframePair {
-    i32 StartKeyframe;
-    i32 EndKeyframe;
-};
-
-struct AnimationFrameTransform {
-    vec3 Scale;
-    quat Rotation;
-    vec3 Translation;
-};
-
-static AnimationFrame* FindFrame(AnimationFrame* Frames, i32 FramesAmount, i32 BoneID)
-{
-    AnimationFrame* Result = 0;
-
-    for (i32 FrameIndex = 0; FrameIndex < FramesAmount; ++FrameIndex) {
-        AnimationFrame* Tmp = &Frames[FrameIndex];
-
-        if (Tmp->Target == BoneID) {
-            Result = Tmp;
-
-            break;
-        }
-    }
-
-    return Result;
-}
-
-static KeyframePair FindKeyframe(real32* Keyframes, i32 KeyframesAmount, real32 CurrentTime)
-{
-    KeyframePair Result = { };
-
-    real32 ZeroKeyframe = Keyframes[0];
-    if (ZeroKeyframe > CurrentTime) {
-        Result.StartKeyframe = 0;
-        Result.EndKeyframe = 1;
-
-        return Result;
-    }
-
-    for (i32 KeyframeIndex = 0; KeyframeIndex < KeyframesAmount; ++KeyframeIndex) {
-        Assert(KeyframeIndex < (KeyframesAmount - 1));
-
-        real32 FrKeyframe = Keyframes[KeyframeIndex];
-        real32 ScKeyframe = Keyframes[KeyframeIndex + 1];
-        if (FrKeyframe <= CurrentTime && CurrentTime <= ScKeyframe) {
-            Result.StartKeyframe    = KeyframeIndex;
-            Result.EndKeyframe      = KeyframeIndex + 1;
-
-            return Result;
-        }
-    }
-
-    Assert(false);
-}
-
-static inline void HandleTranslationInterpolation(AnimationTransformation& Transform, real32 CurrentTime, vec3& FinalTranslation)
-{
-    Assert(Transform.Valid);
-
-    real32* Keyframes = Transform.Keyframes;
-
-    KeyframePair FoundKeyframes = FindKeyframe(Keyframes, Transform.Amount, CurrentTime);
-
-    i32                     StartKeyframe               = FoundKeyframes.StartKeyframe;
-    i32                     EndKeyframe                 = FoundKeyframes.EndKeyframe;
-    TransformationStorage&  StartKeyframeTramsformation = Transform.Transforms[StartKeyframe];
-    TransformationStorage&  EndKeyframeTramsformation   = Transform.Transforms[EndKeyframe];
-    vec3&                   StartTranslation            = StartKeyframeTramsformation.Translation;
-    vec3&                   EndTranslation              = EndKeyframeTramsformation.Translation;
-
-    if (Transform.IType == InterpolationType::IStep) {
-        FinalTranslation = StartTranslation;
-
-        return;
-    }
-
-    real32 T = CalcT(CurrentTime, Keyframes[StartKeyframe], Keyframes[EndKeyframe]);
-
-    vec3 DeltaTranslation = vec3::Lerp(StartTranslation, EndTranslation, T);
-
-    FinalTranslation = StartTranslation + DeltaTranslation;
-}
-
-static inline void HandleRotationInterpolation(AnimationTransformation& Transform, real32 CurrentTime, quat& FinalRotation)
-{
-    Assert(Transform.Valid);
-
-    real32* Keyframes = Transform.Keyframes;
-
-    KeyframePair FoundKeyframes = FindKeyframe(Keyframes, Transform.Amount, CurrentTime);
-
-    i32                     StartKeyframe               = FoundKeyframes.StartKeyframe;
-    i32                     EndKeyframe                 = FoundKeyframes.EndKeyframe;
-    TransformationStorage&  StartKeyframeTramsformation = Transform.Transforms[StartKeyframe];
-    TransformationStorage&  EndKeyframeTramsformation   = Transform.Transforms[EndKeyframe];
-
-    if (Transform.IType == InterpolationType::IStep) {
-        FinalRotation = StartKeyframeTramsformation.Rotation;
-
-        return;
-    }
-
-    real32 T = CalcT(CurrentTime, Keyframes[StartKeyframe], Keyframes[EndKeyframe]);
-
-    FinalRotation = quat::Slerp(StartKeyframeTramsformation.Rotation, EndKeyframeTramsformation.Rotation, T);
-}
-
-static inline void HandleScaleInterpolation(AnimationTransformation& Transform, real32 CurrentTime, vec3& FinalScale)
-{
-    Assert(Transform.Valid);
-
-    real32* Keyframes = Transform.Keyframes;
-
-    KeyframePair FoundKeyframes = FindKeyframe(Keyframes, Transform.Amount, CurrentTime);
-
-    i32                     StartKeyframe               = FoundKeyframes.StartKeyframe;
-    i32                     EndKeyframe                 = FoundKeyframes.EndKeyframe;
-    TransformationStorage&  StartKeyframeTramsformation = Transform.Transforms[StartKeyframe];
-    TransformationStorage&  EndKeyframeTramsformation   = Transform.Transforms[EndKeyframe];
-    vec3&                   StartScale                  = StartKeyframeTramsformation.Scale;
-    vec3&                   EndScale                    = EndKeyframeTramsformation.Scale;
-
-    if (Transform.IType == InterpolationType::IStep) {
-        FinalScale = StartKeyframeTramsformation.Scale;
-
-        return;
-    }
-
-    real32 T = CalcT(CurrentTime, Keyframes[StartKeyframe], Keyframes[EndKeyframe]);
-
-    vec3 DeltaScale = vec3::Lerp(StartScale, EndScale, T);
-
-    FinalScale = StartScale + DeltaScale;
-}
-
-static inline void CalculateAnimationTransform(AnimationTransformation* FrameTransform, real32 CurrentTime, AnimationFrameTransform& FinalTransform)
-{
-    AnimationTransformation& ScaleTransform = FrameTransform[AnimationType::AScale];
-    HandleScaleInterpolation(ScaleTransform, CurrentTime, FinalTransform.Scale);
-
-    AnimationTransformation& RotationTransform = FrameTransform[AnimationType::ARotation];
-    HandleRotationInterpolation(RotationTransform, CurrentTime, FinalTransform.Rotation);
-
-    AnimationTransformation& TranslationTransform = FrameTransform[AnimationType::ATranslation];
-    HandleTranslationInterpolation(TranslationTransform, CurrentTime, FinalTransform.Translation);
-}
-
-static void Calc1DTask(std::map<std::string, BoneIDs>& Bones, mat4* Matrices, Animation& FrAnim, Animation& ScAnim, JointsInfo* Joint, mat4* Parent, real32 FrAnimTime, real32 ScAnimTime, real32 BlendingFactor)
-{
-    BoneIDs& Ids = Bones[Joint->BoneName];
-
-    AnimationFrame* FrAnimFrame = FindFrame(FrAnim.PerBonesFrame, FrAnim.FramesAmount, Ids.BoneID);
-    AnimationFrame* ScAnimFrame = FindFrame(ScAnim.PerBonesFrame, ScAnim.FramesAmount, Ids.BoneID);
-
-    mat4 ParentMat  = Parent ? *Parent : Identity4;
-    mat4 CurrentJointMat  = Identity4;
-
-    if (FrAnimFrame && ScAnimFrame) {
-        AnimationFrameTransform FrAnimCurrentFrameTransform;
-        CalculateAnimationTransform(FrAnimFrame->Transformations, FrAnimTime, FrAnimCurrentFrameTransform);
-
-        AnimationFrameTransform ScAnimCurrentFrameTransform;
-        CalculateAnimationTransform(ScAnimFrame->Transformations, ScAnimTime, ScAnimCurrentFrameTransform);
-
-        vec3& FirstAnimScale    = FrAnimCurrentFrameTransform.Scale;
-        vec3& SecondAnimScale   = ScAnimCurrentFrameTransform.Scale;
-
-        vec3 DeltaScale     = vec3::Lerp(FirstAnimScale, SecondAnimScale, BlendingFactor);
-        vec3 BlendedScale   = FirstAnimScale + DeltaScale;
-
-        quat& FirstAnimRotation     = FrAnimCurrentFrameTransform.Rotation;
-        quat& SecondAnimRotation    = ScAnimCurrentFrameTransform.Rotation;
-
-        quat BlendedRotation = quat::Slerp(FirstAnimRotation, SecondAnimRotation, BlendingFactor);
-
-        vec3& FirstAnimTranslation  = FrAnimCurrentFrameTransform.Translation;
-        vec3& SecondAnimTranslation = ScAnimCurrentFrameTransform.Translation;
-
-        vec3 DeltaTranslation   = vec3::Lerp(FirstAnimTranslation, SecondAnimTranslation, BlendingFactor);
-        vec3 BlendedTranslation = FirstAnimTranslation + DeltaTranslation;
-
-        mat4 ScaleMat         = {};
-        mat4 RotationMat      = {};
-        mat4 TranslationMat   = {};
-
-        ScaleFromVec(BlendedScale, ScaleMat);
-        BlendedRotation.Mat4(RotationMat);
-        TranslationFromVec(BlendedTranslation, TranslationMat);
-
-        CurrentJointMat = TranslationMat * RotationMat * ScaleMat;
-    }
-    else {
-        Assert(false);
-    }
-
-    mat4 ExportMat = ParentMat * CurrentJointMat;
-    Matrices[Ids.OriginalBoneID] = ExportMat;
-
-    i32 ChildrenAmount = Joint->ChildrenAmount;
-    for (i32 ChildrenIndex = 0; ChildrenIndex < ChildrenAmount; ++ChildrenIndex) {
-        Calc1DTask(Bones, Matrices, FrAnim, ScAnim, Joint->Children[ChildrenIndex], &ExportMat, FrAnimTime, ScAnimTime, BlendingFactor);
-    }
-}
-
-static void CalcClipTask(std::map<std::string, BoneIDs>& Bones, mat4* Matrices, Animation& Anim, JointsInfo* Joint, mat4* ParentMat, real32 CurrentTime)
-{
-    BoneIDs& Ids = Bones[Joint->BoneName];
-
-    AnimationFrame* CurrentFrame = FindFrame(Anim.PerBonesFrame, Anim.FramesAmount, Ids.BoneID);
-
-    mat4 Parent           = ParentMat ? *ParentMat : Identity4;
-    mat4 CurrentJointMat  = Identity4;
-
-    if (CurrentFrame) {
-        AnimationFrameTransform CurrentFrameTransform;
-        CalculateAnimationTransform(CurrentFrame->Transformations, CurrentTime, CurrentFrameTransform);
-
-        mat4 ScaleMat         = {};
-        mat4 RotationMat      = {};
-        mat4 TranslationMat   = {};
-
-        ScaleFromVec(CurrentFrameTransform.Scale, ScaleMat);
-        CurrentFrameTransform.Rotation.Mat4(RotationMat);
-        TranslationFromVec(CurrentFrameTransform.Translation, TranslationMat);
-
-        CurrentJointMat = TranslationMat * RotationMat * ScaleMat;
-    }
-    else {
-        Assert(false);
-    }
-
-    mat4 ExportMat = Parent * CurrentJointMat;
-    Matrices[Ids.OriginalBoneID] = ExportMat;
-
-    i32 ChildrenAmount = Joint->ChildrenAmount;
-    for (i32 ChildrenIndex = 0; ChildrenIndex < ChildrenAmount; ++ChildrenIndex) {
-        CalcClipTask(Bones, Matrices, Anim, Joint->Children[ChildrenIndex], &ExportMat, CurrentTime);
-    }
-}
-
-void AnimationSystem::PrepareSkinMatrices(AnimationTrack& Track, i32 TaskId, real32 x, real32 y, real32 dt)
-{
-    Assert(Track.AnimationTasksAmount > TaskId);
-
-    SkeletalComponent& SkinData = SkinningData[Track.SkinId];
-
-    AnimationTask& Task = Track.AnimationTasks[TaskId];
-
-    Skinning& Skin = SkinData.Skin;
-
-    TaskMode Mode = Task.Mode;
-
-    switch(Mode) {
-        
-        case TaskMode::Clip: {
-            AnimationStack& Stack       = Task.Stack[0];
-
-            Assert(Task.StackAmount == 1); // NOTE(ismail): ok chel
-
-            real32 AdvancedTime   = Stack.CurrentTime + dt;
-            real32 MaxDuration    = Stack.MaxDuration;
-
-            if (Task.Loop) {
-                Stack.CurrentTime = fmodf(AdvancedTime, MaxDuration);
-            }
-            else {
-                Stack.CurrentTime = AdvancedTime > MaxDuration ? MaxDuration : AdvancedTime;
-            }
-
-            Animation& AnimToPlay = *Stack.Animation;
-
-            real32 CurrentTime = Stack.CurrentTime;
-
-            SkinningMatricesStorage& MatStorage = Track.Matrices;
-
-            JointsInfo* RootJoint = &Skin.Joints[0];
-
-            CalcClipTask(Skin.Bones, MatStorage.Matrices, AnimToPlay, RootJoint, 0, CurrentTime);
-
-            MatStorage.Amount = Skin.JointsAmount;
-
-        } break;
-
-        case TaskMode::_1D: {
-            AnimationStack* Stack       = Task.Stack;
-            AnimationStack* FrStackNode = 0;
-            AnimationStack* ScStackNode = 0;
-
-            Assert(Task.StackAmount > 1); // NOTE(ismail): If you need to play less than one animation use TaskMode::Clip
-            
-            for (i32 FirstEntry = 0, SecondEntry = 1;;) {
-                FrStackNode = &Stack[FirstEntry];
-                ScStackNode = &Stack[SecondEntry];
-
-                if (FrStackNode->StackPositionX <= x && ScStackNode->StackPositionX >= x) {
-                    break;
-                }
-                else {
-                    FirstEntry = SecondEntry;
-                    SecondEntry = FirstEntry + 1;
-                }
-            }
-
-            real32 FrAdvancedTime   = FrStackNode->CurrentTime + dt;
-            real32 ScAdvancedTime   = ScStackNode->CurrentTime + dt;
-            real32 FrMaxDuration    = FrStackNode->MaxDuration;
-            real32 ScMaxDuration    = ScStackNode->MaxDuration;
-
-            if (Task.Loop) {
-                FrStackNode->CurrentTime = fmodf(FrAdvancedTime, FrMaxDuration);
-                ScStackNode->CurrentTime = fmodf(ScAdvancedTime, ScMaxDuration);
-            }
-            else {
-                FrStackNode->CurrentTime = FrAdvancedTime > FrMaxDuration ? FrMaxDuration : FrAdvancedTime;
-                ScStackNode->CurrentTime = ScAdvancedTime > ScMaxDuration ? ScMaxDuration : ScAdvancedTime;
-            }
-
-            real32 FrPos = FrStackNode->StackPositionX;
-            real32 ScPos = ScStackNode->StackPositionX;
-
-            real32 BlendingFactor = (x - FrPos) / (ScPos - FrPos);
-
-            Animation& FrAnim = *FrStackNode->Animation;
-            Animation& ScAnim = *ScStackNode->Animation;
-
-            real32 FrCurrentTime = FrStackNode->CurrentTime;
-            real32 ScCurrentTime = ScStackNode->CurrentTime;
-
-            SkinningMatricesStorage& MatStorage = Track.Matrices;
-
-            JointsInfo* RootJoint = &Skin.Joints[0];
-
-            Calc1DTask(Skin.Bones, MatStorage.Matrices, FrAnim, ScAnim, RootJoint, 0, FrCurrentTime, ScCurrentTime, BlendingFactor);
-
-            MatStorage.Amount = Skin.JointsAmount;
-        } break;
-
-        case TaskMode::_2D: {
-            Assert(false); // TODO(ismail): implement 2D blending
-        } break;
-    }
-}
-
-void AnimationSystem::Play(i32 CharId, i32 AnimTaskId, real32 x, real32 y, real32 dt)
-{
-    for (AnimationTrack& AnimTrack : CharactersAnimationTrack) {
-        if (CharId == AnimTrack.Id) {
-            PrepareSkinMatrices(AnimTrack, AnimTaskId, x, y, dt);
-
-            break;
-        }
-    }
-}
-
-void AnimationSystem::ExportToRender(SkinningMatricesStorage& Result, i32 CharId)
-{
-    for (AnimationTrack& CharAnimTrack : CharactersAnimationTrack) {
-        if (CharAnimTrack.Id == CharId) {
-            Skinning&                       Skin            = SkinningData[CharAnimTrack.SkinId].Skin;
-            i32                             JointsAmount    = Skin.JointsAmount;
-            std::map<std::string, BoneIDs>& Bones           = Skin.Bones;
-            
-            mat4* OriginMatrices = CharAnimTrack.Matrices.Matrices;
-            mat4* ResultMatrices = Result.Matrices;
-            
-            Result.Amount = JointsAmount;
-
-            for (i32 i = 0; i < JointsAmount; ++i) {
-                JointsInfo *JointInfo = &Skin.Joints[i];
-            
-                BoneIDs& Ids = Bones[JointInfo->BoneName];
-            
-                const mat4&   CurrentOriginMat = OriginMatrices[Ids.OriginalBoneID];
-                mat4&         CurrentResultMat = ResultMatrices[Ids.OriginalBoneID];
-            
-                CurrentResultMat = CurrentOriginMat * JointInfo->InverseBindMatrix;
-            }
-
-            return;
-        }
-    }
-
-    Assert(false); // NOTE(ismail): we must not reache this line
-
-}
-
-mat4& AnimationSystem::GetBoneLocation(i32 CharId, const std::string& BoneName)
-{
-    for (AnimationTrack& Track : CharactersAnimationTrack) {
-        if (Track.Id == CharId) {
-            SkeletalComponent& SkinData = SkinningData[Track.SkinId];
-
-            BoneIDs& IDs = SkinData.Skin.Bones[BoneName];
-
-            return Track.Matrices.Matrices[IDs.OriginalBoneID];
-        }
-    }
-
-    Assert(false); // NOTE(ismail): we must not reache this line
-}
-
-mat4& AnimationSystem::GetBoneLocation(i32 CharId, i32 BoneId)
-{
-    for (AnimationTrack& Track : CharactersAnimationTrack) {
-        if (Track.Id == CharId) {
-            Assert(Track.Matrices.Amount > BoneId);
-            return Track.Matrices.Matrices[BoneId];
-        }
-    }
-
-    Assert(false); // NOTE(ismail): we must not reache this line
-}
-
 static void SetupObjectRendering(GameContext* Ctx, FrameData* Data, WorldTransform& ObjectTransform,
                                  ShaderProgramVariablesStorage*  VarStorage, ObjectNesting& Nesting, 
                                  ShaderProgramsType ShaderType)
@@ -2194,7 +1275,6 @@ static void SetupObjectRendering(GameContext* Ctx, FrameData* Data, WorldTransfo
     if (Nesting.Parent) {
         DynamicSceneObject*             ParentObject    = Nesting.Parent;
         WorldTransform&                 ParentTransform = ParentObject->Transform;
-        std::map<std::string, BoneIDs>& Bones           = ParentObject->ObjMesh.Skelet.Skin.Bones;
 
         mat4 RootToWorldTranslation   = {};
         mat4 RootToWorldRotation      = {};
@@ -2206,7 +1286,7 @@ static void SetupObjectRendering(GameContext* Ctx, FrameData* Data, WorldTransfo
 
         ScaleFromVecRelative(ObjectTransform.Scale, ParentTransform.Scale, ObjectScale);
 
-        mat4& AttachedBoneMat = Ctx->AnimSystem.GetBoneLocation(0, Nesting.AttachedToBone);
+        mat4& AttachedBoneMat = Ctx->AnimSystem.GetBoneLocation(0, Nesting.AttachedToBoneID);
 
         ObjectToCameraSpaceTransformation   = Data->CameraTransformation * RootToWorldTranslation;
         ObjectGeneralTransformation         = RootToWorldRotation * RootToWorldScale * AttachedBoneMat * 
@@ -2246,7 +1326,6 @@ static void SetupObjects(AnimationSystem& AnimSys, WorldTransform& ObjectTransfo
     if (Nesting.Parent) {
         DynamicSceneObject*             ParentObject    = Nesting.Parent;
         WorldTransform&                 ParentTransform = ParentObject->Transform;
-        std::map<std::string, BoneIDs>& Bones           = ParentObject->ObjMesh.Skelet.Skin.Bones;
 
         mat4 RootToWorldTranslation   = {};
         mat4 RootToWorldRotation      = {};
@@ -2258,7 +1337,7 @@ static void SetupObjects(AnimationSystem& AnimSys, WorldTransform& ObjectTransfo
 
         ScaleFromVecRelative(ObjectTransform.Scale, ParentTransform.Scale, ObjectScale);
 
-        mat4& AttachedBoneMat = AnimSys.GetBoneLocation(0, Nesting.AttachedToBone);
+        mat4& AttachedBoneMat = AnimSys.GetBoneLocation(0, Nesting.AttachedToBoneID);
 
         FrameStorage.ObjectToWorldTranslation       = RootToWorldTranslation;
         FrameStorage.ObjectGeneralTransformation    = RootToWorldRotation * RootToWorldScale * AttachedBoneMat * 
@@ -2770,23 +1849,6 @@ static inline void TakeInput(Platform *Platform, GameContext *Cntx)
     else if (Platform->Input.QButton.State == KeyState::Released) {
         Cntx->QWasTriggered = 0;
     }
-    
-    if (Platform->Input.ArrowUp.State == KeyState::Pressed) {
-        if (Cntx->BlendingX <= 1.496f) {
-            Cntx->BlendingX += 0.001f;
-        }
-        else {
-            Cntx->BlendingX = 1.5f;
-        }
-    }
-    else {
-        if (Cntx->BlendingX > 0.005f) {
-            Cntx->BlendingX -= 0.001f;
-        }
-        else {
-            Cntx->BlendingX = 0.0f;
-        }
-    }
 
     if (Platform->Input.ArrowUp.State == KeyState::Pressed && !Cntx->ArrowUpWasTriggered) {
         Cntx->ArrowUpWasTriggered = 1;
@@ -2831,25 +1893,19 @@ void Frame(Platform *Platform, GameContext *Cntx)
 
     FrameData& FrameData = Cntx->FrameDt;
 
+    MemoryCountersSnapshot FrameStartCounters = BeginFrameMemory(Cntx);
+
+    // NOTE(ismail): GL upload of streamed assets, at most Streamer budget per frame
+    AssetStreamerUpload(&Cntx->Streamer);
+
     TakeInput(Platform, Cntx);
 
-    Cntx->AnimSystem.Play(0, 0, Cntx->BlendingX, 0.0f, Cntx->DeltaTimeSec);
+    SimulateFrame(Platform, Cntx);
 
     mat4 PerspProjection = {};
     MakePerspProjection(PerspProjection, 60.0f, Platform->ScreenOpt.AspectRatio, 0.1f, 1500.0f);
 
-    Cntx->PlayerCamera.Transform.Rotation.b = 0.0f;
-    Cntx->PlayerCamera.Transform.Rotation.p += RAD_TO_DEGREE(Platform->Input.MouseInput.Moution.y) * 0.5f;
-    Cntx->PlayerCamera.Transform.Rotation.h += RAD_TO_DEGREE(Platform->Input.MouseInput.Moution.x) * 0.5f;
-
-    real32 ZTranslationMultiplyer = (real32)(Platform->Input.WButton.State + (-1 * Platform->Input.SButton.State)); // 1.0 if W Button -1.0 if S Button and 0 if W and S Button pressed together
-    real32 XTranslationMultiplyer = (real32)(Platform->Input.DButton.State + (-1 * Platform->Input.AButton.State));
-
-    vec3 Target, Right, Up;
     Rotation& PlayerCameraRotation = Cntx->PlayerCamera.Transform.Rotation;
-    PlayerCameraRotation.ToVec(Target, Up, Right);
-
-    Cntx->PlayerCamera.Transform.Position += (Target * ZTranslationMultiplyer * 0.1f) + (Right * XTranslationMultiplyer * 0.1f);
 
     mat4 CameraTranslation = {}; 
     InverseTranslationFromVec(Cntx->PlayerCamera.Transform.Position, CameraTranslation);
@@ -2892,22 +1948,22 @@ void Frame(Platform *Platform, GameContext *Cntx)
 
         VarStorage = &Shader->ProgramVarsStorage;
 
-        Particle*       SceneParticles  = Cntx->SceneParticles;
-        ParticleSystem* ParticleSys     = &Cntx->ParticleSystem;
-        for (i32 Index = 0; Index < PARTICLES_MAX; ++Index) {
-            Particle*       CurrentParticle = &SceneParticles[Index];
-            WorldTransform* Transform       = &CurrentParticle->Transform;
+        ParticleSystem*     Particles   = &Cntx->Particles;
+        ParticleRenderer*   ParticleSys = &Cntx->ParticleRender;
+        for (i32 Index = 0; Index < Particles->Amount; ++Index) {
+            WorldTransform Transform = {};
 
-            CurrentParticle->Integrate(Cntx->DeltaTimeSec);
+            Transform.Scale     = { 5.0f, 5.0f, 5.0f };
+            Transform.Position  = { Particles->PositionX[Index], Particles->PositionY[Index], Particles->PositionZ[Index] };
 
             mat4 ObjectToWorldTranslation = {};
-            MakeTranslationFromVec(&Transform->Position, &ObjectToWorldTranslation);
+            MakeTranslationFromVec(&Transform.Position, &ObjectToWorldTranslation);
 
             mat4 ObjectToWorlRotation = {};
-            MakeObjectToUprightRotation(&Transform->Rotation, &ObjectToWorlRotation);
+            MakeObjectToUprightRotation(&Transform.Rotation, &ObjectToWorlRotation);
 
             mat4 ObjectToWorldScale = {};
-            MakeScaleFromVector(&Transform->Scale, &ObjectToWorldScale);
+            MakeScaleFromVector(&Transform.Scale, &ObjectToWorldScale);
 
             mat4 ObjectToWorldTransformation = CameraTransformation * ObjectToWorldTranslation;
             mat4 ObjectToWorldScaleAndRotate = ObjectToWorlRotation * ObjectToWorldScale;
@@ -2931,4 +1987,6 @@ void Frame(Platform *Platform, GameContext *Cntx)
     }
 
     FrameData = {};
+
+    EndFrameMemory(Cntx, FrameStartCounters);
 }
\ No newline at end of file
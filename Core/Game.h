@@ -3,14 +3,19 @@
 
 // NOTE(ismail): remove this shit
 #include <string>
-#include <map>
-#include <list>
+#include <deque>
 
 #include "Types.h"
+#include "EnginePlatform.h"
+#include "JobSystem.h"
+#include "Memory.h"
 #include "Utils/AssetsLoader.h"
+#include "Utils/AssetStreamer.h"
+#include "Utils/TextureCache.h"
 #include "Math/Vector.h"
 #include "Math/Rotation.h"
 #include "Math/Quat.h"
+#include "Physics/ParticleSystem.h"
 
 #define BATTLE_AREA_GRID_VERT_AMOUNT    100
 #define ONE_SQUARE_INDEX_AMOUNT         6
@@ -20,13 +25,14 @@
 #define MAX_POINTS_LIGHTS               2
 #define MAX_SPOT_LIGHTS                 1
 #define MAX_BONES                       200
-#define MAX_KEYFRAMES                   400
 #define MAX_CHARACTER_ANIMATIONS        20
 #define MAX_JOINT_CHILDREN_AMOUNT       10
 #define MAX_MESH_PRIMITIVES             5
 #define MAX_MESHES                      1
 #define SHADOW_MAP_W                    (2048)
 #define SHADOW_MAP_H                    (2048)
+#define LEVEL_ARENA_SIZE                Megabytes(256)
+#define FRAME_ARENA_SIZE                Megabytes(64)
 
 enum OpenGLBuffersLocation {
     // STATIC MESH
@@ -46,7 +52,7 @@ enum OpenGLBuffersLocation {
 const vec3 GRAVITY = { 0.0f, -10.0f, 0.0f };
 
 struct JointsInfo {
-    std::string BoneName;
+    const char* BoneName; // NOTE(ismail): lives in arena joints were read into
     JointsInfo* Parent;
     JointsInfo* Children[MAX_JOINT_CHILDREN_AMOUNT];
     i32         ChildrenAmount;
@@ -61,10 +67,26 @@ struct BoneIDs {
     i32 BoneID;
 };
 
+// NOTE(ismail): joint table compiled once at load, indexed by BoneID. Joints are stored in
+// parent-before-child order so pose evaluation is a plain linear walk without Bones name lookups
+struct CompiledJoint {
+    i32 OriginalBoneID;
+    i32 ParentOriginalBoneID; // NOTE(ismail): -1 for root joint
+};
+
+#define SKIN_BONES_TABLE_SIZE           (512) // NOTE(ismail): power of two, at least twice MAX_BONES so probes stay short
+
+// NOTE(ismail): open addressing by name hash, Name points to JointsInfo::BoneName, null Name is free slot
+struct SkinBone {
+    const char* Name;
+    BoneIDs     Ids;
+};
+
 struct Skinning {
-    std::map<std::string, BoneIDs>  Bones;
-    JointsInfo*                     Joints;
-    u32                             JointsAmount;
+    SkinBone        Bones[SKIN_BONES_TABLE_SIZE];
+    JointsInfo*     Joints;
+    CompiledJoint   CompiledJoints[MAX_BONES];
+    u32             JointsAmount;
 };
 
 enum AnimationType {
@@ -80,17 +102,6 @@ enum InterpolationType {
     IMax,
 };
 
-// ?????
-union TransformationStorage {
-    TransformationStorage() {
-
-    }
-
-    vec3    Translation;
-    quat    Rotation;
-    vec3    Scale;
-};
-
 enum PLayerAnimations {
     IdleDynamic = 0,
     WalkDefault = 1,
@@ -98,22 +109,26 @@ enum PLayerAnimations {
     Max
 };
 
-struct AnimationTransformation {
-    bool32                  Valid;
-    InterpolationType       IType;
-    real32                  Keyframes[MAX_KEYFRAMES];
-    TransformationStorage   Transforms[MAX_KEYFRAMES];
-    i32                     Amount;
+// NOTE(ismail): offsets in bytes from Animation::Data, keyframes and transforms of one channel are contiguous
+struct AnimationChannel {
+    u32                 KeyframesOffset;
+    u32                 TransformsOffset;   // NOTE(ismail): vec3 for translation and scale, quat for rotation
+    i32                 Amount;
+    InterpolationType   IType;
 };
 
 struct AnimationFrame {
-    i32                     Target;
-    i32                     OriginalBoneID;
-    AnimationTransformation Transformations[AMax];
+    i32                 Target;
+    i32                 OriginalBoneID;
+    AnimationChannel    Channels[AMax];
 };
 
+// NOTE(ismail): packed clip, frames table goes first in Data and then channels keys, so clip takes only as much memory as keys it has
 struct Animation {
-    AnimationFrame  PerBonesFrame[MAX_BONES];
+    u8*             Data;
+    u32             DataSize;
+    AnimationFrame* PerBonesFrame;
+    i32             BoneFrames[MAX_BONES]; // NOTE(ismail): index into PerBonesFrame by BoneID, -1 if bone is not animated
     i32             FramesAmount;
     real32          MaxDuration;
 };
@@ -125,7 +140,7 @@ struct AnimationsArray {
 
 struct WorldTransform {
     vec3        Position;
-    Rotation    Rotation;
+    ::Rotation  Rotation;
     vec3        Scale;
 };
 
@@ -238,7 +253,7 @@ struct LightAttenuation {
 
 struct DirectionalLight {
     LightSpec   Specification;
-    Rotation    Rotation;
+    ::Rotation  Rotation;
 };
 
 struct PointLight {
@@ -249,7 +264,7 @@ struct PointLight {
 struct SpotLight {
     LightSpec           Specification;
     LightAttenuation    Attenuation;
-    Rotation            Rotation;
+    ::Rotation          Rotation;
     real32              CosCutoffAngle;
     real32              CutoffAttenuationFactor;
 };
@@ -273,6 +288,9 @@ struct MeshComponentObjects {
 
 #define MAX_CHARACTERS_ANIMATION_TASKS  (MAX_CHARACTER_ANIMATIONS)
 #define ANIMATION_STACK_LENGTH          (8)
+#define ANIMATION_TRACKS_PER_JOB        (4)
+#define MAX_BLEND_SPACE_TRIANGLES       (56) // NOTE(ismail): every triple of ANIMATION_STACK_LENGTH samples
+#define MAX_BLEND_POSES                 (3)
 
 struct SkeletalComponent {
     AnimationsArray Animations;
@@ -291,12 +309,13 @@ enum TaskMode {
 };
 
 struct AnimationStack {
-    real32      Speed;
-    real32      CurrentTime;
-    real32      MaxDuration;
-    real32      StackPositionX;
-    real32      StackPositionY;
-    Animation*  Animation;
+    real32          Speed;
+    real32          CurrentTime;
+    real32          MaxDuration;
+    real32          StackPositionX;
+    real32          StackPositionY;
+    ::Animation*    Animation;
+    u16             KeyframeCursors[MAX_BONES][AMax]; // NOTE(ismail): last found start keyframe per bone channel, indexed by BoneID
 };
 
 struct AnimationTask {
@@ -308,6 +327,8 @@ struct AnimationTask {
     bool32          Loop;
     AnimationStack  Stack[ANIMATION_STACK_LENGTH];
     i32             StackAmount;
+    u8              BlendTriangles[MAX_BLEND_SPACE_TRIANGLES][3]; // NOTE(ismail): _2D only, built from stacks positions on first evaluation
+    i32             BlendTrianglesAmount;
 };
 
 enum SkeletalCharacters {
@@ -320,9 +341,24 @@ struct AnimationTrack {
     SkeletalCharacters      SkinId;
     AnimationTask           AnimationTasks[MAX_CHARACTERS_ANIMATION_TASKS];
     i32                     AnimationTasksAmount;
+    i32                     ActiveTask; // NOTE(ismail): task evaluated by UpdateAll with its x and y
     SkinningMatricesStorage Matrices;
 };
 
+struct AnimationUpdateStats {
+    real64  UpdateTimeMs;
+    i32     TracksAmount;
+    i32     JobsAmount;
+};
+
+class AnimationSystem;
+
+struct AnimationUpdateJob {
+    AnimationSystem*    System;
+    real32              dt;
+    std::atomic<i32>    RangesAmount;
+};
+
 class AnimationSystem {
 public:
     AnimationSystem() = default;
@@ -338,9 +374,22 @@ public:
         return SkinningData[Id];
     }
 
+    // NOTE(ismail): track Id is its index, deque keeps references valid while we register new tracks
     AnimationTrack& RegisterNewAnimationTrack() {
         CharactersAnimationTrack.emplace_back();
-        return CharactersAnimationTrack.back();
+
+        AnimationTrack& Track = CharactersAnimationTrack.back();
+        Track.Id = (i32)CharactersAnimationTrack.size() - 1;
+
+        return Track;
+    }
+
+    const AnimationUpdateStats& GetUpdateStats() const {
+        return UpdateStats;
+    }
+
+    i32 GetTracksAmount() const {
+        return (i32)CharactersAnimationTrack.size();
     }
 
     Animation* GetAnimationById(SkeletalCharacters SkeletId, i32 AnimationId) {
@@ -348,15 +397,22 @@ public:
     }
 
     void Play(i32 CharId, i32 AnimTaskId, real32 x, real32 y, real32 dt);
+    void SetActiveTask(i32 CharId, i32 AnimTaskId, real32 x, real32 y);
+    void UpdateAll(Platform* Platform, real32 dt);
+    i32 GetBoneID(i32 CharId, const char* BoneName);
     mat4& GetBoneLocation(i32 CharId, i32 BoneId);
-    mat4& GetBoneLocation(i32 CharId, const std::string& BoneName);
+    mat4& GetBoneLocation(i32 CharId, const char* BoneName);
     void ExportToRender(SkinningMatricesStorage& Result, i32 CharId);
 
 private:
     void PrepareSkinMatrices(AnimationTrack& Track, i32 TaskId, real32 x, real32 y, real32 dt);
+    AnimationTrack& GetTrack(i32 CharId);
+
+    static TEARA_JOB_FUNCTION(UpdateTracksJob);
 
-    std::list<AnimationTrack>   CharactersAnimationTrack;
+    std::deque<AnimationTrack>  CharactersAnimationTrack;
     SkeletalComponent           SkinningData[SkeletalCharacters::SkeletalMax];
+    AnimationUpdateStats        UpdateStats;
 };
 
 struct MeshComponent {
@@ -383,6 +439,7 @@ struct DynamicSceneObject;
 
 struct ObjectNesting {
     std::string         AttachedToBone;
+    i32                 AttachedToBoneID; // NOTE(ismail): resolved from AttachedToBone once at load
     DynamicSceneObject* Parent;
 };
 
@@ -419,39 +476,13 @@ struct Terrain {
     WorldTransform  Transform;
 };
 
-#define PARTICLES_MAX 1
+#define PARTICLES_CAPACITY (65536)
 
-struct ParticleSystem {
+struct ParticleRenderer {
     u32 BuffersHandler[GLLocationMax];
     i32 IndicesAmount;
 };
 
-struct Particle {
-    WorldTransform  Transform;
-    vec3            Velocity;
-    vec3            Acceleration;
-    real32          Damping;
-    real32          InverseMass;
-
-    void Integrate(real32 DeltaT)
-    {
-        // x(t) = x0 + v*t
-        // v(t) = v0*t + a*t
-        
-        Transform.Position += Velocity * DeltaT;
-        
-        // NOTE(Ismail): it may cause some perfomance issue, if we will be simulate many particles
-        // so check it for optimization if it will need
-        real32 DampingEffect = powf(Damping, DeltaT);
-
-        vec3 AccelerationTmp = Acceleration * DeltaT;
-
-        Velocity += AccelerationTmp;
-
-        Velocity *= DampingEffect;
-    }
-};
-
 struct FrameDataStorage {
     SkinningMatricesStorage SkinFrameStorage;
     mat4                    ObjectToWorldTranslation;
@@ -471,6 +502,15 @@ struct FrameData {
     vec3                CameraPosition;
 };
 
+// NOTE(ismail): allocations made inside last Frame call, steady state frames are expected to have all of them zero
+struct FrameMemoryStats {
+    i64 HeapAllocations;
+    i64 HeapBytes;
+    i64 PlatformAllocations;
+    i64 PlatformBytes;
+    u64 FrameArenaUsed;
+};
+
 struct GameContext {
     u32 DepthFbo;
     u32 DepthTexture;
@@ -495,9 +535,9 @@ struct GameContext {
     Camera              PlayerCamera;
     SceneObject         TestSceneObjects[SCENE_OBJECTS_MAX];
     DynamicSceneObject  TestDynamocSceneObjects[DYNAMIC_SCENE_OBJECTS_MAX];
-    Terrain             Terrain;
-    Particle            SceneParticles[PARTICLES_MAX];
-    ParticleSystem      ParticleSystem;
+    ::Terrain           Terrain;
+    ParticleSystem      Particles;
+    ParticleRenderer    ParticleRender;
 
     DirectionalLight    LightSource;
     PointLight          PointLights[MAX_POINTS_LIGHTS];
@@ -507,6 +547,13 @@ struct GameContext {
 
     FrameData FrameDt;
 
+    MemoryArena         LevelArena; // NOTE(ismail): lives until level is unloaded, loaders put skins, clips and particles here
+    MemoryArena         FrameArena; // NOTE(ismail): reset at start of every Frame, loaders also use it as scratch
+    FrameMemoryStats    FrameMemory;
+
+    AssetStreamer       Streamer;
+    TextureCache        Textures;
+
     bool32 EWasPressed;
 };
 
@@ -0,0 +1,1566 @@
+#include "Types.h"
+#include "Debug.h"
+#include "Memory.h"
+#include "EnginePlatform.h"
+#include "Game.h"
+#include "Math/Matrix.h"
+#include "Math/Transformation.h"
+#include "Physics/ParticleSystem.h"
+#include "Utils/CookedMesh.h"
+#include "3rdparty/cgltf/cgltf.h"
+
+// NOTE(ismail): part of Frame that never touches GL: glTF skin and clip reading, animation runtime and simulation step.
+// Game.cpp and headless LinuxMain.cpp both include this file
+
+struct SerialaizedAnimations {
+    i32         AnimId;
+    const char* Path;
+};
+
+struct DynamicSceneObjectLoader {
+    SkeletalCharacters      SkeletCharId;
+    SerialaizedAnimations   Mesh;
+    SerialaizedAnimations   Animations[MAX_CHARACTER_ANIMATIONS];
+    i32                     Amount;
+};
+
+DynamicSceneObjectLoader DynamicSceneObjectsName[] = {
+    {
+        SkeletalCharacters::CharacterPlayer,
+        {
+            PLayerAnimations::IdleDynamic,
+            "data/obj/Idle.gltf"
+        },
+        {
+            {
+                PLayerAnimations::WalkDefault,
+                "data/obj/Walk.gltf"
+            },
+            {
+                PLayerAnimations::RunDefault,
+                "data/obj/Run.gltf"
+            }
+        },
+        2
+    },
+};
+
+struct ivec4 {
+    i32 x, y, z, w;
+};
+
+struct uvec4 {
+    union {
+        struct {
+            u32 x, y, z, w;
+        };
+        u32 ValueHolder[4];   
+    };
+};
+
+struct u8vec4 {
+    union {
+        struct {
+            u8 x, y, z, w;
+        };
+        u32 ValueHolder;   
+    };
+};
+
+struct glTF2Primitives {
+    Material    MeshMaterial;
+    vec3*       Positions;
+    vec3*       Normals;
+    vec2*       TextureCoord;
+    vec4*       BoneWeights;
+    ivec4*      BoneIds;
+    u32*        Indices;
+    u32         PositionsCount;
+    u32         NormalsCount;
+    u32         TexturesCount;
+    u32         BoneWeightsCount;
+    u32         BoneIdsCount;
+    u32         IndicesCount;
+};
+
+struct glTF2Mesh {
+    glTF2Primitives MeshPrimitives[MAX_MESH_PRIMITIVES];
+    i32             PrimitivesAmount;
+};
+
+// NOTE(ismail): when primitives come from cooked blob their streams point into Cooked mapping, CloseCookedMesh after upload
+struct glTF2File {
+    Skinning*           Skelet;
+    AnimationsArray*    Animations;
+    glTF2Mesh           Meshes[MAX_MESHES];
+    i32                 MeshesAmount;
+    CookedMesh          Cooked;
+};
+
+// NOTE(ismail): FNV-1a of bone name, table index comes from low bits
+static u32 SkinBoneHash(const char* Name)
+{
+    u32 Result = 0x811C9DC5u;
+
+    for (const char* At = Name; *At; ++At) {
+        Result = (Result ^ (u8)*At) * 0x01000193u;
+    }
+
+    return Result;
+}
+
+static SkinBone* SkinFindBoneSlot(Skinning* Skin, const char* Name)
+{
+    u32 Mask = SKIN_BONES_TABLE_SIZE - 1;
+
+    for (u32 Slot = SkinBoneHash(Name) & Mask; ; Slot = (Slot + 1) & Mask) {
+        SkinBone* Bone = &Skin->Bones[Slot];
+
+        if (!Bone->Name || strcmp(Bone->Name, Name) == 0) {
+            return Bone;
+        }
+    }
+}
+
+// NOTE(ismail): returns 0 when skin has no bone with this name
+BoneIDs* SkinFindBone(Skinning* Skin, const char* Name)
+{
+    SkinBone* Bone = SkinFindBoneSlot(Skin, Name);
+
+    return Bone->Name ? &Bone->Ids : 0;
+}
+
+// NOTE(ismail): Name is not copied, it must live as long as skin
+static BoneIDs* SkinAddBone(Skinning* Skin, const char* Name)
+{
+    SkinBone* Bone = SkinFindBoneSlot(Skin, Name);
+
+    Bone->Name = Name;
+
+    return &Bone->Ids;
+}
+
+static void SkinClearBones(Skinning* Skin)
+{
+    memset(Skin->Bones, 0, sizeof(Skin->Bones));
+}
+
+void ReadJointNode(MemoryArena* Arena, Skinning* Skin, cgltf_node* Joint, JointsInfo* ParentJoint, i32& Index, cgltf_node** RootJoints, i32 Len)
+{
+    if (!Joint) {
+        return;
+    }
+
+    JointsInfo* CurrentJointInfo = &Skin->Joints[Index];
+
+    cgltf_float*    Translation = Joint->translation;
+    cgltf_float*    Scale       = Joint->scale;
+    quat            Rotation    = Joint->rotation;
+
+    mat4 InverseTranslationMatrix = {};
+    mat4 InverseScaleMatrix       = {};
+    mat4 InverseRotationMatrix    = {};
+    mat4 ParentMatrix             = !ParentJoint ? Identity4 : ParentJoint->InverseBindMatrix;
+
+    InverseTranslationFromArr(Translation, InverseTranslationMatrix);
+    InverseScaleFromArr(Scale, InverseScaleMatrix);
+    Rotation.UprightToObject(InverseRotationMatrix);
+
+    i32 ChildreJointsAmount = (i32)Joint->children_count;
+
+    if (ParentJoint) {
+        i32 ChildrenIndex = ParentJoint->ChildrenAmount;
+
+        Assert(ChildrenIndex <= MAX_JOINT_CHILDREN_AMOUNT);
+
+        ++ParentJoint->ChildrenAmount;
+
+        ParentJoint->Children[ChildrenIndex] = CurrentJointInfo;
+    }
+
+    CurrentJointInfo->BoneName              = PushString(Arena, Joint->name);
+    CurrentJointInfo->Parent                = ParentJoint;
+    CurrentJointInfo->InverseBindMatrix     = InverseScaleMatrix * InverseRotationMatrix * InverseTranslationMatrix * ParentMatrix;
+    CurrentJointInfo->DefaultScale          = { Scale[_x_], Scale[_y_], Scale[_z_] };
+    CurrentJointInfo->DefaultRotation       = Rotation;
+    CurrentJointInfo->DefaultTranslation    = { Translation[_x_], Translation[_y_], Translation[_z_] };
+
+    i32 OriginalID = -1;
+    for (i32 RootJointID = 0; RootJointID < Len; ++RootJointID) {
+        cgltf_node** OriginalJoint = &RootJoints[RootJointID];
+
+        if (*OriginalJoint == Joint) {
+            OriginalID = OriginalJoint - RootJoints;
+
+            break;
+        }
+    }
+
+    Assert(OriginalID != -1);
+
+    BoneIDs* Ids = SkinAddBone(Skin, CurrentJointInfo->BoneName);
+
+    Ids->BoneID         = Index;
+    Ids->OriginalBoneID = OriginalID;
+
+    Assert(Index < MAX_BONES);
+
+    // NOTE(ismail): joints are visited in depth-first order so parent entry is always compiled before its children
+    CompiledJoint& Compiled = Skin->CompiledJoints[Index];
+
+    Compiled.OriginalBoneID         = OriginalID;
+    Compiled.ParentOriginalBoneID   = ParentJoint ? Skin->CompiledJoints[ParentJoint - Skin->Joints].OriginalBoneID : -1;
+
+    ++Index;
+
+    for (i32 ChildrenJointIndex = 0; ChildrenJointIndex < ChildreJointsAmount; ++ChildrenJointIndex) {
+        ReadJointNode(Arena, Skin, Joint->children[ChildrenJointIndex], CurrentJointInfo, Index, RootJoints, Len);
+    }
+}
+
+void glTFReadAnimations(MemoryArena* Arena, cgltf_animation* Animations, i32 AnimationsCount, AnimationsArray& AnimArray, Skinning& Skin)
+{
+    Assert(AnimationsCount == 1); // TODO(ismail): restrictions for now in future we should handle that case
+
+    for (i32 AnimationIndex = 0, AnimationArrayIndex = AnimArray.AnimsAmount; 
+            AnimationIndex < AnimationsCount; 
+            ++AnimationIndex, ++AnimationArrayIndex) {
+            cgltf_animation&    CurrentAnimation    = Animations[AnimationIndex];
+            Animation&          AnimationNode       = AnimArray.Anims[AnimationArrayIndex];
+
+            i32                             ChannelsCount   = (i32)CurrentAnimation.channels_count;
+            cgltf_animation_channel*        Channels        = CurrentAnimation.channels;
+
+            // NOTE(ismail): first pass only measures clip so we can allocate it at once
+            i32         FramesAmount    = 0;
+            u32         KeysDataSize    = 0;
+            cgltf_node* LastTargetNode  = 0;
+
+            for (i32 ChannelIndex = 0; ChannelIndex < ChannelsCount; ++ChannelIndex) {
+                cgltf_animation_channel*    CurrentChannel  = &Channels[ChannelIndex];
+                cgltf_node*                 TargetNode      = CurrentChannel->target_node;
+                u32                         KeyframesAmount = (u32)CurrentChannel->sampler->input->count;
+
+                if (LastTargetNode != TargetNode) {
+                    LastTargetNode = TargetNode;
+                    ++FramesAmount;
+                }
+
+                u32 TransformSize = CurrentChannel->target_path == cgltf_animation_path_type::cgltf_animation_path_type_rotation ? sizeof(quat) : sizeof(vec3);
+
+                KeysDataSize += KeyframesAmount * (sizeof(real32) + TransformSize);
+            }
+
+            Assert(FramesAmount <= MAX_BONES);
+
+            u32 FramesSize  = sizeof(AnimationFrame) * FramesAmount;
+            u32 DataSize    = FramesSize + KeysDataSize;
+            u8* Data        = PushArray(Arena, u8, DataSize);
+
+            memset(Data, 0, FramesSize);
+
+            AnimationNode.Data          = Data;
+            AnimationNode.DataSize      = DataSize;
+            AnimationNode.PerBonesFrame = (AnimationFrame*)Data;
+
+            for (i32 BoneFrameIndex = 0; BoneFrameIndex < MAX_BONES; ++BoneFrameIndex) {
+                AnimationNode.BoneFrames[BoneFrameIndex] = -1;
+            }
+
+            real32          AnimationDuration   = 0.0f;
+            i32             BoneIndex           = 0;
+            u32             DataOffset          = FramesSize;
+            AnimationFrame* Frame               = 0;
+
+            LastTargetNode = 0;
+
+            for (i32 ChannelIndex = 0; ChannelIndex < ChannelsCount; ++ChannelIndex) {
+                cgltf_animation_channel*    CurrentChannel  = &Channels[ChannelIndex];
+                cgltf_animation_sampler*    CurrentSampler  = CurrentChannel->sampler;
+                cgltf_node*                 TargetNode      = CurrentChannel->target_node;
+
+                BoneIDs* Ids = SkinFindBone(&Skin, TargetNode->name);
+                if (!Ids) {
+                    // TODO(Ismail): now we just continue but need to handle that case
+                    Assert(false);
+                }
+
+                if (LastTargetNode != TargetNode) {
+                    AnimationNode.BoneFrames[Ids->BoneID] = BoneIndex;
+
+                    Frame           = &AnimationNode.PerBonesFrame[BoneIndex++];
+                    LastTargetNode  = TargetNode;
+
+                    Frame->Target           = Ids->BoneID;
+                    Frame->OriginalBoneID   = Ids->OriginalBoneID;
+                }
+
+                cgltf_animation_path_type   ChannelType         = CurrentChannel->target_path;
+                cgltf_interpolation_type    InterpalationType   = CurrentSampler->interpolation;
+
+                Assert(ChannelType != cgltf_animation_path_type::cgltf_animation_path_type_invalid &&
+                       ChannelType != cgltf_animation_path_type::cgltf_animation_path_type_weights);
+
+                Assert(CurrentSampler->input->count == CurrentSampler->output->count);
+
+                i32 KeyframesAmount = (i32)CurrentSampler->input->count;
+
+                Assert(KeyframesAmount <= 0xFFFF); // NOTE(ismail): keyframe cursors are u16
+
+                AnimationChannel* Channel;
+                switch(ChannelType) {
+                    case cgltf_animation_path_type::cgltf_animation_path_type_translation: {
+                        Channel = &Frame->Channels[ATranslation];
+
+                        Channel->TransformsOffset = DataOffset;
+
+                        vec3*           Translations        = (vec3*)(Data + DataOffset);
+                        cgltf_accessor* TransformAccessor   = CurrentSampler->output;
+                        for (i32 TransformIndex = 0; TransformIndex < KeyframesAmount; ++TransformIndex) {
+                            vec3 Elem = {};
+                            cgltf_accessor_read_float(TransformAccessor, TransformIndex, Elem.vec, sizeof(Elem));
+
+                            Translations[TransformIndex] = Elem;
+                        }
+
+                        DataOffset += sizeof(vec3) * KeyframesAmount;
+                    } break;
+
+                    case cgltf_animation_path_type::cgltf_animation_path_type_rotation: {
+                        Channel = &Frame->Channels[ARotation];
+
+                        Channel->TransformsOffset = DataOffset;
+
+                        quat*           Rotations           = (quat*)(Data + DataOffset);
+                        cgltf_accessor* TransformAccessor   = CurrentSampler->output;
+                        for (i32 TransformIndex = 0; TransformIndex < KeyframesAmount; ++TransformIndex) {
+                            real32 Elem[4] = {};
+                            cgltf_accessor_read_float(TransformAccessor, TransformIndex, Elem, sizeof(Elem));
+
+                            quat *Rot = &Rotations[TransformIndex];
+                            Rot->w = Elem[_w_];
+                            Rot->x = Elem[_x_];
+                            Rot->y = Elem[_y_];
+                            Rot->z = Elem[_z_];
+                        }
+
+                        DataOffset += sizeof(quat) * KeyframesAmount;
+                    } break;
+
+                    case cgltf_animation_path_type::cgltf_animation_path_type_scale: {
+                        Channel = &Frame->Channels[AScale];
+
+                        Channel->TransformsOffset = DataOffset;
+
+                        vec3*           Scales              = (vec3*)(Data + DataOffset);
+                        cgltf_accessor* TransformAccessor   = CurrentSampler->output;
+                        for (i32 TransformIndex = 0; TransformIndex < KeyframesAmount; ++TransformIndex) {
+                            vec3 Elem = {};
+                            cgltf_accessor_read_float(TransformAccessor, TransformIndex, Elem.vec, sizeof(Elem));
+
+                            Scales[TransformIndex] = Elem;
+                        }
+
+                        DataOffset += sizeof(vec3) * KeyframesAmount;
+                    } break;
+
+                    default: {
+                        // NOTE(ismail): weights and invalid channels are rejected above
+                        continue;
+                    }
+                }
+
+                Channel->KeyframesOffset = DataOffset;
+
+                real32* Keyframes = (real32*)(Data + DataOffset);
+                for (i32 KeyframeIndex = 0; KeyframeIndex < KeyframesAmount; ++KeyframeIndex) {
+                    real32 Keyframe = 0.0f;
+                    cgltf_accessor_read_float(CurrentSampler->input, KeyframeIndex, &Keyframe, sizeof(Keyframe));
+
+                    Keyframes[KeyframeIndex] = Keyframe;
+
+                    if (Keyframe > AnimationDuration) {
+                        AnimationDuration = Keyframe;
+                    }
+                }
+
+                DataOffset += sizeof(real32) * KeyframesAmount;
+                
+                Channel->Amount = KeyframesAmount;
+                Channel->IType  = InterpalationType == cgltf_interpolation_type::cgltf_interpolation_type_linear ? ILinear : IStep;
+            }
+
+            Assert(DataOffset == DataSize);
+
+            AnimationNode.MaxDuration  = AnimationDuration;
+            AnimationNode.FramesAmount = BoneIndex;
+        }
+
+        AnimArray.AnimsAmount += AnimationsCount;
+}
+
+void glTFLoadFile(const char *Path, cgltf_data** Mesh)
+{
+    cgltf_options   LoadOptions = {};
+    LoadOptions.memory.alloc_func   = CountedMallocCallback;
+    LoadOptions.memory.free_func    = CountedFreeCallback;
+
+    cgltf_result CallResult = cgltf_parse_file(&LoadOptions, Path, Mesh);
+
+    if (CallResult != cgltf_result::cgltf_result_success) {
+        Assert(false);
+    }
+
+    CallResult = cgltf_load_buffers(&LoadOptions, *Mesh, Path);
+
+    if (CallResult != cgltf_result::cgltf_result_success) {
+        Assert(false);
+    }
+}
+
+void glTFReadAnimations(MemoryArena* Arena, const char* Path, AnimationsArray* AnimArray, Skinning* Skin)
+{
+    cgltf_data* Mesh = 0;
+
+    glTFLoadFile(Path, &Mesh);
+
+    cgltf_animation*    Animations      = Mesh->animations;
+    i32                 AnimationsCount = Mesh->animations_count;
+
+    glTFReadAnimations(Arena, Animations, AnimationsCount, *AnimArray, *Skin);
+
+    cgltf_free(Mesh);
+}
+
+static void glTFReadSkin(cgltf_data* Mesh, MemoryArena* LevelArena, glTF2File* FileOut)
+{
+    if (Mesh->skins_count > 0) {
+
+        Assert(Mesh->skins_count == 1);
+
+        // TODO(Ismail): use already created inverse_bind_matrix in CurrentSkin
+        cgltf_skin* CurrentSkin = &Mesh->skins[0];
+        Skinning*   Skelet      = FileOut->Skelet;
+
+        u32             JointsCount = (u32)CurrentSkin->joints_count;
+        cgltf_node**    Joints      = CurrentSkin->joints;
+
+        Skelet->Joints = (JointsInfo*)PushSizeZero(LevelArena, sizeof(*Skelet->Joints) * JointsCount);
+
+        i32 IndexCounter = 0;
+
+        SkinClearBones(Skelet);
+        ReadJointNode(LevelArena, Skelet, *Joints, NULL, IndexCounter, Joints, (i32)JointsCount);
+
+        FileOut->Skelet->JointsAmount = JointsCount;
+
+        i32 AnimationsCount = (i32)Mesh->animations_count;
+
+        Assert(AnimationsCount == 1);
+
+        cgltf_animation*    Animations  = Mesh->animations;
+        AnimationsArray*    AnimArray   = FileOut->Animations;
+
+        glTFReadAnimations(LevelArena, Animations, AnimationsCount, *AnimArray, *Skelet);
+    }
+}
+
+// NOTE(ismail): skin and clips only, used when vertex streams come from cooked blob
+void glTFReadSkin(const char *Path, MemoryArena* LevelArena, glTF2File *FileOut)
+{
+    cgltf_data* Mesh = 0;
+
+    glTFLoadFile(Path, &Mesh);
+
+    glTFReadSkin(Mesh, LevelArena, FileOut);
+
+    cgltf_free(Mesh);
+}
+
+// NOTE(ismail): vertex streams go to ScratchArena and are dead after GPU upload, skin and clips go to LevelArena
+void glTFRead(const char *Path, MemoryArena* LevelArena, MemoryArena* ScratchArena, glTF2File *FileOut)
+{
+    const cgltf_accessor* AccessorPositions;
+    const cgltf_accessor* AccessorNormals;
+    const cgltf_accessor* AccessorTexturesCoord;
+    const cgltf_accessor* AccessorWeights;
+    const cgltf_accessor* AccessorJoints;
+
+    cgltf_data* Mesh = NULL;
+
+    glTFLoadFile(Path, &Mesh);
+
+    i32         MeshesCount = (i32)Mesh->meshes_count;
+    glTF2Mesh*  MeshesOut   = FileOut->Meshes;
+
+    Assert(MeshesCount <= MAX_MESHES);
+
+    for (i32 MeshIndex = 0; MeshIndex < MeshesCount; ++MeshIndex) {
+        cgltf_mesh* CurrentMesh     = &Mesh->meshes[MeshIndex];
+        glTF2Mesh*  CurrentMeshOut  = &MeshesOut[MeshIndex];
+
+        i32                 PrimitivesAmount    = (i32)CurrentMesh->primitives_count;
+        cgltf_primitive*    PrimitivesBase      = CurrentMesh->primitives;
+        glTF2Primitives*    MeshPrimitivesOut   = CurrentMeshOut->MeshPrimitives;
+
+        Assert(PrimitivesAmount <= MAX_MESH_PRIMITIVES);
+        
+        for (i32 PrimitiveIndex = 0; PrimitiveIndex < PrimitivesAmount; ++PrimitiveIndex) {
+            cgltf_primitive*    CurrentMeshPrimitive            = &PrimitivesBase[PrimitiveIndex];
+            cgltf_material*     CurrentMeshPrimitiveMaterial    = CurrentMeshPrimitive->material;
+            glTF2Primitives*    CurrentPrimitiveOut             = &MeshPrimitivesOut[PrimitiveIndex];
+            Material*           CurrentPrimitiveMaterial        = &CurrentPrimitiveOut->MeshMaterial;
+
+            Assert(CurrentMeshPrimitive->type == cgltf_primitive_type::cgltf_primitive_type_triangles);
+
+            AccessorPositions     = cgltf_find_accessor(CurrentMeshPrimitive, cgltf_attribute_type::cgltf_attribute_type_position,    0);
+            AccessorNormals       = cgltf_find_accessor(CurrentMeshPrimitive, cgltf_attribute_type::cgltf_attribute_type_normal,      0);
+            AccessorTexturesCoord = cgltf_find_accessor(CurrentMeshPrimitive, cgltf_attribute_type::cgltf_attribute_type_texcoord,    0);
+            AccessorWeights       = cgltf_find_accessor(CurrentMeshPrimitive, cgltf_attribute_type::cgltf_attribute_type_weights,     0);
+            AccessorJoints        = cgltf_find_accessor(CurrentMeshPrimitive, cgltf_attribute_type::cgltf_attribute_type_joints,      0);
+
+            Assert(AccessorPositions->component_type    == cgltf_component_type::cgltf_component_type_r_32f && 
+                   AccessorPositions->type              == cgltf_type::cgltf_type_vec3 &&
+                   AccessorPositions->stride            == 12);
+            Assert(AccessorNormals->component_type  == cgltf_component_type::cgltf_component_type_r_32f && 
+                   AccessorNormals->type            == cgltf_type::cgltf_type_vec3 &&
+                   AccessorNormals->stride          == 12);
+            Assert(AccessorTexturesCoord->component_type    == cgltf_component_type::cgltf_component_type_r_32f && 
+                   AccessorTexturesCoord->type              == cgltf_type::cgltf_type_vec2 &&
+                   AccessorTexturesCoord->stride            == 8);
+            Assert(AccessorWeights->component_type  == cgltf_component_type::cgltf_component_type_r_32f &&
+                   AccessorWeights->type            == cgltf_type_vec4 &&
+                   AccessorWeights->stride          == 16);
+            Assert(AccessorJoints->component_type   == cgltf_component_type::cgltf_component_type_r_8u &&
+                   AccessorJoints->type             == cgltf_type_vec4 &&
+                   AccessorJoints->stride           == 4);
+
+            const cgltf_accessor* NextJoints    = cgltf_find_accessor(CurrentMeshPrimitive, cgltf_attribute_type::cgltf_attribute_type_joints,      1);
+            const cgltf_accessor* NextWeights   = cgltf_find_accessor(CurrentMeshPrimitive, cgltf_attribute_type::cgltf_attribute_type_weights,     1);
+
+            Assert(NextJoints == NULL && NextWeights == NULL);
+
+            // NOTE(ismail): streams are sized from accessors
+            u64 IndicesCount = CurrentMeshPrimitive->indices->count;
+
+            vec3*   Positions       = PushArray(ScratchArena, vec3,     AccessorPositions->count);
+            vec3*   Normals         = PushArray(ScratchArena, vec3,     AccessorNormals->count);
+            vec2*   TextureCoords   = PushArray(ScratchArena, vec2,     AccessorTexturesCoord->count);
+            ivec4*  BoneIDs         = PushArray(ScratchArena, ivec4,    AccessorJoints->count);
+            vec4*   BoneWeights     = PushArray(ScratchArena, vec4,     AccessorWeights->count);
+            u32*    Indices         = PushArray(ScratchArena, u32,      IndicesCount);
+
+            cgltf_accessor_unpack_floats(AccessorPositions,     (real32*)Positions,     AccessorPositions->count * 3);
+            cgltf_accessor_unpack_floats(AccessorNormals,       (real32*)Normals,       AccessorNormals->count * 3);
+            cgltf_accessor_unpack_floats(AccessorTexturesCoord, (real32*)TextureCoords, AccessorTexturesCoord->count * 2);
+            cgltf_accessor_unpack_floats(AccessorWeights,       (real32*)BoneWeights,   AccessorWeights->count * 4);
+
+            cgltf_accessor_unpack_indices_32bit_package(AccessorJoints, BoneIDs, AccessorJoints->count);
+
+            cgltf_accessor_unpack_indices(CurrentMeshPrimitive->indices, Indices, sizeof(*Indices), IndicesCount);
+
+            CurrentPrimitiveOut->Positions      = Positions;
+            CurrentPrimitiveOut->Normals        = Normals;
+            CurrentPrimitiveOut->TextureCoord   = TextureCoords;
+            CurrentPrimitiveOut->BoneIds        = BoneIDs;
+            CurrentPrimitiveOut->BoneWeights    = BoneWeights;
+            CurrentPrimitiveOut->Indices        = Indices;
+
+            CurrentPrimitiveOut->PositionsCount   = AccessorPositions->count;
+            CurrentPrimitiveOut->NormalsCount     = AccessorNormals->count;
+            CurrentPrimitiveOut->TexturesCount    = AccessorTexturesCoord->count;
+            CurrentPrimitiveOut->BoneWeightsCount = AccessorWeights->count;
+            CurrentPrimitiveOut->BoneIdsCount     = AccessorJoints->count;
+            CurrentPrimitiveOut->IndicesCount     = CurrentMeshPrimitive->indices->count;
+
+            Assert(CurrentMeshPrimitiveMaterial->has_pbr_metallic_roughness);
+
+            CurrentPrimitiveMaterial->AmbientColor = { 1.0f, 1.0f, 1.0f };
+
+            cgltf_pbr_metallic_roughness* Diffuse = &CurrentMeshPrimitiveMaterial->pbr_metallic_roughness;
+
+            char* DiffuseTextureFileName = Diffuse->base_color_texture.texture->image->uri;
+
+            memcpy_s(CurrentPrimitiveMaterial->TextureFilePath, 
+                     sizeof(CurrentPrimitiveMaterial->TextureFilePath), 
+                     DiffuseTextureFileName, 
+                     strlen(DiffuseTextureFileName));
+            
+            CurrentPrimitiveMaterial->DiffuseColor = { Diffuse->base_color_factor[_x_], Diffuse->base_color_factor[_y_], Diffuse->base_color_factor[_z_] };
+            CurrentPrimitiveMaterial->HaveTexture = 1;
+
+            if (CurrentMeshPrimitiveMaterial->has_specular) {
+                cgltf_specular* Specular = &CurrentMeshPrimitiveMaterial->specular;
+
+                char *SpecularTextureFileName = Specular->specular_texture.texture->image->uri;
+                memcpy_s(CurrentPrimitiveMaterial->SpecularExpFilePath, 
+                         sizeof(CurrentPrimitiveMaterial->SpecularExpFilePath), 
+                         SpecularTextureFileName, 
+                         strlen(SpecularTextureFileName));
+
+                CurrentPrimitiveMaterial->SpecularColor = { 
+                    0.1f, //Specular->specular_color_factor[_x_], 
+                    0.1f, //Specular->specular_color_factor[_y_], 
+                    0.1f  //Specular->specular_color_factor[_z_] 
+                };
+                CurrentPrimitiveMaterial->HaveSpecularExponent  = 1;
+            }
+        }
+
+        CurrentMeshOut->PrimitivesAmount = PrimitivesAmount;
+    }
+
+    FileOut->MeshesAmount = MeshesCount;
+
+    glTFReadSkin(Mesh, LevelArena, FileOut);
+
+    cgltf_free(Mesh);
+}
+
+// NOTE(ismail): primitives of all meshes go one after another, each keeps its own local indices and is
+// found back by VertexOffset/IndexOffset. Streams are gathered on ScratchArena because CookMesh wants them contiguous
+Statuses CookglTFFile(const char *Path, const char *SourcePath, MemoryArena* ScratchArena, glTF2File *File)
+{
+    u32 StreamCount[CookedStreamsMax]  = {};
+    u32 SubmeshesCount                 = 0;
+
+    for (i32 MeshIndex = 0; MeshIndex < File->MeshesAmount; ++MeshIndex) {
+        glTF2Mesh* CurrentMesh = &File->Meshes[MeshIndex];
+
+        for (i32 PrimitiveIndex = 0; PrimitiveIndex < CurrentMesh->PrimitivesAmount; ++PrimitiveIndex) {
+            glTF2Primitives* Primitive = &CurrentMesh->MeshPrimitives[PrimitiveIndex];
+
+            Assert(Primitive->NormalsCount      == Primitive->PositionsCount &&
+                   Primitive->TexturesCount     == Primitive->PositionsCount &&
+                   Primitive->BoneIdsCount      == Primitive->PositionsCount &&
+                   Primitive->BoneWeightsCount  == Primitive->PositionsCount);
+
+            StreamCount[CookedPositions]   += Primitive->PositionsCount;
+            StreamCount[CookedIndices]     += Primitive->IndicesCount;
+
+            ++SubmeshesCount;
+        }
+    }
+
+    TemporaryMemory CookMemory = BeginTemporaryMemory(ScratchArena);
+
+    vec3*           Positions       = PushArray(ScratchArena, vec3,   StreamCount[CookedPositions]);
+    vec3*           Normals         = PushArray(ScratchArena, vec3,   StreamCount[CookedPositions]);
+    vec2*           TextureCoords   = PushArray(ScratchArena, vec2,   StreamCount[CookedPositions]);
+    ivec4*          BoneIds         = PushArray(ScratchArena, ivec4,  StreamCount[CookedPositions]);
+    vec4*           BoneWeights     = PushArray(ScratchArena, vec4,   StreamCount[CookedPositions]);
+    u32*            Indices         = PushArray(ScratchArena, u32,    StreamCount[CookedIndices]);
+    Mesh*           Submeshes       = PushArray(ScratchArena, Mesh,   SubmeshesCount);
+    CookedSubmesh*  SubmeshInfo     = PushArray(ScratchArena, CookedSubmesh, SubmeshesCount);
+
+    u32 VertexOffset    = 0;
+    u32 IndexOffset     = 0;
+    u32 SubmeshIndex    = 0;
+
+    for (i32 MeshIndex = 0; MeshIndex < File->MeshesAmount; ++MeshIndex) {
+        glTF2Mesh* CurrentMesh = &File->Meshes[MeshIndex];
+
+        for (i32 PrimitiveIndex = 0; PrimitiveIndex < CurrentMesh->PrimitivesAmount; ++PrimitiveIndex, ++SubmeshIndex) {
+            glTF2Primitives*    Primitive   = &CurrentMesh->MeshPrimitives[PrimitiveIndex];
+            u32                 Vertices    = Primitive->PositionsCount;
+
+            memcpy(Positions + VertexOffset,        Primitive->Positions,       sizeof(*Positions)      * Vertices);
+            memcpy(Normals + VertexOffset,          Primitive->Normals,         sizeof(*Normals)        * Vertices);
+            memcpy(TextureCoords + VertexOffset,    Primitive->TextureCoord,    sizeof(*TextureCoords)  * Vertices);
+            memcpy(BoneIds + VertexOffset,          Primitive->BoneIds,         sizeof(*BoneIds)        * Vertices);
+            memcpy(BoneWeights + VertexOffset,      Primitive->BoneWeights,     sizeof(*BoneWeights)    * Vertices);
+            memcpy(Indices + IndexOffset,           Primitive->Indices,         sizeof(*Indices)        * Primitive->IndicesCount);
+
+            Submeshes[SubmeshIndex].Material        = Primitive->MeshMaterial;
+            Submeshes[SubmeshIndex].IndexOffset     = IndexOffset;
+            Submeshes[SubmeshIndex].VertexOffset    = VertexOffset;
+            Submeshes[SubmeshIndex].IndicesAmount   = Primitive->IndicesCount;
+
+            SubmeshInfo[SubmeshIndex].MeshIndex         = (u32)MeshIndex;
+            SubmeshInfo[SubmeshIndex].VerticesAmount    = Vertices;
+
+            VertexOffset    += Vertices;
+            IndexOffset     += Primitive->IndicesCount;
+        }
+    }
+
+    CookedMeshSource Source = {};
+
+    Source.SourcePath                   = SourcePath;
+    Source.Streams[CookedPositions]     = Positions;
+    Source.Streams[CookedNormals]       = Normals;
+    Source.Streams[CookedTextureCoord]  = TextureCoords;
+    Source.Streams[CookedBoneIds]       = BoneIds;
+    Source.Streams[CookedBoneWeights]   = BoneWeights;
+    Source.Streams[CookedIndices]       = Indices;
+    Source.SubmeshesCount               = SubmeshesCount;
+    Source.Submeshes                    = Submeshes;
+    Source.SubmeshInfo                  = SubmeshInfo;
+
+    for (u32 Stream = 0; Stream < CookedIndices; ++Stream) {
+        Source.StreamCount[Stream] = StreamCount[CookedPositions];
+    }
+    Source.StreamCount[CookedIndices] = StreamCount[CookedIndices];
+
+    Statuses Result = CookMesh(Path, &Source);
+
+    EndTemporaryMemory(CookMemory);
+
+    return Result;
+}
+
+void CookedMeshToglTF(CookedMesh *Cooked, glTF2File *Result)
+{
+    CookedMeshHeader* Header = Cooked->Header;
+
+    Assert(Header->StreamCount[CookedBoneIds] && Header->StreamCount[CookedBoneWeights]);
+
+    Result->MeshesAmount = 0;
+
+    for (u32 SubmeshIndex = 0; SubmeshIndex < Header->SubmeshesCount; ++SubmeshIndex) {
+        Mesh*           Submesh     = &Cooked->Submeshes[SubmeshIndex];
+        CookedSubmesh*  Info        = &Cooked->SubmeshInfo[SubmeshIndex];
+
+        Assert(Info->MeshIndex < MAX_MESHES);
+
+        glTF2Mesh* CurrentMesh = &Result->Meshes[Info->MeshIndex];
+
+        Assert(CurrentMesh->PrimitivesAmount < MAX_MESH_PRIMITIVES);
+
+        glTF2Primitives* Primitive = &CurrentMesh->MeshPrimitives[CurrentMesh->PrimitivesAmount++];
+
+        Primitive->MeshMaterial     = Submesh->Material;
+        Primitive->Positions        = (vec3*)Cooked->Streams[CookedPositions]       + Submesh->VertexOffset;
+        Primitive->Normals          = (vec3*)Cooked->Streams[CookedNormals]         + Submesh->VertexOffset;
+        Primitive->TextureCoord     = (vec2*)Cooked->Streams[CookedTextureCoord]    + Submesh->VertexOffset;
+        Primitive->BoneIds          = (ivec4*)Cooked->Streams[CookedBoneIds]        + Submesh->VertexOffset;
+        Primitive->BoneWeights      = (vec4*)Cooked->Streams[CookedBoneWeights]     + Submesh->VertexOffset;
+        Primitive->Indices          = (u32*)Cooked->Streams[CookedIndices]          + Submesh->IndexOffset;
+
+        Primitive->PositionsCount   = Info->VerticesAmount;
+        Primitive->NormalsCount     = Info->VerticesAmount;
+        Primitive->TexturesCount    = Info->VerticesAmount;
+        Primitive->BoneIdsCount     = Info->VerticesAmount;
+        Primitive->BoneWeightsCount = Info->VerticesAmount;
+        Primitive->IndicesCount     = Submesh->IndicesAmount;
+
+        if ((i32)Info->MeshIndex >= Result->MeshesAmount) {
+            Result->MeshesAmount = (i32)Info->MeshIndex + 1;
+        }
+    }
+}
+
+inline real32 CalcT(real32 t, real32 StartKeyframe, real32 EndKeyframe)
+{
+    return 1.0f - ((EndKeyframe - t) / (EndKeyframe - StartKeyframe));
+}
+
+struct KeyframePair {
+    i32 StartKeyframe;
+    i32 EndKeyframe;
+};
+
+struct AnimationFrameTransform {
+    vec3 Scale;
+    quat Rotation;
+    vec3 Translation;
+};
+
+static inline AnimationFrame* FindFrame(Animation& Anim, i32 BoneID)
+{
+    i32 FrameIndex = Anim.BoneFrames[BoneID];
+
+    return FrameIndex < 0 ? 0 : &Anim.PerBonesFrame[FrameIndex];
+}
+
+static KeyframePair FindKeyframe(real32* Keyframes, i32 KeyframesAmount, real32 CurrentTime, u16& Cursor)
+{
+    Assert(KeyframesAmount > 0);
+
+    KeyframePair    Result          = { };
+
+    // NOTE(ismail): glTF allows channels with single key, it holds for whole clip
+    if (KeyframesAmount == 1) {
+        Cursor = 0;
+
+        return Result;
+    }
+
+    i32             LastInterval    = KeyframesAmount - 2;
+    i32             Start           = Cursor;
+
+    if (Start <= LastInterval && Keyframes[Start] <= CurrentTime) {
+        // NOTE(ismail): playback moves forward so usually we still in the same interval or in the next one
+        if (CurrentTime > Keyframes[Start + 1] && Start < LastInterval) {
+            ++Start;
+
+            if (CurrentTime > Keyframes[Start + 1] && Start < LastInterval) {
+                Start = -1;
+            }
+        }
+    }
+    else {
+        Start = -1;
+    }
+
+    if (Start < 0) {
+        // NOTE(ismail): seek or loop wrap, find last keyframe which is not greater than CurrentTime
+        i32 Low     = 0;
+        i32 High    = LastInterval;
+
+        while (Low < High) {
+            i32 Middle = (Low + High + 1) >> 1;
+
+            if (Keyframes[Middle] <= CurrentTime) {
+                Low = Middle;
+            }
+            else {
+                High = Middle - 1;
+            }
+        }
+
+        Start = Low;
+    }
+
+    Cursor = (u16)Start;
+
+    Result.StartKeyframe    = Start;
+    Result.EndKeyframe      = Start + 1;
+
+    return Result;
+}
+
+static inline void HandleTranslationInterpolation(u8* ClipData, AnimationChannel& Channel, real32 CurrentTime, u16& Cursor, vec3& FinalTranslation)
+{
+    Assert(Channel.Amount > 0);
+
+    real32* Keyframes       = (real32*)(ClipData + Channel.KeyframesOffset);
+    vec3*   Translations    = (vec3*)(ClipData + Channel.TransformsOffset);
+
+    KeyframePair FoundKeyframes = FindKeyframe(Keyframes, Channel.Amount, CurrentTime, Cursor);
+
+    i32     StartKeyframe       = FoundKeyframes.StartKeyframe;
+    i32     EndKeyframe         = FoundKeyframes.EndKeyframe;
+    vec3&   StartTranslation    = Translations[StartKeyframe];
+    vec3&   EndTranslation      = Translations[EndKeyframe];
+
+    if (Channel.IType == InterpolationType::IStep || StartKeyframe == EndKeyframe) {
+        FinalTranslation = StartTranslation;
+
+        return;
+    }
+
+    real32 T = CalcT(CurrentTime, Keyframes[StartKeyframe], Keyframes[EndKeyframe]);
+
+    vec3 DeltaTranslation = vec3::Lerp(StartTranslation, EndTranslation, T);
+
+    FinalTranslation = StartTranslation + DeltaTranslation;
+}
+
+static inline void HandleRotationInterpolation(u8* ClipData, AnimationChannel& Channel, real32 CurrentTime, u16& Cursor, quat& FinalRotation)
+{
+    Assert(Channel.Amount > 0);
+
+    real32* Keyframes   = (real32*)(ClipData + Channel.KeyframesOffset);
+    quat*   Rotations   = (quat*)(ClipData + Channel.TransformsOffset);
+
+    KeyframePair FoundKeyframes = FindKeyframe(Keyframes, Channel.Amount, CurrentTime, Cursor);
+
+    i32     StartKeyframe   = FoundKeyframes.StartKeyframe;
+    i32     EndKeyframe     = FoundKeyframes.EndKeyframe;
+    quat&   StartRotation   = Rotations[StartKeyframe];
+    quat&   EndRotation     = Rotations[EndKeyframe];
+
+    if (Channel.IType == InterpolationType::IStep || StartKeyframe == EndKeyframe) {
+        FinalRotation = StartRotation;
+
+        return;
+    }
+
+    real32 T = CalcT(CurrentTime, Keyframes[StartKeyframe], Keyframes[EndKeyframe]);
+
+    FinalRotation = quat::Slerp(StartRotation, EndRotation, T);
+}
+
+static inline void HandleScaleInterpolation(u8* ClipData, AnimationChannel& Channel, real32 CurrentTime, u16& Cursor, vec3& FinalScale)
+{
+    Assert(Channel.Amount > 0);
+
+    real32* Keyframes   = (real32*)(ClipData + Channel.KeyframesOffset);
+    vec3*   Scales      = (vec3*)(ClipData + Channel.TransformsOffset);
+
+    KeyframePair FoundKeyframes = FindKeyframe(Keyframes, Channel.Amount, CurrentTime, Cursor);
+
+    i32     StartKeyframe   = FoundKeyframes.StartKeyframe;
+    i32     EndKeyframe     = FoundKeyframes.EndKeyframe;
+    vec3&   StartScale      = Scales[StartKeyframe];
+    vec3&   EndScale        = Scales[EndKeyframe];
+
+    if (Channel.IType == InterpolationType::IStep || StartKeyframe == EndKeyframe) {
+        FinalScale = StartScale;
+
+        return;
+    }
+
+    real32 T = CalcT(CurrentTime, Keyframes[StartKeyframe], Keyframes[EndKeyframe]);
+
+    vec3 DeltaScale = vec3::Lerp(StartScale, EndScale, T);
+
+    FinalScale = StartScale + DeltaScale;
+}
+
+static inline void CalculateAnimationTransform(u8* ClipData, AnimationChannel* Channels, real32 CurrentTime, u16* Cursors, AnimationFrameTransform& FinalTransform)
+{
+    AnimationChannel& ScaleChannel = Channels[AnimationType::AScale];
+    HandleScaleInterpolation(ClipData, ScaleChannel, CurrentTime, Cursors[AnimationType::AScale], FinalTransform.Scale);
+
+    AnimationChannel& RotationChannel = Channels[AnimationType::ARotation];
+    HandleRotationInterpolation(ClipData, RotationChannel, CurrentTime, Cursors[AnimationType::ARotation], FinalTransform.Rotation);
+
+    AnimationChannel& TranslationChannel = Channels[AnimationType::ATranslation];
+    HandleTranslationInterpolation(ClipData, TranslationChannel, CurrentTime, Cursors[AnimationType::ATranslation], FinalTransform.Translation);
+}
+
+static void SampleClip(Skinning& Skin, AnimationStack& Stack, AnimationFrameTransform* Pose)
+{
+    i32         JointsAmount    = Skin.JointsAmount;
+    Animation&  Anim            = *Stack.Animation;
+    real32      CurrentTime     = Stack.CurrentTime;
+
+    for (i32 JointIndex = 0; JointIndex < JointsAmount; ++JointIndex) {
+        AnimationFrame* CurrentFrame = FindFrame(Anim, JointIndex);
+
+        Assert(CurrentFrame);
+
+        CalculateAnimationTransform(Anim.Data, CurrentFrame->Channels, CurrentTime, Stack.KeyframeCursors[JointIndex], Pose[JointIndex]);
+    }
+}
+
+// NOTE(ismail): weights must sum to one, rotations are blended with successive exact slerps, each pose is folded in
+// for all joints at once. quat::FastSlerpN would be faster but moves blended rotations by up to 0.0015 rad
+static void BlendPoses(AnimationFrameTransform** Poses, real32* Weights, i32 PosesAmount, i32 JointsAmount, AnimationFrameTransform* Result)
+{
+    quat    BlendedRotations[MAX_BONES];
+    quat    PoseRotations[MAX_BONES];
+    real32  SlerpFactors[MAX_BONES];
+
+    AnimationFrameTransform*    FirstPose   = Poses[0];
+    real32                      FirstWeight = Weights[0];
+
+    for (i32 JointIndex = 0; JointIndex < JointsAmount; ++JointIndex) {
+        AnimationFrameTransform& BlendedPose = Result[JointIndex];
+
+        BlendedPose.Scale               = FirstPose[JointIndex].Scale * FirstWeight;
+        BlendedPose.Translation         = FirstPose[JointIndex].Translation * FirstWeight;
+        BlendedRotations[JointIndex]    = FirstPose[JointIndex].Rotation;
+    }
+
+    real32 AccumulatedWeight = FirstWeight;
+
+    for (i32 PoseIndex = 1; PoseIndex < PosesAmount; ++PoseIndex) {
+        AnimationFrameTransform*    Pose    = Poses[PoseIndex];
+        real32                      Weight  = Weights[PoseIndex];
+
+        AccumulatedWeight += Weight;
+
+        real32 SlerpFactor = Weight / AccumulatedWeight;
+
+        for (i32 JointIndex = 0; JointIndex < JointsAmount; ++JointIndex) {
+            AnimationFrameTransform& BlendedPose = Result[JointIndex];
+
+            BlendedPose.Scale       += Pose[JointIndex].Scale * Weight;
+            BlendedPose.Translation += Pose[JointIndex].Translation * Weight;
+
+            PoseRotations[JointIndex]   = Pose[JointIndex].Rotation;
+            SlerpFactors[JointIndex]    = SlerpFactor;
+        }
+
+        quat::SlerpN(BlendedRotations, PoseRotations, SlerpFactors, BlendedRotations, JointsAmount);
+    }
+
+    for (i32 JointIndex = 0; JointIndex < JointsAmount; ++JointIndex) {
+        Result[JointIndex].Rotation = BlendedRotations[JointIndex];
+    }
+}
+
+// NOTE(ismail): joints are stored parent-before-child so parent model matrix is always ready,
+// rotations are converted to matrices in one batch before walking the hierarchy
+static void LocalToModel(Skinning& Skin, AnimationFrameTransform* Pose, mat4* Matrices)
+{
+    i32             JointsAmount    = Skin.JointsAmount;
+    CompiledJoint*  Joints          = Skin.CompiledJoints;
+
+    quat Rotations[MAX_BONES];
+    mat4 RotationMatrices[MAX_BONES];
+
+    for (i32 JointIndex = 0; JointIndex < JointsAmount; ++JointIndex) {
+        Rotations[JointIndex] = Pose[JointIndex].Rotation;
+    }
+
+    quat::Mat4N(Rotations, RotationMatrices, JointsAmount);
+
+    for (i32 JointIndex = 0; JointIndex < JointsAmount; ++JointIndex) {
+        CompiledJoint&              Joint       = Joints[JointIndex];
+        AnimationFrameTransform&    JointPose   = Pose[JointIndex];
+        mat4&                       RotationMat = RotationMatrices[JointIndex];
+        mat4&                       ModelMat    = Matrices[Joint.OriginalBoneID];
+
+        if (Joint.ParentOriginalBoneID < 0) {
+            AffineFromTRS(JointPose.Translation, RotationMat, JointPose.Scale, ModelMat);
+        }
+        else {
+            mat4 LocalMat;
+            AffineFromTRS(JointPose.Translation, RotationMat, JointPose.Scale, LocalMat);
+
+            AffineMul(Matrices[Joint.ParentOriginalBoneID], LocalMat, ModelMat);
+        }
+    }
+}
+
+static inline void AdvanceStackTime(AnimationStack& Stack, bool32 Loop, real32 dt)
+{
+    real32 AdvancedTime   = Stack.CurrentTime + dt;
+    real32 MaxDuration    = Stack.MaxDuration;
+
+    if (Loop) {
+        Stack.CurrentTime = fmodf(AdvancedTime, MaxDuration);
+    }
+    else {
+        Stack.CurrentTime = AdvancedTime > MaxDuration ? MaxDuration : AdvancedTime;
+    }
+}
+
+// NOTE(ismail): brute force Delaunay, stack has at most ANIMATION_STACK_LENGTH samples so it is cheap and done once.
+// Triangles of co-circular samples may overlap but any triangle that contains the point gives valid weights
+static void TriangulateBlendSpace(AnimationTask& Task)
+{
+    AnimationStack* Stack           = Task.Stack;
+    i32             SamplesAmount   = Task.StackAmount;
+    i32             TrianglesAmount = 0;
+
+    for (i32 First = 0; First < SamplesAmount; ++First) {
+        for (i32 Second = First + 1; Second < SamplesAmount; ++Second) {
+            for (i32 Third = Second + 1; Third < SamplesAmount; ++Third) {
+                vec2 A = { Stack[First].StackPositionX,     Stack[First].StackPositionY };
+                vec2 B = { Stack[Second].StackPositionX,    Stack[Second].StackPositionY };
+                vec2 C = { Stack[Third].StackPositionX,     Stack[Third].StackPositionY };
+
+                real32 DoubleArea = (B.x - A.x) * (C.y - A.y) - (B.y - A.y) * (C.x - A.x);
+                if (fabsf(DoubleArea) < 1e-6f) {
+                    continue;
+                }
+
+                bool32 Empty = true;
+                for (i32 Other = 0; Other < SamplesAmount && Empty; ++Other) {
+                    if (Other == First || Other == Second || Other == Third) {
+                        continue;
+                    }
+
+                    vec2 D = { Stack[Other].StackPositionX, Stack[Other].StackPositionY };
+
+                    vec2 AD = A - D;
+                    vec2 BD = B - D;
+                    vec2 CD = C - D;
+
+                    real32 InCircle = AD.Dot(AD) * (BD.x * CD.y - CD.x * BD.y) -
+                                      BD.Dot(BD) * (AD.x * CD.y - CD.x * AD.y) +
+                                      CD.Dot(CD) * (AD.x * BD.y - BD.x * AD.y);
+
+                    // NOTE(ismail): sign of in-circle test depends on triangle winding
+                    if (DoubleArea > 0.0f ? InCircle > 1e-6f : InCircle < -1e-6f) {
+                        Empty = false;
+                    }
+                }
+
+                if (Empty) {
+                    Assert(TrianglesAmount < MAX_BLEND_SPACE_TRIANGLES);
+
+                    u8* Triangle = Task.BlendTriangles[TrianglesAmount++];
+                    Triangle[0] = (u8)First;
+                    Triangle[1] = (u8)Second;
+                    Triangle[2] = (u8)Third;
+                }
+            }
+        }
+    }
+
+    Assert(TrianglesAmount > 0); // NOTE(ismail): all samples are collinear, use TaskMode::_1D
+
+    Task.BlendTrianglesAmount = TrianglesAmount;
+}
+
+// NOTE(ismail): returns amount of stacks with non zero weight, if point is outside of samples hull
+// it is clamped to the closest hull edge
+static i32 FindBlendSpaceWeights(AnimationTask& Task, real32 x, real32 y, AnimationStack** Stacks, real32* Weights)
+{
+    AnimationStack* Stack = Task.Stack;
+    vec2            P     = { x, y };
+
+    i32     FoundIndices[MAX_BLEND_POSES]   = {};
+    real32  FoundWeights[MAX_BLEND_POSES]   = {};
+    real32  ClosestDistance                         = INFINITY;
+
+    for (i32 TriangleIndex = 0; TriangleIndex < Task.BlendTrianglesAmount; ++TriangleIndex) {
+        u8* Triangle = Task.BlendTriangles[TriangleIndex];
+
+        vec2 Vertices[3];
+        for (i32 VertexIndex = 0; VertexIndex < 3; ++VertexIndex) {
+            AnimationStack& Sample = Stack[Triangle[VertexIndex]];
+            Vertices[VertexIndex] = { Sample.StackPositionX, Sample.StackPositionY };
+        }
+
+        vec2 V0 = Vertices[1] - Vertices[0];
+        vec2 V1 = Vertices[2] - Vertices[0];
+        vec2 V2 = P - Vertices[0];
+
+        real32 D00 = V0.Dot(V0);
+        real32 D01 = V0.Dot(V1);
+        real32 D11 = V1.Dot(V1);
+        real32 D20 = V2.Dot(V0);
+        real32 D21 = V2.Dot(V1);
+
+        real32 InvDenom = 1.0f / (D00 * D11 - D01 * D01);
+        real32 V        = (D11 * D20 - D01 * D21) * InvDenom;
+        real32 W        = (D00 * D21 - D01 * D20) * InvDenom;
+        real32 U        = 1.0f - V - W;
+
+        if (U >= -1e-5f && V >= -1e-5f && W >= -1e-5f) {
+            FoundIndices[0] = Triangle[0];
+            FoundIndices[1] = Triangle[1];
+            FoundIndices[2] = Triangle[2];
+            FoundWeights[0] = U;
+            FoundWeights[1] = V;
+            FoundWeights[2] = W;
+
+            ClosestDistance = 0.0f;
+
+            break;
+        }
+
+        for (i32 EdgeIndex = 0; EdgeIndex < 3; ++EdgeIndex) {
+            i32 StartIndex  = EdgeIndex;
+            i32 EndIndex    = (EdgeIndex + 1) % 3;
+
+            vec2    Edge        = Vertices[EndIndex] - Vertices[StartIndex];
+            real32  T           = (P - Vertices[StartIndex]).Dot(Edge) / Edge.Dot(Edge);
+
+            T = T < 0.0f ? 0.0f : (T > 1.0f ? 1.0f : T);
+
+            vec2    Closest     = Vertices[StartIndex] + Edge * T;
+            vec2    ToClosest   = P - Closest;
+            real32  Distance    = ToClosest.Dot(ToClosest);
+
+            if (Distance < ClosestDistance) {
+                ClosestDistance = Distance;
+
+                FoundIndices[0] = Triangle[StartIndex];
+                FoundIndices[1] = Triangle[EndIndex];
+                FoundIndices[2] = Triangle[3 - StartIndex - EndIndex];
+                FoundWeights[0] = 1.0f - T;
+                FoundWeights[1] = T;
+                FoundWeights[2] = 0.0f;
+            }
+        }
+    }
+
+    i32 SamplesAmount = 0;
+    for (i32 SampleIndex = 0; SampleIndex < MAX_BLEND_POSES; ++SampleIndex) {
+        real32 Weight = FoundWeights[SampleIndex];
+
+        if (Weight > 1e-4f) {
+            Stacks[SamplesAmount]   = &Stack[FoundIndices[SampleIndex]];
+            Weights[SamplesAmount]  = Weight;
+
+            ++SamplesAmount;
+        }
+    }
+
+    Assert(SamplesAmount > 0);
+
+    return SamplesAmount;
+}
+
+void AnimationSystem::PrepareSkinMatrices(AnimationTrack& Track, i32 TaskId, real32 x, real32 y, real32 dt)
+{
+    Assert(Track.AnimationTasksAmount > TaskId);
+
+    SkeletalComponent& SkinData = SkinningData[Track.SkinId];
+
+    AnimationTask& Task = Track.AnimationTasks[TaskId];
+
+    Skinning& Skin = SkinData.Skin;
+
+    TaskMode Mode = Task.Mode;
+
+    AnimationStack* Stacks[MAX_BLEND_POSES];
+    real32          Weights[MAX_BLEND_POSES];
+    i32             PosesAmount = 0;
+
+    switch(Mode) {
+        
+        case TaskMode::Clip: {
+            AnimationStack& Stack       = Task.Stack[0];
+
+            Assert(Task.StackAmount == 1); // NOTE(ismail): ok chel
+
+            AdvanceStackTime(Stack, Task.Loop, dt);
+
+            Stacks[0]   = &Stack;
+            Weights[0]  = 1.0f;
+            PosesAmount = 1;
+        } break;
+
+        case TaskMode::_1D: {
+            AnimationStack* Stack       = Task.Stack;
+            AnimationStack* FrStackNode = 0;
+            AnimationStack* ScStackNode = 0;
+
+            Assert(Task.StackAmount > 1); // NOTE(ismail): If you need to play less than one animation use TaskMode::Clip
+            
+            for (i32 FirstEntry = 0, SecondEntry = 1;;) {
+                FrStackNode = &Stack[FirstEntry];
+                ScStackNode = &Stack[SecondEntry];
+
+                if (FrStackNode->StackPositionX <= x && ScStackNode->StackPositionX >= x) {
+                    break;
+                }
+                else {
+                    FirstEntry = SecondEntry;
+                    SecondEntry = FirstEntry + 1;
+                }
+            }
+
+            AdvanceStackTime(*FrStackNode, Task.Loop, dt);
+            AdvanceStackTime(*ScStackNode, Task.Loop, dt);
+
+            real32 FrPos = FrStackNode->StackPositionX;
+            real32 ScPos = ScStackNode->StackPositionX;
+
+            real32 BlendingFactor = (x - FrPos) / (ScPos - FrPos);
+
+            Stacks[0]   = FrStackNode;
+            Stacks[1]   = ScStackNode;
+            Weights[0]  = 1.0f - BlendingFactor;
+            Weights[1]  = BlendingFactor;
+            PosesAmount = 2;
+        } break;
+
+        case TaskMode::_2D: {
+            Assert(Task.StackAmount > 2); // NOTE(ismail): If you need to blend two animations use TaskMode::_1D
+
+            if (!Task.BlendTrianglesAmount) {
+                TriangulateBlendSpace(Task);
+            }
+
+            // NOTE(ismail): every sample keeps running, so clip which enters the blend is in phase with the rest.
+            // Only clips with non zero weight are sampled
+            for (i32 StackIndex = 0; StackIndex < Task.StackAmount; ++StackIndex) {
+                AdvanceStackTime(Task.Stack[StackIndex], Task.Loop, dt);
+            }
+
+            PosesAmount = FindBlendSpaceWeights(Task, x, y, Stacks, Weights);
+        } break;
+    }
+
+    // NOTE(ismail): sample -> blend -> local to model, every stage works on flat per joint arrays
+    AnimationFrameTransform     Poses[MAX_BLEND_POSES][MAX_BONES];
+    AnimationFrameTransform*    PosesToBlend[MAX_BLEND_POSES];
+
+    for (i32 PoseIndex = 0; PoseIndex < PosesAmount; ++PoseIndex) {
+        SampleClip(Skin, *Stacks[PoseIndex], Poses[PoseIndex]);
+
+        PosesToBlend[PoseIndex] = Poses[PoseIndex];
+    }
+
+    AnimationFrameTransform* FinalPose = Poses[0];
+
+    AnimationFrameTransform BlendedPose[MAX_BONES];
+    if (PosesAmount > 1) {
+        BlendPoses(PosesToBlend, Weights, PosesAmount, Skin.JointsAmount, BlendedPose);
+
+        FinalPose = BlendedPose;
+    }
+
+    SkinningMatricesStorage& MatStorage = Track.Matrices;
+
+    LocalToModel(Skin, FinalPose, MatStorage.Matrices);
+
+    MatStorage.Amount = Skin.JointsAmount;
+}
+
+AnimationTrack& AnimationSystem::GetTrack(i32 CharId)
+{
+    Assert(CharId >= 0 && CharId < (i32)CharactersAnimationTrack.size());
+
+    return CharactersAnimationTrack[CharId];
+}
+
+void AnimationSystem::Play(i32 CharId, i32 AnimTaskId, real32 x, real32 y, real32 dt)
+{
+    PrepareSkinMatrices(GetTrack(CharId), AnimTaskId, x, y, dt);
+}
+
+void AnimationSystem::SetActiveTask(i32 CharId, i32 AnimTaskId, real32 x, real32 y)
+{
+    AnimationTrack& Track = GetTrack(CharId);
+
+    Assert(Track.AnimationTasksAmount > AnimTaskId);
+
+    AnimationTask& Task = Track.AnimationTasks[AnimTaskId];
+
+    Track.ActiveTask    = AnimTaskId;
+    Task.x              = x;
+    Task.y              = y;
+}
+
+TEARA_JOB_FUNCTION(AnimationSystem::UpdateTracksJob)
+{
+    (void)Jobs;
+
+    AnimationUpdateJob* Job     = (AnimationUpdateJob*)Data;
+    AnimationSystem*    System  = Job->System;
+
+    i32 LastTrack = First + Amount;
+    for (i32 TrackIndex = First; TrackIndex < LastTrack; ++TrackIndex) {
+        AnimationTrack& Track   = System->CharactersAnimationTrack[TrackIndex];
+        AnimationTask&  Task    = Track.AnimationTasks[Track.ActiveTask];
+
+        System->PrepareSkinMatrices(Track, Track.ActiveTask, Task.x, Task.y, Job->dt);
+    }
+
+    Job->RangesAmount.fetch_add(1, std::memory_order_relaxed);
+}
+
+// NOTE(ismail): every track writes only its own matrices and stacks, skins and clips are read only here
+void AnimationSystem::UpdateAll(Platform* Platform, real32 dt)
+{
+    real64 StartTime = Platform->GetWallClock();
+
+    i32 TracksAmount = (i32)CharactersAnimationTrack.size();
+
+    AnimationUpdateJob Job;
+    Job.System  = this;
+    Job.dt      = dt;
+    Job.RangesAmount.store(0);
+
+    ParallelFor(Platform->Jobs, TracksAmount, ANIMATION_TRACKS_PER_JOB, &AnimationSystem::UpdateTracksJob, &Job);
+
+    UpdateStats.UpdateTimeMs    = (Platform->GetWallClock() - StartTime) * 1000.0;
+    UpdateStats.TracksAmount    = TracksAmount;
+    UpdateStats.JobsAmount      = Job.RangesAmount.load();
+}
+
+void AnimationSystem::ExportToRender(SkinningMatricesStorage& Result, i32 CharId)
+{
+    AnimationTrack& CharAnimTrack   = GetTrack(CharId);
+    Skinning&       Skin            = SkinningData[CharAnimTrack.SkinId].Skin;
+    i32             JointsAmount    = Skin.JointsAmount;
+    CompiledJoint*  Joints          = Skin.CompiledJoints;
+    
+    mat4* OriginMatrices = CharAnimTrack.Matrices.Matrices;
+    mat4* ResultMatrices = Result.Matrices;
+    
+    Result.Amount = JointsAmount;
+
+    for (i32 i = 0; i < JointsAmount; ++i) {
+        JointsInfo*     JointInfo       = &Skin.Joints[i];
+        i32             OriginalBoneID  = Joints[i].OriginalBoneID;
+    
+        const mat4&   CurrentOriginMat = OriginMatrices[OriginalBoneID];
+        mat4&         CurrentResultMat = ResultMatrices[OriginalBoneID];
+    
+        CurrentResultMat = CurrentOriginMat * JointInfo->InverseBindMatrix;
+    }
+}
+
+i32 AnimationSystem::GetBoneID(i32 CharId, const char* BoneName)
+{
+    AnimationTrack& Track   = GetTrack(CharId);
+    BoneIDs*        Bone    = SkinFindBone(&SkinningData[Track.SkinId].Skin, BoneName);
+
+    Assert(Bone);
+
+    return Bone->OriginalBoneID;
+}
+
+mat4& AnimationSystem::GetBoneLocation(i32 CharId, const char* BoneName)
+{
+    AnimationTrack& Track = GetTrack(CharId);
+
+    return Track.Matrices.Matrices[GetBoneID(CharId, BoneName)];
+}
+
+mat4& AnimationSystem::GetBoneLocation(i32 CharId, i32 BoneId)
+{
+    AnimationTrack& Track = GetTrack(CharId);
+
+    Assert(Track.Matrices.Amount > BoneId);
+
+    return Track.Matrices.Matrices[BoneId];
+}
+
+void InitGameMemory(Platform* Platform, GameContext* Cntx)
+{
+    ArenaInit(&Cntx->LevelArena, Platform->AllocMem(LEVEL_ARENA_SIZE), LEVEL_ARENA_SIZE);
+    ArenaInit(&Cntx->FrameArena, Platform->AllocMem(FRAME_ARENA_SIZE), FRAME_ARENA_SIZE);
+}
+
+// NOTE(ismail): vertex streams of LoadFile point into FrameArena or into LoadFile->Cooked mapping when cooked blob exists,
+// caller keeps them alive with TemporaryMemory and CloseCookedMesh until upload
+void LoadSkeletalCharacter(Platform* Platform, GameContext* Cntx, DynamicSceneObjectLoader& Loader, glTF2File* LoadFile)
+{
+    AnimationSystem& AnimSys = Cntx->AnimSystem;
+
+    SkeletalComponent& NewComponent = AnimSys.RegisterNewSkin(Loader.SkeletCharId);
+
+    LoadFile->Animations    = &NewComponent.Animations;
+    LoadFile->Skelet        = &NewComponent.Skin;
+
+    char CookedPath[COOKED_MESH_PATH_MAX];
+    CookedMeshPath(CookedPath, sizeof(CookedPath), Loader.Mesh.Path);
+
+    if (OpenCookedMesh(Platform, CookedPath, Loader.Mesh.Path, 0, &LoadFile->Cooked) == Statuses::Success) {
+        CookedMeshToglTF(&LoadFile->Cooked, LoadFile);
+
+        glTFReadSkin(Loader.Mesh.Path, &Cntx->LevelArena, LoadFile);
+    }
+    else {
+        glTFRead(Loader.Mesh.Path, &Cntx->LevelArena, &Cntx->FrameArena, LoadFile);
+    }
+
+    i32 AnimCount = Loader.Amount;
+    for (i32 AnimIndex = 0; AnimIndex < AnimCount; ++AnimIndex) {
+        SerialaizedAnimations& SerialaizedAnims = Loader.Animations[AnimIndex];
+
+        glTFReadAnimations(&Cntx->LevelArena, SerialaizedAnims.Path, LoadFile->Animations, LoadFile->Skelet);
+    }
+}
+
+AnimationTrack& PreparePlayerAnimationTrack(GameContext* Cntx)
+{
+    AnimationSystem& AnimSys = Cntx->AnimSystem;
+
+    AnimationTrack& PlayerTrack = AnimSys.RegisterNewAnimationTrack();
+
+    PlayerTrack.SkinId  = SkeletalCharacters::CharacterPlayer;
+
+    AnimationTask& PlayerWalkTask = PlayerTrack.AnimationTasks[0];
+    PlayerWalkTask.MaxX         = 1.5f;
+    PlayerWalkTask.Mode         = TaskMode::_1D;
+    PlayerWalkTask.Loop         = 1;
+    PlayerWalkTask.StackAmount  = 3;
+
+    Animation* IdleAnim = AnimSys.GetAnimationById(SkeletalCharacters::CharacterPlayer, PLayerAnimations::IdleDynamic);
+    AnimationStack& IdleStack = PlayerWalkTask.Stack[PLayerAnimations::IdleDynamic];
+    IdleStack                   = {};
+    IdleStack.Speed             = 1.0f;
+    IdleStack.StackPositionX    = 0.0f;
+    IdleStack.MaxDuration       = IdleAnim->MaxDuration;
+    IdleStack.Animation         = IdleAnim;
+
+    Animation* WalkAnim = AnimSys.GetAnimationById(SkeletalCharacters::CharacterPlayer, PLayerAnimations::WalkDefault);    
+    AnimationStack& WalkStack = PlayerWalkTask.Stack[PLayerAnimations::WalkDefault];
+    WalkStack                   = {};
+    WalkStack.Speed             = 1.0f;
+    WalkStack.StackPositionX    = 0.75f;
+    WalkStack.MaxDuration       = WalkAnim->MaxDuration;
+    WalkStack.Animation         = WalkAnim;
+
+    Animation* RunAnim = AnimSys.GetAnimationById(SkeletalCharacters::CharacterPlayer, PLayerAnimations::RunDefault);    
+    AnimationStack& RunStack = PlayerWalkTask.Stack[PLayerAnimations::RunDefault];
+    RunStack                   = {};
+    RunStack.Speed             = 1.0f;
+    RunStack.StackPositionX    = 1.5f;
+    RunStack.MaxDuration       = RunAnim->MaxDuration;
+    RunStack.Animation         = RunAnim;
+
+    PlayerTrack.AnimationTasksAmount = 1;
+    PlayerTrack.ActiveTask           = 0;
+
+    return PlayerTrack;
+}
+
+// NOTE(ismail): scene has one test particle, EmitterRate > 0 adds emitter spawning that many particles per second.
+// Game doesn't draw particles in batch, so emitter is for headless runs only
+void PrepareParticles(GameContext* Cntx, real32 EmitterRate)
+{
+    ParticleSystem* Particles = &Cntx->Particles;
+    ParticleSystemInit(Particles, PushSize(&Cntx->LevelArena, ParticleSystemMemorySize(PARTICLES_CAPACITY)), PARTICLES_CAPACITY, 0.8f);
+
+    ParticleSystemSpawn(Particles, { 0.0f, 0.0f, 2.0f }, { 0.0f, 25.0f, 0.0f }, GRAVITY, PARTICLE_LIFETIME_FOREVER);
+
+    if (EmitterRate <= 0.0f) {
+        return;
+    }
+
+    ParticleEmitter* Emitter = ParticleSystemAddEmitter(Particles);
+
+    Emitter->Position       = { 0.0f,  0.0f, 2.0f };
+    Emitter->Velocity       = { 0.0f, 25.0f, 0.0f };
+    Emitter->VelocitySpread = { 2.0f,  5.0f, 2.0f };
+    Emitter->Acceleration   = GRAVITY;
+    Emitter->Rate           = EmitterRate;
+    Emitter->Lifetime       = 3.0f;
+}
+
+// NOTE(ismail): nothing allocated from FrameArena survives the frame
+MemoryCountersSnapshot BeginFrameMemory(GameContext* Cntx)
+{
+    ArenaReset(&Cntx->FrameArena);
+
+    return TakeMemoryCountersSnapshot();
+}
+
+void EndFrameMemory(GameContext* Cntx, MemoryCountersSnapshot FrameStartCounters)
+{
+    MemoryCountersSnapshot FrameEndCounters = TakeMemoryCountersSnapshot();
+
+    Cntx->FrameMemory.HeapAllocations       = FrameEndCounters.HeapAllocations - FrameStartCounters.HeapAllocations;
+    Cntx->FrameMemory.HeapBytes             = FrameEndCounters.HeapBytes - FrameStartCounters.HeapBytes;
+    Cntx->FrameMemory.PlatformAllocations   = FrameEndCounters.PlatformAllocations - FrameStartCounters.PlatformAllocations;
+    Cntx->FrameMemory.PlatformBytes         = FrameEndCounters.PlatformBytes - FrameStartCounters.PlatformBytes;
+    Cntx->FrameMemory.FrameArenaUsed        = Cntx->FrameArena.Used;
+}
+
+// NOTE(ismail): input, animation, particles and camera movement, everything Frame does before rendering
+void SimulateFrame(Platform *Platform, GameContext *Cntx)
+{
+    if (Platform->Input.ArrowUp.State == KeyState::Pressed) {
+        if (Cntx->BlendingX <= 1.496f) {
+            Cntx->BlendingX += 0.001f;
+        }
+        else {
+            Cntx->BlendingX = 1.5f;
+        }
+    }
+    else {
+        if (Cntx->BlendingX > 0.005f) {
+            Cntx->BlendingX -= 0.001f;
+        }
+        else {
+            Cntx->BlendingX = 0.0f;
+        }
+    }
+
+    // NOTE(ismail): track 0 is the player, headless runs may have no characters loaded
+    if (Cntx->AnimSystem.GetTracksAmount() > 0) {
+        Cntx->AnimSystem.SetActiveTask(0, 0, Cntx->BlendingX, 0.0f);
+    }
+
+    Cntx->AnimSystem.UpdateAll(Platform, Cntx->DeltaTimeSec);
+
+    ParticleSystemUpdate(Platform, &Cntx->Particles, Cntx->DeltaTimeSec);
+
+    Cntx->PlayerCamera.Transform.Rotation.b = 0.0f;
+    Cntx->PlayerCamera.Transform.Rotation.p += RAD_TO_DEGREE(Platform->Input.MouseInput.Moution.y) * 0.5f;
+    Cntx->PlayerCamera.Transform.Rotation.h += RAD_TO_DEGREE(Platform->Input.MouseInput.Moution.x) * 0.5f;
+
+    real32 ZTranslationMultiplyer = (real32)(Platform->Input.WButton.State + (-1 * Platform->Input.SButton.State)); // 1.0 if W Button -1.0 if S Button and 0 if W and S Button pressed together
+    real32 XTranslationMultiplyer = (real32)(Platform->Input.DButton.State + (-1 * Platform->Input.AButton.State));
+
+    vec3 Target, Right, Up;
+    Rotation& PlayerCameraRotation = Cntx->PlayerCamera.Transform.Rotation;
+    PlayerCameraRotation.ToVec(Target, Up, Right);
+
+    Cntx->PlayerCamera.Transform.Position += (Target * ZTranslationMultiplyer * 0.1f) + (Right * XTranslationMultiplyer * 0.1f);
+}
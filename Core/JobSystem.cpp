@@ -0,0 +1,398 @@
+#include "JobSystem.h"
+#include "Debug.h"
+
+static thread_local i32 JobWorkerIndex = -1;
+
+// NOTE(ismail): returns 0 when deque is full, job is not queued then and caller has to run it itself
+static bool32 JobDequePush(JobDeque* Deque, const Job& NewJob)
+{
+    i64 Bottom  = Deque->Bottom.load(std::memory_order_relaxed);
+    i64 Top     = Deque->Top.load(std::memory_order_acquire);
+
+    if (Bottom - Top >= JOB_DEQUE_CAPACITY) {
+        return 0;
+    }
+
+    Deque->Jobs[Bottom & (JOB_DEQUE_CAPACITY - 1)] = NewJob;
+
+    // NOTE(ismail): job must be visible before thieves see new Bottom
+    Deque->Bottom.store(Bottom + 1, std::memory_order_release);
+
+    return 1;
+}
+
+static bool32 JobDequePop(JobDeque* Deque, Job* Result)
+{
+    i64 Bottom = Deque->Bottom.load(std::memory_order_relaxed) - 1;
+
+    Deque->Bottom.store(Bottom, std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    i64     Top     = Deque->Top.load(std::memory_order_relaxed);
+    bool32  Found   = 1;
+
+    if (Top <= Bottom) {
+        *Result = Deque->Jobs[Bottom & (JOB_DEQUE_CAPACITY - 1)];
+
+        if (Top == Bottom) {
+            // NOTE(ismail): last job, race with thieves for it
+            if (!Deque->Top.compare_exchange_strong(Top, Top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                Found = 0;
+            }
+
+            Deque->Bottom.store(Bottom + 1, std::memory_order_relaxed);
+        }
+    }
+    else {
+        Found = 0;
+
+        Deque->Bottom.store(Bottom + 1, std::memory_order_relaxed);
+    }
+
+    return Found;
+}
+
+// NOTE(ismail): background job at Top is left in place when thief doesn't take them, it blocks the rest of this deque for that thief
+static bool32 JobDequeSteal(JobDeque* Deque, Job* Result, bool32 TakeBackground)
+{
+    i64 Top = Deque->Top.load(std::memory_order_acquire);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    i64 Bottom = Deque->Bottom.load(std::memory_order_acquire);
+
+    if (Top >= Bottom) {
+        return 0;
+    }
+
+    *Result = Deque->Jobs[Top & (JOB_DEQUE_CAPACITY - 1)];
+
+    if (Result->Background && !TakeBackground) {
+        return 0;
+    }
+
+    return Deque->Top.compare_exchange_strong(Top, Top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+}
+
+static bool32 JobSystemPush(JobSystem* Jobs, JobWorker* Worker, const Job& NewJob)
+{
+    if (!JobDequePush(&Worker->Deque, NewJob)) {
+        Worker->Stats.Inlined.fetch_add(1, std::memory_order_relaxed);
+
+        return 0;
+    }
+
+    Jobs->QueuedJobs.fetch_add(1);
+
+    // NOTE(ismail): sleeper registers itself under WakeMutex before it checks QueuedJobs, so it either sees our job or gets notified
+    if (Jobs->SleepingWorkers.load() > 0) {
+        std::lock_guard<std::mutex> Lock(Jobs->WakeMutex);
+        Jobs->WakeCondition.notify_one();
+    }
+
+    return 1;
+}
+
+static bool32 JobSystemFindJob(JobSystem* Jobs, JobWorker* Worker, Job* Result)
+{
+    if (JobDequePop(&Worker->Deque, Result)) {
+        Jobs->QueuedJobs.fetch_sub(1);
+
+        return 1;
+    }
+
+    // NOTE(ismail): xorshift32 picks first victim so workers don't all hammer worker 0
+    u32 x = Worker->RandomState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    Worker->RandomState = x;
+
+    i32     SlotsAmount     = Jobs->SlotsAmount;
+    i32     FirstVictim     = (i32)(x % (u32)SlotsAmount);
+    bool32  TakeBackground  = Worker->Index != 0;
+
+    for (i32 Offset = 0; Offset < SlotsAmount; ++Offset) {
+        i32 Victim = (FirstVictim + Offset) % SlotsAmount;
+
+        if (Victim == Worker->Index) {
+            continue;
+        }
+
+        if (JobDequeSteal(&Jobs->Workers[Victim].Deque, Result, TakeBackground)) {
+            Jobs->QueuedJobs.fetch_sub(1);
+
+            Worker->Stats.Stolen.fetch_add(1, std::memory_order_relaxed);
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static void JobSystemExecute(JobSystem* Jobs, JobWorker* Worker, Job* Current)
+{
+    // NOTE(ismail): keep first half of the range and publish second one, thieves take oldest (biggest) halves
+    while (Current->Batch > 0 && Current->Amount > Current->Batch) {
+        i32 Half = Current->Amount / 2;
+
+        Job Second = *Current;
+        Second.First    += Half;
+        Second.Amount   -= Half;
+
+        Current->Amount = Half;
+
+        Current->Counter->Value.fetch_add(1);
+
+        // NOTE(ismail): deque is full, rest of the range runs here
+        if (!JobSystemPush(Jobs, Worker, Second)) {
+            Current->Counter->Value.fetch_sub(1, std::memory_order_relaxed);
+            Current->Amount += Second.Amount;
+
+            break;
+        }
+    }
+
+    Current->Function(Jobs, Current->Data, Current->First, Current->Amount);
+
+    Worker->Stats.Executed.fetch_add(1, std::memory_order_relaxed);
+
+    Current->Counter->Value.fetch_sub(1, std::memory_order_release);
+}
+
+static void JobWorkerThread(JobWorker* Worker)
+{
+    JobSystem* Jobs = Worker->System;
+
+    JobWorkerIndex = Worker->Index;
+
+    i32 FailedAttempts = 0;
+
+    while (Jobs->Running.load(std::memory_order_acquire)) {
+        Job Current;
+
+        if (JobSystemFindJob(Jobs, Worker, &Current)) {
+            JobSystemExecute(Jobs, Worker, &Current);
+
+            FailedAttempts = 0;
+
+            continue;
+        }
+
+        if (++FailedAttempts < JOB_STEAL_ATTEMPTS) {
+            std::this_thread::yield();
+
+            continue;
+        }
+
+        std::unique_lock<std::mutex> Lock(Jobs->WakeMutex);
+
+        Jobs->SleepingWorkers.fetch_add(1);
+        Jobs->WakeCondition.wait(Lock, [Jobs] { return Jobs->QueuedJobs.load() > 0 || !Jobs->Running.load(); });
+        Jobs->SleepingWorkers.fetch_sub(1);
+
+        FailedAttempts = 0;
+    }
+}
+
+void JobSystemInit(JobSystem* Jobs, i32 ThreadsAmount)
+{
+    if (ThreadsAmount < 0) {
+        ThreadsAmount = 0;
+    }
+    if (ThreadsAmount > JOB_SYSTEM_MAX_WORKERS - 1) {
+        ThreadsAmount = JOB_SYSTEM_MAX_WORKERS - 1;
+    }
+
+    Jobs->WorkersAmount = ThreadsAmount + 1;
+    Jobs->SlotsAmount   = Jobs->WorkersAmount + JOB_SYSTEM_MAX_ATTACHED;
+    Jobs->Workers       = new JobWorker[Jobs->SlotsAmount];
+
+    Jobs->QueuedJobs.store(0);
+    Jobs->SleepingWorkers.store(0);
+    Jobs->Running.store(1);
+
+    for (i32 WorkerIndex = 0; WorkerIndex < Jobs->SlotsAmount; ++WorkerIndex) {
+        JobWorker* Worker = &Jobs->Workers[WorkerIndex];
+
+        Worker->Deque.Top.store(0);
+        Worker->Deque.Bottom.store(0);
+        Worker->System      = Jobs;
+        Worker->Index       = WorkerIndex;
+        Worker->RandomState = 0x9E3779B9u * (u32)(WorkerIndex + 1);
+        Worker->Background  = WorkerIndex >= Jobs->WorkersAmount;
+        Worker->Attached.store(0);
+        Worker->Stats.Executed.store(0);
+        Worker->Stats.Stolen.store(0);
+        Worker->Stats.Inlined.store(0);
+    }
+
+    JobWorkerIndex = 0;
+
+    for (i32 WorkerIndex = 1; WorkerIndex < Jobs->WorkersAmount; ++WorkerIndex) {
+        Jobs->Workers[WorkerIndex].Thread = std::thread(JobWorkerThread, &Jobs->Workers[WorkerIndex]);
+    }
+}
+
+void JobSystemShutdown(JobSystem* Jobs)
+{
+    {
+        std::lock_guard<std::mutex> Lock(Jobs->WakeMutex);
+
+        Jobs->Running.store(0);
+        Jobs->WakeCondition.notify_all();
+    }
+
+    for (i32 WorkerIndex = 1; WorkerIndex < Jobs->WorkersAmount; ++WorkerIndex) {
+        Jobs->Workers[WorkerIndex].Thread.join();
+    }
+
+    for (i32 WorkerIndex = Jobs->WorkersAmount; WorkerIndex < Jobs->SlotsAmount; ++WorkerIndex) {
+        Assert(!Jobs->Workers[WorkerIndex].Attached.load());
+    }
+
+    delete[] Jobs->Workers;
+
+    Jobs->Workers       = 0;
+    Jobs->WorkersAmount = 0;
+    Jobs->SlotsAmount   = 0;
+}
+
+bool32 JobSystemAttachThread(JobSystem* Jobs)
+{
+    Assert(JobWorkerIndex < 0);
+
+    for (i32 WorkerIndex = Jobs ? Jobs->WorkersAmount : 0; Jobs && WorkerIndex < Jobs->SlotsAmount; ++WorkerIndex) {
+        bool32 Expected = 0;
+
+        if (Jobs->Workers[WorkerIndex].Attached.compare_exchange_strong(Expected, 1)) {
+            JobWorkerIndex = WorkerIndex;
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+void JobSystemDetachThread(JobSystem* Jobs)
+{
+    if (!Jobs || JobWorkerIndex < Jobs->WorkersAmount) {
+        return;
+    }
+
+    JobWorker* Worker = &Jobs->Workers[JobWorkerIndex];
+
+    // NOTE(ismail): every wait of this thread has returned, so thieves took or finished all it pushed
+    Assert(Worker->Deque.Top.load() >= Worker->Deque.Bottom.load());
+
+    JobWorkerIndex = -1;
+
+    Worker->Attached.store(0, std::memory_order_release);
+}
+
+void JobSystemRun(JobSystem* Jobs, TEARA_JobFunction Function, void* Data, JobCounter* Counter)
+{
+    Assert(Counter);
+
+    Counter->Value.fetch_add(1);
+
+    // NOTE(ismail): threads outside of the pool have no deque, they run job themselves
+    if (!Jobs || Jobs->WorkersAmount == 1 || JobWorkerIndex < 0) {
+        Function(Jobs, Data, 0, 1);
+
+        Counter->Value.fetch_sub(1, std::memory_order_release);
+
+        return;
+    }
+
+    JobWorker*  Worker = &Jobs->Workers[JobWorkerIndex];
+    Job         NewJob = { Function, Data, Counter, 0, 1, 0, Worker->Background };
+
+    // NOTE(ismail): deque is full, so running job now is the only way to not lose it
+    if (!JobSystemPush(Jobs, Worker, NewJob)) {
+        Function(Jobs, Data, 0, 1);
+
+        Counter->Value.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void JobSystemWait(JobSystem* Jobs, JobCounter* Counter)
+{
+    if (!Jobs || JobWorkerIndex < 0) {
+        Assert(Counter->Value.load() == 0);
+
+        return;
+    }
+
+    JobWorker* Worker = &Jobs->Workers[JobWorkerIndex];
+
+    // NOTE(ismail): waiting thread runs other jobs, so nested waits inside jobs don't block a worker
+    while (Counter->Value.load(std::memory_order_acquire) != 0) {
+        Job Current;
+
+        if (JobSystemFindJob(Jobs, Worker, &Current)) {
+            JobSystemExecute(Jobs, Worker, &Current);
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void ParallelFor(JobSystem* Jobs, i32 Amount, i32 Batch, TEARA_JobFunction Function, void* Data)
+{
+    if (Amount <= 0) {
+        return;
+    }
+
+    if (Batch < 1) {
+        Batch = 1;
+    }
+
+    if (!Jobs || Jobs->WorkersAmount == 1 || Amount <= Batch || JobWorkerIndex < 0) {
+        Function(Jobs, Data, 0, Amount);
+
+        return;
+    }
+
+    JobCounter Counter;
+    Counter.Value.store(1);
+
+    JobWorker*  Worker  = &Jobs->Workers[JobWorkerIndex];
+    Job         Root    = { Function, Data, &Counter, 0, Amount, Batch, Worker->Background };
+
+    if (!JobSystemPush(Jobs, Worker, Root)) {
+        JobSystemExecute(Jobs, Worker, &Root);
+    }
+
+    JobSystemWait(Jobs, &Counter);
+}
+
+i32 JobSystemThreadsAmount(JobSystem* Jobs)
+{
+    return Jobs ? Jobs->WorkersAmount : 1;
+}
+
+i32 JobSystemFanOut(JobSystem* Jobs)
+{
+    // NOTE(ismail): attached thread loses worker 0 and gets itself instead, so the amount is the same as for pool thread
+    if (!Jobs || JobWorkerIndex < 0) {
+        return 1;
+    }
+
+    return Jobs->WorkersAmount;
+}
+
+void JobSystemCollectStats(JobSystem* Jobs, JobWorkerStats* Result)
+{
+    *Result = {};
+
+    for (i32 WorkerIndex = 0; Jobs && WorkerIndex < Jobs->SlotsAmount; ++WorkerIndex) {
+        Result->Executed    += Jobs->Workers[WorkerIndex].Stats.Executed.load(std::memory_order_relaxed);
+        Result->Stolen      += Jobs->Workers[WorkerIndex].Stats.Stolen.load(std::memory_order_relaxed);
+        Result->Inlined     += Jobs->Workers[WorkerIndex].Stats.Inlined.load(std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,111 @@
+#ifndef _TEARA_CORE_JOB_SYSTEM_H_
+#define _TEARA_CORE_JOB_SYSTEM_H_
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "Types.h"
+
+#define JOB_SYSTEM_MAX_WORKERS      (32)
+#define JOB_SYSTEM_MAX_ATTACHED     (2)  // NOTE(ismail): slots for threads outside of the pool, asset streamer takes one
+#define JOB_DEQUE_CAPACITY          (4096) // NOTE(ismail): must be power of two
+#define JOB_STEAL_ATTEMPTS          (64)
+
+struct JobSystem;
+
+#define TEARA_JOB_FUNCTION(Name) void (Name)(JobSystem *Jobs, void *Data, i32 First, i32 Amount)
+typedef TEARA_JOB_FUNCTION(*TEARA_JobFunction);
+
+// NOTE(ismail): counter is incremented by every job started against it and decremented when the job is done,
+// zero means all work behind it is complete. Jobs express dependencies by waiting on counters of other jobs
+struct JobCounter {
+    std::atomic<i32> Value;
+};
+
+// NOTE(ismail): First and Amount are a range for ParallelFor, plain jobs get 0 and 1.
+// For ParallelFor jobs Batch > 0 and job splits itself until range is not bigger than Batch.
+// Background jobs come from attached threads, halves of their ranges stay background
+struct Job {
+    TEARA_JobFunction   Function;
+    void*               Data;
+    JobCounter*         Counter;
+    i32                 First;
+    i32                 Amount;
+    i32                 Batch;
+    bool32              Background;
+};
+
+// NOTE(ismail): Chase-Lev deque, owner pushes and pops at Bottom, thieves steal at Top
+struct JobDeque {
+    alignas(64) std::atomic<i64>    Top;
+    alignas(64) std::atomic<i64>    Bottom;
+    Job                             Jobs[JOB_DEQUE_CAPACITY];
+};
+
+struct JobWorkerStats {
+    i64 Executed;
+    i64 Stolen;
+    i64 Inlined;    // NOTE(ismail): jobs run by the pusher because its deque was full
+};
+
+// NOTE(ismail): written only by its worker, relaxed atomics because JobSystemCollectStats reads them while jobs run
+struct JobWorkerCounters {
+    std::atomic<i64> Executed;
+    std::atomic<i64> Stolen;
+    std::atomic<i64> Inlined;
+};
+
+struct JobWorker {
+    JobDeque            Deque;
+    JobSystem*          System;
+    i32                 Index;
+    u32                 RandomState;
+    bool32              Background;     // NOTE(ismail): slot of attached thread, its jobs are background
+    std::atomic<bool32> Attached;
+    std::thread         Thread;
+    JobWorkerCounters   Stats;
+};
+
+// NOTE(ismail): worker 0 is the thread that called JobSystemInit, it runs jobs only inside JobSystemWait and never
+// takes background jobs, so streaming work can't stall a frame. Other workers sleep on WakeCondition when nothing is queued.
+// Slots from WorkersAmount to SlotsAmount belong to attached threads, pool steals from their deques as from any other
+struct JobSystem {
+    JobWorker*              Workers;
+    i32                     WorkersAmount;
+    i32                     SlotsAmount;
+
+    std::atomic<i32>        QueuedJobs;
+    std::atomic<i32>        SleepingWorkers;
+    std::atomic<bool32>     Running;
+    std::mutex              WakeMutex;
+    std::condition_variable WakeCondition;
+};
+
+// NOTE(ismail): ThreadsAmount is amount of extra threads, 0 makes every call run on the caller
+void JobSystemInit(JobSystem* Jobs, i32 ThreadsAmount);
+void JobSystemShutdown(JobSystem* Jobs);
+
+// NOTE(ismail): gives calling thread outside of the pool a deque, its Run, ParallelFor and Wait work as on pool thread and
+// its jobs go to pool threads. Returns 0 when all JOB_SYSTEM_MAX_ATTACHED slots are taken, thread stays outside then.
+// Thread detaches before JobSystemShutdown and only when it waits for nothing
+bool32 JobSystemAttachThread(JobSystem* Jobs);
+void JobSystemDetachThread(JobSystem* Jobs);
+
+// NOTE(ismail): on threads outside of the pool Run and ParallelFor execute everything on the caller and Wait returns at once.
+// When caller's deque is full (JOB_DEQUE_CAPACITY pending jobs) Run executes job before it returns
+void JobSystemRun(JobSystem* Jobs, TEARA_JobFunction Function, void* Data, JobCounter* Counter);
+void JobSystemWait(JobSystem* Jobs, JobCounter* Counter);
+
+// NOTE(ismail): calls Function over [0, Amount) in ranges of at most Batch and returns when all are done.
+// Ranges are split in halves on demand so idle workers steal big pieces first
+void ParallelFor(JobSystem* Jobs, i32 Amount, i32 Batch, TEARA_JobFunction Function, void* Data);
+
+i32 JobSystemThreadsAmount(JobSystem* Jobs);
+
+// NOTE(ismail): how many threads run jobs calling thread pushes, itself included. 1 means its Run and ParallelFor run inline
+i32 JobSystemFanOut(JobSystem* Jobs);
+void JobSystemCollectStats(JobSystem* Jobs, JobWorkerStats* Result);
+
+#endif
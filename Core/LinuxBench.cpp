@@ -0,0 +1,1660 @@
+// NOTE(ismail): micro benchmarks and reference checks of engine kernels for headless runner, included by LinuxMain.cpp.
+// Every mode prints its numbers and returns 0 when results disagree with reference, so runner exits with failure
+
+#define LINUX_KEY_BENCH_KEYS            (400)
+#define LINUX_KEY_BENCH_TIMES           (1 << 16)
+#define LINUX_KEY_BENCH_PASSES          (16)
+#define LINUX_KEY_BENCH_EPSILON         (1e-5f)
+#define LINUX_MATH_TEST_CASES           (100000)
+#define LINUX_MATH_TEST_POINTS          (37)
+#define LINUX_SLERP_MAX_ERROR           (0.0015) // NOTE(ismail): bound quat::FastSlerpN documents
+#define LINUX_BROADPHASE_FRAMES         (60)
+#define LINUX_BROADPHASE_QUERIES        (100)
+#define LINUX_BROADPHASE_MAX_PAIRS      (8)    // NOTE(ismail): per body
+#define LINUX_BROADPHASE_FAT_MARGIN     (0.1f)
+#define LINUX_SOA_BENCH_BOXES           (10000)
+#define LINUX_SOA_BENCH_QUERIES         (2000)
+#define LINUX_COLLISION_TEST_BATCHES    (125000)
+#define LINUX_COLLISION_TEST_MARGIN     (1e-4)
+#define LINUX_OBB_BENCH_BOXES           (5500)
+#define LINUX_OBB_BENCH_MAX_PAIRS       (65536)
+#define LINUX_OBB_BENCH_PAIR_DISTANCE   (4.0f)
+#define LINUX_OBB_BENCH_FRAMES          (200)
+#define LINUX_CACHE_TEST_PIN_WAIT       (5.0)  // NOTE(ismail): seconds streaming thread gets to hash one small file
+#define LINUX_PILE_BENCH_STACKS         (10)   // NOTE(ismail): per side
+#define LINUX_PILE_BENCH_STEPS          (600)
+#define LINUX_PILE_BENCH_WINDOW         (100)
+#define LINUX_PILE_BENCH_HASH_STEPS     (60)
+#define LINUX_PILE_BENCH_STANDING       (0.1f)
+#define LINUX_JOB_BENCH_ITEMS           (1 << 20)
+#define LINUX_JOB_BENCH_BATCH           (1024)
+#define LINUX_JOB_BENCH_SINGLE_JOBS     (3 * JOB_DEQUE_CAPACITY)   // NOTE(ismail): more than deque holds, full deque path runs
+#define LINUX_JOB_BENCH_RUNS            (5)
+#define LINUX_PILE_BENCH_MAX_PAIRS      (8)    // NOTE(ismail): per body, fallen boxes touch more neighbours than standing ones
+
+#if TEARA_MATH_AVX2
+    #define LINUX_MATH_PATH "avx2"
+#elif TEARA_MATH_SSE2
+    #define LINUX_MATH_PATH "sse2"
+#else
+    #define LINUX_MATH_PATH "scalar"
+#endif
+
+static inline u32 LinuxRandom(u32* State)
+{
+    u32 x = *State;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *State = x;
+
+    return x;
+}
+
+static inline real32 LinuxRandomReal(u32* State, real32 Min, real32 Max)
+{
+    return Min + (Max - Min) * ((real32)(LinuxRandom(State) & 0xFFFFFF) / (real32)0xFFFFFF);
+}
+
+// NOTE(ismail): FindKeyframe before cursors were added, scans from first key every call
+static i32 LinuxScanKeyframe(real32* Keyframes, i32 KeyframesAmount, real32 CurrentTime)
+{
+    if (Keyframes[0] > CurrentTime) {
+        return 0;
+    }
+
+    for (i32 KeyframeIndex = 0; KeyframeIndex < KeyframesAmount - 1; ++KeyframeIndex) {
+        if (Keyframes[KeyframeIndex] <= CurrentTime && CurrentTime <= Keyframes[KeyframeIndex + 1]) {
+            return KeyframeIndex;
+        }
+    }
+
+    return KeyframesAmount - 2;
+}
+
+static inline real32 LinuxSampleKey(real32* Keyframes, real32* Values, i32 Start, real32 CurrentTime)
+{
+    real32 T = CalcT(CurrentTime, Keyframes[Start], Keyframes[Start + 1]);
+
+    return Values[Start] + (Values[Start + 1] - Values[Start]) * T;
+}
+
+// NOTE(ismail): channel of 30 Hz keys played at 60 Hz with loop wrap. On exact key hits scan, binary search and cursor
+// may pick intervals on different sides of the key, so sampled values are compared instead of intervals
+static bool32 LinuxKeyBench(Platform* Platform)
+{
+    real32* Keyframes   = (real32*)Platform->AllocMem(sizeof(real32) * (LINUX_KEY_BENCH_KEYS * 2 + LINUX_KEY_BENCH_TIMES));
+    real32* Values      = Keyframes + LINUX_KEY_BENCH_KEYS;
+    real32* Times       = Values + LINUX_KEY_BENCH_KEYS;
+    u32     Random      = 0x2545F491u;
+
+    for (i32 KeyIndex = 0; KeyIndex < LINUX_KEY_BENCH_KEYS; ++KeyIndex) {
+        Keyframes[KeyIndex] = (real32)KeyIndex / 30.0f;
+        Values[KeyIndex]    = LinuxRandomReal(&Random, 0.0f, 1.0f);
+    }
+
+    real32 Duration     = Keyframes[LINUX_KEY_BENCH_KEYS - 1];
+    real32 CurrentTime  = 0.0f;
+
+    for (i32 TimeIndex = 0; TimeIndex < LINUX_KEY_BENCH_TIMES; ++TimeIndex) {
+        Times[TimeIndex]    = CurrentTime;
+        CurrentTime         = fmodf(CurrentTime + 1.0f / 60.0f, Duration);
+    }
+
+    i32     CallsAmount = LINUX_KEY_BENCH_TIMES * LINUX_KEY_BENCH_PASSES;
+    real64  Sums[3]     = { };
+    i32     Mismatches  = 0;
+    u16     Cursor      = 0;
+
+    real64 StartTime = Platform->GetWallClock();
+
+    for (i32 Pass = 0; Pass < LINUX_KEY_BENCH_PASSES; ++Pass) {
+        for (i32 TimeIndex = 0; TimeIndex < LINUX_KEY_BENCH_TIMES; ++TimeIndex) {
+            i32 Start = LinuxScanKeyframe(Keyframes, LINUX_KEY_BENCH_KEYS, Times[TimeIndex]);
+
+            Sums[0] += LinuxSampleKey(Keyframes, Values, Start, Times[TimeIndex]);
+        }
+    }
+
+    real64 ScanNs = (Platform->GetWallClock() - StartTime) * 1e9 / (real64)CallsAmount;
+
+    StartTime = Platform->GetWallClock();
+
+    for (i32 Pass = 0; Pass < LINUX_KEY_BENCH_PASSES; ++Pass) {
+        for (i32 TimeIndex = 0; TimeIndex < LINUX_KEY_BENCH_TIMES; ++TimeIndex) {
+            // NOTE(ismail): cursor past last interval forces binary search
+            u16             SeekCursor  = 0xFFFF;
+            KeyframePair    Found       = FindKeyframe(Keyframes, LINUX_KEY_BENCH_KEYS, Times[TimeIndex], SeekCursor);
+
+            Sums[1] += LinuxSampleKey(Keyframes, Values, Found.StartKeyframe, Times[TimeIndex]);
+        }
+    }
+
+    real64 SearchNs = (Platform->GetWallClock() - StartTime) * 1e9 / (real64)CallsAmount;
+
+    StartTime = Platform->GetWallClock();
+
+    for (i32 Pass = 0; Pass < LINUX_KEY_BENCH_PASSES; ++Pass) {
+        for (i32 TimeIndex = 0; TimeIndex < LINUX_KEY_BENCH_TIMES; ++TimeIndex) {
+            KeyframePair Found = FindKeyframe(Keyframes, LINUX_KEY_BENCH_KEYS, Times[TimeIndex], Cursor);
+
+            Sums[2] += LinuxSampleKey(Keyframes, Values, Found.StartKeyframe, Times[TimeIndex]);
+        }
+    }
+
+    real64 CursorNs = (Platform->GetWallClock() - StartTime) * 1e9 / (real64)CallsAmount;
+
+    // NOTE(ismail): timed loops only sum, every sample is compared here
+    Cursor = 0;
+
+    for (i32 TimeIndex = 0; TimeIndex < LINUX_KEY_BENCH_TIMES; ++TimeIndex) {
+        real32          Time        = Times[TimeIndex];
+        u16             SeekCursor  = 0xFFFF;
+        real32          Scanned     = LinuxSampleKey(Keyframes, Values, LinuxScanKeyframe(Keyframes, LINUX_KEY_BENCH_KEYS, Time), Time);
+        KeyframePair    Searched    = FindKeyframe(Keyframes, LINUX_KEY_BENCH_KEYS, Time, SeekCursor);
+        KeyframePair    Cached      = FindKeyframe(Keyframes, LINUX_KEY_BENCH_KEYS, Time, Cursor);
+
+        if (fabsf(Scanned - LinuxSampleKey(Keyframes, Values, Searched.StartKeyframe, Time)) > LINUX_KEY_BENCH_EPSILON ||
+            fabsf(Scanned - LinuxSampleKey(Keyframes, Values, Cached.StartKeyframe, Time)) > LINUX_KEY_BENCH_EPSILON) {
+            ++Mismatches;
+        }
+    }
+
+    // NOTE(ismail): glTF channel with one key holds it for whole clip
+    struct {
+        real32  Keyframe;
+        vec3    Translation;
+    } SingleKey = { 0.5f, vec3{ 1.0f, 2.0f, 3.0f } };
+
+    AnimationChannel SingleChannel = { 0, sizeof(real32), 1, InterpolationType::ILinear };
+
+    for (real32 Time = 0.0f; Time < 1.0f; Time += 0.25f) {
+        u16     SingleCursor    = 7;
+        vec3    Translation     = {};
+
+        HandleTranslationInterpolation((u8*)&SingleKey, SingleChannel, Time, SingleCursor, Translation);
+
+        if (SingleCursor != 0 || Translation.x != 1.0f || Translation.y != 2.0f || Translation.z != 3.0f) {
+            ++Mismatches;
+        }
+    }
+
+    printf("key-bench   %d keys at 30 Hz played at 60 Hz with wrap | %d calls\n", LINUX_KEY_BENCH_KEYS, CallsAmount);
+    printf("            scan %.01f ns/call | binary search %.01f ns/call | cursor %.01f ns/call | x%.01f over scan\n",
+           ScanNs, SearchNs, CursorNs, ScanNs / CursorNs);
+    printf("            checksum %.03f %.03f %.03f | single key channel and samples %s\n",
+           Sums[0], Sums[1], Sums[2], Mismatches ? "MISMATCH" : "match");
+
+    Platform->ReleaseMem(Keyframes);
+
+    return Mismatches == 0;
+}
+
+// NOTE(ismail): SIMD results against scalar formulas written out in the same order of additions. Built with -ffp-contract=off
+// they match bit for bit, compiler which fuses scalar code into FMA makes them differ by rounding, so bit exact results
+// are only reported and check fails when difference is bigger than rounding of the sum allows
+struct LinuxMathCheck {
+    i64     Values;
+    i64     BitExact;
+    i64     Failed;
+    real64  MaxError;
+};
+
+static inline void LinuxCheckValue(LinuxMathCheck* Check, real32 Value, real32 Reference, real32 Magnitude)
+{
+    real64 Error = fabs((real64)Value - (real64)Reference);
+
+    ++Check->Values;
+
+    if (memcmp(&Value, &Reference, sizeof(real32)) == 0) {
+        ++Check->BitExact;
+    }
+    if (Error > 4.0 * FLT_EPSILON * (real64)Magnitude) {
+        ++Check->Failed;
+    }
+    if (Error > Check->MaxError) {
+        Check->MaxError = Error;
+    }
+}
+
+static void LinuxCheckMat4Product(LinuxMathCheck* Check, const mat4& Result, const mat4& A, const mat4& B)
+{
+    for (i32 Row = 0; Row < 4; ++Row) {
+        for (i32 Column = 0; Column < 4; ++Column) {
+            real32 Reference = A.mat[Row][0] * B.mat[0][Column] + A.mat[Row][1] * B.mat[1][Column] +
+                               A.mat[Row][2] * B.mat[2][Column] + A.mat[Row][3] * B.mat[3][Column];
+            real32 Magnitude = fabsf(A.mat[Row][0] * B.mat[0][Column]) + fabsf(A.mat[Row][1] * B.mat[1][Column]) +
+                               fabsf(A.mat[Row][2] * B.mat[2][Column]) + fabsf(A.mat[Row][3] * B.mat[3][Column]);
+
+            LinuxCheckValue(Check, Result.mat[Row][Column], Reference, Magnitude);
+        }
+    }
+}
+
+static void LinuxPrintMathCheck(const char* Name, LinuxMathCheck* Check)
+{
+    printf("            %-16s %lld values | %lld bit exact | max error %g | %s\n", Name, (long long)Check->Values,
+           (long long)Check->BitExact, Check->MaxError, Check->Failed ? "MISMATCH" : "match");
+}
+
+static bool32 LinuxMathTest(Platform* Platform)
+{
+    (void)Platform;
+
+    LinuxMathCheck  Products        = {};
+    LinuxMathCheck  InPlace         = {};
+    LinuxMathCheck  VectorProducts  = {};
+    LinuxMathCheck  Points          = {};
+    u32             Random          = 0x6C8E9CF5u;
+
+    for (i32 CaseIndex = 0; CaseIndex < LINUX_MATH_TEST_CASES; ++CaseIndex) {
+        mat4 A;
+        mat4 B;
+        vec4 V;
+
+        for (i32 Element = 0; Element < 16; ++Element) {
+            A.mat[Element / 4][Element % 4] = LinuxRandomReal(&Random, -10.0f, 10.0f);
+            B.mat[Element / 4][Element % 4] = LinuxRandomReal(&Random, -10.0f, 10.0f);
+        }
+        for (i32 Element = 0; Element < 4; ++Element) {
+            V.vec[Element] = LinuxRandomReal(&Random, -10.0f, 10.0f);
+        }
+
+        LinuxCheckMat4Product(&Products, A * B, A, B);
+
+        mat4 C = A;
+        C *= B;
+
+        LinuxCheckMat4Product(&InPlace, C, A, B);
+
+        vec4 Transformed = A * V;
+
+        for (i32 Row = 0; Row < 4; ++Row) {
+            real32 Reference = A.mat[Row][0] * V.x + A.mat[Row][1] * V.y + A.mat[Row][2] * V.z + A.mat[Row][3] * V.w;
+            real32 Magnitude = fabsf(A.mat[Row][0] * V.x) + fabsf(A.mat[Row][1] * V.y) + fabsf(A.mat[Row][2] * V.z) + fabsf(A.mat[Row][3] * V.w);
+
+            LinuxCheckValue(&VectorProducts, Transformed.vec[Row], Reference, Magnitude);
+        }
+
+        // NOTE(ismail): every batch length up to LINUX_MATH_TEST_POINTS covers SIMD body and scalar tail, odd cases run in place
+        vec3    In[LINUX_MATH_TEST_POINTS];
+        vec3    Out[LINUX_MATH_TEST_POINTS];
+        i32     PointsAmount    = CaseIndex % (LINUX_MATH_TEST_POINTS + 1);
+        bool32  SameArray       = CaseIndex & 1;
+
+        for (i32 PointIndex = 0; PointIndex < PointsAmount; ++PointIndex) {
+            In[PointIndex] = { LinuxRandomReal(&Random, -10.0f, 10.0f), LinuxRandomReal(&Random, -10.0f, 10.0f), LinuxRandomReal(&Random, -10.0f, 10.0f) };
+            Out[PointIndex] = In[PointIndex];
+        }
+
+        TransformPoints(A, SameArray ? Out : In, Out, PointsAmount);
+
+        for (i32 PointIndex = 0; PointIndex < PointsAmount; ++PointIndex) {
+            vec3 P = In[PointIndex];
+
+            for (i32 Row = 0; Row < 3; ++Row) {
+                real32 Reference = A.mat[Row][0] * P.x + A.mat[Row][1] * P.y + A.mat[Row][2] * P.z + A.mat[Row][3];
+                real32 Magnitude = fabsf(A.mat[Row][0] * P.x) + fabsf(A.mat[Row][1] * P.y) + fabsf(A.mat[Row][2] * P.z) + fabsf(A.mat[Row][3]);
+
+                LinuxCheckValue(&Points, Out[PointIndex].vec[Row], Reference, Magnitude);
+            }
+        }
+    }
+
+    printf("math-test   %s path | %d random cases\n", LINUX_MATH_PATH, LINUX_MATH_TEST_CASES);
+    LinuxPrintMathCheck("mat4 * mat4", &Products);
+    LinuxPrintMathCheck("mat4 *= mat4", &InPlace);
+    LinuxPrintMathCheck("mat4 * vec4", &VectorProducts);
+    LinuxPrintMathCheck("TransformPoints", &Points);
+
+    return !Products.Failed && !InPlace.Failed && !VectorProducts.Failed && !Points.Failed;
+}
+
+static quat LinuxNormalizeQuat(quat Value)
+{
+    real32 OneOverLength = 1.0f / Value.Length();
+
+    Value.w *= OneOverLength;
+    Value.x *= OneOverLength;
+    Value.y *= OneOverLength;
+    Value.z *= OneOverLength;
+
+    return Value;
+}
+
+static quat LinuxRandomQuat(u32* State)
+{
+    quat Result(LinuxRandomReal(State, -1.0f, 1.0f), LinuxRandomReal(State, -1.0f, 1.0f),
+                LinuxRandomReal(State, -1.0f, 1.0f), LinuxRandomReal(State, -1.0f, 1.0f));
+
+    return LinuxNormalizeQuat(Result);
+}
+
+// NOTE(ismail): angle between Value and shortest arc slerp from a to b computed in doubles
+static real64 LinuxSlerpAngleError(const quat& a, const quat& b, real32 t, const quat& Value)
+{
+    real64 Dot  = (real64)a.w * b.w + (real64)a.x * b.x + (real64)a.y * b.y + (real64)a.z * b.z;
+    real64 Sign = Dot < 0.0 ? -1.0 : 1.0;
+
+    Dot = fabs(Dot) > 1.0 ? 1.0 : fabs(Dot);
+
+    real64 Omega = acos(Dot);
+    real64 k0    = 1.0 - t;
+    real64 k1    = t;
+
+    if (sin(Omega) > 1e-9) {
+        k0 = sin((1.0 - t) * Omega) / sin(Omega);
+        k1 = sin(t * Omega) / sin(Omega);
+    }
+
+    real64 Reference[4] = {
+        a.w * k0 + Sign * b.w * k1,
+        a.x * k0 + Sign * b.x * k1,
+        a.y * k0 + Sign * b.y * k1,
+        a.z * k0 + Sign * b.z * k1,
+    };
+
+    real64 Length   = sqrt(Reference[0] * Reference[0] + Reference[1] * Reference[1] + Reference[2] * Reference[2] + Reference[3] * Reference[3]);
+    real64 Cos      = fabs(Reference[0] * Value.w + Reference[1] * Value.x + Reference[2] * Value.y + Reference[3] * Value.z) / Length;
+
+    return 2.0 * acos(Cos > 1.0 ? 1.0 : Cos);
+}
+
+// NOTE(ismail): Mat4N has to match quat::Mat4 like matrix kernels match scalar formulas and SlerpN has to match quat::Slerp.
+// NlerpN and FastSlerpN sum dot products in other order than scalar tail, so they are compared with tail within rounding
+// and FastSlerpN is compared with real slerp
+static bool32 LinuxQuatTest(Platform* Platform)
+{
+    (void)Platform;
+
+    LinuxMathCheck  Matrices        = {};
+    LinuxMathCheck  Nlerps          = {};
+    LinuxMathCheck  Slerps          = {};
+    LinuxMathCheck  FastSlerps      = {};
+    real64          MaxAngleError   = 0.0;
+    u32             Random          = 0x1B873593u;
+
+    for (i32 CaseIndex = 0; CaseIndex < LINUX_MATH_TEST_CASES / 10; ++CaseIndex) {
+        quat    a[LINUX_MATH_TEST_POINTS];
+        quat    b[LINUX_MATH_TEST_POINTS];
+        real32  t[LINUX_MATH_TEST_POINTS];
+        quat    Nlerped[LINUX_MATH_TEST_POINTS];
+        quat    Slerped[LINUX_MATH_TEST_POINTS];
+        quat    FastSlerped[LINUX_MATH_TEST_POINTS];
+        mat4    Converted[LINUX_MATH_TEST_POINTS];
+        i32     Amount = CaseIndex % (LINUX_MATH_TEST_POINTS + 1);
+
+        for (i32 Index = 0; Index < Amount; ++Index) {
+            a[Index] = LinuxRandomQuat(&Random);
+            b[Index] = LinuxRandomQuat(&Random);
+            t[Index] = LinuxRandomReal(&Random, 0.0f, 1.0f);
+
+            // NOTE(ismail): some pairs are close to each other and some are close to opposite
+            if ((LinuxRandom(&Random) & 7) == 0) {
+                real32 Sign = (LinuxRandom(&Random) & 1) ? -1.0f : 1.0f;
+
+                b[Index] = LinuxNormalizeQuat(quat(Sign * a[Index].w + 0.01f, Sign * a[Index].x, Sign * a[Index].y, Sign * a[Index].z));
+            }
+
+            Slerped[Index]      = a[Index];
+            FastSlerped[Index]  = a[Index];
+        }
+
+        quat::NlerpN(a, b, t, Nlerped, Amount);
+        quat::Mat4N(a, Converted, Amount);
+
+        // NOTE(ismail): odd cases write over a copy of first input like BlendPoses does
+        if (CaseIndex & 1) {
+            quat::SlerpN(Slerped, b, t, Slerped, Amount);
+            quat::FastSlerpN(FastSlerped, b, t, FastSlerped, Amount);
+        }
+        else {
+            quat::SlerpN(a, b, t, Slerped, Amount);
+            quat::FastSlerpN(a, b, t, FastSlerped, Amount);
+        }
+
+        for (i32 Index = 0; Index < Amount; ++Index) {
+            mat4 Reference;
+            a[Index].Mat4(Reference);
+
+            for (i32 Element = 0; Element < 16; ++Element) {
+                LinuxCheckValue(&Matrices, Converted[Index].mat[Element / 4][Element % 4], Reference.mat[Element / 4][Element % 4], 3.0f);
+            }
+
+            real32  d               = Fabs(a[Index].Dot(b[Index]));
+            quat    NlerpReference  = NlerpShortest(a[Index], b[Index], t[Index]);
+            quat    SlerpReference  = quat::Slerp(a[Index], b[Index], t[Index]);
+            quat    FastReference   = NlerpShortest(a[Index], b[Index], FastSlerpCorrection(d, t[Index]));
+
+            for (i32 Component = 0; Component < 4; ++Component) {
+                LinuxCheckValue(&Nlerps, Nlerped[Index].q[Component], NlerpReference.q[Component], 4.0f);
+                LinuxCheckValue(&Slerps, Slerped[Index].q[Component], SlerpReference.q[Component], 0.0f);
+                LinuxCheckValue(&FastSlerps, FastSlerped[Index].q[Component], FastReference.q[Component], 4.0f);
+            }
+
+            real64 AngleError = LinuxSlerpAngleError(a[Index], b[Index], t[Index], FastSlerped[Index]);
+
+            MaxAngleError = AngleError > MaxAngleError ? AngleError : MaxAngleError;
+        }
+    }
+
+    LinuxPrintMathCheck("quat Mat4N", &Matrices);
+    LinuxPrintMathCheck("quat NlerpN", &Nlerps);
+    LinuxPrintMathCheck("quat SlerpN", &Slerps);
+    LinuxPrintMathCheck("quat FastSlerpN", &FastSlerps);
+    printf("            %-16s max angle error %.05f rad against double slerp | %s\n", "quat FastSlerpN", MaxAngleError,
+           MaxAngleError < LINUX_SLERP_MAX_ERROR ? "match" : "MISMATCH");
+
+    return !Matrices.Failed && !Nlerps.Failed && !Slerps.Failed && !FastSlerps.Failed && MaxAngleError < LINUX_SLERP_MAX_ERROR;
+}
+
+// NOTE(ismail): spheres scattered on a plane with about one body per 4 square units, every body moves every frame
+// and bounces off scene bounds
+struct LinuxMoverScene {
+    BoundingVolume* Volumes;
+    vec3*           Velocities;
+    i32             Amount;
+    real32          HalfSize;
+};
+
+static void LinuxMoverSceneInit(Platform* Platform, LinuxMoverScene* Scene, i32 Amount, u32 Seed)
+{
+    Scene->Volumes      = (BoundingVolume*)Platform->AllocMem(sizeof(BoundingVolume) * Amount);
+    Scene->Velocities   = (vec3*)Platform->AllocMem(sizeof(vec3) * Amount);
+    Scene->Amount       = Amount;
+    Scene->HalfSize     = sqrtf((real32)Amount);
+
+    for (i32 BodyIndex = 0; BodyIndex < Amount; ++BodyIndex) {
+        BoundingVolume* Volume = &Scene->Volumes[BodyIndex];
+
+        Volume->VolumeType                      = BoundingVolumeType::SphereVolume;
+        Volume->VolumeData.Sphere.Center        = { LinuxRandomReal(&Seed, -Scene->HalfSize, Scene->HalfSize), 0.0f,
+                                                    LinuxRandomReal(&Seed, -Scene->HalfSize, Scene->HalfSize) };
+        Volume->VolumeData.Sphere.Radius        = LinuxRandomReal(&Seed, 0.25f, 0.75f);
+
+        Scene->Velocities[BodyIndex] = { LinuxRandomReal(&Seed, -2.0f, 2.0f), 0.0f, LinuxRandomReal(&Seed, -2.0f, 2.0f) };
+    }
+}
+
+static void LinuxMoverSceneFree(Platform* Platform, LinuxMoverScene* Scene)
+{
+    Platform->ReleaseMem(Scene->Volumes);
+    Platform->ReleaseMem(Scene->Velocities);
+}
+
+static inline vec3 LinuxMoverSceneStep(LinuxMoverScene* Scene, i32 BodyIndex, real32 dt)
+{
+    vec3&   Center      = Scene->Volumes[BodyIndex].VolumeData.Sphere.Center;
+    vec3&   Velocity    = Scene->Velocities[BodyIndex];
+
+    if (Fabs(Center.x) > Scene->HalfSize && Center.x * Velocity.x > 0.0f) {
+        Velocity.x = -Velocity.x;
+    }
+    if (Fabs(Center.z) > Scene->HalfSize && Center.z * Velocity.z > 0.0f) {
+        Velocity.z = -Velocity.z;
+    }
+
+    vec3 Displacement = Velocity * dt;
+
+    Center += Displacement;
+
+    return Displacement;
+}
+
+struct LinuxSweepEntry {
+    real32  Min;
+    i32     Index;
+};
+
+static int LinuxSweepEntryCompare(const void* A, const void* B)
+{
+    const LinuxSweepEntry* EntryA = (const LinuxSweepEntry*)A;
+    const LinuxSweepEntry* EntryB = (const LinuxSweepEntry*)B;
+
+    if (EntryA->Min != EntryB->Min) {
+        return EntryA->Min < EntryB->Min ? -1 : 1;
+    }
+
+    return EntryA->Index < EntryB->Index ? -1 : (EntryA->Index > EntryB->Index ? 1 : 0);
+}
+
+// NOTE(ismail): reference pairs of Boxes[i], plain sort on min x and scan, independent from tree and sweep-and-prune.
+// Pairs hold box indices and come out sorted
+static i32 LinuxReferencePairs(Platform* Platform, AABB* Boxes, i32 Amount, BroadPhasePair* Pairs, i32 MaxPairs)
+{
+    LinuxSweepEntry* Entries = (LinuxSweepEntry*)Platform->AllocMem(sizeof(LinuxSweepEntry) * Amount);
+
+    for (i32 Index = 0; Index < Amount; ++Index) {
+        Entries[Index].Min      = Boxes[Index].Center.x - Boxes[Index].Extens.x;
+        Entries[Index].Index    = Index;
+    }
+
+    qsort(Entries, Amount, sizeof(*Entries), LinuxSweepEntryCompare);
+
+    i32 Found = 0;
+
+    for (i32 First = 0; First < Amount; ++First) {
+        AABB&   Box = Boxes[Entries[First].Index];
+        real32  Max = Box.Center.x + Box.Extens.x;
+
+        for (i32 Second = First + 1; Second < Amount && Entries[Second].Min <= Max; ++Second) {
+            if (!AABBTreeOverlap(Box, Boxes[Entries[Second].Index])) {
+                continue;
+            }
+
+            if (Found < MaxPairs) {
+                i32 IndexA = Entries[First].Index;
+                i32 IndexB = Entries[Second].Index;
+
+                Pairs[Found].ProxyA = IndexA < IndexB ? IndexA : IndexB;
+                Pairs[Found].ProxyB = IndexA < IndexB ? IndexB : IndexA;
+            }
+
+            ++Found;
+        }
+    }
+
+    Platform->ReleaseMem(Entries);
+
+    Found = Found < MaxPairs ? Found : MaxPairs;
+
+    qsort(Pairs, Found, sizeof(*Pairs), BroadPhasePairCompare);
+
+    return Found;
+}
+
+// NOTE(ismail): proxies are turned into body indices through user data, then both lists are sorted and compared
+static bool32 LinuxSamePairs(BroadPhasePair* Pairs, i32 PairsAmount, BroadPhasePair* Reference, i32 ReferenceAmount)
+{
+    if (PairsAmount != ReferenceAmount) {
+        return 0;
+    }
+
+    qsort(Pairs, PairsAmount, sizeof(*Pairs), BroadPhasePairCompare);
+
+    return memcmp(Pairs, Reference, sizeof(*Pairs) * PairsAmount) == 0;
+}
+
+static i32 LinuxTreePairsToBodies(AABBTree* Tree, BroadPhasePair* Pairs, i32 PairsAmount)
+{
+    for (i32 PairIndex = 0; PairIndex < PairsAmount; ++PairIndex) {
+        i32 BodyA = (i32)(u64)AABBTreeGetUserData(Tree, Pairs[PairIndex].ProxyA);
+        i32 BodyB = (i32)(u64)AABBTreeGetUserData(Tree, Pairs[PairIndex].ProxyB);
+
+        Pairs[PairIndex].ProxyA = BodyA < BodyB ? BodyA : BodyB;
+        Pairs[PairIndex].ProxyB = BodyA < BodyB ? BodyB : BodyA;
+    }
+
+    return PairsAmount;
+}
+
+static i32 LinuxSAPPairsToBodies(SweepAndPrune* SAP, BroadPhasePair* Pairs, i32 PairsAmount)
+{
+    for (i32 PairIndex = 0; PairIndex < PairsAmount; ++PairIndex) {
+        i32 BodyA = (i32)(u64)SweepAndPruneGetUserData(SAP, Pairs[PairIndex].ProxyA);
+        i32 BodyB = (i32)(u64)SweepAndPruneGetUserData(SAP, Pairs[PairIndex].ProxyB);
+
+        Pairs[PairIndex].ProxyA = BodyA < BodyB ? BodyA : BodyB;
+        Pairs[PairIndex].ProxyB = BodyA < BodyB ? BodyB : BodyA;
+    }
+
+    return PairsAmount;
+}
+
+// NOTE(ismail): tree built over exactly 2 * N - 1 nodes takes N proxies, next insert must fail without touching the tree
+// and succeed after AABBTreeGrow
+static bool32 LinuxCheckTreeGrowth(Platform* Platform, LinuxMoverScene* Scene)
+{
+    i32             Amount          = 64;
+    i32             NodesCapacity   = 2 * Amount - 1;
+    AABBTreeNode*   Nodes           = (AABBTreeNode*)Platform->AllocMem(sizeof(AABBTreeNode) * NodesCapacity);
+    AABBTree        Tree;
+
+    AABBTreeInit(&Tree, Nodes, NodesCapacity, LINUX_BROADPHASE_FAT_MARGIN);
+
+    bool32 Passed = 1;
+
+    for (i32 BodyIndex = 0; BodyIndex < Amount; ++BodyIndex) {
+        Passed = Passed && AABBTreeInsert(&Tree, &Scene->Volumes[BodyIndex], (void*)(u64)BodyIndex) != AABB_TREE_NULL_NODE;
+    }
+
+    i32 RootBefore = Tree.Root;
+
+    Passed = Passed && AABBTreeInsert(&Tree, &Scene->Volumes[Amount], (void*)(u64)Amount) == AABB_TREE_NULL_NODE;
+    Passed = Passed && Tree.Root == RootBefore && Tree.NodesAmount == NodesCapacity;
+
+    AABBTreeNode* GrownNodes = (AABBTreeNode*)Platform->AllocMem(sizeof(AABBTreeNode) * NodesCapacity * 2);
+
+    AABBTreeGrow(&Tree, GrownNodes, NodesCapacity * 2);
+
+    Platform->ReleaseMem(Nodes);
+
+    Passed = Passed && AABBTreeInsert(&Tree, &Scene->Volumes[Amount], (void*)(u64)Amount) != AABB_TREE_NULL_NODE;
+
+    BroadPhasePair Pairs[512];
+    BroadPhasePair Reference[512];
+    AABB           Boxes[128];
+
+    for (i32 Proxy = 0; Proxy < Tree.NodesCapacity; ++Proxy) {
+        if (Tree.Nodes[Proxy].Height == 0) {
+            Boxes[(i32)(u64)Tree.Nodes[Proxy].UserData] = Tree.Nodes[Proxy].FatBox;
+        }
+    }
+
+    i32 PairsAmount     = LinuxTreePairsToBodies(&Tree, Pairs, AABBTreeQueryPairs(&Tree, Pairs, 512));
+    i32 ReferenceAmount = LinuxReferencePairs(Platform, Boxes, Amount + 1, Reference, 512);
+
+    Passed = Passed && LinuxSamePairs(Pairs, PairsAmount, Reference, ReferenceAmount);
+
+    Platform->ReleaseMem(GrownNodes);
+
+    return Passed;
+}
+
+static bool32 LinuxBroadPhaseBench(Platform* Platform, i32 BodiesAmount)
+{
+    LinuxMoverScene Scene;
+    LinuxMoverSceneInit(Platform, &Scene, BodiesAmount > 65 ? BodiesAmount : 65, 0x68E31DA4u);
+
+    BodiesAmount = Scene.Amount;
+
+    i32             MaxPairs        = BodiesAmount * LINUX_BROADPHASE_MAX_PAIRS;
+    i32             NodesCapacity   = 2 * BodiesAmount - 1;
+    AABBTreeNode*   Nodes           = (AABBTreeNode*)Platform->AllocMem(sizeof(AABBTreeNode) * NodesCapacity);
+    i32*            Proxies         = (i32*)Platform->AllocMem(sizeof(i32) * BodiesAmount);
+    AABB*           Boxes           = (AABB*)Platform->AllocMem(sizeof(AABB) * BodiesAmount);
+    BroadPhasePair* Pairs           = (BroadPhasePair*)Platform->AllocMem(sizeof(BroadPhasePair) * MaxPairs);
+    BroadPhasePair* Reference       = (BroadPhasePair*)Platform->AllocMem(sizeof(BroadPhasePair) * MaxPairs);
+    AABBTree        Tree;
+
+    AABBTreeInit(&Tree, Nodes, NodesCapacity, LINUX_BROADPHASE_FAT_MARGIN);
+
+    real64 StartTime = Platform->GetWallClock();
+
+    for (i32 BodyIndex = 0; BodyIndex < BodiesAmount; ++BodyIndex) {
+        Proxies[BodyIndex] = AABBTreeInsert(&Tree, &Scene.Volumes[BodyIndex], (void*)(u64)BodyIndex);
+    }
+
+    real64  BuildMs         = (Platform->GetWallClock() - StartTime) * 1000.0;
+    real64  MoveMs          = 0.0;
+    real64  PairsMs         = 0.0;
+    i64     Reinserted      = 0;
+    i32     PairsAmount     = 0;
+    bool32  PairsMatch      = 1;
+    i32     QueryMismatches = 0;
+
+    for (i32 Frame = 0; Frame < LINUX_BROADPHASE_FRAMES; ++Frame) {
+        StartTime = Platform->GetWallClock();
+
+        for (i32 BodyIndex = 0; BodyIndex < BodiesAmount; ++BodyIndex) {
+            vec3 Displacement = LinuxMoverSceneStep(&Scene, BodyIndex, LINUX_DEFAULT_DELTA_TIME);
+
+            Reinserted += AABBTreeMove(&Tree, Proxies[BodyIndex], &Scene.Volumes[BodyIndex], Displacement);
+        }
+
+        real64 PairsStartTime = Platform->GetWallClock();
+
+        PairsAmount = AABBTreeQueryPairs(&Tree, Pairs, MaxPairs);
+
+        real64 EndTime = Platform->GetWallClock();
+
+        MoveMs  += (PairsStartTime - StartTime) * 1000.0;
+        PairsMs += (EndTime - PairsStartTime) * 1000.0;
+
+        // NOTE(ismail): first and last frame are checked, reference runs outside of timers
+        if (Frame != 0 && Frame != LINUX_BROADPHASE_FRAMES - 1) {
+            continue;
+        }
+
+        for (i32 BodyIndex = 0; BodyIndex < BodiesAmount; ++BodyIndex) {
+            Boxes[BodyIndex] = Tree.Nodes[Proxies[BodyIndex]].FatBox;
+        }
+
+        i32 ReferenceAmount = LinuxReferencePairs(Platform, Boxes, BodiesAmount, Reference, MaxPairs);
+
+        LinuxTreePairsToBodies(&Tree, Pairs, PairsAmount < MaxPairs ? PairsAmount : MaxPairs);
+
+        PairsMatch = PairsMatch && PairsAmount <= MaxPairs && LinuxSamePairs(Pairs, PairsAmount, Reference, ReferenceAmount);
+
+        u32 Seed = 0x3C6EF372u + (u32)Frame;
+
+        for (i32 QueryIndex = 0; QueryIndex < LINUX_BROADPHASE_QUERIES; ++QueryIndex) {
+            AABB Box = { { LinuxRandomReal(&Seed, -Scene.HalfSize, Scene.HalfSize), 0.0f, LinuxRandomReal(&Seed, -Scene.HalfSize, Scene.HalfSize) },
+                         { LinuxRandomReal(&Seed, 0.5f, 5.0f), 1.0f, LinuxRandomReal(&Seed, 0.5f, 5.0f) } };
+
+            i32 Expected = 0;
+
+            for (i32 BodyIndex = 0; BodyIndex < BodiesAmount; ++BodyIndex) {
+                Expected += AABBTreeOverlap(Boxes[BodyIndex], Box) ? 1 : 0;
+            }
+
+            if (AABBTreeQuery(&Tree, &Box, 0, 0) != Expected) {
+                ++QueryMismatches;
+            }
+        }
+    }
+
+    bool32 GrowthPassed = LinuxCheckTreeGrowth(Platform, &Scene);
+
+    // NOTE(ismail): sweep-and-prune gets the same motion from the start, it keeps tight boxes so it finds fewer pairs than tree
+    LinuxMoverSceneFree(Platform, &Scene);
+    LinuxMoverSceneInit(Platform, &Scene, BodiesAmount, 0x68E31DA4u);
+
+    void*           SAPMemory = Platform->AllocMem(SweepAndPruneMemorySize(BodiesAmount));
+    SweepAndPrune   SAP;
+
+    SweepAndPruneInit(&SAP, SAPMemory, BodiesAmount, 0);
+
+    for (i32 BodyIndex = 0; BodyIndex < BodiesAmount; ++BodyIndex) {
+        Proxies[BodyIndex] = SweepAndPruneInsert(&SAP, &Scene.Volumes[BodyIndex], (void*)(u64)BodyIndex);
+    }
+
+    real64  SAPMoveMs       = 0.0;
+    real64  SAPPairsMs      = 0.0;
+    i32     SAPPairsAmount  = 0;
+    bool32  SAPPairsMatch   = 1;
+
+    for (i32 Frame = 0; Frame < LINUX_BROADPHASE_FRAMES; ++Frame) {
+        StartTime = Platform->GetWallClock();
+
+        for (i32 BodyIndex = 0; BodyIndex < BodiesAmount; ++BodyIndex) {
+            LinuxMoverSceneStep(&Scene, BodyIndex, LINUX_DEFAULT_DELTA_TIME);
+
+            SweepAndPruneMove(&SAP, Proxies[BodyIndex], &Scene.Volumes[BodyIndex]);
+        }
+
+        real64 PairsStartTime = Platform->GetWallClock();
+
+        SAPPairsAmount = SweepAndPruneQueryPairs(&SAP, Pairs, MaxPairs);
+
+        real64 EndTime = Platform->GetWallClock();
+
+        SAPMoveMs   += (PairsStartTime - StartTime) * 1000.0;
+        SAPPairsMs  += (EndTime - PairsStartTime) * 1000.0;
+
+        if (Frame != 0 && Frame != LINUX_BROADPHASE_FRAMES - 1) {
+            continue;
+        }
+
+        for (i32 BodyIndex = 0; BodyIndex < BodiesAmount; ++BodyIndex) {
+            Boxes[BodyIndex] = SAP.Proxies[Proxies[BodyIndex]].Box;
+        }
+
+        i32 ReferenceAmount = LinuxReferencePairs(Platform, Boxes, BodiesAmount, Reference, MaxPairs);
+
+        LinuxSAPPairsToBodies(&SAP, Pairs, SAPPairsAmount < MaxPairs ? SAPPairsAmount : MaxPairs);
+
+        SAPPairsMatch = SAPPairsMatch && SAPPairsAmount <= MaxPairs && LinuxSamePairs(Pairs, SAPPairsAmount, Reference, ReferenceAmount);
+    }
+
+    real64 TreeFrameMs  = (MoveMs + PairsMs) / LINUX_BROADPHASE_FRAMES;
+    real64 SAPFrameMs   = (SAPMoveMs + SAPPairsMs) / LINUX_BROADPHASE_FRAMES;
+
+    printf("broadphase-bench %d spheres moving on a plane | %d frames | %d tree pairs | %d sweep-and-prune pairs on last frame\n",
+           BodiesAmount, LINUX_BROADPHASE_FRAMES, PairsAmount, SAPPairsAmount);
+    printf("            tree build %.03f ms | move %.03f ms/frame (%.01f%% reinserted) | pairs %.03f ms/frame | %.03f ms/frame | height %d\n",
+           BuildMs, MoveMs / LINUX_BROADPHASE_FRAMES,
+           100.0 * (real64)Reinserted / ((real64)BodiesAmount * LINUX_BROADPHASE_FRAMES), PairsMs / LINUX_BROADPHASE_FRAMES,
+           TreeFrameMs, Tree.Nodes[Tree.Root].Height);
+    printf("            sweep-and-prune on x | move %.03f ms/frame | sort and pairs %.03f ms/frame | %.03f ms/frame | x%.02f over tree\n",
+           SAPMoveMs / LINUX_BROADPHASE_FRAMES, SAPPairsMs / LINUX_BROADPHASE_FRAMES, SAPFrameMs, TreeFrameMs / SAPFrameMs);
+    printf("            tree pairs %s | queries %s | full pool insert and grow %s | sweep-and-prune pairs %s\n",
+           PairsMatch ? "match" : "MISMATCH", QueryMismatches ? "MISMATCH" : "match", GrowthPassed ? "match" : "MISMATCH",
+           SAPPairsMatch ? "match" : "MISMATCH");
+
+    Platform->ReleaseMem(SAPMemory);
+    Platform->ReleaseMem(Nodes);
+    Platform->ReleaseMem(Proxies);
+    Platform->ReleaseMem(Boxes);
+    Platform->ReleaseMem(Pairs);
+    Platform->ReleaseMem(Reference);
+
+    LinuxMoverSceneFree(Platform, &Scene);
+
+    return PairsMatch && !QueryMismatches && GrowthPassed && SAPPairsMatch;
+}
+
+// NOTE(ismail): query results of every kernel are written as index lists and compared, scalar loop tests AABB array pairwise
+static i32 LinuxQueryBoxesScalar(AABB* Boxes, i32 Amount, AABB* Box, Sphere* Ball, i32* Result)
+{
+    i32 Found = 0;
+
+    for (i32 BoxIndex = 0; BoxIndex < Amount; ++BoxIndex) {
+        bool32 Overlap = Ball ? SphereToAABBTestOverlap(&Boxes[BoxIndex], Ball) : AABBToAABBTestOverlap(&Boxes[BoxIndex], Box);
+
+        if (Overlap) {
+            Result[Found++] = BoxIndex;
+        }
+    }
+
+    return Found;
+}
+
+static i32 LinuxQueryBoxes4(AABBSoA* Boxes, AABB* Box, Sphere* Ball, i32* Result)
+{
+    i32 Found = 0;
+
+    for (i32 First = 0; First < Boxes->Amount; First += 4) {
+        u32 Mask = Ball ? SphereToAABBTestOverlap4(Ball, Boxes, First) : AABBToAABBTestOverlap4(Box, Boxes, First);
+
+        for (i32 Lane = 0; Mask; ++Lane, Mask >>= 1) {
+            if (Mask & 1) {
+                Result[Found++] = First + Lane;
+            }
+        }
+    }
+
+    return Found;
+}
+
+static bool32 LinuxSoABench(Platform* Platform)
+{
+    i32         Amount      = LINUX_SOA_BENCH_BOXES;
+    AABB*       Boxes       = (AABB*)Platform->AllocMem(sizeof(AABB) * Amount);
+    i32*        Results     = (i32*)Platform->AllocMem(sizeof(i32) * Amount * 3);
+    void*       SoAMemory   = Platform->AllocMem(AABBSoAMemorySize(Amount));
+    AABBSoA     BoxesSoA;
+    u32         Random      = 0x510E527Fu;
+
+    AABBSoAInit(&BoxesSoA, SoAMemory, Amount);
+
+    // NOTE(ismail): boxes are scattered over 100x100 area, every query box or sphere hits about twenty of them
+    for (i32 BoxIndex = 0; BoxIndex < Amount; ++BoxIndex) {
+        Boxes[BoxIndex].Center = { LinuxRandomReal(&Random, -50.0f, 50.0f), LinuxRandomReal(&Random, -5.0f, 5.0f), LinuxRandomReal(&Random, -50.0f, 50.0f) };
+        Boxes[BoxIndex].Extens = { LinuxRandomReal(&Random, 0.1f, 1.5f), LinuxRandomReal(&Random, 0.1f, 1.5f), LinuxRandomReal(&Random, 0.1f, 1.5f) };
+
+        AABBSoAPush(&BoxesSoA, &Boxes[BoxIndex]);
+    }
+
+    i32*    ScalarResult    = Results;
+    i32*    Wide4Result     = Results + Amount;
+    i32*    Wide8Result     = Results + Amount * 2;
+    real64  Times[2][3]     = {};
+    i64     Hits[2]         = {};
+    i32     Mismatches      = 0;
+
+    for (i32 QueryIndex = 0; QueryIndex < LINUX_SOA_BENCH_QUERIES; ++QueryIndex) {
+        AABB    Box     = { { LinuxRandomReal(&Random, -50.0f, 50.0f), LinuxRandomReal(&Random, -5.0f, 5.0f), LinuxRandomReal(&Random, -50.0f, 50.0f) },
+                            { LinuxRandomReal(&Random, 0.5f, 4.0f), LinuxRandomReal(&Random, 0.5f, 4.0f), LinuxRandomReal(&Random, 0.5f, 4.0f) } };
+        Sphere  Ball    = { Box.Center, Box.Extens.x };
+
+        // NOTE(ismail): even queries are boxes, odd ones are spheres
+        i32     Kind        = QueryIndex & 1;
+        Sphere* QueryBall   = Kind ? &Ball : 0;
+
+        real64 StartTime = Platform->GetWallClock();
+        i32 ScalarFound = LinuxQueryBoxesScalar(Boxes, Amount, &Box, QueryBall, ScalarResult);
+        real64 ScalarTime = Platform->GetWallClock();
+        i32 Wide4Found = LinuxQueryBoxes4(&BoxesSoA, &Box, QueryBall, Wide4Result);
+        real64 Wide4Time = Platform->GetWallClock();
+        i32 Wide8Found = Kind ? AABBSoAQuerySphereOverlaps(&BoxesSoA, &Ball, Wide8Result, Amount) : AABBSoAQueryOverlaps(&BoxesSoA, &Box, Wide8Result, Amount);
+        real64 Wide8Time = Platform->GetWallClock();
+
+        Times[Kind][0] += ScalarTime - StartTime;
+        Times[Kind][1] += Wide4Time - ScalarTime;
+        Times[Kind][2] += Wide8Time - Wide4Time;
+        Hits[Kind]     += ScalarFound;
+
+        if (ScalarFound != Wide4Found || ScalarFound != Wide8Found ||
+            memcmp(ScalarResult, Wide4Result, sizeof(i32) * ScalarFound) != 0 ||
+            memcmp(ScalarResult, Wide8Result, sizeof(i32) * ScalarFound) != 0) {
+            ++Mismatches;
+        }
+    }
+
+    real64 BoxTests = (real64)Amount * (LINUX_SOA_BENCH_QUERIES / 2);
+
+    printf("soa-bench   %d boxes | %d queries | %s path\n", Amount, LINUX_SOA_BENCH_QUERIES, LINUX_MATH_PATH);
+    printf("            AABB query   scalar %.02f ns/box | 4 wide %.02f ns/box | 8 wide %.02f ns/box | %.01f hits per query\n",
+           Times[0][0] * 1e9 / BoxTests, Times[0][1] * 1e9 / BoxTests, Times[0][2] * 1e9 / BoxTests, (real64)Hits[0] / (LINUX_SOA_BENCH_QUERIES / 2));
+    printf("            sphere query scalar %.02f ns/box | 4 wide %.02f ns/box | 8 wide %.02f ns/box | %.01f hits per query\n",
+           Times[1][0] * 1e9 / BoxTests, Times[1][1] * 1e9 / BoxTests, Times[1][2] * 1e9 / BoxTests, (real64)Hits[1] / (LINUX_SOA_BENCH_QUERIES / 2));
+    printf("            scalar, 4 and 8 wide results %s\n", Mismatches ? "MISMATCH" : "match");
+
+    Platform->ReleaseMem(Boxes);
+    Platform->ReleaseMem(Results);
+    Platform->ReleaseMem(SoAMemory);
+
+    return Mismatches == 0;
+}
+
+// NOTE(ismail): clamps sphere center to box in doubles, Margin is distance between sphere surface and box,
+// float kernels may disagree with it only when it is about rounding error
+static bool32 LinuxSphereBoxReference(AABB* Box, Sphere* Ball, real64* Margin)
+{
+    real64 DistanceSquare = 0.0;
+
+    for (i32 Axis = 0; Axis < 3; ++Axis) {
+        real64 Min      = (real64)Box->Center[Axis] - (real64)Box->Extens[Axis];
+        real64 Max      = (real64)Box->Center[Axis] + (real64)Box->Extens[Axis];
+        real64 Point    = (real64)Ball->Center[Axis];
+        real64 Closest  = Point < Min ? Min : (Point > Max ? Max : Point);
+
+        DistanceSquare += (Point - Closest) * (Point - Closest);
+    }
+
+    *Margin = fabs(sqrt(DistanceSquare) - (real64)Ball->Radius);
+
+    return DistanceSquare <= (real64)Ball->Radius * (real64)Ball->Radius;
+}
+
+// NOTE(ismail): mostly long thin boxes with spheres around their faces and edges, where center distance test used to fail
+static void LinuxRandomSphereBox(u32* Random, AABB* Box, Sphere* Ball)
+{
+    Box->Center = { LinuxRandomReal(Random, -10.0f, 10.0f), LinuxRandomReal(Random, -10.0f, 10.0f), LinuxRandomReal(Random, -10.0f, 10.0f) };
+    Box->Extens = { LinuxRandomReal(Random, 0.01f, 8.0f), LinuxRandomReal(Random, 0.01f, 8.0f), LinuxRandomReal(Random, 0.01f, 8.0f) };
+
+    Ball->Radius = LinuxRandomReal(Random, 0.01f, 4.0f);
+
+    for (i32 Axis = 0; Axis < 3; ++Axis) {
+        real32 Reach = Box->Extens[Axis] + Ball->Radius + 0.5f;
+
+        Ball->Center[Axis] = Box->Center[Axis] + LinuxRandomReal(Random, -Reach, Reach);
+    }
+}
+
+struct LinuxCollisionCheck {
+    i64 Tested;
+    i64 Overlaps;
+    i64 Borderline;
+    i64 Mismatches;
+};
+
+static inline void LinuxCheckOverlap(LinuxCollisionCheck* Check, bool32 Overlap, bool32 Expected, real64 Margin)
+{
+    ++Check->Tested;
+
+    Check->Overlaps += Expected ? 1 : 0;
+
+    if (Margin < LINUX_COLLISION_TEST_MARGIN) {
+        ++Check->Borderline;
+    }
+    else if ((Overlap != 0) != (Expected != 0)) {
+        ++Check->Mismatches;
+    }
+}
+
+static void LinuxPrintCollisionCheck(const char* Name, LinuxCollisionCheck* Check)
+{
+    printf("            %-28s %lld pairs | %lld overlap | %lld within %g of touching | %lld mismatches\n", Name,
+           (long long)Check->Tested, (long long)Check->Overlaps, (long long)Check->Borderline, LINUX_COLLISION_TEST_MARGIN,
+           (long long)Check->Mismatches);
+}
+
+// NOTE(ismail): every batch is 8 boxes against one sphere and 8 spheres against one box. Scalar test, 4 wide SSE2 and
+// 8 wide AVX kernels and SoA queries built on them are compared with double precision reference
+static bool32 LinuxCollisionTest(Platform* Platform)
+{
+    (void)Platform;
+
+    real32      BoxesMemory[6 * AABB_SOA_LANES];
+    real32      SpheresMemory[4 * AABB_SOA_LANES];
+    AABBSoA     BoxesSoA;
+    SphereSoA   SpheresSoA;
+    u32         Random = 0x9B05688Cu;
+
+    AABBSoAInit(&BoxesSoA, BoxesMemory, AABB_SOA_LANES);
+    SphereSoAInit(&SpheresSoA, SpheresMemory, AABB_SOA_LANES);
+
+    LinuxCollisionCheck Scalar          = {};
+    LinuxCollisionCheck SphereToBoxes4  = {};
+    LinuxCollisionCheck SphereToBoxes8  = {};
+    LinuxCollisionCheck BoxToSpheres4   = {};
+    LinuxCollisionCheck BoxToSpheres8   = {};
+    i32                 QueryMismatches = 0;
+
+    for (i32 Batch = 0; Batch < LINUX_COLLISION_TEST_BATCHES; ++Batch) {
+        AABB    Boxes[AABB_SOA_LANES];
+        Sphere  Spheres[AABB_SOA_LANES];
+
+        // NOTE(ismail): lane pairs are generated together, so each box lane sits near the sphere and each sphere lane near the box
+        LinuxRandomSphereBox(&Random, &Boxes[0], &Spheres[0]);
+
+        for (i32 Lane = 1; Lane < AABB_SOA_LANES; ++Lane) {
+            AABB    LaneBox;
+            Sphere  LaneSphere;
+
+            LinuxRandomSphereBox(&Random, &LaneBox, &LaneSphere);
+
+            vec3 SphereOffset = LaneSphere.Center - LaneBox.Center;
+
+            Boxes[Lane]             = LaneBox;
+            Boxes[Lane].Center      = Spheres[0].Center - SphereOffset;
+            Spheres[Lane]           = LaneSphere;
+            Spheres[Lane].Center    = Boxes[0].Center + SphereOffset;
+        }
+
+        for (i32 Lane = 0; Lane < AABB_SOA_LANES; ++Lane) {
+            AABBSoASet(&BoxesSoA, Lane, &Boxes[Lane]);
+            SphereSoASet(&SpheresSoA, Lane, &Spheres[Lane]);
+        }
+
+        u32 SphereMask4 = SphereToAABBTestOverlap4(&Spheres[0], &BoxesSoA, 0) | (SphereToAABBTestOverlap4(&Spheres[0], &BoxesSoA, 4) << 4);
+        u32 SphereMask8 = SphereToAABBTestOverlap8(&Spheres[0], &BoxesSoA, 0);
+        u32 BoxMask4    = AABBToSphereTestOverlap4(&Boxes[0], &SpheresSoA, 0) | (AABBToSphereTestOverlap4(&Boxes[0], &SpheresSoA, 4) << 4);
+        u32 BoxMask8    = AABBToSphereTestOverlap8(&Boxes[0], &SpheresSoA, 0);
+
+        for (i32 Lane = 0; Lane < AABB_SOA_LANES; ++Lane) {
+            real64 Margin;
+            bool32 Expected = LinuxSphereBoxReference(&Boxes[Lane], &Spheres[0], &Margin);
+
+            LinuxCheckOverlap(&Scalar, SphereToAABBTestOverlap(&Boxes[Lane], &Spheres[0]), Expected, Margin);
+            LinuxCheckOverlap(&SphereToBoxes4, (SphereMask4 >> Lane) & 1, Expected, Margin);
+            LinuxCheckOverlap(&SphereToBoxes8, (SphereMask8 >> Lane) & 1, Expected, Margin);
+
+            Expected = LinuxSphereBoxReference(&Boxes[0], &Spheres[Lane], &Margin);
+
+            LinuxCheckOverlap(&BoxToSpheres4, (BoxMask4 >> Lane) & 1, Expected, Margin);
+            LinuxCheckOverlap(&BoxToSpheres8, (BoxMask8 >> Lane) & 1, Expected, Margin);
+        }
+
+        // NOTE(ismail): queries only collect kernel bits, they must report exactly the lanes of 8 wide masks
+        i32 Found[AABB_SOA_LANES];
+        i32 FoundAmount = AABBSoAQuerySphereOverlaps(&BoxesSoA, &Spheres[0], Found, AABB_SOA_LANES);
+        u32 QueryMask   = 0;
+
+        for (i32 Index = 0; Index < FoundAmount; ++Index) {
+            QueryMask |= 1u << Found[Index];
+        }
+
+        QueryMismatches += QueryMask != SphereMask8 ? 1 : 0;
+
+        FoundAmount = SphereSoAQueryAABBOverlaps(&SpheresSoA, &Boxes[0], Found, AABB_SOA_LANES);
+        QueryMask   = 0;
+
+        for (i32 Index = 0; Index < FoundAmount; ++Index) {
+            QueryMask |= 1u << Found[Index];
+        }
+
+        QueryMismatches += QueryMask != BoxMask8 ? 1 : 0;
+    }
+
+    printf("collision-test %s path | sphere against box, double precision clamp-to-box reference\n", LINUX_MATH_PATH);
+    LinuxPrintCollisionCheck("SphereToAABBTestOverlap", &Scalar);
+    LinuxPrintCollisionCheck("SphereToAABBTestOverlap4", &SphereToBoxes4);
+    LinuxPrintCollisionCheck("SphereToAABBTestOverlap8", &SphereToBoxes8);
+    LinuxPrintCollisionCheck("AABBToSphereTestOverlap4", &BoxToSpheres4);
+    LinuxPrintCollisionCheck("AABBToSphereTestOverlap8", &BoxToSpheres8);
+    printf("            SoA queries against kernel masks %s\n", QueryMismatches ? "MISMATCH" : "match");
+
+    return !Scalar.Mismatches && !SphereToBoxes4.Mismatches && !SphereToBoxes8.Mismatches &&
+           !BoxToSpheres4.Mismatches && !BoxToSpheres8.Mismatches && !QueryMismatches;
+}
+
+struct LinuxSpinningBox {
+    quat    Orientation;
+    quat    Spin;       // NOTE(ismail): rotation per frame
+    vec3    Velocity;
+};
+
+static void LinuxSpinningBoxAxes(LinuxSpinningBox* Spinning, OBB* Box)
+{
+    Box->Axis[0] = Spinning->Orientation * vec3{ 1.0f, 0.0f, 0.0f };
+    Box->Axis[1] = Spinning->Orientation * vec3{ 0.0f, 1.0f, 0.0f };
+    Box->Axis[2] = Spinning->Orientation * vec3{ 0.0f, 0.0f, 1.0f };
+}
+
+// NOTE(ismail): pair set is built once from boxes close at start and kept for every frame like broad phase output,
+// boxes drift and spin slowly so most pairs keep their separating axis between frames
+static bool32 LinuxOBBBench(Platform* Platform)
+{
+    i32                 Amount      = LINUX_OBB_BENCH_BOXES;
+    OBB*                Boxes       = (OBB*)Platform->AllocMem(sizeof(OBB) * Amount);
+    LinuxSpinningBox*   Spinning    = (LinuxSpinningBox*)Platform->AllocMem(sizeof(LinuxSpinningBox) * Amount);
+    OBBPair*            Pairs       = (OBBPair*)Platform->AllocMem(sizeof(OBBPair) * LINUX_OBB_BENCH_MAX_PAIRS);
+    bool32*             Uncached    = (bool32*)Platform->AllocMem(sizeof(bool32) * LINUX_OBB_BENCH_MAX_PAIRS);
+    i32                 PairsAmount = 0;
+    real32              dt          = LINUX_DEFAULT_DELTA_TIME;
+    u32                 Random      = 0x1F83D9ABu;
+
+    for (i32 BoxIndex = 0; BoxIndex < Amount; ++BoxIndex) {
+        vec3    SpinAxis    = { LinuxRandomReal(&Random, -1.0f, 1.0f), LinuxRandomReal(&Random, -1.0f, 1.0f), LinuxRandomReal(&Random, -1.0f, 1.0f) };
+        real32  SpinLength  = SpinAxis.Length();
+
+        SpinAxis = SpinLength > 0.0f ? SpinAxis * (1.0f / SpinLength) : vec3{ 0.0f, 1.0f, 0.0f };
+
+        Boxes[BoxIndex].Center          = { LinuxRandomReal(&Random, -20.0f, 20.0f), LinuxRandomReal(&Random, -20.0f, 20.0f), LinuxRandomReal(&Random, -20.0f, 20.0f) };
+        Boxes[BoxIndex].Extens          = { LinuxRandomReal(&Random, 0.2f, 1.5f), LinuxRandomReal(&Random, 0.2f, 1.5f), LinuxRandomReal(&Random, 0.2f, 1.5f) };
+        Spinning[BoxIndex].Orientation  = LinuxRandomQuat(&Random);
+        Spinning[BoxIndex].Spin         = quat(LinuxRandomReal(&Random, -1.0f, 1.0f) * dt, SpinAxis);
+        Spinning[BoxIndex].Velocity     = { LinuxRandomReal(&Random, -1.0f, 1.0f), LinuxRandomReal(&Random, -1.0f, 1.0f), LinuxRandomReal(&Random, -1.0f, 1.0f) };
+
+        LinuxSpinningBoxAxes(&Spinning[BoxIndex], &Boxes[BoxIndex]);
+    }
+
+    real32 PairDistanceSquare = LINUX_OBB_BENCH_PAIR_DISTANCE * LINUX_OBB_BENCH_PAIR_DISTANCE;
+
+    for (i32 BoxA = 0; BoxA < Amount && PairsAmount < LINUX_OBB_BENCH_MAX_PAIRS; ++BoxA) {
+        for (i32 BoxB = BoxA + 1; BoxB < Amount && PairsAmount < LINUX_OBB_BENCH_MAX_PAIRS; ++BoxB) {
+            vec3 Offset = Boxes[BoxB].Center - Boxes[BoxA].Center;
+
+            if (vec3::DotProduct(Offset, Offset) < PairDistanceSquare) {
+                OBBPairInit(&Pairs[PairsAmount++], BoxA, BoxB);
+            }
+        }
+    }
+
+    real64  CachedTime      = 0.0;
+    real64  UncachedTime    = 0.0;
+    i64     Overlaps        = 0;
+    i64     AxisKept        = 0;
+    i32     Mismatches      = 0;
+
+    for (i32 Frame = 0; Frame < LINUX_OBB_BENCH_FRAMES; ++Frame) {
+        for (i32 BoxIndex = 0; BoxIndex < Amount; ++BoxIndex) {
+            LinuxSpinningBox* Box = &Spinning[BoxIndex];
+
+            Box->Orientation = LinuxNormalizeQuat(Box->Spin * Box->Orientation);
+
+            Boxes[BoxIndex].Center += Box->Velocity * dt;
+            LinuxSpinningBoxAxes(Box, &Boxes[BoxIndex]);
+        }
+
+        // NOTE(ismail): counted outside timers, separated pairs whose last frame axis still separates them
+        for (i32 PairIndex = 0; PairIndex < PairsAmount; ++PairIndex) {
+            OBBPair* Pair = &Pairs[PairIndex];
+
+            if (Pair->CachedAxis != OBB_NO_SEPARATING_AXIS && OBBSeparatedOnAxis(&Boxes[Pair->BoxA], &Boxes[Pair->BoxB], Pair->CachedAxis)) {
+                ++AxisKept;
+            }
+        }
+
+        real64 StartTime = Platform->GetWallClock();
+        i32 FrameOverlaps = OBBToOBBTestOverlapBatch(Boxes, Pairs, PairsAmount);
+        real64 CachedEnd = Platform->GetWallClock();
+
+        for (i32 PairIndex = 0; PairIndex < PairsAmount; ++PairIndex) {
+            Uncached[PairIndex] = OBBToOBBTestOverlap(&Boxes[Pairs[PairIndex].BoxA], &Boxes[Pairs[PairIndex].BoxB]);
+        }
+
+        real64 UncachedEnd = Platform->GetWallClock();
+
+        CachedTime      += CachedEnd - StartTime;
+        UncachedTime    += UncachedEnd - CachedEnd;
+        Overlaps        += FrameOverlaps;
+
+        for (i32 PairIndex = 0; PairIndex < PairsAmount; ++PairIndex) {
+            Mismatches += (Pairs[PairIndex].Overlap != 0) != (Uncached[PairIndex] != 0) ? 1 : 0;
+        }
+    }
+
+    real64 PairTests = (real64)PairsAmount * LINUX_OBB_BENCH_FRAMES;
+
+    printf("obb-bench   %d boxes | %d persistent pairs | %d frames\n", Amount, PairsAmount, LINUX_OBB_BENCH_FRAMES);
+    printf("            cached axis %.02f ns/pair | full search %.02f ns/pair\n", CachedTime * 1e9 / PairTests, UncachedTime * 1e9 / PairTests);
+    printf("            %.01f%% overlapping | %.01f%% separated by last frame axis\n",
+           (real64)Overlaps * 100.0 / PairTests, (real64)AxisKept * 100.0 / PairTests);
+    printf("            cached and full search results %s\n", Mismatches ? "MISMATCH" : "match");
+
+    Platform->ReleaseMem(Boxes);
+    Platform->ReleaseMem(Spinning);
+    Platform->ReleaseMem(Pairs);
+    Platform->ReleaseMem(Uncached);
+
+    return Mismatches == 0;
+}
+
+// NOTE(ismail): ground plus 10x10 stacks of unit boxes, every box starts 1 mm above one below it
+static void LinuxPileInit(Platform* Platform, RigidBodyWorld* World, i32 BodiesAmount, void** Memory)
+{
+    i32 MaxBodies       = BodiesAmount + 1;
+    i32 MaxManifolds    = MaxBodies * LINUX_PILE_BENCH_MAX_PAIRS;
+
+    *Memory = Platform->AllocMem(RigidBodyWorldMemorySize(MaxBodies, MaxManifolds));
+
+    RigidBodyWorldInit(World, *Memory, MaxBodies, MaxManifolds);
+
+    BoundingVolume Ground = {};
+    Ground.VolumeType                   = AABBVolume;
+    Ground.VolumeData.AxisBox.Center    = { 0.0f, -1.0f, 0.0f };
+    Ground.VolumeData.AxisBox.Extens    = { 100.0f, 1.0f, 100.0f };
+
+    RigidBodyAdd(World, &Ground, quat(1.0f, 0.0f, 0.0f, 0.0f), 0.0f);
+
+    i32 StacksAmount = LINUX_PILE_BENCH_STACKS * LINUX_PILE_BENCH_STACKS;
+
+    for (i32 BodyIndex = 0; BodyIndex < BodiesAmount; ++BodyIndex) {
+        i32 Stack = BodyIndex % StacksAmount;
+        i32 Level = BodyIndex / StacksAmount;
+
+        BoundingVolume Shape = {};
+        Shape.VolumeType                        = OBBVolume;
+        Shape.VolumeData.OrientedBox.Center     = { ((real32)(Stack % LINUX_PILE_BENCH_STACKS) - 0.5f * LINUX_PILE_BENCH_STACKS) * 2.0f,
+                                                    0.501f + (real32)Level * 1.001f,
+                                                    ((real32)(Stack / LINUX_PILE_BENCH_STACKS) - 0.5f * LINUX_PILE_BENCH_STACKS) * 2.0f };
+        Shape.VolumeData.OrientedBox.Extens     = { 0.5f, 0.5f, 0.5f };
+
+        RigidBodyAdd(World, &Shape, quat(1.0f, 0.0f, 0.0f, 0.0f), 1.0f);
+    }
+}
+
+static u64 LinuxPileHash(RigidBodyWorld* World)
+{
+    u64 Hash = 0xCBF29CE484222325ull;
+
+    for (i32 BodyIndex = 0; BodyIndex < World->BodiesAmount; ++BodyIndex) {
+        Hash = LinuxHashBytes(Hash, &World->Bodies[BodyIndex].Position, sizeof(vec3));
+        Hash = LinuxHashBytes(Hash, &World->Bodies[BodyIndex].Orientation, sizeof(quat));
+    }
+
+    return Hash;
+}
+
+// NOTE(ismail): frame time has to stay flat once stacks settle, so first and last windows are reported next to
+// worst step. Second short run checks that steps are bit identical
+static bool32 LinuxPileBench(Platform* Platform, i32 BodiesAmount)
+{
+    RigidBodyWorld  World;
+    void*           Memory;
+    real32          dt          = LINUX_DEFAULT_DELTA_TIME;
+    real64          Windows[LINUX_PILE_BENCH_STEPS / LINUX_PILE_BENCH_WINDOW] = {};
+    real64          TotalTime   = 0.0;
+    real64          WorstStep   = 0.0;
+    u64             EarlyHash   = 0;
+
+    LinuxPileInit(Platform, &World, BodiesAmount, &Memory);
+
+    vec3* StartPositions = (vec3*)Platform->AllocMem(sizeof(vec3) * World.BodiesAmount);
+
+    for (i32 BodyIndex = 0; BodyIndex < World.BodiesAmount; ++BodyIndex) {
+        StartPositions[BodyIndex] = World.Bodies[BodyIndex].Position;
+    }
+
+    for (i32 Step = 0; Step < LINUX_PILE_BENCH_STEPS; ++Step) {
+        real64 StartTime = Platform->GetWallClock();
+        RigidBodyWorldStep(&World, dt);
+        real64 StepTime = Platform->GetWallClock() - StartTime;
+
+        TotalTime                               += StepTime;
+        Windows[Step / LINUX_PILE_BENCH_WINDOW] += StepTime;
+        WorstStep                               = StepTime > WorstStep ? StepTime : WorstStep;
+
+        if (Step + 1 == LINUX_PILE_BENCH_HASH_STEPS) {
+            EarlyHash = LinuxPileHash(&World);
+        }
+    }
+
+    i32 Standing = 0;
+
+    for (i32 BodyIndex = 1; BodyIndex < World.BodiesAmount; ++BodyIndex) {
+        vec3 Offset = World.Bodies[BodyIndex].Position - StartPositions[BodyIndex];
+
+        Standing += vec3::DotProduct(Offset, Offset) < LINUX_PILE_BENCH_STANDING * LINUX_PILE_BENCH_STANDING ? 1 : 0;
+    }
+
+    RigidBodyStats Stats = World.Stats;
+
+    Platform->ReleaseMem(Memory);
+
+    LinuxPileInit(Platform, &World, BodiesAmount, &Memory);
+
+    for (i32 Step = 0; Step < LINUX_PILE_BENCH_HASH_STEPS; ++Step) {
+        RigidBodyWorldStep(&World, dt);
+    }
+
+    u64 RepeatHash = LinuxPileHash(&World);
+
+    Platform->ReleaseMem(Memory);
+    Platform->ReleaseMem(StartPositions);
+
+    i32 WindowsAmount = LINUX_PILE_BENCH_STEPS / LINUX_PILE_BENCH_WINDOW;
+
+    printf("pile-bench  %d boxes in %d stacks | %d steps of %.4f s | %d solver iterations\n", BodiesAmount,
+           LINUX_PILE_BENCH_STACKS * LINUX_PILE_BENCH_STACKS, LINUX_PILE_BENCH_STEPS, dt, World.Iterations);
+    printf("            %.02f ms/step | first %d steps %.02f ms/step | last %d steps %.02f ms/step | worst step %.02f ms\n",
+           TotalTime * 1e3 / LINUX_PILE_BENCH_STEPS, LINUX_PILE_BENCH_WINDOW, Windows[0] * 1e3 / LINUX_PILE_BENCH_WINDOW,
+           LINUX_PILE_BENCH_WINDOW, Windows[WindowsAmount - 1] * 1e3 / LINUX_PILE_BENCH_WINDOW, WorstStep * 1e3);
+    printf("            %d contacts | %d manifolds | %d dropped pairs | %d of %d boxes within %.1f of start\n",
+           Stats.ContactsAmount, Stats.ManifoldsAmount, Stats.DroppedPairs, Standing, BodiesAmount, LINUX_PILE_BENCH_STANDING);
+    printf("            repeated run after %d steps %s\n", LINUX_PILE_BENCH_HASH_STEPS, EarlyHash == RepeatHash ? "match" : "MISMATCH");
+
+    return EarlyHash == RepeatHash;
+}
+
+struct LinuxJobBenchData {
+    real32* Input;
+    real32* Output;
+};
+
+static inline real32 LinuxJobBenchItem(real32 Value)
+{
+    real32 Result = Value;
+
+    for (i32 Iteration = 0; Iteration < 4; ++Iteration) {
+        Result = sqrtf(Result * Result + 1.0f) - Sin(Result) * 0.5f;
+    }
+
+    return Result;
+}
+
+static TEARA_JOB_FUNCTION(LinuxJobBenchItems)
+{
+    (void)Jobs;
+
+    LinuxJobBenchData* Bench = (LinuxJobBenchData*)Data;
+
+    for (i32 Index = First; Index < First + Amount; ++Index) {
+        Bench->Output[Index] = LinuxJobBenchItem(Bench->Input[Index]);
+    }
+}
+
+static TEARA_JOB_FUNCTION(LinuxJobBenchSingle)
+{
+    (void)Jobs;
+    (void)First;
+    (void)Amount;
+
+    *(real32*)Data = LinuxJobBenchItem(*(real32*)Data);
+}
+
+// NOTE(ismail): every thread count gets its own job system, main thread is worker 0 in each of them.
+// Single jobs are pushed from one thread faster than they drain, so deque fills and pusher runs the rest inline
+static bool32 LinuxJobBench(Platform* Platform, i32 MaxThreads)
+{
+    i32     Amount      = LINUX_JOB_BENCH_ITEMS;
+    real32* Input       = (real32*)Platform->AllocMem(sizeof(real32) * Amount);
+    real32* Output      = (real32*)Platform->AllocMem(sizeof(real32) * Amount);
+    real32* Reference   = (real32*)Platform->AllocMem(sizeof(real32) * Amount);
+    real32* Singles     = (real32*)Platform->AllocMem(sizeof(real32) * LINUX_JOB_BENCH_SINGLE_JOBS);
+    u32     Random      = 0x5BE0CD19u;
+    i32     Mismatches  = 0;
+    real64  BaseTime    = 0.0;
+
+    if (MaxThreads > JOB_SYSTEM_MAX_WORKERS) {
+        MaxThreads = JOB_SYSTEM_MAX_WORKERS;
+    }
+
+    for (i32 Index = 0; Index < Amount; ++Index) {
+        Input[Index]        = LinuxRandomReal(&Random, -10.0f, 10.0f);
+        Reference[Index]    = LinuxJobBenchItem(Input[Index]);
+    }
+
+    real32 SingleReference = LinuxJobBenchItem(LinuxJobBenchItem(1.0f));
+
+    printf("job-bench   parallel for %d items in batches of %d | %d single jobs from one thread | %d runs\n",
+           Amount, LINUX_JOB_BENCH_BATCH, LINUX_JOB_BENCH_SINGLE_JOBS, LINUX_JOB_BENCH_RUNS);
+
+    for (i32 Threads = 1; Threads <= MaxThreads; ++Threads) {
+        JobSystem           Jobs;
+        LinuxJobBenchData   Bench       = { Input, Output };
+        real64              ForTime     = 0.0;
+        real64              SinglesTime = 0.0;
+
+        JobSystemInit(&Jobs, Threads - 1);
+
+        for (i32 Run = 0; Run < LINUX_JOB_BENCH_RUNS; ++Run) {
+            memset(Output, 0, sizeof(real32) * Amount);
+
+            real64 StartTime = Platform->GetWallClock();
+            ParallelFor(&Jobs, Amount, LINUX_JOB_BENCH_BATCH, LinuxJobBenchItems, &Bench);
+            ForTime += Platform->GetWallClock() - StartTime;
+
+            Mismatches += memcmp(Output, Reference, sizeof(real32) * Amount) != 0 ? 1 : 0;
+
+            JobCounter Counter;
+            Counter.Value.store(0);
+
+            for (i32 Index = 0; Index < LINUX_JOB_BENCH_SINGLE_JOBS; ++Index) {
+                Singles[Index] = 1.0f;
+            }
+
+            // NOTE(ismail): two passes over same slots, second one starts only after first is done
+            StartTime = Platform->GetWallClock();
+            for (i32 Pass = 0; Pass < 2; ++Pass) {
+                for (i32 Index = 0; Index < LINUX_JOB_BENCH_SINGLE_JOBS; ++Index) {
+                    JobSystemRun(&Jobs, LinuxJobBenchSingle, &Singles[Index], &Counter);
+                }
+
+                JobSystemWait(&Jobs, &Counter);
+            }
+            SinglesTime += Platform->GetWallClock() - StartTime;
+
+            for (i32 Index = 0; Index < LINUX_JOB_BENCH_SINGLE_JOBS; ++Index) {
+                Mismatches += Singles[Index] != SingleReference ? 1 : 0;
+            }
+        }
+
+        JobWorkerStats Stats;
+        JobSystemCollectStats(&Jobs, &Stats);
+
+        JobSystemShutdown(&Jobs);
+
+        ForTime     /= LINUX_JOB_BENCH_RUNS;
+        SinglesTime /= LINUX_JOB_BENCH_RUNS;
+        BaseTime    = Threads == 1 ? ForTime : BaseTime;
+
+        printf("            %d threads | parallel for %.02f ms (%.02fx) | single jobs %.02f ms | %lld stolen | %lld run inline on full deque\n",
+               Threads, ForTime * 1e3, BaseTime / ForTime, SinglesTime * 1e3, (long long)Stats.Stolen, (long long)Stats.Inlined);
+    }
+
+    printf("            results against single thread %s\n", Mismatches ? "MISMATCH" : "match");
+
+    Platform->ReleaseMem(Input);
+    Platform->ReleaseMem(Output);
+    Platform->ReleaseMem(Reference);
+    Platform->ReleaseMem(Singles);
+
+    return Mismatches == 0;
+}
+
+static TEARA_TEXTURE_BIND(LinuxRecordTextureHandle)
+{
+    ((u32*)Target)[TargetSlot] = Handle;
+}
+
+// NOTE(ismail): 4x4 binary PPM, Seed picks pixels so same seed gives same file bytes
+static bool32 LinuxWriteTestImage(const char* Path, u8 Seed)
+{
+    FILE* Output = fopen(Path, "wb");
+
+    if (!Output) {
+        return 0;
+    }
+
+    u8 Pixels[4 * 4 * 3];
+
+    for (u32 Index = 0; Index < sizeof(Pixels); ++Index) {
+        Pixels[Index] = (u8)(Seed + Index * 7);
+    }
+
+    bool32 Result = fprintf(Output, "P6\n4 4\n255\n") > 0 && fwrite(Pixels, 1, sizeof(Pixels), Output) == sizeof(Pixels);
+
+    return (fclose(Output) == 0) && Result;
+}
+
+static i32 LinuxTextureCacheEntry(TextureCache* Cache, const char* Path)
+{
+    for (i32 EntryIndex = 0; EntryIndex < TEXTURE_CACHE_MAX_ENTRIES; ++EntryIndex) {
+        if (Cache->PathHashes[EntryIndex] && strcmp(Cache->Entries[EntryIndex].Path, Path) == 0) {
+            return EntryIndex;
+        }
+    }
+
+    return -1;
+}
+
+static bool32 LinuxCacheCheck(const char* What, bool32 Passed)
+{
+    printf("            %-60s %s\n", What, Passed ? "ok" : "FAILED");
+
+    return Passed;
+}
+
+// NOTE(ismail): a.ppm and b.ppm have same bytes so b is content alias of a, c.ppm is different. Destroy counter of
+// stub GPU shows when last user of shared texture is gone. Pin case releases a while b is hashed but not uploaded
+static bool32 LinuxTextureCacheTest(Platform* Platform)
+{
+    char Directory[] = "/tmp/teara-cache-XXXXXX";
+    char PathA[64];
+    char PathB[64];
+    char PathC[64];
+    char PathMissing[64];
+
+    if (!mkdtemp(Directory)) {
+        printf("texture-cache-test can't create temporary directory\n");
+
+        return 0;
+    }
+
+    snprintf(PathA, sizeof(PathA), "%s/a.ppm", Directory);
+    snprintf(PathB, sizeof(PathB), "%s/b.ppm", Directory);
+    snprintf(PathC, sizeof(PathC), "%s/c.ppm", Directory);
+    snprintf(PathMissing, sizeof(PathMissing), "%s/missing.ppm", Directory);
+
+    if (!LinuxWriteTestImage(PathA, 1) || !LinuxWriteTestImage(PathB, 1) || !LinuxWriteTestImage(PathC, 2)) {
+        printf("texture-cache-test can't write images to %s\n", Directory);
+
+        return 0;
+    }
+
+    if (!LinuxApp.Upload.Scratch) {
+        LinuxApp.Upload.Scratch = (u8*)Platform->AllocMem(LINUX_UPLOAD_SCRATCH_SIZE);
+    }
+
+    AssetStreamer*  Streamer    = new AssetStreamer();
+    TextureCache*   Cache       = new TextureCache();
+    u32             Handles[4]  = {};
+    u32             Created     = LinuxApp.Upload.TexturesCreated;
+    u32             Destroyed   = LinuxApp.Upload.TexturesDestroyed;
+    bool32          Passed      = 1;
+
+    AssetStreamerInit(Streamer, Platform, 0, 0.0);
+    TextureCacheInit(Cache, Streamer, &LinuxCreateStreamedTexture, &LinuxDestroyStreamedTexture);
+
+    printf("texture-cache-test %s\n", Directory);
+
+    TextureCacheRequest(Cache, PathA, 0, 0, &LinuxRecordTextureHandle, Handles, 0);
+    TextureCacheRequest(Cache, PathA, 0, 0, &LinuxRecordTextureHandle, Handles, 1);
+    TextureCacheRequest(Cache, PathB, 0, 0, &LinuxRecordTextureHandle, Handles, 2);
+    TextureCacheRequest(Cache, PathC, 0, 0, &LinuxRecordTextureHandle, Handles, 3);
+    AssetStreamerFlush(Streamer);
+
+    Passed = LinuxCacheCheck("a twice, b with a's bytes and c make 2 GPU textures",
+                             LinuxApp.Upload.TexturesCreated - Created == 2 && Cache->Stats.Textures == 2) && Passed;
+    Passed = LinuxCacheCheck("a, a and b are bound to one handle, c to another",
+                             Handles[0] && Handles[0] == Handles[1] && Handles[0] == Handles[2] && Handles[3] != Handles[0]) && Passed;
+    Passed = LinuxCacheCheck("1 path hit and 1 content hit",
+                             Cache->Stats.PathHits == 1 && Cache->Stats.ContentHits == 1) && Passed;
+
+    TextureCacheRelease(Cache, PathA, 0, 0);
+    TextureCacheRelease(Cache, PathA, 0, 0);
+
+    Passed = LinuxCacheCheck("releasing both a keeps texture while b uses it",
+                             LinuxApp.Upload.TexturesDestroyed == Destroyed) && Passed;
+
+    TextureCacheRelease(Cache, PathB, 0, 0);
+
+    Passed = LinuxCacheCheck("releasing b destroys shared texture",
+                             LinuxApp.Upload.TexturesDestroyed - Destroyed == 1 && Cache->Stats.Textures == 1) && Passed;
+
+    TextureCacheRelease(Cache, PathC, 0, 0);
+
+    Passed = LinuxCacheCheck("releasing c destroys it, no entries left",
+                             LinuxApp.Upload.TexturesDestroyed - Destroyed == 2 && Cache->Stats.Textures == 0 &&
+                             LinuxTextureCacheEntry(Cache, PathA) < 0 && LinuxTextureCacheEntry(Cache, PathB) < 0 &&
+                             LinuxTextureCacheEntry(Cache, PathC) < 0) && Passed;
+
+    memset(Handles, 0, sizeof(Handles));
+
+    TextureCacheRequest(Cache, PathA, 0, 0, &LinuxRecordTextureHandle, Handles, 0);
+    AssetStreamerFlush(Streamer);
+    TextureCacheRequest(Cache, PathB, 0, 0, &LinuxRecordTextureHandle, Handles, 1);
+
+    // NOTE(ismail): b is deduplicated on streaming thread and waits for upload, a is pinned until then
+    i32     EntryA      = LinuxTextureCacheEntry(Cache, PathA);
+    bool32  Pinned      = 0;
+    real64  WaitStart   = Platform->GetWallClock();
+
+    while (!Pinned && EntryA >= 0 && Platform->GetWallClock() - WaitStart < LINUX_CACHE_TEST_PIN_WAIT) {
+        {
+            std::lock_guard<std::mutex> Lock(Cache->ContentMutex);
+
+            Pinned = Cache->ContentPins[EntryA] > 0;
+        }
+
+        std::this_thread::yield();
+    }
+
+    Passed = LinuxCacheCheck("b in flight pins a", Pinned) && Passed;
+
+    TextureCacheRelease(Cache, PathA, 0, 0);
+
+    Passed = LinuxCacheCheck("releasing pinned a keeps its texture",
+                             LinuxApp.Upload.TexturesDestroyed - Destroyed == 2 && LinuxTextureCacheEntry(Cache, PathA) == EntryA) && Passed;
+
+    AssetStreamerFlush(Streamer);
+
+    Passed = LinuxCacheCheck("b uploads as alias of a",
+                             Handles[1] && Handles[1] == Handles[0] && LinuxApp.Upload.TexturesCreated - Created == 3) && Passed;
+
+    TextureCacheRelease(Cache, PathB, 0, 0);
+
+    Passed = LinuxCacheCheck("releasing b destroys a's texture",
+                             LinuxApp.Upload.TexturesDestroyed - Destroyed == 3 && Cache->Stats.Textures == 0 &&
+                             LinuxTextureCacheEntry(Cache, PathA) < 0) && Passed;
+
+    bool32 FirstRequest = TextureCacheRequest(Cache, PathMissing, 0, 0, &LinuxRecordTextureHandle, Handles, 2);
+    AssetStreamerFlush(Streamer);
+    bool32 SecondRequest = TextureCacheRequest(Cache, PathMissing, 0, 0, &LinuxRecordTextureHandle, Handles, 2);
+
+    Passed = LinuxCacheCheck("missing file fails once, later requests fail at once",
+                             FirstRequest && !SecondRequest && Cache->Stats.Failed == 1) && Passed;
+
+    printf("            %u created | %u destroyed | %s\n", LinuxApp.Upload.TexturesCreated - Created,
+           LinuxApp.Upload.TexturesDestroyed - Destroyed, Passed ? "match" : "MISMATCH");
+
+    AssetStreamerShutdown(Streamer);
+
+    delete Cache;
+    delete Streamer;
+
+    remove(PathA);
+    remove(PathB);
+    remove(PathC);
+    rmdir(Directory);
+
+    return Passed;
+}
+
+static bool32 LinuxBenchRequested(LinuxOptions* Options)
+{
+    return Options->KeyBench || Options->MathTest || Options->BroadPhaseBodies > 0 || Options->SoABench ||
+           Options->CollisionTest || Options->OBBBench || Options->PileBodies > 0 || Options->JobBenchThreads > 0 ||
+           Options->TextureCacheTest;
+}
+
+static bool32 LinuxRunBenches(Platform* Platform, LinuxOptions* Options)
+{
+    bool32 Passed = 1;
+
+    if (Options->KeyBench) {
+        Passed = LinuxKeyBench(Platform) && Passed;
+    }
+    if (Options->MathTest) {
+        Passed = LinuxMathTest(Platform) && Passed;
+        Passed = LinuxQuatTest(Platform) && Passed;
+    }
+    if (Options->BroadPhaseBodies > 0) {
+        Passed = LinuxBroadPhaseBench(Platform, Options->BroadPhaseBodies) && Passed;
+    }
+    if (Options->SoABench) {
+        Passed = LinuxSoABench(Platform) && Passed;
+    }
+    if (Options->CollisionTest) {
+        Passed = LinuxCollisionTest(Platform) && Passed;
+    }
+    if (Options->OBBBench) {
+        Passed = LinuxOBBBench(Platform) && Passed;
+    }
+    if (Options->PileBodies > 0) {
+        Passed = LinuxPileBench(Platform, Options->PileBodies) && Passed;
+    }
+    if (Options->JobBenchThreads > 0) {
+        Passed = LinuxJobBench(Platform, Options->JobBenchThreads) && Passed;
+    }
+    if (Options->TextureCacheTest) {
+        Passed = LinuxTextureCacheTest(Platform) && Passed;
+    }
+
+    return Passed;
+}
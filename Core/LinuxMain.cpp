@@ -0,0 +1,1752 @@
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+
+#include "Core/Types.h"
+#include "Math/Math.h"
+#include "Utils/AssetsLoader.h"
+#include "Utils/CookedMesh.h"
+#include "Utils/CookedTexture.h"
+#include "Utils/AssetStreamer.h"
+#include "Utils/TextureCache.h"
+#include "Utils/AudioLoader.h"
+#include "Utils/AudioStreamer.h"
+#include "Physics/RigidBody.h"
+#include "GameSimulation.cpp"
+
+// NOTE(ismail): headless platform for build and benchmark machines. No window, no GL and no audio device,
+// it drives the part of Frame that lives in GameSimulation.cpp plus a physics scene at unlocked frame rate
+
+#define LINUX_DEFAULT_FRAMES_AMOUNT     (1000)
+#define LINUX_DEFAULT_DELTA_TIME        (1.0f / 60.0f)
+#define LINUX_OBJ_MAX_ELEMENTS          (140000)
+#define LINUX_OBJ_MAX_MESHES            (10)
+#define LINUX_OBJ_FILES_MAX             (16)
+#define LINUX_SCRIPT_KEY_NAME_MAX       (16)
+#define LINUX_DEFAULT_BENCH_RUNS        (10)
+#define LINUX_DEFAULT_STREAM_FRAME      (1)
+#define LINUX_UPLOAD_SCRATCH_SIZE       (Megabytes(1))
+
+// NOTE(ismail): Button is 0 for mouse events, Moution is applied for that frame only
+struct LinuxScriptEvent {
+    i32         Frame;
+    Key*        Button;
+    KeyState    State;
+    vec2        Moution;
+};
+
+struct LinuxScriptedInput {
+    LinuxScriptEvent*   Events;
+    i32                 EventsAmount;
+    i32                 NextEvent;
+};
+
+struct LinuxOptions {
+    i32         FramesAmount;
+    i32         ThreadsAmount;
+    real32      DeltaTime;
+    i32         CharactersAmount;
+    i32         BodiesAmount;
+    real32      ParticleRate;
+    bool32      LoadCharacters;
+    const char* InputPath;
+    const char* ObjPaths[LINUX_OBJ_FILES_MAX];
+    i32         ObjPathsAmount;
+    const char* CookPaths[LINUX_OBJ_FILES_MAX];
+    i32         CookPathsAmount;
+    const char* BenchPaths[LINUX_OBJ_FILES_MAX];
+    i32         BenchPathsAmount;
+    i32         BenchRuns;
+    bool32      SmoothNormals;
+    bool32      CookFlip;
+    bool32      CookUncompressed;
+    const char* TextureBenchPaths[LINUX_OBJ_FILES_MAX];
+    i32         TextureBenchPathsAmount;
+    const char* AudioBenchPaths[LINUX_OBJ_FILES_MAX];
+    i32         AudioBenchPathsAmount;
+    const char* StreamPaths[LINUX_OBJ_FILES_MAX];
+    i32         StreamPathsAmount;
+    i32         StreamFrame;
+    u64         UploadBudgetBytes;
+    real64      UploadBudgetMs;
+    bool32      SyncLoad;
+    bool32      KeyBench;
+    bool32      MathTest;
+    i32         BroadPhaseBodies;
+    i32         PileBodies;
+    i32         JobBenchThreads;
+    bool32      SoABench;
+    bool32      CollisionTest;
+    bool32      OBBBench;
+    bool32      TextureCacheTest;
+};
+
+struct LinuxSubsystemTime {
+    real64  TotalMs;
+    real64  MinMs;
+    real64  MaxMs;
+};
+
+// NOTE(ismail): GL upload stub copies asset into Scratch, Checksum lets streamed and --sync-load runs be compared
+struct LinuxUploadStub {
+    u8*     Scratch;
+    u64     Checksum;
+    u32     TexturesCreated;
+    u32     TexturesDestroyed;
+};
+
+struct LinuxPlatform {
+    u64                 PageSize;
+    LinuxUploadStub     Upload;
+    JobSystem           Jobs;
+    LinuxScriptedInput  Script;
+    Platform            EnginePlatformDetails;
+};
+
+static LinuxPlatform LinuxApp;
+
+// NOTE(ismail): first page keeps mapping size for munmap, returned memory is page aligned and zeroed like VirtualAlloc
+static void* LinuxMapMemory(u64 Size)
+{
+    u64     TotalSize   = Size + LinuxApp.PageSize;
+    void*   Base        = mmap(0, TotalSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (Base == MAP_FAILED) {
+        return 0;
+    }
+
+    *(u64*)Base = TotalSize;
+
+    return (u8*)Base + LinuxApp.PageSize;
+}
+
+static void LinuxUnmapMemory(void* Ptr)
+{
+    u8* Base = (u8*)Ptr - LinuxApp.PageSize;
+
+    munmap(Base, *(u64*)Base);
+}
+
+static TEARA_PLATFORM_ALLOCATE_MEMORY(LinuxMemoryAllocate)
+{
+    Assert(Size > 0);
+
+    CountPlatformAllocation(Size);
+
+    return LinuxMapMemory(Size);
+}
+
+static TEARA_PLATFORM_RELEASE_MEMORY(LinuxMemoryRelease)
+{
+    if (Ptr) {
+        LinuxUnmapMemory(Ptr);
+    }
+}
+
+static TEARA_PLATFORM_FREE_FILE_DATA(LinuxFreeFileData)
+{
+    if (FileData->Data) {
+        LinuxUnmapMemory(FileData->Data);
+    }
+}
+
+static TEARA_PLATFORM_READ_FILE(LinuxReadFile)
+{
+    struct stat FileStat;
+    File        Result = {};
+
+    i32 FileHandle = open(FileName, O_RDONLY);
+    if (FileHandle == -1) {
+        return Result;
+    }
+
+    if (fstat(FileHandle, &FileStat) == 0 && FileStat.st_size > 0) {
+        u64 FileSize = (u64)FileStat.st_size;
+
+        Result.Data = (byte*)LinuxMapMemory(FileSize);
+
+        if (Result.Data) {
+            u64 BytesRead = 0;
+
+            while (BytesRead < FileSize) {
+                ssize_t ReadResult = read(FileHandle, Result.Data + BytesRead, FileSize - BytesRead);
+
+                if (ReadResult <= 0) {
+                    break;
+                }
+
+                BytesRead += (u64)ReadResult;
+            }
+
+            if (BytesRead == FileSize) {
+                Result.Size = FileSize;
+            }
+            else {
+                LinuxFreeFileData(&Result);
+                Result.Data = 0;
+            }
+        }
+    }
+
+    close(FileHandle);
+
+    return Result;
+}
+
+static TEARA_PLATFORM_MAP_FILE(LinuxMapFile)
+{
+    struct stat FileStat;
+    File        Result = {};
+
+    i32 FileHandle = open(FileName, O_RDONLY);
+    if (FileHandle == -1) {
+        return Result;
+    }
+
+    if (fstat(FileHandle, &FileStat) == 0 && FileStat.st_size > 0) {
+        void* Data = mmap(0, (u64)FileStat.st_size, PROT_READ, MAP_PRIVATE, FileHandle, 0);
+
+        if (Data != MAP_FAILED) {
+            Result.Data = (byte*)Data;
+            Result.Size = (u64)FileStat.st_size;
+        }
+    }
+
+    // NOTE(ismail): mapping keeps the file alive
+    close(FileHandle);
+
+    return Result;
+}
+
+static TEARA_PLATFORM_UNMAP_FILE(LinuxUnmapFile)
+{
+    if (FileData->Data) {
+        munmap(FileData->Data, FileData->Size);
+    }
+
+    *FileData = {};
+}
+
+static TEARA_PLATFORM_GET_WALL_CLOCK(LinuxGetWallClock)
+{
+    struct timespec Time;
+    clock_gettime(CLOCK_MONOTONIC, &Time);
+
+    return (real64)Time.tv_sec + (real64)Time.tv_nsec * 1e-9;
+}
+
+// NOTE(ismail): main thread is job worker 0 and runs jobs while it waits on them
+static i32 LinuxJobThreadsAmount()
+{
+    i64 ProcessorsAmount = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return ProcessorsAmount > 1 ? (i32)ProcessorsAmount - 1 : 0;
+}
+
+static void LinuxPlatformInit(LinuxOptions* Options)
+{
+    LinuxApp.PageSize = (u64)sysconf(_SC_PAGESIZE);
+
+    LinuxApp.EnginePlatformDetails.AllocMem       = &LinuxMemoryAllocate;
+    LinuxApp.EnginePlatformDetails.ReleaseMem     = &LinuxMemoryRelease;
+    LinuxApp.EnginePlatformDetails.ReadFile       = &LinuxReadFile;
+    LinuxApp.EnginePlatformDetails.FreeFileData   = &LinuxFreeFileData;
+    LinuxApp.EnginePlatformDetails.MapFile        = &LinuxMapFile;
+    LinuxApp.EnginePlatformDetails.UnmapFile      = &LinuxUnmapFile;
+    LinuxApp.EnginePlatformDetails.GetWallClock   = &LinuxGetWallClock;
+
+    JobSystemInit(&LinuxApp.Jobs, Options->ThreadsAmount);
+
+    LinuxApp.EnginePlatformDetails.Jobs           = &LinuxApp.Jobs;
+
+    ScreenOptions& ScreenOpt = LinuxApp.EnginePlatformDetails.ScreenOpt;
+    ScreenOpt.Width         = 1600;
+    ScreenOpt.Height        = 900;
+    ScreenOpt.ActualWidth   = ScreenOpt.Width;
+    ScreenOpt.ActualHeight  = ScreenOpt.Height;
+    ScreenOpt.AspectRatio   = (real32)ScreenOpt.Width / (real32)ScreenOpt.Height;
+
+    LinuxApp.EnginePlatformDetails.Running = 1;
+}
+
+static void LinuxProcessKey(Key *ProcessKey, KeyState NewKeyState)
+{
+    if (ProcessKey->State != NewKeyState) {
+        ProcessKey->PrevState   = ProcessKey->State ;
+        ProcessKey->State       = NewKeyState;
+        ++(ProcessKey->TransactionCount);
+    }
+}
+
+static Key* LinuxScriptKey(Input* Input, const char* Name)
+{
+    struct ScriptKey {
+        const char* Name;
+        Key*        Button;
+    };
+
+    ScriptKey Keys[] = {
+        { "W",      &Input->WButton     },
+        { "S",      &Input->SButton     },
+        { "A",      &Input->AButton     },
+        { "D",      &Input->DButton     },
+        { "Q",      &Input->QButton     },
+        { "E",      &Input->EButton     },
+        { "I",      &Input->IButton     },
+        { "K",      &Input->KButton     },
+        { "L",      &Input->LButton     },
+        { "J",      &Input->JButton     },
+        { "M",      &Input->MButton     },
+        { "Up",     &Input->ArrowUp     },
+        { "Down",   &Input->ArrowDown   },
+        { "Right",  &Input->ArrowRight  },
+        { "Left",   &Input->ArrowLeft   },
+    };
+
+    for (i32 KeyIndex = 0; KeyIndex < (i32)(sizeof(Keys) / sizeof(*Keys)); ++KeyIndex) {
+        if (strcmp(Keys[KeyIndex].Name, Name) == 0) {
+            return Keys[KeyIndex].Button;
+        }
+    }
+
+    return 0;
+}
+
+// NOTE(ismail): one event per line, '#' starts a comment, events are sorted by frame:
+//   <frame> key <W|S|A|D|Q|E|I|K|L|J|M|Up|Down|Right|Left> <down|up>
+//   <frame> mouse <dx> <dy>
+static Statuses LinuxLoadScript(Platform* Platform, const char* Path, LinuxScriptedInput* Script)
+{
+    File ScriptFile = Platform->ReadFile(Path);
+
+    if (!ScriptFile.Data) {
+        return Statuses::FileLoadFailed;
+    }
+
+    i32 LinesAmount = 1;
+    for (u64 Index = 0; Index < ScriptFile.Size; ++Index) {
+        LinesAmount += ScriptFile.Data[Index] == '\n';
+    }
+
+    Script->Events          = (LinuxScriptEvent*)Platform->AllocMem(sizeof(LinuxScriptEvent) * LinesAmount);
+    Script->EventsAmount    = 0;
+    Script->NextEvent       = 0;
+
+    char*   At      = (char*)ScriptFile.Data;
+    char*   End     = At + ScriptFile.Size;
+    i32     Line    = 0;
+
+    while (At < End) {
+        char    LineBuffer[256];
+        i32     LineLength = 0;
+
+        while (At < End && *At != '\n') {
+            if (LineLength < (i32)sizeof(LineBuffer) - 1) {
+                LineBuffer[LineLength++] = *At;
+            }
+            ++At;
+        }
+        ++At;
+        ++Line;
+
+        LineBuffer[LineLength] = 0;
+
+        char* Comment = strchr(LineBuffer, '#');
+        if (Comment) {
+            *Comment = 0;
+        }
+
+        i32     Frame;
+        char    Kind[LINUX_SCRIPT_KEY_NAME_MAX];
+        char    Name[LINUX_SCRIPT_KEY_NAME_MAX];
+        char    State[LINUX_SCRIPT_KEY_NAME_MAX];
+        real32  dx, dy;
+
+        LinuxScriptEvent Event = {};
+
+        if (sscanf(LineBuffer, "%d %15s", &Frame, Kind) != 2) {
+            continue;
+        }
+
+        Event.Frame = Frame;
+
+        if (strcmp(Kind, "key") == 0 && sscanf(LineBuffer, "%*d %*s %15s %15s", Name, State) == 2) {
+            Event.Button    = LinuxScriptKey(&Platform->Input, Name);
+            Event.State     = strcmp(State, "down") == 0 ? KeyState::Pressed : KeyState::Released;
+
+            if (!Event.Button) {
+                fprintf(stderr, "%s:%d: unknown key %s\n", Path, Line, Name);
+                continue;
+            }
+        }
+        else if (strcmp(Kind, "mouse") == 0 && sscanf(LineBuffer, "%*d %*s %f %f", &dx, &dy) == 2) {
+            Event.Moution = { dx, dy };
+        }
+        else {
+            fprintf(stderr, "%s:%d: can't parse event\n", Path, Line);
+            continue;
+        }
+
+        Assert(Script->EventsAmount == 0 || Script->Events[Script->EventsAmount - 1].Frame <= Frame);
+
+        Script->Events[Script->EventsAmount++] = Event;
+    }
+
+    Platform->FreeFileData(&ScriptFile);
+
+    return Statuses::Success;
+}
+
+static void LinuxTakeScriptedInput(Platform* Platform, LinuxScriptedInput* Script, i32 Frame)
+{
+    Input& Input = Platform->Input;
+
+    Input.MouseInput.Moution = { 0.0f, 0.0f };
+
+    while (Script->NextEvent < Script->EventsAmount && Script->Events[Script->NextEvent].Frame <= Frame) {
+        LinuxScriptEvent& Event = Script->Events[Script->NextEvent++];
+
+        if (Event.Button) {
+            LinuxProcessKey(Event.Button, Event.State);
+        }
+        else {
+            Input.MouseInput.Moution = Event.Moution;
+        }
+    }
+}
+
+static void LinuxPrintUsage(const char* Name)
+{
+    printf("usage: %s [options]\n"
+           "  --frames N       frames to simulate (%d)\n"
+           "  --threads N      extra job threads, main thread is worker 0 (cores - 1)\n"
+           "  --dt SECONDS     fixed frame delta time (%.4f)\n"
+           "  --characters N   animation tracks driven by the player skin (1)\n"
+           "  --bodies N       rigid bodies in physics scene (0)\n"
+           "  --particle-rate N  particles per second from demo emitter, 0 keeps single test particle (0)\n"
+           "  --no-characters  skip glTF character loading\n"
+           "  --obj PATH       time .obj loading, may be repeated\n"
+           "  --input PATH     scripted input file\n"
+           "  --cook PATH      write PATH" COOKED_MESH_EXTENSION " from .obj or .gltf, PATH" COOKED_TEXTURE_EXTENSION " from image and exit, may be repeated\n"
+           "  --cook-flip      cook images flipped vertically, like material textures of .obj are loaded\n"
+           "  --cook-uncompressed  cook RGBA8 mip chain instead of BC1 / BC3\n"
+           "  --smooth-normals generate smooth normals when cooking or loading .obj\n"
+           "  --mesh-bench PATH  compare text and cooked loading, cold and warm, and text .obj through streamer, may be repeated\n"
+           "  --texture-bench PATH  compare decoding image and mapping its cooked mip chain, cold and warm, may be repeated\n"
+           "  --audio-bench PATH  compare whole file decode of .wav or .flac with streaming it through chunk ring, may be repeated\n"
+           "  --bench-runs N   warm runs per path in --mesh-bench and --texture-bench (%d)\n"
+           "  --stream PATH    stream .obj or image during the run, GL upload is stubbed, may be repeated\n"
+           "  --stream-frame N frame that submits --stream assets (%d)\n"
+           "  --upload-budget-kb N  bytes uploaded per frame, 0 is no limit (%d)\n"
+           "  --upload-budget-ms MS main thread upload time per frame, 0 is no limit (%.1f)\n"
+           "  --sync-load      load --stream assets blocking in one frame, like loading without streamer\n"
+           "  --key-bench      time keyframe scan, binary search and cursor on a 400 key channel, check they agree\n"
+           "  --math-test      check SIMD matrix kernels against scalar formulas\n"
+           "  --soa-bench      time box and sphere queries over 10k boxes, scalar against 4 and 8 wide SoA kernels\n"
+           "  --collision-test check scalar, SSE2 and AVX sphere against box tests with double precision reference\n"
+           "  --texture-cache-test  request and release shared textures, check GPU textures are destroyed with last user\n"
+           "  --obb-bench      time cached separating axis against full SAT search over persistent OBB pairs\n"
+           "  --broadphase-bench N  time AABB tree and sweep-and-prune over N moving spheres, check pairs against reference\n"
+           "  --pile-bench N   step N boxes stacked in 10x10 stacks, report frame time over run and repeatability\n"
+           "  --job-bench N    time parallel for and single jobs on 1 to N threads, check results against one thread\n",
+           Name, LINUX_DEFAULT_FRAMES_AMOUNT, LINUX_DEFAULT_DELTA_TIME, LINUX_DEFAULT_BENCH_RUNS, LINUX_DEFAULT_STREAM_FRAME,
+           (i32)(ASSET_STREAMER_DEFAULT_BUDGET_BYTES / 1024), ASSET_STREAMER_DEFAULT_BUDGET_MS);
+}
+
+static bool32 LinuxParseOptions(i32 ArgsAmount, char** Args, LinuxOptions* Options)
+{
+    *Options = {};
+
+    Options->FramesAmount       = LINUX_DEFAULT_FRAMES_AMOUNT;
+    Options->ThreadsAmount      = LinuxJobThreadsAmount();
+    Options->DeltaTime          = LINUX_DEFAULT_DELTA_TIME;
+    Options->CharactersAmount   = 1;
+    Options->LoadCharacters     = 1;
+    Options->BenchRuns          = LINUX_DEFAULT_BENCH_RUNS;
+    Options->StreamFrame        = LINUX_DEFAULT_STREAM_FRAME;
+    Options->UploadBudgetBytes  = ASSET_STREAMER_DEFAULT_BUDGET_BYTES;
+    Options->UploadBudgetMs     = ASSET_STREAMER_DEFAULT_BUDGET_MS;
+
+    for (i32 ArgIndex = 1; ArgIndex < ArgsAmount; ++ArgIndex) {
+        const char* Arg     = Args[ArgIndex];
+        const char* Value   = ArgIndex + 1 < ArgsAmount ? Args[ArgIndex + 1] : 0;
+
+        if (strcmp(Arg, "--no-characters") == 0) {
+            Options->LoadCharacters = 0;
+
+            continue;
+        }
+
+        if (strcmp(Arg, "--smooth-normals") == 0) {
+            Options->SmoothNormals = 1;
+
+            continue;
+        }
+
+        if (strcmp(Arg, "--sync-load") == 0) {
+            Options->SyncLoad = 1;
+
+            continue;
+        }
+
+        if (strcmp(Arg, "--cook-flip") == 0) {
+            Options->CookFlip = 1;
+
+            continue;
+        }
+
+        if (strcmp(Arg, "--cook-uncompressed") == 0) {
+            Options->CookUncompressed = 1;
+
+            continue;
+        }
+
+        if (strcmp(Arg, "--key-bench") == 0) {
+            Options->KeyBench = 1;
+
+            continue;
+        }
+
+        if (strcmp(Arg, "--math-test") == 0) {
+            Options->MathTest = 1;
+
+            continue;
+        }
+
+        if (strcmp(Arg, "--soa-bench") == 0) {
+            Options->SoABench = 1;
+
+            continue;
+        }
+
+        if (strcmp(Arg, "--collision-test") == 0) {
+            Options->CollisionTest = 1;
+
+            continue;
+        }
+
+        if (strcmp(Arg, "--obb-bench") == 0) {
+            Options->OBBBench = 1;
+
+            continue;
+        }
+
+        if (strcmp(Arg, "--texture-cache-test") == 0) {
+            Options->TextureCacheTest = 1;
+
+            continue;
+        }
+
+        if (!Value) {
+            return 0;
+        }
+
+        if (strcmp(Arg, "--frames") == 0) {
+            Options->FramesAmount = atoi(Value);
+        }
+        else if (strcmp(Arg, "--threads") == 0) {
+            Options->ThreadsAmount = atoi(Value);
+        }
+        else if (strcmp(Arg, "--dt") == 0) {
+            Options->DeltaTime = (real32)atof(Value);
+        }
+        else if (strcmp(Arg, "--characters") == 0) {
+            Options->CharactersAmount = atoi(Value);
+        }
+        else if (strcmp(Arg, "--bodies") == 0) {
+            Options->BodiesAmount = atoi(Value);
+        }
+        else if (strcmp(Arg, "--particle-rate") == 0) {
+            Options->ParticleRate = (real32)atof(Value);
+        }
+        else if (strcmp(Arg, "--input") == 0) {
+            Options->InputPath = Value;
+        }
+        else if (strcmp(Arg, "--obj") == 0 && Options->ObjPathsAmount < LINUX_OBJ_FILES_MAX) {
+            Options->ObjPaths[Options->ObjPathsAmount++] = Value;
+        }
+        else if (strcmp(Arg, "--cook") == 0 && Options->CookPathsAmount < LINUX_OBJ_FILES_MAX) {
+            Options->CookPaths[Options->CookPathsAmount++] = Value;
+        }
+        else if (strcmp(Arg, "--mesh-bench") == 0 && Options->BenchPathsAmount < LINUX_OBJ_FILES_MAX) {
+            Options->BenchPaths[Options->BenchPathsAmount++] = Value;
+        }
+        else if (strcmp(Arg, "--texture-bench") == 0 && Options->TextureBenchPathsAmount < LINUX_OBJ_FILES_MAX) {
+            Options->TextureBenchPaths[Options->TextureBenchPathsAmount++] = Value;
+        }
+        else if (strcmp(Arg, "--audio-bench") == 0 && Options->AudioBenchPathsAmount < LINUX_OBJ_FILES_MAX) {
+            Options->AudioBenchPaths[Options->AudioBenchPathsAmount++] = Value;
+        }
+        else if (strcmp(Arg, "--bench-runs") == 0) {
+            Options->BenchRuns = atoi(Value);
+        }
+        else if (strcmp(Arg, "--stream") == 0 && Options->StreamPathsAmount < LINUX_OBJ_FILES_MAX) {
+            Options->StreamPaths[Options->StreamPathsAmount++] = Value;
+        }
+        else if (strcmp(Arg, "--stream-frame") == 0) {
+            Options->StreamFrame = atoi(Value);
+        }
+        else if (strcmp(Arg, "--upload-budget-kb") == 0) {
+            Options->UploadBudgetBytes = (u64)atoll(Value) * 1024;
+        }
+        else if (strcmp(Arg, "--upload-budget-ms") == 0) {
+            Options->UploadBudgetMs = atof(Value);
+        }
+        else if (strcmp(Arg, "--broadphase-bench") == 0) {
+            Options->BroadPhaseBodies = atoi(Value);
+        }
+        else if (strcmp(Arg, "--pile-bench") == 0) {
+            Options->PileBodies = atoi(Value);
+        }
+        else if (strcmp(Arg, "--job-bench") == 0) {
+            Options->JobBenchThreads = atoi(Value);
+        }
+        else {
+            return 0;
+        }
+
+        ++ArgIndex;
+    }
+
+    return Options->FramesAmount > 0 && Options->DeltaTime > 0.0f && Options->BenchRuns > 0 &&
+           Options->StreamFrame >= 0 && Options->UploadBudgetMs >= 0.0;
+}
+
+static bool32 LinuxFileExists(const char* Path)
+{
+    return access(Path, R_OK) == 0;
+}
+
+// NOTE(ismail): player character and its clips, same data PrepareFrame loads, extra tracks share the skin
+static bool32 LinuxLoadCharacters(Platform* Platform, GameContext* Cntx, LinuxOptions* Options)
+{
+    DynamicSceneObjectLoader& Loader = DynamicSceneObjectsName[0];
+
+    bool32 FilesExist = LinuxFileExists(Loader.Mesh.Path);
+    for (i32 AnimIndex = 0; AnimIndex < Loader.Amount; ++AnimIndex) {
+        FilesExist = FilesExist && LinuxFileExists(Loader.Animations[AnimIndex].Path);
+    }
+
+    if (!FilesExist) {
+        printf("characters  skipped, %s or its clips are missing\n", Loader.Mesh.Path);
+
+        return 0;
+    }
+
+    real64 StartTime = Platform->GetWallClock();
+
+    glTF2File       LoadFile    = {};
+    TemporaryMemory LoadMemory  = BeginTemporaryMemory(&Cntx->FrameArena);
+
+    LoadSkeletalCharacter(Platform, Cntx, Loader, &LoadFile);
+
+    CloseCookedMesh(Platform, &LoadFile.Cooked);
+
+    EndTemporaryMemory(LoadMemory);
+
+    for (i32 CharacterIndex = 0; CharacterIndex < Options->CharactersAmount; ++CharacterIndex) {
+        AnimationTrack& Track = PreparePlayerAnimationTrack(Cntx);
+
+        // NOTE(ismail): spread tracks over blend space so they don't sample identical poses
+        real32 x = Options->CharactersAmount > 1 ? 1.5f * (real32)CharacterIndex / (real32)(Options->CharactersAmount - 1) : 0.0f;
+
+        Cntx->AnimSystem.SetActiveTask(Track.Id, 0, x, 0.0f);
+    }
+
+    printf("characters  %d tracks | load %.03f ms | level arena %.02f MB\n",
+           Options->CharactersAmount, (Platform->GetWallClock() - StartTime) * 1000.0,
+           (real64)Cntx->LevelArena.Used / (real64)Megabytes(1));
+
+    return 1;
+}
+
+static void LinuxPushObjBuffers(MemoryArena* Arena, ObjFile* LoadFile)
+{
+    LoadFile->Meshes        = PushArray(Arena, Mesh, LINUX_OBJ_MAX_MESHES);
+    LoadFile->Positions     = PushArray(Arena, vec3, LINUX_OBJ_MAX_ELEMENTS);
+    LoadFile->Normals       = PushArray(Arena, vec3, LINUX_OBJ_MAX_ELEMENTS);
+    LoadFile->TextureCoord  = PushArray(Arena, vec2, LINUX_OBJ_MAX_ELEMENTS);
+    LoadFile->Indices       = PushArray(Arena, u32,  LINUX_OBJ_MAX_ELEMENTS);
+}
+
+static void LinuxLoadObjFiles(Platform* Platform, GameContext* Cntx, LinuxOptions* Options)
+{
+    if (!Options->ObjPathsAmount) {
+        return;
+    }
+
+    ObjFileLoaderFlags LoadFlags = {};
+    LoadFlags.GenerateSmoothNormals = Options->SmoothNormals;
+
+    for (i32 PathIndex = 0; PathIndex < Options->ObjPathsAmount; ++PathIndex) {
+        const char* Path = Options->ObjPaths[PathIndex];
+
+        if (!LinuxFileExists(Path)) {
+            printf("obj         %s is missing\n", Path);
+
+            continue;
+        }
+
+        TemporaryMemory LoadMemory  = BeginTemporaryMemory(&Cntx->FrameArena);
+        ObjFile         LoadFile    = {};
+
+        LinuxPushObjBuffers(&Cntx->FrameArena, &LoadFile);
+
+        real64      StartTime   = Platform->GetWallClock();
+        Statuses    LoadStatus  = LoadObjFile(Path, &LoadFile, LoadFlags);
+        real64      LoadTime    = (Platform->GetWallClock() - StartTime) * 1000.0;
+
+        printf("obj         %s | %s | %.03f ms | %u vertices | %u indices\n",
+               Path, LoadStatus == Statuses::Success ? "ok" : "failed", LoadTime,
+               LoadFile.PositionsCount, LoadFile.IndicesCount);
+
+        EndTemporaryMemory(LoadMemory);
+    }
+}
+
+static bool32 LinuxIsglTF(const char* Path)
+{
+    const char* Extension = strrchr(Path, '.');
+
+    return Extension && (strcmp(Extension, ".gltf") == 0 || strcmp(Extension, ".glb") == 0);
+}
+
+// NOTE(ismail): formats stb_image reads that we ship or test with
+static bool32 LinuxIsImage(const char* Path)
+{
+    const char* Extension = strrchr(Path, '.');
+
+    return Extension && (strcmp(Extension, ".png") == 0 || strcmp(Extension, ".jpg") == 0 || strcmp(Extension, ".jpeg") == 0 ||
+                         strcmp(Extension, ".tga") == 0 || strcmp(Extension, ".bmp") == 0 || strcmp(Extension, ".ppm") == 0);
+}
+
+// NOTE(ismail): skin is read too, glTFRead has no streams only mode. Skin is reused between reads so clips are dropped first
+static void LinuxReadglTFText(GameContext* Cntx, const char* Path, SkeletalComponent* Skin, glTF2File* LoadFile)
+{
+    Skin->Animations.AnimsAmount = 0;
+
+    LoadFile->Animations    = &Skin->Animations;
+    LoadFile->Skelet        = &Skin->Skin;
+
+    glTFRead(Path, &Cntx->FrameArena, &Cntx->FrameArena, LoadFile);
+}
+
+static void LinuxCookMeshes(Platform* Platform, GameContext* Cntx, LinuxOptions* Options)
+{
+    ObjFileLoaderFlags LoadFlags = {};
+    LoadFlags.GenerateSmoothNormals = Options->SmoothNormals;
+
+    SkeletalComponent* Skin = new SkeletalComponent();
+
+    for (i32 PathIndex = 0; PathIndex < Options->CookPathsAmount; ++PathIndex) {
+        const char* Path = Options->CookPaths[PathIndex];
+        char        CookedPath[COOKED_MESH_PATH_MAX];
+
+        if (LinuxIsImage(Path)) {
+            continue;
+        }
+
+        CookedMeshPath(CookedPath, sizeof(CookedPath), Path);
+
+        if (!LinuxFileExists(Path)) {
+            printf("cook        %s is missing\n", Path);
+
+            continue;
+        }
+
+        TemporaryMemory CookMemory  = BeginTemporaryMemory(&Cntx->FrameArena);
+        real64          StartTime   = Platform->GetWallClock();
+        Statuses        CookStatus;
+
+        if (LinuxIsglTF(Path)) {
+            glTF2File LoadFile = {};
+
+            LinuxReadglTFText(Cntx, Path, Skin, &LoadFile);
+
+            CookStatus = CookglTFFile(CookedPath, Path, &Cntx->FrameArena, &LoadFile);
+        }
+        else {
+            ObjFile LoadFile = {};
+
+            LinuxPushObjBuffers(&Cntx->FrameArena, &LoadFile);
+
+            CookStatus = LoadObjFile(Path, &LoadFile, LoadFlags);
+
+            if (CookStatus == Statuses::Success) {
+                CookStatus = CookObjFile(CookedPath, Path, &LoadFile, LoadFlags);
+            }
+        }
+
+        EndTemporaryMemory(CookMemory);
+
+        struct stat CookedStat = {};
+        stat(CookedPath, &CookedStat);
+
+        printf("cook        %s -> %s | %s | %.03f ms | %.02f KB\n",
+               Path, CookedPath, CookStatus == Statuses::Success ? "ok" : "failed",
+               (Platform->GetWallClock() - StartTime) * 1000.0, (real64)CookedStat.st_size / 1024.0);
+    }
+
+    delete Skin;
+}
+
+// NOTE(ismail): clean pages of the file are dropped from page cache, next read goes to disk. Works without root
+static void LinuxDropFileCache(const char* Path)
+{
+    i32 FileHandle = open(Path, O_RDONLY);
+
+    if (FileHandle != -1) {
+        posix_fadvise(FileHandle, 0, 0, POSIX_FADV_DONTNEED);
+        close(FileHandle);
+    }
+}
+
+// NOTE(ismail): one word per cache line, stands in for GPU upload that walks whole buffer and faults mapped pages in
+static u64 LinuxTouchStream(const void* Data, u64 Size)
+{
+    const u8*   Bytes   = (const u8*)Data;
+    u64         Result  = 0;
+
+    for (u64 Offset = 0; Offset + sizeof(u32) <= Size; Offset += 64) {
+        Result += *(const u32*)(Bytes + Offset);
+    }
+
+    return Result;
+}
+
+static u64 LinuxTouchObjFile(ObjFile* LoadFile)
+{
+    u64 Result = 0;
+
+    Result += LinuxTouchStream(LoadFile->Positions,       sizeof(vec3) * LoadFile->PositionsCount);
+    Result += LinuxTouchStream(LoadFile->Normals,         sizeof(vec3) * LoadFile->NormalsCount);
+    Result += LinuxTouchStream(LoadFile->TextureCoord,    sizeof(vec2) * LoadFile->TexturesCount);
+    Result += LinuxTouchStream(LoadFile->Indices,         sizeof(u32)  * LoadFile->IndicesCount);
+
+    return Result;
+}
+
+static u64 LinuxTouchglTFFile(glTF2File* LoadFile)
+{
+    u64 Result = 0;
+
+    for (i32 MeshIndex = 0; MeshIndex < LoadFile->MeshesAmount; ++MeshIndex) {
+        glTF2Mesh* CurrentMesh = &LoadFile->Meshes[MeshIndex];
+
+        for (i32 PrimitiveIndex = 0; PrimitiveIndex < CurrentMesh->PrimitivesAmount; ++PrimitiveIndex) {
+            glTF2Primitives* Primitive = &CurrentMesh->MeshPrimitives[PrimitiveIndex];
+
+            Result += LinuxTouchStream(Primitive->Positions,      sizeof(vec3)  * Primitive->PositionsCount);
+            Result += LinuxTouchStream(Primitive->Normals,        sizeof(vec3)  * Primitive->NormalsCount);
+            Result += LinuxTouchStream(Primitive->TextureCoord,   sizeof(vec2)  * Primitive->TexturesCount);
+            Result += LinuxTouchStream(Primitive->BoneIds,        sizeof(ivec4) * Primitive->BoneIdsCount);
+            Result += LinuxTouchStream(Primitive->BoneWeights,    sizeof(vec4)  * Primitive->BoneWeightsCount);
+            Result += LinuxTouchStream(Primitive->Indices,        sizeof(u32)   * Primitive->IndicesCount);
+        }
+    }
+
+    return Result;
+}
+
+static u64 LinuxBenchTextLoad(GameContext* Cntx, const char* Path, ObjFileLoaderFlags LoadFlags, SkeletalComponent* Skin)
+{
+    TemporaryMemory LoadMemory  = BeginTemporaryMemory(&Cntx->FrameArena);
+    u64             Result;
+
+    if (LinuxIsglTF(Path)) {
+        glTF2File LoadFile = {};
+
+        LinuxReadglTFText(Cntx, Path, Skin, &LoadFile);
+
+        Result = LinuxTouchglTFFile(&LoadFile);
+    }
+    else {
+        ObjFile LoadFile = {};
+
+        LinuxPushObjBuffers(&Cntx->FrameArena, &LoadFile);
+        LoadObjFile(Path, &LoadFile, LoadFlags);
+
+        Result = LinuxTouchObjFile(&LoadFile);
+    }
+
+    EndTemporaryMemory(LoadMemory);
+
+    return Result;
+}
+
+// NOTE(ismail): same work LoadSkeletalCharacter and InitMeshComponent do on cooked path, glTF still reads skin and clips from source
+static u64 LinuxBenchCookedLoad(Platform* Platform, GameContext* Cntx, const char* Path, const char* CookedPath,
+                                ObjFileLoaderFlags LoadFlags, SkeletalComponent* Skin)
+{
+    TemporaryMemory LoadMemory  = BeginTemporaryMemory(&Cntx->FrameArena);
+    u64             Result      = 0;
+
+    if (LinuxIsglTF(Path)) {
+        glTF2File LoadFile = {};
+
+        if (OpenCookedMesh(Platform, CookedPath, Path, 0, &LoadFile.Cooked) == Statuses::Success) {
+            Skin->Animations.AnimsAmount = 0;
+
+            LoadFile.Animations = &Skin->Animations;
+            LoadFile.Skelet     = &Skin->Skin;
+
+            CookedMeshToglTF(&LoadFile.Cooked, &LoadFile);
+            glTFReadSkin(Path, &Cntx->FrameArena, &LoadFile);
+
+            Result = LinuxTouchglTFFile(&LoadFile);
+
+            CloseCookedMesh(Platform, &LoadFile.Cooked);
+        }
+    }
+    else {
+        ObjFile     LoadFile    = {};
+        CookedMesh  Cooked      = {};
+
+        if (OpenCookedMesh(Platform, CookedPath, Path, CookedMeshFlags(LoadFlags), &Cooked) == Statuses::Success) {
+            CookedMeshToObjFile(&Cooked, &LoadFile);
+
+            Result = LinuxTouchObjFile(&LoadFile);
+
+            CloseCookedMesh(Platform, &Cooked);
+        }
+    }
+
+    EndTemporaryMemory(LoadMemory);
+
+    return Result;
+}
+
+// NOTE(ismail): glTF is cooked without loader flags, see LinuxCookMeshes
+static bool32 LinuxCookedMeshUpToDate(Platform* Platform, const char* Path, const char* CookedPath, ObjFileLoaderFlags LoadFlags)
+{
+    CookedMesh Cooked;
+
+    if (OpenCookedMesh(Platform, CookedPath, Path, LinuxIsglTF(Path) ? 0 : CookedMeshFlags(LoadFlags), &Cooked) != Statuses::Success) {
+        return 0;
+    }
+
+    CloseCookedMesh(Platform, &Cooked);
+
+    return 1;
+}
+
+static TEARA_ASSET_UPLOAD(LinuxBenchStreamedMesh)
+{
+    (void)Streamer;
+
+    *(u64*)Asset->Target = LinuxTouchObjFile(&Asset->MeshFile);
+}
+
+// NOTE(ismail): .obj text the way game loads it, parse runs on streaming thread and fans out to pool from there.
+// 0 means streamer failed, mesh is bigger than its buffers
+static u64 LinuxBenchStreamLoad(AssetStreamer* Streamer, const char* Path, ObjFileLoaderFlags LoadFlags)
+{
+    u64 Result = 0;
+
+    AssetStreamRequest Request = {};
+    Request.Kind        = AssetStreamMesh;
+    Request.Path        = Path;
+    Request.Upload      = &LinuxBenchStreamedMesh;
+    Request.Target      = &Result;
+    Request.MeshFlags   = LoadFlags;
+    Request.SkipCooked  = 1;
+
+    if (AssetStreamerSubmit(Streamer, &Request)) {
+        AssetStreamerFlush(Streamer);
+    }
+
+    return Result;
+}
+
+// NOTE(ismail): cold run drops source, .bin next to it and cooked blob from page cache first, warm is best of BenchRuns.
+// Checksums of all paths must match, cooked blob is cooked on the fly when it is missing or stale
+static void LinuxBenchMeshes(Platform* Platform, GameContext* Cntx, LinuxOptions* Options)
+{
+    if (!Options->BenchPathsAmount) {
+        return;
+    }
+
+    ObjFileLoaderFlags LoadFlags = {};
+    LoadFlags.GenerateSmoothNormals = Options->SmoothNormals;
+
+    SkeletalComponent*  Skin        = new SkeletalComponent();
+    AssetStreamer*      Streamer    = new AssetStreamer();
+
+    AssetStreamerInit(Streamer, Platform, 0, 0.0);
+
+    for (i32 PathIndex = 0; PathIndex < Options->BenchPathsAmount; ++PathIndex) {
+        const char* Path = Options->BenchPaths[PathIndex];
+        char        CookedPath[COOKED_MESH_PATH_MAX];
+        char        BufferPath[COOKED_MESH_PATH_MAX];
+
+        CookedMeshPath(CookedPath, sizeof(CookedPath), Path);
+
+        if (!LinuxFileExists(Path)) {
+            printf("mesh-bench  %s is missing\n", Path);
+
+            continue;
+        }
+
+        if (!LinuxCookedMeshUpToDate(Platform, Path, CookedPath, LoadFlags)) {
+            LinuxOptions CookOptions = *Options;
+
+            CookOptions.CookPaths[0]    = Path;
+            CookOptions.CookPathsAmount = 1;
+
+            LinuxCookMeshes(Platform, Cntx, &CookOptions);
+        }
+
+        // NOTE(ismail): glTF exporters put buffers into <name>.bin next to <name>.gltf
+        snprintf(BufferPath, sizeof(BufferPath), "%.*s.bin", (i32)(strrchr(Path, '.') - Path), Path);
+
+        real64 TextColdMs   = 0.0;
+        real64 TextWarmMs   = 1e9;
+        real64 CookedColdMs = 0.0;
+        real64 CookedWarmMs = 1e9;
+        real64 StreamWarmMs = 1e9;
+        u64    StreamSum    = 0;
+
+        LinuxDropFileCache(Path);
+        LinuxDropFileCache(BufferPath);
+
+        real64  StartTime       = Platform->GetWallClock();
+        u64     TextChecksum    = LinuxBenchTextLoad(Cntx, Path, LoadFlags, Skin);
+        TextColdMs              = (Platform->GetWallClock() - StartTime) * 1000.0;
+
+        LinuxDropFileCache(Path);
+        LinuxDropFileCache(BufferPath);
+        LinuxDropFileCache(CookedPath);
+
+        StartTime               = Platform->GetWallClock();
+        u64     CookedChecksum  = LinuxBenchCookedLoad(Platform, Cntx, Path, CookedPath, LoadFlags, Skin);
+        CookedColdMs            = (Platform->GetWallClock() - StartTime) * 1000.0;
+
+        for (i32 Run = 0; Run < Options->BenchRuns; ++Run) {
+            StartTime = Platform->GetWallClock();
+            LinuxBenchTextLoad(Cntx, Path, LoadFlags, Skin);
+            real64 TextMs = (Platform->GetWallClock() - StartTime) * 1000.0;
+
+            StartTime = Platform->GetWallClock();
+            LinuxBenchCookedLoad(Platform, Cntx, Path, CookedPath, LoadFlags, Skin);
+            real64 CookedMs = (Platform->GetWallClock() - StartTime) * 1000.0;
+
+            TextWarmMs      = TextMs < TextWarmMs ? TextMs : TextWarmMs;
+            CookedWarmMs    = CookedMs < CookedWarmMs ? CookedMs : CookedWarmMs;
+
+            if (!LinuxIsglTF(Path)) {
+                StartTime = Platform->GetWallClock();
+                StreamSum = LinuxBenchStreamLoad(Streamer, Path, LoadFlags);
+                real64 StreamMs = (Platform->GetWallClock() - StartTime) * 1000.0;
+
+                StreamWarmMs = StreamMs < StreamWarmMs ? StreamMs : StreamWarmMs;
+            }
+        }
+
+        printf("mesh-bench  %s | text cold %.03f ms warm %.03f ms | cooked cold %.03f ms warm %.03f ms | warm x%.01f | data %s\n",
+               Path, TextColdMs, TextWarmMs, CookedColdMs, CookedWarmMs, TextWarmMs / CookedWarmMs,
+               TextChecksum == CookedChecksum ? "match" : "DIFFERS");
+
+        // NOTE(ismail): main thread text load fans out too, streamer close to it means parse isn't serial on streaming thread
+        if (!LinuxIsglTF(Path) && Options->BenchRuns > 0) {
+            if (StreamSum) {
+                printf("            streamer text warm %.03f ms | x%.02f of main thread text | %d threads | data %s\n",
+                       StreamWarmMs, TextWarmMs / StreamWarmMs, JobSystemThreadsAmount(Platform->Jobs),
+                       StreamSum == TextChecksum ? "match" : "DIFFERS");
+            }
+            else {
+                printf("            streamer text failed, mesh doesn't fit %d elements\n", ASSET_STREAMER_OBJ_MAX_ELEMENTS);
+            }
+        }
+    }
+
+    AssetStreamerShutdown(Streamer);
+
+    delete Streamer;
+    delete Skin;
+}
+
+// NOTE(ismail): stands in for glBufferData / glTexImage2D, driver copies data out of client memory the same way
+static void LinuxStubUpload(LinuxUploadStub* Upload, const void* Data, u64 Size)
+{
+    const u8* Bytes = (const u8*)Data;
+
+    for (u64 Offset = 0; Offset < Size; Offset += LINUX_UPLOAD_SCRATCH_SIZE) {
+        u64 CopySize = Size - Offset < LINUX_UPLOAD_SCRATCH_SIZE ? Size - Offset : LINUX_UPLOAD_SCRATCH_SIZE;
+
+        memcpy(Upload->Scratch, Bytes + Offset, CopySize);
+    }
+
+    Upload->Checksum += LinuxTouchStream(Data, Size) + Size;
+}
+
+// NOTE(ismail): glTexImage2D of decoded level 0 or every mip of cooked chain, glGenerateMipmap runs on GPU and has no stub
+static void LinuxStubTextureUpload(LinuxUploadStub* Upload, TextureFile* Texture)
+{
+    if (!Texture->MipsCount) {
+        LinuxStubUpload(Upload, Texture->Data, TextureFileSize(Texture));
+
+        return;
+    }
+
+    for (i32 MipIndex = 0; MipIndex < Texture->MipsCount; ++MipIndex) {
+        LinuxStubUpload(Upload, Texture->Mips[MipIndex].Data, Texture->Mips[MipIndex].Size);
+    }
+}
+
+static const char* LinuxTextureFormatName(TextureFormat Format)
+{
+    switch (Format) {
+        case TextureFormatR8:       return "R8";
+        case TextureFormatRGBA8:    return "RGBA8";
+        case TextureFormatBC1:      return "BC1";
+        case TextureFormatBC3:      return "BC3";
+        default:                    return "decoded";
+    }
+}
+
+static void LinuxCookTextures(Platform* Platform, LinuxOptions* Options)
+{
+    for (i32 PathIndex = 0; PathIndex < Options->CookPathsAmount; ++PathIndex) {
+        const char* Path = Options->CookPaths[PathIndex];
+        char        CookedPath[COOKED_TEXTURE_PATH_MAX];
+
+        if (!LinuxIsImage(Path)) {
+            continue;
+        }
+
+        CookedTexturePath(CookedPath, sizeof(CookedPath), Path);
+
+        if (!LinuxFileExists(Path)) {
+            printf("cook        %s is missing\n", Path);
+
+            continue;
+        }
+
+        real64          StartTime   = Platform->GetWallClock();
+        TextureFile     Source      = {};
+        TextureFormat   Format      = TextureFormatDecoded;
+        Statuses        CookStatus  = LoadTextureFile(Path, &Source, Options->CookFlip);
+
+        if (CookStatus == Statuses::Success) {
+            Format      = CookedTextureFormat(Source.Channels, !Options->CookUncompressed);
+            CookStatus  = CookTexture(Platform, CookedPath, Path, &Source, Format, Options->CookFlip);
+
+            FreeTextureFile(&Source);
+        }
+
+        struct stat CookedStat = {};
+        stat(CookedPath, &CookedStat);
+
+        printf("cook        %s -> %s | %s | %.03f ms | %.02f KB | %dx%d %s%s\n",
+               Path, CookedPath, CookStatus == Statuses::Success ? "ok" : "failed",
+               (Platform->GetWallClock() - StartTime) * 1000.0, (real64)CookedStat.st_size / 1024.0,
+               Source.Width, Source.Height, LinuxTextureFormatName(Format), Options->CookFlip ? " flipped" : "");
+    }
+}
+
+// NOTE(ismail): what game did before cooking, stb_image decode of source and upload of level 0
+static u64 LinuxBenchSourceTexture(const char* Path, bool32 VerticalFlip, TextureFile* Info)
+{
+    TextureFile Texture = {};
+    u64         Result  = 0;
+
+    if (LoadTextureFile(Path, &Texture, VerticalFlip) == Statuses::Success) {
+        LinuxStubTextureUpload(&LinuxApp.Upload, &Texture);
+
+        Result  = TextureFileSize(&Texture);
+        *Info   = Texture;
+
+        FreeTextureFile(&Texture);
+    }
+
+    return Result;
+}
+
+static u64 LinuxBenchCookedTexture(Platform* Platform, const char* Path, const char* CookedPath, bool32 VerticalFlip, TextureFile* Info)
+{
+    CookedTexture   Cooked  = {};
+    u64             Result  = 0;
+
+    if (OpenCookedTexture(Platform, CookedPath, Path, VerticalFlip, &Cooked) == Statuses::Success) {
+        CookedTextureToTextureFile(&Cooked, Info);
+        LinuxStubTextureUpload(&LinuxApp.Upload, Info);
+
+        Result = TextureFileSize(Info);
+
+        CloseCookedTexture(Platform, &Cooked);
+    }
+
+    return Result;
+}
+
+static bool32 LinuxCookedTextureUpToDate(Platform* Platform, const char* Path, const char* CookedPath, bool32 VerticalFlip)
+{
+    CookedTexture Cooked;
+
+    if (OpenCookedTexture(Platform, CookedPath, Path, VerticalFlip, &Cooked) != Statuses::Success) {
+        return 0;
+    }
+
+    CloseCookedTexture(Platform, &Cooked);
+
+    return 1;
+}
+
+// NOTE(ismail): cold run drops source and cooked blob from page cache first, warm is best of BenchRuns. Source GPU size assumes
+// driver keeps GL_RGB as RGBA8 and GL_RED as R8 plus a third for generated mips, cooked GPU size is exactly what is uploaded.
+// Cooked blob is cooked on the fly when it is missing or stale
+static void LinuxBenchTextures(Platform* Platform, LinuxOptions* Options)
+{
+    if (!LinuxApp.Upload.Scratch) {
+        LinuxApp.Upload.Scratch = (u8*)Platform->AllocMem(LINUX_UPLOAD_SCRATCH_SIZE);
+    }
+
+    for (i32 PathIndex = 0; PathIndex < Options->TextureBenchPathsAmount; ++PathIndex) {
+        const char* Path = Options->TextureBenchPaths[PathIndex];
+        char        CookedPath[COOKED_TEXTURE_PATH_MAX];
+
+        CookedTexturePath(CookedPath, sizeof(CookedPath), Path);
+
+        if (!LinuxFileExists(Path)) {
+            printf("texture-bench %s is missing\n", Path);
+
+            continue;
+        }
+
+        if (!LinuxCookedTextureUpToDate(Platform, Path, CookedPath, Options->CookFlip)) {
+            LinuxOptions CookOptions = *Options;
+
+            CookOptions.CookPaths[0]    = Path;
+            CookOptions.CookPathsAmount = 1;
+
+            LinuxCookTextures(Platform, &CookOptions);
+        }
+
+        TextureFile SourceInfo  = {};
+        TextureFile CookedInfo  = {};
+
+        LinuxDropFileCache(Path);
+
+        real64  StartTime       = Platform->GetWallClock();
+        u64     SourceBytes     = LinuxBenchSourceTexture(Path, Options->CookFlip, &SourceInfo);
+        real64  SourceColdMs    = (Platform->GetWallClock() - StartTime) * 1000.0;
+
+        LinuxDropFileCache(CookedPath);
+
+        StartTime               = Platform->GetWallClock();
+        u64     CookedBytes     = LinuxBenchCookedTexture(Platform, Path, CookedPath, Options->CookFlip, &CookedInfo);
+        real64  CookedColdMs    = (Platform->GetWallClock() - StartTime) * 1000.0;
+
+        real64  SourceWarmMs    = 1e9;
+        real64  CookedWarmMs    = 1e9;
+
+        for (i32 Run = 0; Run < Options->BenchRuns; ++Run) {
+            StartTime = Platform->GetWallClock();
+            LinuxBenchSourceTexture(Path, Options->CookFlip, &SourceInfo);
+            real64 SourceMs = (Platform->GetWallClock() - StartTime) * 1000.0;
+
+            StartTime = Platform->GetWallClock();
+            LinuxBenchCookedTexture(Platform, Path, CookedPath, Options->CookFlip, &CookedInfo);
+            real64 CookedMs = (Platform->GetWallClock() - StartTime) * 1000.0;
+
+            SourceWarmMs = SourceMs < SourceWarmMs ? SourceMs : SourceWarmMs;
+            CookedWarmMs = CookedMs < CookedWarmMs ? CookedMs : CookedWarmMs;
+        }
+
+        if (!SourceBytes || !CookedBytes) {
+            printf("texture-bench %s | failed to decode source or open %s\n", Path, CookedPath);
+
+            continue;
+        }
+
+        u64 SourceTexelBytes    = SourceInfo.Channels == 1 ? 1 : 4;
+        u64 SourceGPUBytes      = (u64)SourceInfo.Width * (u64)SourceInfo.Height * SourceTexelBytes * 4 / 3;
+
+        printf("texture-bench %s | %dx%d %s %d mips\n", Path, CookedInfo.Width, CookedInfo.Height,
+               LinuxTextureFormatName(CookedInfo.Format), CookedInfo.MipsCount);
+        printf("              source cold %.03f ms warm %.03f ms | decoded %.02f MB | GPU %.02f MB with generated mips\n",
+               SourceColdMs, SourceWarmMs, (real64)SourceBytes / (real64)Megabytes(1), (real64)SourceGPUBytes / (real64)Megabytes(1));
+        printf("              cooked cold %.03f ms warm %.03f ms | mapped %.02f MB | GPU %.02f MB | warm x%.01f | memory x%.01f\n",
+               CookedColdMs, CookedWarmMs, (real64)CookedBytes / (real64)Megabytes(1), (real64)CookedBytes / (real64)Megabytes(1),
+               SourceWarmMs / CookedWarmMs, (real64)SourceGPUBytes / (real64)CookedBytes);
+    }
+}
+
+// NOTE(ismail): every byte goes in, so PCM split into chunks hashes the same as PCM decoded at once
+static u64 LinuxHashBytes(u64 Hash, const void* Data, u64 Size)
+{
+    const u8* Bytes = (const u8*)Data;
+
+    for (u64 Offset = 0; Offset < Size; ++Offset) {
+        Hash = (Hash ^ Bytes[Offset]) * 0x100000001B3ull;
+    }
+
+    return Hash;
+}
+
+// NOTE(ismail): main thread side of streamed playback, spins where game would just try again next frame.
+// Returns frames consumed, stops after FramesLimit or at last chunk of track
+static u64 LinuxConsumeAudioStream(AudioStreamer* Streamer, i32 Stream, u64 FramesLimit, u64* Hash, bool32* EndSeen)
+{
+    u64 Result = 0;
+
+    *EndSeen = 0;
+
+    while (Result < FramesLimit && !*EndSeen) {
+        AudioStreamChunk* Chunk = AudioStreamPeek(Streamer, Stream);
+
+        if (!Chunk) {
+            std::this_thread::yield();
+
+            continue;
+        }
+
+        *Hash   = LinuxHashBytes(*Hash, Chunk->Data, Chunk->Size);
+        *EndSeen = Chunk->Last;
+        Result  += Chunk->Frames;
+
+        AudioStreamPop(Streamer, Stream);
+    }
+
+    return Result;
+}
+
+// NOTE(ismail): whole file decode needs memory for entire track, streamer needs AUDIO_STREAMER_MEMORY_SIZE for all streams.
+// Streamed PCM must hash the same as whole file one, looped stream must run past track end without reporting it.
+// Streamed time includes hashing on main thread, whole file hash is taken after its timer stops
+static void LinuxBenchAudio(Platform* Platform, LinuxOptions* Options)
+{
+    if (!Options->AudioBenchPathsAmount) {
+        return;
+    }
+
+    void*           StreamerMemory  = Platform->AllocMem(AUDIO_STREAMER_MEMORY_SIZE);
+    AudioStreamer*  Streamer        = new AudioStreamer();
+
+    AudioStreamerInit(Streamer, StreamerMemory, AUDIO_STREAMER_MEMORY_SIZE);
+
+    for (i32 PathIndex = 0; PathIndex < Options->AudioBenchPathsAmount; ++PathIndex) {
+        const char*     Path        = Options->AudioBenchPaths[PathIndex];
+        const char*     Extension   = strrchr(Path, '.');
+        AudioFormat     Fmt         = Extension && strcmp(Extension, ".flac") == 0 ? AudioFormat::FLAC : AudioFormat::WAV;
+        AudioDecoder    Decoder     = {};
+
+        if (!AudioDecoderOpen(Path, Fmt, 1, &Decoder)) {
+            printf("audio-bench %s | can't open\n", Path);
+
+            continue;
+        }
+
+        AudioDecoderClose(&Decoder);
+
+        u64     WholeSize   = (u64)AudioDecoderFrameSize(&Decoder) * Decoder.TotalFrames;
+        void*   WholeMemory = Platform->AllocMem(WholeSize);
+
+        AudioFile Sound = {};
+        Sound.Fmt       = Fmt;
+
+        real64  StartTime   = Platform->GetWallClock();
+        bool32  WholeLoaded = LoadSound(Path, WholeMemory, WholeSize, &Sound, 1);
+        real64  WholeMs     = (Platform->GetWallClock() - StartTime) * 1000.0;
+        u64     WholeHash   = LinuxHashBytes(0xCBF29CE484222325ull, Sound.Buffer, Sound.Size);
+
+        Platform->ReleaseMem(WholeMemory);
+
+        u64     StreamHash  = 0xCBF29CE484222325ull;
+        bool32  EndSeen     = 0;
+        real64  FirstMs     = 0.0;
+        u64     Frames      = 0;
+
+        StartTime = Platform->GetWallClock();
+
+        i32 Stream = AudioStreamOpen(Streamer, Path, Fmt, 1, 0);
+
+        if (Stream >= 0) {
+            while (!AudioStreamPeek(Streamer, Stream)) {
+                std::this_thread::yield();
+            }
+
+            FirstMs = (Platform->GetWallClock() - StartTime) * 1000.0;
+            Frames  = LinuxConsumeAudioStream(Streamer, Stream, ~0ull, &StreamHash, &EndSeen);
+
+            AudioStreamClose(Streamer, Stream);
+        }
+
+        real64  StreamMs    = (Platform->GetWallClock() - StartTime) * 1000.0;
+        u64     LoopHash    = 0;
+        bool32  LoopEndSeen = 1;
+        u64     LoopFrames  = 0;
+
+        Stream = AudioStreamOpen(Streamer, Path, Fmt, 1, 1);
+
+        if (Stream >= 0) {
+            LoopFrames = LinuxConsumeAudioStream(Streamer, Stream, Decoder.TotalFrames * 2 + 1, &LoopHash, &LoopEndSeen);
+
+            AudioStreamClose(Streamer, Stream);
+        }
+
+        if (!WholeLoaded || Stream < 0) {
+            printf("audio-bench %s | failed to decode\n", Path);
+
+            continue;
+        }
+
+        real64 Seconds = (real64)Decoder.TotalFrames / (real64)Decoder.SampleRate;
+
+        printf("audio-bench %s | %u ch %u Hz %.01f s\n", Path, Decoder.Channels, Decoder.SampleRate, Seconds);
+        printf("            whole file %.03f ms | %.02f MB decoded\n", WholeMs, (real64)WholeSize / (real64)Megabytes(1));
+        printf("            streamed %.03f ms | first chunk %.03f ms | %.02f MB for %d streams | frames %s | PCM %s | loop %s\n",
+               StreamMs, FirstMs, (real64)AUDIO_STREAMER_MEMORY_SIZE / (real64)Megabytes(1), AUDIO_STREAMER_MAX_STREAMS,
+               Frames == Decoder.TotalFrames && EndSeen ? "match" : "MISMATCH",
+               StreamHash == WholeHash ? "match" : "MISMATCH",
+               !LoopEndSeen && LoopFrames > Decoder.TotalFrames * 2 ? "wraps" : "BROKEN");
+    }
+
+    AudioStreamerShutdown(Streamer);
+
+    delete Streamer;
+
+    Platform->ReleaseMem(StreamerMemory);
+}
+
+// NOTE(ismail): handles are fake, cache only needs them to be unique and non zero
+static TEARA_TEXTURE_CREATE(LinuxCreateStreamedTexture)
+{
+    (void)Variant;
+
+    LinuxStubTextureUpload(&LinuxApp.Upload, Texture);
+
+    return ++LinuxApp.Upload.TexturesCreated;
+}
+
+static TEARA_TEXTURE_DESTROY(LinuxDestroyStreamedTexture)
+{
+    (void)Handle;
+
+    ++LinuxApp.Upload.TexturesDestroyed;
+}
+
+static TEARA_TEXTURE_BIND(LinuxBindStreamedTexture)
+{
+    (void)Target;
+    (void)TargetSlot;
+
+    LinuxApp.Upload.Checksum += Handle;
+}
+
+// NOTE(ismail): material textures are chained like UploadStreamedMesh in Game.cpp does
+static TEARA_ASSET_UPLOAD(LinuxUploadStreamedMesh)
+{
+    ObjFile&        LoadFile    = Asset->MeshFile;
+    TextureCache*   Textures    = &((GameContext*)Streamer->UserData)->Textures;
+
+    LinuxStubUpload(&LinuxApp.Upload, LoadFile.Positions,       sizeof(vec3) * LoadFile.PositionsCount);
+    LinuxStubUpload(&LinuxApp.Upload, LoadFile.TextureCoord,    sizeof(vec2) * LoadFile.TexturesCount);
+    LinuxStubUpload(&LinuxApp.Upload, LoadFile.Normals,         sizeof(vec3) * LoadFile.NormalsCount);
+    LinuxStubUpload(&LinuxApp.Upload, LoadFile.Indices,         sizeof(u32)  * LoadFile.IndicesCount);
+
+    for (u32 MeshIndex = 0; MeshIndex < LoadFile.MeshesCount; ++MeshIndex) {
+        Material* CurrentMaterial = &LoadFile.Meshes[MeshIndex].Material;
+
+        if (CurrentMaterial->HaveTexture) {
+            TextureCacheRequest(Textures, CurrentMaterial->TextureFilePath, 0, 1, &LinuxBindStreamedTexture, 0, 0);
+        }
+
+        if (CurrentMaterial->HaveSpecularExponent) {
+            TextureCacheRequest(Textures, CurrentMaterial->SpecularExpFilePath, 1, 1, &LinuxBindStreamedTexture, 0, 0);
+        }
+    }
+}
+
+static bool32 LinuxIsObj(const char* Path)
+{
+    const char* Extension = strrchr(Path, '.');
+
+    return Extension && strcmp(Extension, ".obj") == 0;
+}
+
+// NOTE(ismail): with --sync-load frame waits for everything like PrepareFrame did before streamer, worst frame shows the difference
+static void LinuxSubmitStreamedAssets(AssetStreamer* Streamer, TextureCache* Textures, LinuxOptions* Options)
+{
+    ObjFileLoaderFlags LoadFlags = {};
+    LoadFlags.GenerateSmoothNormals = Options->SmoothNormals;
+
+    for (i32 PathIndex = 0; PathIndex < Options->StreamPathsAmount; ++PathIndex) {
+        const char* Path        = Options->StreamPaths[PathIndex];
+        bool32      Submitted   = 0;
+
+        if (LinuxIsObj(Path)) {
+            AssetStreamRequest Request = {};
+
+            Request.Kind        = AssetStreamMesh;
+            Request.Path        = Path;
+            Request.Upload      = &LinuxUploadStreamedMesh;
+            Request.MeshFlags   = LoadFlags;
+
+            Submitted = AssetStreamerSubmit(Streamer, &Request);
+        }
+        else {
+            Submitted = TextureCacheRequest(Textures, Path, 0, 0, &LinuxBindStreamedTexture, 0, 0);
+        }
+
+        if (!Submitted) {
+            printf("stream      %s dropped, all %d slots are busy or texture failed before\n", Path, ASSET_STREAMER_MAX_ASSETS);
+        }
+    }
+
+    if (Options->SyncLoad) {
+        AssetStreamerFlush(Streamer);
+    }
+}
+
+// NOTE(ismail): ground plus a grid of boxes and spheres dropped in layers
+static void LinuxPreparePhysics(GameContext* Cntx, RigidBodyWorld* World, i32 BodiesAmount)
+{
+    i32 MaxBodies       = BodiesAmount + 1;
+    i32 MaxManifolds    = MaxBodies * 4;
+
+    RigidBodyWorldInit(World, PushSize(&Cntx->LevelArena, RigidBodyWorldMemorySize(MaxBodies, MaxManifolds)), MaxBodies, MaxManifolds);
+
+    BoundingVolume Ground = {};
+    Ground.VolumeType                   = AABBVolume;
+    Ground.VolumeData.AxisBox.Center    = { 0.0f, -1.0f, 0.0f };
+    Ground.VolumeData.AxisBox.Extens    = { 500.0f, 1.0f, 500.0f };
+
+    RigidBodyAdd(World, &Ground, quat(1.0f, 0.0f, 0.0f, 0.0f), 0.0f);
+
+    i32 Side = 1;
+    while (Side * Side * Side < BodiesAmount) {
+        ++Side;
+    }
+
+    for (i32 BodyIndex = 0; BodyIndex < BodiesAmount; ++BodyIndex) {
+        i32 Column  = BodyIndex % (Side * Side);
+        i32 Layer   = BodyIndex / (Side * Side);
+
+        vec3 Center = {
+            ((real32)(Column % Side) - 0.5f * (real32)Side) * 1.5f + (Layer & 1) * 0.25f,
+            1.0f + (real32)Layer * 1.5f,
+            ((real32)(Column / Side) - 0.5f * (real32)Side) * 1.5f,
+        };
+
+        BoundingVolume Shape = {};
+
+        if (BodyIndex & 1) {
+            Shape.VolumeType                        = OBBVolume;
+            Shape.VolumeData.OrientedBox.Center     = Center;
+            Shape.VolumeData.OrientedBox.Extens     = { 0.5f, 0.5f, 0.5f };
+        }
+        else {
+            Shape.VolumeType                    = SphereVolume;
+            Shape.VolumeData.Sphere.Center      = Center;
+            Shape.VolumeData.Sphere.Radius      = 0.5f;
+        }
+
+        RigidBodyAdd(World, &Shape, quat(DEGREE_TO_RAD((real32)(BodyIndex % 90)), vec3{ 0.0f, 1.0f, 0.0f }), 1.0f);
+    }
+}
+
+static inline void LinuxAccumulateTime(LinuxSubsystemTime* Time, real64 Ms)
+{
+    Time->TotalMs += Ms;
+
+    if (Ms < Time->MinMs) {
+        Time->MinMs = Ms;
+    }
+    if (Ms > Time->MaxMs) {
+        Time->MaxMs = Ms;
+    }
+}
+
+static inline void LinuxPrintTime(const char* Name, LinuxSubsystemTime* Time, i32 FramesAmount)
+{
+    printf("%-11s avg %.04f ms | min %.04f ms | max %.04f ms\n",
+           Name, Time->TotalMs / (real64)FramesAmount, Time->MinMs, Time->MaxMs);
+}
+
+#include "LinuxBench.cpp"
+
+int main(int ArgsAmount, char** Args)
+{
+    LinuxOptions Options;
+
+    if (!LinuxParseOptions(ArgsAmount, Args, &Options)) {
+        LinuxPrintUsage(Args[0]);
+
+        return Statuses::Failed;
+    }
+
+    LinuxPlatformInit(&Options);
+
+    Platform* EnginePlatform = &LinuxApp.EnginePlatformDetails;
+
+    if (Options.InputPath && LinuxLoadScript(EnginePlatform, Options.InputPath, &LinuxApp.Script) != Statuses::Success) {
+        fprintf(stderr, "can't read input script %s\n", Options.InputPath);
+
+        return Statuses::FileLoadFailed;
+    }
+
+    GameContext* Context = new GameContext();
+
+    InitGameMemory(EnginePlatform, Context);
+
+    if (Options.ObjPathsAmount || Options.CookPathsAmount || Options.BenchPathsAmount || Options.StreamPathsAmount) {
+        AssetsLoaderVars AssetsLoadVars;
+        AssetsLoadVars.AssetsLoaderCacheSize = 100000;
+        AssetsLoaderInit(EnginePlatform, &AssetsLoadVars);
+    }
+
+    // NOTE(ismail): cook and bench are offline modes, simulation doesn't run after them
+    if (Options.CookPathsAmount || Options.BenchPathsAmount || Options.TextureBenchPathsAmount || Options.AudioBenchPathsAmount ||
+        LinuxBenchRequested(&Options)) {
+        LinuxCookMeshes(EnginePlatform, Context, &Options);
+        LinuxCookTextures(EnginePlatform, &Options);
+        LinuxBenchMeshes(EnginePlatform, Context, &Options);
+        LinuxBenchTextures(EnginePlatform, &Options);
+        LinuxBenchAudio(EnginePlatform, &Options);
+
+        bool32 Passed = LinuxRunBenches(EnginePlatform, &Options);
+
+        JobSystemShutdown(&LinuxApp.Jobs);
+
+        return Passed ? Statuses::Success : Statuses::Failed;
+    }
+
+    if (Options.LoadCharacters) {
+        LinuxLoadCharacters(EnginePlatform, Context, &Options);
+    }
+
+    LinuxLoadObjFiles(EnginePlatform, Context, &Options);
+
+    PrepareParticles(Context, Options.ParticleRate);
+
+    RigidBodyWorld Physics = {};
+    if (Options.BodiesAmount > 0) {
+        LinuxPreparePhysics(Context, &Physics, Options.BodiesAmount);
+    }
+
+    Context->DeltaTimeSec = Options.DeltaTime;
+
+    AssetStreamer*  Streamer        = &Context->Streamer;
+    i32             StreamDoneFrame = -1;
+
+    if (Options.StreamPathsAmount) {
+        LinuxApp.Upload.Scratch = (u8*)EnginePlatform->AllocMem(LINUX_UPLOAD_SCRATCH_SIZE);
+
+        AssetStreamerInit(Streamer, EnginePlatform, Options.UploadBudgetBytes, Options.UploadBudgetMs);
+        TextureCacheInit(&Context->Textures, Streamer, &LinuxCreateStreamedTexture, &LinuxDestroyStreamedTexture);
+
+        Streamer->UserData = Context;
+    }
+
+    LinuxSubsystemTime FrameTime    = { 0.0, 1e9, 0.0 };
+    LinuxSubsystemTime AnimTime     = { 0.0, 1e9, 0.0 };
+    LinuxSubsystemTime ParticleTime = { 0.0, 1e9, 0.0 };
+    LinuxSubsystemTime PhysicsTime  = { 0.0, 1e9, 0.0 };
+
+    i64 SteadyHeapAllocations = 0;
+
+    real64 RunStartTime = EnginePlatform->GetWallClock();
+
+    for (i32 FrameIndex = 0; FrameIndex < Options.FramesAmount && EnginePlatform->Running; ++FrameIndex) {
+        real64 FrameStartTime = EnginePlatform->GetWallClock();
+
+        MemoryCountersSnapshot FrameStartCounters = BeginFrameMemory(Context);
+
+        LinuxTakeScriptedInput(EnginePlatform, &LinuxApp.Script, FrameIndex);
+
+        if (Options.StreamPathsAmount) {
+            if (FrameIndex == Options.StreamFrame) {
+                LinuxSubmitStreamedAssets(Streamer, &Context->Textures, &Options);
+            }
+
+            AssetStreamerUpload(Streamer);
+
+            if (FrameIndex >= Options.StreamFrame && StreamDoneFrame < 0 && Streamer->InFlight == 0) {
+                StreamDoneFrame = FrameIndex;
+            }
+        }
+
+        SimulateFrame(EnginePlatform, Context);
+
+        real64 PhysicsStartTime = EnginePlatform->GetWallClock();
+
+        if (Physics.BodiesAmount) {
+            RigidBodyWorldStep(&Physics, Context->DeltaTimeSec);
+        }
+
+        real64 FrameEndTime = EnginePlatform->GetWallClock();
+
+        EndFrameMemory(Context, FrameStartCounters);
+
+        LinuxAccumulateTime(&FrameTime, (FrameEndTime - FrameStartTime) * 1000.0);
+        LinuxAccumulateTime(&AnimTime, Context->AnimSystem.GetUpdateStats().UpdateTimeMs);
+        LinuxAccumulateTime(&ParticleTime, Context->Particles.Stats.UpdateTimeMs);
+        LinuxAccumulateTime(&PhysicsTime, (FrameEndTime - PhysicsStartTime) * 1000.0);
+
+        // NOTE(ismail): first frame may grow deque and std containers, later frames are expected to allocate nothing
+        if (FrameIndex > 0) {
+            SteadyHeapAllocations += Context->FrameMemory.HeapAllocations + Context->FrameMemory.PlatformAllocations;
+        }
+    }
+
+    real64 RunTime = EnginePlatform->GetWallClock() - RunStartTime;
+
+    JobWorkerStats JobStats;
+    JobSystemCollectStats(&LinuxApp.Jobs, &JobStats);
+
+    // NOTE(ismail): run may end before streaming does, rest is uploaded here so checksum is complete
+    bool32 StreamFinished = Streamer->InFlight == 0;
+
+    if (Options.StreamPathsAmount) {
+        AssetStreamerFlush(Streamer);
+        AssetStreamerShutdown(Streamer);
+    }
+
+    printf("run         %d frames | %.03f s | %.01f frames/s | dt %.04f s | %d workers\n",
+           Options.FramesAmount, RunTime, (real64)Options.FramesAmount / RunTime,
+           Options.DeltaTime, JobSystemThreadsAmount(&LinuxApp.Jobs));
+    LinuxPrintTime("frame", &FrameTime, Options.FramesAmount);
+    LinuxPrintTime("animation", &AnimTime, Options.FramesAmount);
+    LinuxPrintTime("particles", &ParticleTime, Options.FramesAmount);
+    LinuxPrintTime("physics", &PhysicsTime, Options.FramesAmount);
+    printf("state       %d tracks | %d particles | %d bodies | %d contacts | blend x %.03f\n",
+           Context->AnimSystem.GetUpdateStats().TracksAmount, Context->Particles.Amount,
+           Physics.BodiesAmount, Physics.Stats.ContactsAmount, Context->BlendingX);
+    printf("jobs        %lld executed | %lld stolen | %lld run inline on full deque\n", (long long)JobStats.Executed,
+           (long long)JobStats.Stolen, (long long)JobStats.Inlined);
+    printf("memory      %lld allocations after first frame | frame arena peak %.02f MB | level arena %.02f MB\n",
+           (long long)SteadyHeapAllocations, (real64)Context->FrameArena.MaxUsed / (real64)Megabytes(1),
+           (real64)Context->LevelArena.Used / (real64)Megabytes(1));
+
+    if (Options.StreamPathsAmount) {
+        AssetStreamerStats& StreamStats = Streamer->Stats;
+
+        printf("stream      %s | %lld uploaded | %lld failed | %.02f MB | budget %llu KB %.02f ms | done %s frame %d\n",
+               Options.SyncLoad ? "sync" : "streamed", (long long)StreamStats.Uploaded, (long long)StreamStats.Failed,
+               (real64)StreamStats.UploadedBytes / (real64)Megabytes(1),
+               (unsigned long long)(Options.UploadBudgetBytes / 1024), Options.UploadBudgetMs,
+               StreamFinished ? "at" : "after last", StreamFinished ? StreamDoneFrame : Options.FramesAmount);
+        printf("upload      load %.03f ms summed over assets | upload %.03f ms | worst upload frame %.03f ms %.02f MB | checksum %016llx\n",
+               StreamStats.LoadMs, StreamStats.UploadMs, StreamStats.MaxUploadMs,
+               (real64)StreamStats.MaxUploadBytes / (real64)Megabytes(1), (unsigned long long)LinuxApp.Upload.Checksum);
+
+        TextureCacheStats& TextureStats = Context->Textures.Stats;
+
+        printf("textures    %lld requests | %lld path hits | %lld content hits | %lld misses | %lld failed | %.02f MB saved | %.02f MB uploaded | %d live\n",
+               (long long)TextureStats.Requests, (long long)TextureStats.PathHits, (long long)TextureStats.ContentHits,
+               (long long)TextureStats.Misses, (long long)TextureStats.Failed,
+               (real64)TextureStats.BytesSaved / (real64)Megabytes(1), (real64)TextureStats.BytesUploaded / (real64)Megabytes(1),
+               TextureStats.Textures);
+    }
+
+    JobSystemShutdown(&LinuxApp.Jobs);
+
+    return Statuses::Success;
+}
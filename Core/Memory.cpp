@@ -0,0 +1,150 @@
+#include <new>
+#include <stdlib.h>
+
+#include "Memory.h"
+
+MemoryCounters GlobalMemoryCounters;
+
+static inline void CountHeapAllocation(size_t Size)
+{
+    GlobalMemoryCounters.HeapAllocations.fetch_add(1, std::memory_order_relaxed);
+    GlobalMemoryCounters.HeapBytes.fetch_add((i64)Size, std::memory_order_relaxed);
+}
+
+void* CountedMalloc(size_t Size)
+{
+    CountHeapAllocation(Size);
+
+    return malloc(Size);
+}
+
+void* CountedRealloc(void* Ptr, size_t Size)
+{
+    CountHeapAllocation(Size);
+
+    return realloc(Ptr, Size);
+}
+
+void CountedFree(void* Ptr)
+{
+    free(Ptr);
+}
+
+void* CountedMallocCallback(void* UserData, size_t Size)
+{
+    (void)UserData;
+
+    return CountedMalloc(Size);
+}
+
+void CountedFreeCallback(void* UserData, void* Ptr)
+{
+    (void)UserData;
+
+    CountedFree(Ptr);
+}
+
+// NOTE(ismail): global operator new is replaced only to count heap traffic, storage still comes from malloc
+static void* CountedHeapAllocate(size_t Size)
+{
+    CountHeapAllocation(Size);
+
+    void* Result = malloc(Size ? Size : 1);
+
+    if (!Result) {
+        throw std::bad_alloc();
+    }
+
+    return Result;
+}
+
+void* operator new(size_t Size)
+{
+    return CountedHeapAllocate(Size);
+}
+
+void* operator new[](size_t Size)
+{
+    return CountedHeapAllocate(Size);
+}
+
+void operator delete(void* Ptr) noexcept
+{
+    free(Ptr);
+}
+
+void operator delete[](void* Ptr) noexcept
+{
+    free(Ptr);
+}
+
+void operator delete(void* Ptr, size_t) noexcept
+{
+    free(Ptr);
+}
+
+void operator delete[](void* Ptr, size_t) noexcept
+{
+    free(Ptr);
+}
+
+// NOTE(ismail): over-aligned types (alignas bigger than 16) come here, MSVC can't free them with free()
+static void* CountedHeapAllocateAligned(size_t Size, std::align_val_t Alignment)
+{
+    CountHeapAllocation(Size);
+
+#if defined(_MSC_VER)
+    void* Result = _aligned_malloc(Size ? Size : 1, (size_t)Alignment);
+#else
+    void* Result = 0;
+
+    if (posix_memalign(&Result, (size_t)Alignment, Size ? Size : 1) != 0) {
+        Result = 0;
+    }
+#endif
+
+    if (!Result) {
+        throw std::bad_alloc();
+    }
+
+    return Result;
+}
+
+static void CountedHeapFreeAligned(void* Ptr)
+{
+#if defined(_MSC_VER)
+    _aligned_free(Ptr);
+#else
+    free(Ptr);
+#endif
+}
+
+void* operator new(size_t Size, std::align_val_t Alignment)
+{
+    return CountedHeapAllocateAligned(Size, Alignment);
+}
+
+void* operator new[](size_t Size, std::align_val_t Alignment)
+{
+    return CountedHeapAllocateAligned(Size, Alignment);
+}
+
+void operator delete(void* Ptr, std::align_val_t) noexcept
+{
+    CountedHeapFreeAligned(Ptr);
+}
+
+void operator delete[](void* Ptr, std::align_val_t) noexcept
+{
+    CountedHeapFreeAligned(Ptr);
+}
+
+void operator delete(void* Ptr, size_t, std::align_val_t) noexcept
+{
+    CountedHeapFreeAligned(Ptr);
+}
+
+void operator delete[](void* Ptr, size_t, std::align_val_t) noexcept
+{
+    CountedHeapFreeAligned(Ptr);
+}
@@ -0,0 +1,163 @@
+#ifndef _TEARA_CORE_MEMORY_H_
+#define _TEARA_CORE_MEMORY_H_
+
+#include <atomic>
+#include <string.h>
+
+#include "Types.h"
+#include "Debug.h"
+
+#define Kilobytes(Value)    ((u64)(Value) * 1024)
+#define Megabytes(Value)    (Kilobytes(Value) * 1024)
+#define Gigabytes(Value)    (Megabytes(Value) * 1024)
+
+#define ARENA_DEFAULT_ALIGNMENT (16)
+
+// NOTE(ismail): linear allocator over one block, nothing is freed separately.
+// Whole arena is dropped by ArenaReset, nested scratch by Begin/EndTemporaryMemory
+struct MemoryArena {
+    u8*     Base;
+    u64     Size;
+    u64     Used;
+    u64     MaxUsed;
+    i32     TemporaryCount;
+};
+
+struct TemporaryMemory {
+    MemoryArena*    Arena;
+    u64             Used;
+};
+
+inline void ArenaInit(MemoryArena* Arena, void* Base, u64 Size)
+{
+    Assert(Base);
+
+    Arena->Base             = (u8*)Base;
+    Arena->Size             = Size;
+    Arena->Used             = 0;
+    Arena->MaxUsed          = 0;
+    Arena->TemporaryCount   = 0;
+}
+
+inline void* PushSize_(MemoryArena* Arena, u64 Size, u64 Alignment = ARENA_DEFAULT_ALIGNMENT)
+{
+    Assert((Alignment & (Alignment - 1)) == 0);
+
+    u64 Address         = (u64)(Arena->Base + Arena->Used);
+    u64 AlignmentOffset = (Alignment - (Address & (Alignment - 1))) & (Alignment - 1);
+
+    Assert(Arena->Used + AlignmentOffset + Size <= Arena->Size); // NOTE(ismail): arena is out of memory
+
+    void* Result = Arena->Base + Arena->Used + AlignmentOffset;
+
+    Arena->Used += AlignmentOffset + Size;
+
+    if (Arena->Used > Arena->MaxUsed) {
+        Arena->MaxUsed = Arena->Used;
+    }
+
+    return Result;
+}
+
+#define PushStruct(Arena, type, ...)            ((type*)PushSize_((Arena), sizeof(type), ##__VA_ARGS__))
+#define PushArray(Arena, type, Count, ...)      ((type*)PushSize_((Arena), sizeof(type) * (u64)(Count), ##__VA_ARGS__))
+#define PushSize(Arena, Size, ...)              PushSize_((Arena), (Size), ##__VA_ARGS__)
+
+inline void* PushSizeZero(MemoryArena* Arena, u64 Size, u64 Alignment = ARENA_DEFAULT_ALIGNMENT)
+{
+    void* Result = PushSize_(Arena, Size, Alignment);
+
+    memset(Result, 0, Size);
+
+    return Result;
+}
+
+inline char* PushString(MemoryArena* Arena, const char* String)
+{
+    u64     Length  = strlen(String);
+    char*   Result  = (char*)PushSize_(Arena, Length + 1, 1);
+
+    memcpy(Result, String, Length + 1);
+
+    return Result;
+}
+
+inline void ArenaReset(MemoryArena* Arena)
+{
+    Assert(Arena->TemporaryCount == 0);
+
+    Arena->Used = 0;
+}
+
+inline TemporaryMemory BeginTemporaryMemory(MemoryArena* Arena)
+{
+    TemporaryMemory Result;
+
+    Result.Arena    = Arena;
+    Result.Used     = Arena->Used;
+
+    ++Arena->TemporaryCount;
+
+    return Result;
+}
+
+inline void EndTemporaryMemory(TemporaryMemory Temp)
+{
+    MemoryArena* Arena = Temp.Arena;
+
+    Assert(Arena->Used >= Temp.Used);
+    Assert(Arena->TemporaryCount > 0);
+
+    Arena->Used = Temp.Used;
+
+    --Arena->TemporaryCount;
+}
+
+// NOTE(ismail): HeapAllocations counts global operator new calls, aligned ones included (Memory.cpp replaces them),
+// and Counted* calls that third party loaders use instead of malloc. PlatformAllocations counts Platform::AllocMem calls.
+// Frame takes difference of two snapshots
+struct MemoryCounters {
+    std::atomic<i64> HeapAllocations;
+    std::atomic<i64> HeapBytes;
+    std::atomic<i64> PlatformAllocations;
+    std::atomic<i64> PlatformBytes;
+};
+
+struct MemoryCountersSnapshot {
+    i64 HeapAllocations;
+    i64 HeapBytes;
+    i64 PlatformAllocations;
+    i64 PlatformBytes;
+};
+
+extern MemoryCounters GlobalMemoryCounters;
+
+// NOTE(ismail): malloc family for stb_image, fast_obj, dr_wav and dr_flac (macros in their implementation units),
+// realloc is counted as allocation every time because it may move the block
+void* CountedMalloc(size_t Size);
+void* CountedRealloc(void* Ptr, size_t Size);
+void CountedFree(void* Ptr);
+
+// NOTE(ismail): same with user data argument, for cgltf_options::memory
+void* CountedMallocCallback(void* UserData, size_t Size);
+void CountedFreeCallback(void* UserData, void* Ptr);
+
+inline MemoryCountersSnapshot TakeMemoryCountersSnapshot()
+{
+    MemoryCountersSnapshot Result;
+
+    Result.HeapAllocations      = GlobalMemoryCounters.HeapAllocations.load(std::memory_order_relaxed);
+    Result.HeapBytes            = GlobalMemoryCounters.HeapBytes.load(std::memory_order_relaxed);
+    Result.PlatformAllocations  = GlobalMemoryCounters.PlatformAllocations.load(std::memory_order_relaxed);
+    Result.PlatformBytes        = GlobalMemoryCounters.PlatformBytes.load(std::memory_order_relaxed);
+
+    return Result;
+}
+
+inline void CountPlatformAllocation(u64 Size)
+{
+    GlobalMemoryCounters.PlatformAllocations.fetch_add(1, std::memory_order_relaxed);
+    GlobalMemoryCounters.PlatformBytes.fetch_add((i64)Size, std::memory_order_relaxed);
+}
+
+#endif
@@ -21,6 +21,23 @@ typedef i64         bool64;
 
 typedef u8          byte;
 
+#if !defined(_WIN32)
+#include <string.h>
+
+// NOTE(ismail): MSVC secure CRT copy used by loaders, on other platforms it is a plain checked memcpy
+inline int memcpy_s(void *Dest, size_t DestSize, const void *Src, size_t Count)
+{
+    if (Count > DestSize) {
+        memset(Dest, 0, DestSize);
+        return 1;
+    }
+
+    memcpy(Dest, Src, Count);
+
+    return 0;
+}
+#endif
+
 enum Statuses {
     Success                         =  0,
     Failed                          = -1,
@@ -127,11 +127,13 @@ struct Camera {
 #endif
 
 struct Win32Platform {
-    HINSTANCE       AppInstance;
-    HWND            Window;
-    HDC             WindowDeviceContext;
-    HGLRC           GLDeviceContext;
-    Platform        EnginePlatformDetails;
+    HINSTANCE           AppInstance;
+    HWND                Window;
+    HDC                 WindowDeviceContext;
+    HGLRC               GLDeviceContext;
+    i64                 PerfCountFrequency;
+    JobSystem           Jobs;
+    Platform            EnginePlatformDetails;
 };
 
 // TODO (ismail): check bug with camera when screen scale is biger than 100%
@@ -157,6 +159,9 @@ static real32                   DeltaTime;
 static TEARA_PLATFORM_ALLOCATE_MEMORY(WinMemoryAllocate)
 {
     Assert(Size > 0);
+
+    CountPlatformAllocation(Size);
+
     return VirtualAlloc(0, Size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
 }
 
@@ -213,6 +218,45 @@ static TEARA_PLATFORM_READ_FILE(WinReadFile)
     return Result;
 }
 
+static TEARA_PLATFORM_MAP_FILE(WinMapFile)
+{
+    LARGE_INTEGER   FileSize;
+    File            Result = {};
+
+    HANDLE FileHandle = CreateFileA(FileName, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    if (FileHandle == INVALID_HANDLE_VALUE) {
+        return Result;
+    }
+
+    if (GetFileSizeEx(FileHandle, &FileSize) && FileSize.QuadPart > 0) {
+        HANDLE MappingHandle = CreateFileMappingA(FileHandle, 0, PAGE_READONLY, 0, 0, 0);
+
+        if (MappingHandle) {
+            // NOTE(ismail): view keeps the mapping alive, both handles can be closed right away
+            Result.Data = (byte*)MapViewOfFile(MappingHandle, FILE_MAP_READ, 0, 0, 0);
+
+            if (Result.Data) {
+                Result.Size = (u64)FileSize.QuadPart;
+            }
+
+            CloseHandle(MappingHandle);
+        }
+    }
+
+    CloseHandle(FileHandle);
+
+    return Result;
+}
+
+static TEARA_PLATFORM_UNMAP_FILE(WinUnmapFile)
+{
+    if (FileData->Data) {
+        UnmapViewOfFile(FileData->Data);
+    }
+
+    *FileData = {};
+}
+
 static inline void WinGetDesiredPixelFormat(PIXELFORMATDESCRIPTOR *PixelFormat)
 {
     PixelFormat->nSize            = sizeof(PIXELFORMATDESCRIPTOR); // size of that struct
@@ -670,12 +714,41 @@ static Statuses WinCreateWindow()
     return Statuses::Success;
 }
 
+static TEARA_PLATFORM_GET_WALL_CLOCK(WinGetWallClock)
+{
+    LARGE_INTEGER Counter;
+    QueryPerformanceCounter(&Counter);
+
+    return (real64)Counter.QuadPart / (real64)Win32App.PerfCountFrequency;
+}
+
+// NOTE(ismail): main thread is job worker 0 and runs jobs while it waits on them
+static i32 WinJobThreadsAmount()
+{
+    SYSTEM_INFO SystemInfo;
+    GetSystemInfo(&SystemInfo);
+
+    return (i32)SystemInfo.dwNumberOfProcessors - 1;
+}
+
 static void WinPlatformInit()
 {
+    LARGE_INTEGER PerfomanceCountFrequencyResult;
+    QueryPerformanceFrequency(&PerfomanceCountFrequencyResult);
+
+    Win32App.PerfCountFrequency = PerfomanceCountFrequencyResult.QuadPart;
+
     Win32App.EnginePlatformDetails.AllocMem       = &WinMemoryAllocate;
     Win32App.EnginePlatformDetails.ReleaseMem     = &WinMemoryRelease;
     Win32App.EnginePlatformDetails.ReadFile       = &WinReadFile;
     Win32App.EnginePlatformDetails.FreeFileData   = &WinFreeFileData;
+    Win32App.EnginePlatformDetails.MapFile        = &WinMapFile;
+    Win32App.EnginePlatformDetails.UnmapFile      = &WinUnmapFile;
+    Win32App.EnginePlatformDetails.GetWallClock   = &WinGetWallClock;
+
+    JobSystemInit(&Win32App.Jobs, WinJobThreadsAmount());
+
+    Win32App.EnginePlatformDetails.Jobs           = &Win32App.Jobs;
 }
 
 static Statuses WinInit()
@@ -1486,6 +1559,32 @@ i32 APIENTRY WinMain( HINSTANCE Instance, HINSTANCE PrevInstance,
             ImGui::Begin("Animation Editor");
 
             ImGui::SliderFloat("float", &f, 0.0f, 1.0f);
+
+            const AnimationUpdateStats& AnimStats = Context->AnimSystem.GetUpdateStats();
+            ImGui::Text("Animation update: %.03f ms | %d tracks | %d jobs | %d workers", 
+                        AnimStats.UpdateTimeMs, AnimStats.TracksAmount, AnimStats.JobsAmount, 
+                        JobSystemThreadsAmount(&Win32App.Jobs));
+
+            const ParticleUpdateStats& ParticleStats = Context->Particles.Stats;
+            ImGui::Text("Particles update: %.03f ms | %d particles | +%d -%d | %d jobs",
+                        ParticleStats.UpdateTimeMs, ParticleStats.ParticlesAmount,
+                        ParticleStats.SpawnedAmount, ParticleStats.KilledAmount, ParticleStats.JobsAmount);
+
+            const FrameMemoryStats& MemoryStats = Context->FrameMemory;
+            ImGui::Text("Frame memory: %lld heap allocs (%lld bytes) | %lld platform allocs | arena %.02f / %.02f MB",
+                        MemoryStats.HeapAllocations, MemoryStats.HeapBytes, MemoryStats.PlatformAllocations,
+                        (real64)MemoryStats.FrameArenaUsed / (real64)Megabytes(1),
+                        (real64)Context->FrameArena.Size / (real64)Megabytes(1));
+
+            const AssetStreamerStats& StreamStats = Context->Streamer.Stats;
+            ImGui::Text("Streaming: %d in flight | %lld uploaded (%.02f MB) | %lld failed | worst upload %.03f ms",
+                        Context->Streamer.InFlight, StreamStats.Uploaded, (real64)StreamStats.UploadedBytes / (real64)Megabytes(1),
+                        StreamStats.Failed, StreamStats.MaxUploadMs);
+
+            const TextureCacheStats& TextureStats = Context->Textures.Stats;
+            ImGui::Text("Textures: %d live | %lld path hits | %lld content hits | %lld misses | %.02f MB saved",
+                        TextureStats.Textures, TextureStats.PathHits, TextureStats.ContentHits, TextureStats.Misses,
+                        (real64)TextureStats.BytesSaved / (real64)Megabytes(1));
             
             ImGui::End();
         }
@@ -1494,6 +1593,8 @@ i32 APIENTRY WinMain( HINSTANCE Instance, HINSTANCE PrevInstance,
 
         Frame(&Win32App.EnginePlatformDetails, Context);
 
+        AudioSystemUpdate(&Audio);
+
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
         SwapBuffers(Win32App.WindowDeviceContext);
@@ -1522,5 +1623,9 @@ i32 APIENTRY WinMain( HINSTANCE Instance, HINSTANCE PrevInstance,
         LastCounter = EndCounter;
     }
 
+    AssetStreamerShutdown(&Context->Streamer);
+    JobSystemShutdown(&Win32App.Jobs);
+    AudioDestroy(&Audio);
+
     return 0;
 }
\ No newline at end of file
@@ -2,7 +2,11 @@
 #define _TEARA_MATH_UTILS_H_
 
 // TODO (ismail): my own SIMD math function or instead my own use SDL
+#if defined(_WIN32)
 #include <corecrt_math.h>
+#else
+#include <math.h>
+#endif
 #include <stdlib.h>
 
 #include "Core/Types.h"
@@ -18,6 +22,8 @@
 #define          RAD_IN_DEGREE         (PI * ONE_OVER_HALF_ROTATION)
 #define          DEGREE_TO_RAD(Deg)    ((Deg) * RAD_IN_DEGREE)
 #define          RAD_TO_DEGREE(Rad)    (Rad * DEGREE_IN_RAD)
+// NOTE(ismail): engine INFINITY is big finite value, so math on it never gives inf or nan. Replaces the one from math.h
+#undef INFINITY
 #define               INFINITY		   (1e30f)
 #define         SMALLEST_FLOAT         (1.1754944e-038f)
 #define                 SQUARE(Val)    ((Val) * (Val))
@@ -3,8 +3,24 @@
 
 #include "Vector.h"
 
+// NOTE(ismail): SIMD paths are picked at compile time, define TEARA_MATH_NO_SIMD to force scalar code.
+// SSE2 is always present on x64, AVX2 is used only when compiler targets it (/arch:AVX2 or -mavx2)
+#if !defined(TEARA_MATH_NO_SIMD)
+    #if defined(__AVX2__)
+        #define TEARA_MATH_AVX2 1
+    #endif
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define TEARA_MATH_SSE2 1
+    #endif
+#endif
+
+#if TEARA_MATH_AVX2
+    #include <immintrin.h>
+#elif TEARA_MATH_SSE2
+    #include <emmintrin.h>
+#endif
+
 // TODO(ismail): convert all to SIMD
-// TODO(ismail): add tests
 
 struct mat2 {
     real32 *operator[](i32 Index);
@@ -416,8 +432,52 @@ inline mat4 mat4::operator*(real32 Scalar) const
     return Result;
 }
 
+// NOTE(ismail): SIMD versions keep the same order of additions as scalar code and use no FMA. Results are bit exact only
+// while compiler doesn't fuse scalar code either (-ffp-contract=off with -mfma, MSVC /fp:precise), --math-test checks it
 inline mat4 mat4::operator*(const mat4 &Other) const
 {
+#if TEARA_MATH_AVX2
+    mat4 Result;
+
+    // NOTE(ismail): every 256 bit register holds two rows of result, each Other row is duplicated in both lanes
+    __m256 OtherRow0 = _mm256_broadcast_ps((const __m128*)Other.mat[0]);
+    __m256 OtherRow1 = _mm256_broadcast_ps((const __m128*)Other.mat[1]);
+    __m256 OtherRow2 = _mm256_broadcast_ps((const __m128*)Other.mat[2]);
+    __m256 OtherRow3 = _mm256_broadcast_ps((const __m128*)Other.mat[3]);
+
+    for (i32 Row = 0; Row < 4; Row += 2) {
+        __m256 Rows = _mm256_loadu_ps(mat[Row]);
+
+        __m256 Sum = _mm256_mul_ps(_mm256_shuffle_ps(Rows, Rows, _MM_SHUFFLE(0, 0, 0, 0)), OtherRow0);
+        Sum = _mm256_add_ps(Sum, _mm256_mul_ps(_mm256_shuffle_ps(Rows, Rows, _MM_SHUFFLE(1, 1, 1, 1)), OtherRow1));
+        Sum = _mm256_add_ps(Sum, _mm256_mul_ps(_mm256_shuffle_ps(Rows, Rows, _MM_SHUFFLE(2, 2, 2, 2)), OtherRow2));
+        Sum = _mm256_add_ps(Sum, _mm256_mul_ps(_mm256_shuffle_ps(Rows, Rows, _MM_SHUFFLE(3, 3, 3, 3)), OtherRow3));
+
+        _mm256_storeu_ps(Result.mat[Row], Sum);
+    }
+
+    return Result;
+#elif TEARA_MATH_SSE2
+    mat4 Result;
+
+    __m128 OtherRow0 = _mm_loadu_ps(Other.mat[0]);
+    __m128 OtherRow1 = _mm_loadu_ps(Other.mat[1]);
+    __m128 OtherRow2 = _mm_loadu_ps(Other.mat[2]);
+    __m128 OtherRow3 = _mm_loadu_ps(Other.mat[3]);
+
+    for (i32 Row = 0; Row < 4; ++Row) {
+        __m128 CurrentRow = _mm_loadu_ps(mat[Row]);
+
+        __m128 Sum = _mm_mul_ps(_mm_shuffle_ps(CurrentRow, CurrentRow, _MM_SHUFFLE(0, 0, 0, 0)), OtherRow0);
+        Sum = _mm_add_ps(Sum, _mm_mul_ps(_mm_shuffle_ps(CurrentRow, CurrentRow, _MM_SHUFFLE(1, 1, 1, 1)), OtherRow1));
+        Sum = _mm_add_ps(Sum, _mm_mul_ps(_mm_shuffle_ps(CurrentRow, CurrentRow, _MM_SHUFFLE(2, 2, 2, 2)), OtherRow2));
+        Sum = _mm_add_ps(Sum, _mm_mul_ps(_mm_shuffle_ps(CurrentRow, CurrentRow, _MM_SHUFFLE(3, 3, 3, 3)), OtherRow3));
+
+        _mm_storeu_ps(Result.mat[Row], Sum);
+    }
+
+    return Result;
+#else
     // TODO(ismail): check can i optimise this?
 
     mat4 Result = {
@@ -443,10 +503,29 @@ inline mat4 mat4::operator*(const mat4 &Other) const
     };
 
     return Result;
+#endif
 }
 
 inline vec4 mat4::operator*(const vec4 &Vec) const
 {
+#if TEARA_MATH_SSE2
+    __m128 VecReg = _mm_loadu_ps(Vec.vec);
+
+    __m128 Products0 = _mm_mul_ps(_mm_loadu_ps(mat[0]), VecReg);
+    __m128 Products1 = _mm_mul_ps(_mm_loadu_ps(mat[1]), VecReg);
+    __m128 Products2 = _mm_mul_ps(_mm_loadu_ps(mat[2]), VecReg);
+    __m128 Products3 = _mm_mul_ps(_mm_loadu_ps(mat[3]), VecReg);
+
+    // NOTE(ismail): after transpose every register holds one term of all four dot products
+    _MM_TRANSPOSE4_PS(Products0, Products1, Products2, Products3);
+
+    __m128 Sum = _mm_add_ps(_mm_add_ps(_mm_add_ps(Products0, Products1), Products2), Products3);
+
+    vec4 Result;
+    _mm_storeu_ps(Result.vec, Sum);
+
+    return Result;
+#else
     vec4 Result = {
         mat[0][0] * Vec.x + mat[0][1] * Vec.y + mat[0][2] * Vec.z + mat[0][3] * Vec.w,
         mat[1][0] * Vec.x + mat[1][1] * Vec.y + mat[1][2] * Vec.z + mat[1][3] * Vec.w,
@@ -455,6 +534,7 @@ inline vec4 mat4::operator*(const vec4 &Vec) const
     };
 
     return Result;
+#endif
 }
 
 inline mat4 &mat4::operator*=(real32 Scalar)
@@ -489,6 +569,11 @@ inline mat4 &mat4::operator+=(const mat4 &Other)
 
 inline mat4 &mat4::operator*=(const mat4 &Other)
 {
+#if TEARA_MATH_SSE2
+    *this = *this * Other;
+
+    return *this;
+#else
     real32 x, y, z, w;
 
     x = mat[0][0];
@@ -532,6 +617,64 @@ inline mat4 &mat4::operator*=(const mat4 &Other)
     mat[3][3] = x * Other.mat[0][3] + y * Other.mat[1][3] + z * Other.mat[2][3] + w * Other.mat[3][3]; // i = 4 j = 4
 
     return *this;
+#endif
+}
+
+// NOTE(ismail): points are treated as (x, y, z, 1) and bottom row of Transform is ignored, In and Out may be the same array
+inline void TransformPoints(const mat4& Transform, const vec3* In, vec3* Out, i32 Amount)
+{
+    const real32 (*m)[4] = Transform.mat;
+
+    i32 Index = 0;
+
+#if TEARA_MATH_SSE2
+    __m128 m00 = _mm_set1_ps(m[0][0]), m01 = _mm_set1_ps(m[0][1]), m02 = _mm_set1_ps(m[0][2]), m03 = _mm_set1_ps(m[0][3]);
+    __m128 m10 = _mm_set1_ps(m[1][0]), m11 = _mm_set1_ps(m[1][1]), m12 = _mm_set1_ps(m[1][2]), m13 = _mm_set1_ps(m[1][3]);
+    __m128 m20 = _mm_set1_ps(m[2][0]), m21 = _mm_set1_ps(m[2][1]), m22 = _mm_set1_ps(m[2][2]), m23 = _mm_set1_ps(m[2][3]);
+
+    // NOTE(ismail): four points per iteration, 12 floats are deinterleaved to xxxx yyyy zzzz and back
+    for (; Index + 4 <= Amount; Index += 4) {
+        const real32*   Src = In[Index].vec;
+        real32*         Dst = Out[Index].vec;
+
+        __m128 L0 = _mm_loadu_ps(Src);      // x0 y0 z0 x1
+        __m128 L1 = _mm_loadu_ps(Src + 4);  // y1 z1 x2 y2
+        __m128 L2 = _mm_loadu_ps(Src + 8);  // z2 x3 y3 z3
+
+        __m128 T0 = _mm_shuffle_ps(L1, L2, _MM_SHUFFLE(1, 0, 3, 2)); // x2 y2 z2 x3
+        __m128 T1 = _mm_shuffle_ps(L0, L1, _MM_SHUFFLE(1, 0, 2, 1)); // y0 z0 y1 z1
+        __m128 T2 = _mm_shuffle_ps(T0, L2, _MM_SHUFFLE(3, 2, 2, 1)); // y2 z2 y3 z3
+
+        __m128 X = _mm_shuffle_ps(L0, T0, _MM_SHUFFLE(3, 0, 3, 0));
+        __m128 Y = _mm_shuffle_ps(T1, T2, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 Z = _mm_shuffle_ps(T1, T2, _MM_SHUFFLE(3, 1, 3, 1));
+
+        __m128 OutX = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, X), _mm_mul_ps(m01, Y)), _mm_mul_ps(m02, Z)), m03);
+        __m128 OutY = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, X), _mm_mul_ps(m11, Y)), _mm_mul_ps(m12, Z)), m13);
+        __m128 OutZ = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, X), _mm_mul_ps(m21, Y)), _mm_mul_ps(m22, Z)), m23);
+
+        __m128 XYLow    = _mm_unpacklo_ps(OutX, OutY);                          // x0 y0 x1 y1
+        __m128 XYHigh   = _mm_unpackhi_ps(OutX, OutY);                          // x2 y2 x3 y3
+        __m128 Z0X1     = _mm_shuffle_ps(OutZ, XYLow, _MM_SHUFFLE(2, 2, 0, 0)); // z0 z0 x1 x1
+        __m128 Y1Z1     = _mm_shuffle_ps(XYLow, OutZ, _MM_SHUFFLE(1, 1, 3, 3)); // y1 y1 z1 z1
+        __m128 Z2X3     = _mm_shuffle_ps(OutZ, XYHigh, _MM_SHUFFLE(2, 2, 2, 2)); // z2 z2 x3 x3
+        __m128 Y3Z3     = _mm_shuffle_ps(XYHigh, OutZ, _MM_SHUFFLE(3, 3, 3, 3)); // y3 y3 z3 z3
+
+        _mm_storeu_ps(Dst,      _mm_shuffle_ps(XYLow, Z0X1, _MM_SHUFFLE(2, 0, 1, 0)));
+        _mm_storeu_ps(Dst + 4,  _mm_shuffle_ps(Y1Z1, XYHigh, _MM_SHUFFLE(1, 0, 2, 0)));
+        _mm_storeu_ps(Dst + 8,  _mm_shuffle_ps(Z2X3, Y3Z3, _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+#endif
+
+    for (; Index < Amount; ++Index) {
+        vec3 Point = In[Index];
+
+        Out[Index] = {
+            m[0][0] * Point.x + m[0][1] * Point.y + m[0][2] * Point.z + m[0][3],
+            m[1][0] * Point.x + m[1][1] * Point.y + m[1][2] * Point.z + m[1][3],
+            m[2][0] * Point.x + m[2][1] * Point.y + m[2][2] * Point.z + m[2][3],
+        };
+    }
 }
 
 const mat4 Identity4 = 
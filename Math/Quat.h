@@ -22,12 +22,20 @@ struct quat {
 
     static quat Slerp(const quat &Src, const quat &Dst, real32 Delta);
 
+    // NOTE(ismail): batched versions, Out may alias a, all take the shortest arc. SlerpN is Slerp per element and gives
+    // same result. FastSlerpN is nlerp with corrected t, it stays within 0.0015 rad of real slerp (--math-test measures it)
+    // for several times less time per quat than Slerp. NlerpN is plain nlerp, up to ~0.14 rad off near opposite quats
+    static void NlerpN(const quat* a, const quat* b, const real32* t, quat* Out, i32 Amount);
+    static void SlerpN(const quat* a, const quat* b, const real32* t, quat* Out, i32 Amount);
+    static void FastSlerpN(const quat* a, const quat* b, const real32* t, quat* Out, i32 Amount);
+    static void Mat4N(const quat* In, mat4* Out, i32 Amount);
+
     union {
         struct {
             real32 w, x, y, z;
         };
         struct {
-            real32 w;
+            real32 s; // NOTE(ismail): same as w, repeating the name is MSVC only
             vec3 n;
         };
         real32 q[4];   
@@ -266,4 +274,314 @@ inline quat quat::Slerp(const quat &Src, const quat &Dst, real32 Delta)
     return Result;
 }
 
+// NOTE(ismail): nlerp with t remapped by a cubic fitted against real slerp (d is |cos| between inputs),
+// max angular error is ~0.0015 rad for any pair, plain nlerp reaches ~0.14 rad near 180 degrees
+inline real32 FastSlerpCorrection(real32 d, real32 t)
+{
+    real32 A = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+    real32 B = 0.848013f + d * (-1.06021f + d * 0.215638f);
+
+    real32 Centered = t - 0.5f;
+    real32 k        = A * Centered * Centered + B;
+
+    real32 Result = t + t * Centered * (t - 1.0f) * k;
+
+    return Result;
+}
+
+inline quat NlerpShortest(const quat& a, const quat& b, real32 t)
+{
+    real32 Dot  = a.Dot(b);
+    real32 t1   = Dot < 0.0f ? -t : t;
+    real32 t0   = 1.0f - t;
+
+    quat Result(
+        a.w * t0 + b.w * t1,
+        a.x * t0 + b.x * t1,
+        a.y * t0 + b.y * t1,
+        a.z * t0 + b.z * t1
+    );
+
+    real32 OneOverLength = 1.0f / Result.Length();
+
+    Result.w *= OneOverLength;
+    Result.x *= OneOverLength;
+    Result.y *= OneOverLength;
+    Result.z *= OneOverLength;
+
+    return Result;
+}
+
+#if TEARA_MATH_SSE2
+// NOTE(ismail): 4 quats from a and b are transposed to wwww xxxx yyyy zzzz, lerped and normalized,
+// with FastCorrection set t goes through FastSlerpCorrection first
+inline void QuatLerp4(const quat* a, const quat* b, const real32* t, quat* Out, bool FastCorrection)
+{
+    __m128 AW = _mm_loadu_ps(a[0].q);
+    __m128 AX = _mm_loadu_ps(a[1].q);
+    __m128 AY = _mm_loadu_ps(a[2].q);
+    __m128 AZ = _mm_loadu_ps(a[3].q);
+    _MM_TRANSPOSE4_PS(AW, AX, AY, AZ);
+
+    __m128 BW = _mm_loadu_ps(b[0].q);
+    __m128 BX = _mm_loadu_ps(b[1].q);
+    __m128 BY = _mm_loadu_ps(b[2].q);
+    __m128 BZ = _mm_loadu_ps(b[3].q);
+    _MM_TRANSPOSE4_PS(BW, BX, BY, BZ);
+
+    __m128 SignMask = _mm_set1_ps(-0.0f);
+    __m128 One      = _mm_set1_ps(1.0f);
+
+    __m128 Dot  = _mm_add_ps(_mm_add_ps(_mm_mul_ps(AW, BW), _mm_mul_ps(AX, BX)), _mm_add_ps(_mm_mul_ps(AY, BY), _mm_mul_ps(AZ, BZ)));
+    __m128 Sign = _mm_and_ps(Dot, SignMask);
+    __m128 T    = _mm_loadu_ps(t);
+
+    if (FastCorrection) {
+        __m128 d        = _mm_andnot_ps(SignMask, Dot);
+        __m128 Half     = _mm_set1_ps(0.5f);
+
+        __m128 A = _mm_sub_ps(_mm_set1_ps(3.55645f), _mm_mul_ps(d, _mm_set1_ps(1.43519f)));
+        A = _mm_add_ps(_mm_set1_ps(-3.2452f), _mm_mul_ps(d, A));
+        A = _mm_add_ps(_mm_set1_ps(1.0904f), _mm_mul_ps(d, A));
+
+        __m128 B = _mm_add_ps(_mm_set1_ps(-1.06021f), _mm_mul_ps(d, _mm_set1_ps(0.215638f)));
+        B = _mm_add_ps(_mm_set1_ps(0.848013f), _mm_mul_ps(d, B));
+
+        __m128 Centered = _mm_sub_ps(T, Half);
+        __m128 k        = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(A, Centered), Centered), B);
+
+        T = _mm_add_ps(T, _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(T, Centered), _mm_sub_ps(T, One)), k));
+    }
+
+    __m128 T0 = _mm_sub_ps(One, T);
+    __m128 T1 = _mm_xor_ps(T, Sign);
+
+    __m128 W = _mm_add_ps(_mm_mul_ps(AW, T0), _mm_mul_ps(BW, T1));
+    __m128 X = _mm_add_ps(_mm_mul_ps(AX, T0), _mm_mul_ps(BX, T1));
+    __m128 Y = _mm_add_ps(_mm_mul_ps(AY, T0), _mm_mul_ps(BY, T1));
+    __m128 Z = _mm_add_ps(_mm_mul_ps(AZ, T0), _mm_mul_ps(BZ, T1));
+
+    __m128 LengthSquare     = _mm_add_ps(_mm_add_ps(_mm_mul_ps(W, W), _mm_mul_ps(X, X)), _mm_add_ps(_mm_mul_ps(Y, Y), _mm_mul_ps(Z, Z)));
+    __m128 OneOverLength    = _mm_div_ps(One, _mm_sqrt_ps(LengthSquare));
+
+    W = _mm_mul_ps(W, OneOverLength);
+    X = _mm_mul_ps(X, OneOverLength);
+    Y = _mm_mul_ps(Y, OneOverLength);
+    Z = _mm_mul_ps(Z, OneOverLength);
+    _MM_TRANSPOSE4_PS(W, X, Y, Z);
+
+    _mm_storeu_ps(Out[0].q, W);
+    _mm_storeu_ps(Out[1].q, X);
+    _mm_storeu_ps(Out[2].q, Y);
+    _mm_storeu_ps(Out[3].q, Z);
+}
+#endif
+
+#if TEARA_MATH_AVX2
+// NOTE(ismail): 4x4 transpose inside each 128 bit lane, like _MM_TRANSPOSE4_PS does for one register
+#define TEARA_MM256_TRANSPOSE4_LANES_PS(Row0, Row1, Row2, Row3) {          \
+    __m256 Temp0 = _mm256_unpacklo_ps((Row0), (Row1));                      \
+    __m256 Temp1 = _mm256_unpacklo_ps((Row2), (Row3));                      \
+    __m256 Temp2 = _mm256_unpackhi_ps((Row0), (Row1));                      \
+    __m256 Temp3 = _mm256_unpackhi_ps((Row2), (Row3));                      \
+    (Row0) = _mm256_shuffle_ps(Temp0, Temp1, _MM_SHUFFLE(1, 0, 1, 0));      \
+    (Row1) = _mm256_shuffle_ps(Temp0, Temp1, _MM_SHUFFLE(3, 2, 3, 2));      \
+    (Row2) = _mm256_shuffle_ps(Temp2, Temp3, _MM_SHUFFLE(1, 0, 1, 0));      \
+    (Row3) = _mm256_shuffle_ps(Temp2, Temp3, _MM_SHUFFLE(3, 2, 3, 2));      \
+}
+
+// NOTE(ismail): quats i and i + 4 share one register so after in-lane transpose lane k holds quat k in natural order
+inline void QuatLoad8(const quat* q, __m256& W, __m256& X, __m256& Y, __m256& Z)
+{
+    W = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(q[0].q)), _mm_loadu_ps(q[4].q), 1);
+    X = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(q[1].q)), _mm_loadu_ps(q[5].q), 1);
+    Y = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(q[2].q)), _mm_loadu_ps(q[6].q), 1);
+    Z = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(q[3].q)), _mm_loadu_ps(q[7].q), 1);
+    TEARA_MM256_TRANSPOSE4_LANES_PS(W, X, Y, Z);
+}
+
+// NOTE(ismail): same math and order of operations as QuatLerp4 over 8 quats
+inline void QuatLerp8(const quat* a, const quat* b, const real32* t, quat* Out, bool FastCorrection)
+{
+    __m256 AW, AX, AY, AZ;
+    __m256 BW, BX, BY, BZ;
+    QuatLoad8(a, AW, AX, AY, AZ);
+    QuatLoad8(b, BW, BX, BY, BZ);
+
+    __m256 SignMask = _mm256_set1_ps(-0.0f);
+    __m256 One      = _mm256_set1_ps(1.0f);
+
+    __m256 Dot  = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(AW, BW), _mm256_mul_ps(AX, BX)), _mm256_add_ps(_mm256_mul_ps(AY, BY), _mm256_mul_ps(AZ, BZ)));
+    __m256 Sign = _mm256_and_ps(Dot, SignMask);
+    __m256 T    = _mm256_loadu_ps(t);
+
+    if (FastCorrection) {
+        __m256 d        = _mm256_andnot_ps(SignMask, Dot);
+        __m256 Half     = _mm256_set1_ps(0.5f);
+
+        __m256 A = _mm256_sub_ps(_mm256_set1_ps(3.55645f), _mm256_mul_ps(d, _mm256_set1_ps(1.43519f)));
+        A = _mm256_add_ps(_mm256_set1_ps(-3.2452f), _mm256_mul_ps(d, A));
+        A = _mm256_add_ps(_mm256_set1_ps(1.0904f), _mm256_mul_ps(d, A));
+
+        __m256 B = _mm256_add_ps(_mm256_set1_ps(-1.06021f), _mm256_mul_ps(d, _mm256_set1_ps(0.215638f)));
+        B = _mm256_add_ps(_mm256_set1_ps(0.848013f), _mm256_mul_ps(d, B));
+
+        __m256 Centered = _mm256_sub_ps(T, Half);
+        __m256 k        = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(A, Centered), Centered), B);
+
+        T = _mm256_add_ps(T, _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(T, Centered), _mm256_sub_ps(T, One)), k));
+    }
+
+    __m256 T0 = _mm256_sub_ps(One, T);
+    __m256 T1 = _mm256_xor_ps(T, Sign);
+
+    __m256 W = _mm256_add_ps(_mm256_mul_ps(AW, T0), _mm256_mul_ps(BW, T1));
+    __m256 X = _mm256_add_ps(_mm256_mul_ps(AX, T0), _mm256_mul_ps(BX, T1));
+    __m256 Y = _mm256_add_ps(_mm256_mul_ps(AY, T0), _mm256_mul_ps(BY, T1));
+    __m256 Z = _mm256_add_ps(_mm256_mul_ps(AZ, T0), _mm256_mul_ps(BZ, T1));
+
+    __m256 LengthSquare     = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(W, W), _mm256_mul_ps(X, X)), _mm256_add_ps(_mm256_mul_ps(Y, Y), _mm256_mul_ps(Z, Z)));
+    __m256 OneOverLength    = _mm256_div_ps(One, _mm256_sqrt_ps(LengthSquare));
+
+    W = _mm256_mul_ps(W, OneOverLength);
+    X = _mm256_mul_ps(X, OneOverLength);
+    Y = _mm256_mul_ps(Y, OneOverLength);
+    Z = _mm256_mul_ps(Z, OneOverLength);
+    TEARA_MM256_TRANSPOSE4_LANES_PS(W, X, Y, Z);
+
+    _mm_storeu_ps(Out[0].q, _mm256_castps256_ps128(W));
+    _mm_storeu_ps(Out[1].q, _mm256_castps256_ps128(X));
+    _mm_storeu_ps(Out[2].q, _mm256_castps256_ps128(Y));
+    _mm_storeu_ps(Out[3].q, _mm256_castps256_ps128(Z));
+    _mm_storeu_ps(Out[4].q, _mm256_extractf128_ps(W, 1));
+    _mm_storeu_ps(Out[5].q, _mm256_extractf128_ps(X, 1));
+    _mm_storeu_ps(Out[6].q, _mm256_extractf128_ps(Y, 1));
+    _mm_storeu_ps(Out[7].q, _mm256_extractf128_ps(Z, 1));
+}
+#endif
+
+inline void quat::NlerpN(const quat* a, const quat* b, const real32* t, quat* Out, i32 Amount)
+{
+    i32 Index = 0;
+
+#if TEARA_MATH_AVX2
+    for (; Index + 8 <= Amount; Index += 8) {
+        QuatLerp8(a + Index, b + Index, t + Index, Out + Index, false);
+    }
+#endif
+#if TEARA_MATH_SSE2
+    for (; Index + 4 <= Amount; Index += 4) {
+        QuatLerp4(a + Index, b + Index, t + Index, Out + Index, false);
+    }
+#endif
+
+    for (; Index < Amount; ++Index) {
+        Out[Index] = NlerpShortest(a[Index], b[Index], t[Index]);
+    }
+}
+
+inline void quat::SlerpN(const quat* a, const quat* b, const real32* t, quat* Out, i32 Amount)
+{
+    for (i32 Index = 0; Index < Amount; ++Index) {
+        Out[Index] = Slerp(a[Index], b[Index], t[Index]);
+    }
+}
+
+inline void quat::FastSlerpN(const quat* a, const quat* b, const real32* t, quat* Out, i32 Amount)
+{
+    i32 Index = 0;
+
+#if TEARA_MATH_AVX2
+    for (; Index + 8 <= Amount; Index += 8) {
+        QuatLerp8(a + Index, b + Index, t + Index, Out + Index, true);
+    }
+#endif
+#if TEARA_MATH_SSE2
+    for (; Index + 4 <= Amount; Index += 4) {
+        QuatLerp4(a + Index, b + Index, t + Index, Out + Index, true);
+    }
+#endif
+
+    for (; Index < Amount; ++Index) {
+        real32 d = Fabs(a[Index].Dot(b[Index]));
+
+        Out[Index] = NlerpShortest(a[Index], b[Index], FastSlerpCorrection(d, t[Index]));
+    }
+}
+
+inline void quat::Mat4N(const quat* In, mat4* Out, i32 Amount)
+{
+    i32 Index = 0;
+
+#if TEARA_MATH_SSE2
+    __m128 Zero = _mm_setzero_ps();
+    __m128 One  = _mm_set1_ps(1.0f);
+    __m128 Two  = _mm_set1_ps(2.0f);
+    __m128 LastRow = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+
+    // NOTE(ismail): same expression order as quat::Mat4, results match it bit for bit while scalar code isn't fused into FMA (see Matrix.h)
+    for (; Index + 4 <= Amount; Index += 4) {
+        __m128 W = _mm_loadu_ps(In[Index + 0].q);
+        __m128 X = _mm_loadu_ps(In[Index + 1].q);
+        __m128 Y = _mm_loadu_ps(In[Index + 2].q);
+        __m128 Z = _mm_loadu_ps(In[Index + 3].q);
+        _MM_TRANSPOSE4_PS(W, X, Y, Z);
+
+        __m128 x2 = _mm_mul_ps(X, Two);
+        __m128 y2 = _mm_mul_ps(Y, Two);
+        __m128 z2 = _mm_mul_ps(Z, Two);
+
+        __m128 xx2 = _mm_mul_ps(x2, X);
+        __m128 yy2 = _mm_mul_ps(y2, Y);
+        __m128 zz2 = _mm_mul_ps(z2, Z);
+
+        __m128 wx2 = _mm_mul_ps(x2, W);
+        __m128 xy2 = _mm_mul_ps(x2, Y);
+
+        __m128 wz2 = _mm_mul_ps(z2, W);
+        __m128 xz2 = _mm_mul_ps(z2, X);
+
+        __m128 wy2 = _mm_mul_ps(y2, W);
+        __m128 yz2 = _mm_mul_ps(y2, Z);
+
+        __m128 R00 = _mm_sub_ps(_mm_sub_ps(One, yy2), zz2);
+        __m128 R01 = _mm_sub_ps(xy2, wz2);
+        __m128 R02 = _mm_add_ps(xz2, wy2);
+        __m128 R03 = Zero;
+        _MM_TRANSPOSE4_PS(R00, R01, R02, R03);
+
+        __m128 R10 = _mm_add_ps(xy2, wz2);
+        __m128 R11 = _mm_sub_ps(_mm_sub_ps(One, xx2), zz2);
+        __m128 R12 = _mm_sub_ps(yz2, wx2);
+        __m128 R13 = Zero;
+        _MM_TRANSPOSE4_PS(R10, R11, R12, R13);
+
+        __m128 R20 = _mm_sub_ps(xz2, wy2);
+        __m128 R21 = _mm_add_ps(yz2, wx2);
+        __m128 R22 = _mm_sub_ps(_mm_sub_ps(One, xx2), yy2);
+        __m128 R23 = Zero;
+        _MM_TRANSPOSE4_PS(R20, R21, R22, R23);
+
+        __m128 Rows[3][4] = {
+            { R00, R01, R02, R03 },
+            { R10, R11, R12, R13 },
+            { R20, R21, R22, R23 },
+        };
+
+        for (i32 QuatIndex = 0; QuatIndex < 4; ++QuatIndex) {
+            real32 (*m)[4] = Out[Index + QuatIndex].mat;
+
+            _mm_storeu_ps(m[0], Rows[0][QuatIndex]);
+            _mm_storeu_ps(m[1], Rows[1][QuatIndex]);
+            _mm_storeu_ps(m[2], Rows[2][QuatIndex]);
+            _mm_storeu_ps(m[3], LastRow);
+        }
+    }
+#endif
+
+    for (; Index < Amount; ++Index) {
+        In[Index].Mat4(Out[Index]);
+    }
+}
+
 #endif
\ No newline at end of file
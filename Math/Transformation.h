@@ -84,6 +84,53 @@ inline void InverseTranslationFromArr(real32 *Translation, mat4& Result)
     };
 }
 
+// NOTE(ismail): same as T * R * S but written straight into affine part, bottom row is always 0 0 0 1
+inline void AffineFromTRS(const vec3& Translation, const quat& Rotation, const vec3& Scale, mat4& Result)
+{
+    mat3 RotationMat;
+    Rotation.Mat3(RotationMat);
+
+    Result = {
+        RotationMat.mat[0][0] * Scale.x, RotationMat.mat[0][1] * Scale.y, RotationMat.mat[0][2] * Scale.z, Translation.x,
+        RotationMat.mat[1][0] * Scale.x, RotationMat.mat[1][1] * Scale.y, RotationMat.mat[1][2] * Scale.z, Translation.y,
+        RotationMat.mat[2][0] * Scale.x, RotationMat.mat[2][1] * Scale.y, RotationMat.mat[2][2] * Scale.z, Translation.z,
+                                   0.0f,                            0.0f,                            0.0f,          1.0f
+    };
+}
+
+// NOTE(ismail): same as above when rotation matrix is already built (see quat::Mat4N)
+inline void AffineFromTRS(const vec3& Translation, const mat4& Rotation, const vec3& Scale, mat4& Result)
+{
+    const real32 (*r)[4] = Rotation.mat;
+
+    Result = {
+        r[0][0] * Scale.x, r[0][1] * Scale.y, r[0][2] * Scale.z, Translation.x,
+        r[1][0] * Scale.x, r[1][1] * Scale.y, r[1][2] * Scale.z, Translation.y,
+        r[2][0] * Scale.x, r[2][1] * Scale.y, r[2][2] * Scale.z, Translation.z,
+                     0.0f,              0.0f,              0.0f,          1.0f
+    };
+}
+
+// NOTE(ismail): A * B when both are affine, 3x4 by 3x4 instead of full 4x4 product
+inline void AffineMul(const mat4& A, const mat4& B, mat4& Result)
+{
+    for (i32 Row = 0; Row < 3; ++Row) {
+        real32 a0 = A.mat[Row][0];
+        real32 a1 = A.mat[Row][1];
+        real32 a2 = A.mat[Row][2];
+
+        Result.mat[Row][0] = a0 * B.mat[0][0] + a1 * B.mat[1][0] + a2 * B.mat[2][0];
+        Result.mat[Row][1] = a0 * B.mat[0][1] + a1 * B.mat[1][1] + a2 * B.mat[2][1];
+        Result.mat[Row][2] = a0 * B.mat[0][2] + a1 * B.mat[1][2] + a2 * B.mat[2][2];
+        Result.mat[Row][3] = a0 * B.mat[0][3] + a1 * B.mat[1][3] + a2 * B.mat[2][3] + A.mat[Row][3];
+    }
+
+    Result.mat[3][0] = 0.0f;
+    Result.mat[3][1] = 0.0f;
+    Result.mat[3][2] = 0.0f;
+    Result.mat[3][3] = 1.0f;
+}
+
 inline void MakePerspProjection(mat4& Result, real32 FovInDegree, real32 AspectRatio, real32 NearZ, real32 FarZ)
 {
     real32 d = 1 / Tan(DEGREE_TO_RAD(FovInDegree / 2.0f));
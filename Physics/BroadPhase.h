@@ -0,0 +1,866 @@
+#ifndef TEARA_PHYSICS_BROAD_PHASE_H_
+#define TEARA_PHYSICS_BROAD_PHASE_H_
+
+#include "Core/Types.h"
+#include "Core/Debug.h"
+#include "Math/Vector.h"
+#include "CollisionDetection.h"
+
+#define AABB_TREE_NULL_NODE                 (-1)
+#define AABB_TREE_DISPLACEMENT_MULTIPLIER   (2.0f)
+#define AABB_TREE_QUERY_STACK_SIZE          (256)
+#define AABB_TREE_PAIRS_STACK_SIZE          (1024)
+#define SAP_NULL_PROXY                      (-1)
+#define SAP_MAX_ENDPOINT_FLAG               (0x80000000u)
+#define SAP_RESORT_THRESHOLD                (64)
+
+struct BroadPhasePair {
+    i32 ProxyA; // NOTE(ismail): always ProxyA < ProxyB
+    i32 ProxyB;
+};
+
+// NOTE(ismail): leaves hold fattened boxes so small moves don't touch the tree,
+// Children[0] == AABB_TREE_NULL_NODE marks a leaf, Height == -1 marks a free node
+struct AABBTreeNode {
+    AABB    FatBox;
+    void*   UserData;
+    union {
+        i32 Parent;
+        i32 NextFree;
+    };
+    i32     Children[2];
+    i32     Height;
+};
+
+// NOTE(ismail): node memory belongs to caller, tree with N proxies needs 2 * N - 1 nodes.
+// When nodes run out AABBTreeInsert fails, caller may give bigger memory with AABBTreeGrow and insert again
+struct AABBTree {
+    AABBTreeNode*   Nodes;
+    i32             NodesCapacity;
+    i32             NodesAmount;
+    i32             Root;
+    i32             FreeList;
+    real32          FatMargin;
+};
+
+inline AABB AABBUnion(const AABB& A, const AABB& B)
+{
+    AABB Result;
+
+    for (i32 Axis = 0; Axis < 3; ++Axis) {
+        real32 MinA = A.Center[Axis] - A.Extens[Axis];
+        real32 MinB = B.Center[Axis] - B.Extens[Axis];
+        real32 MaxA = A.Center[Axis] + A.Extens[Axis];
+        real32 MaxB = B.Center[Axis] + B.Extens[Axis];
+
+        real32 Min = MinA < MinB ? MinA : MinB;
+        real32 Max = MaxA > MaxB ? MaxA : MaxB;
+
+        Result.Center[Axis] = (Min + Max) * 0.5f;
+        Result.Extens[Axis] = (Max - Min) * 0.5f;
+    }
+
+    return Result;
+}
+
+// NOTE(ismail): half perimeter, only used to compare insertion costs. Surface area gave
+// worse trees on our flat scenes because long thin nodes are cheap by area
+inline real32 AABBCost(const AABB& Box)
+{
+    const vec3& e = Box.Extens;
+
+    real32 Result = e.x + e.y + e.z;
+
+    return Result;
+}
+
+inline bool32 AABBContains(const AABB& Outer, const AABB& Inner)
+{
+    for (i32 Axis = 0; Axis < 3; ++Axis) {
+        if (Fabs(Outer.Center[Axis] - Inner.Center[Axis]) + Inner.Extens[Axis] > Outer.Extens[Axis]) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+inline bool32 AABBTreeOverlap(const AABB& A, const AABB& B)
+{
+    if (Fabs(A.Center.x - B.Center.x) > (A.Extens.x + B.Extens.x)) return 0;
+    if (Fabs(A.Center.y - B.Center.y) > (A.Extens.y + B.Extens.y)) return 0;
+    if (Fabs(A.Center.z - B.Center.z) > (A.Extens.z + B.Extens.z)) return 0;
+
+    return 1;
+}
+
+inline bool32 AABBTreeIsLeaf(AABBTreeNode* Node)
+{
+    return Node->Children[0] == AABB_TREE_NULL_NODE;
+}
+
+inline void AABBTreeInit(AABBTree* Tree, AABBTreeNode* NodesMemory, i32 NodesCapacity, real32 FatMargin)
+{
+    Assert(NodesMemory);
+    Assert(NodesCapacity > 0);
+
+    Tree->Nodes         = NodesMemory;
+    Tree->NodesCapacity = NodesCapacity;
+    Tree->NodesAmount   = 0;
+    Tree->Root          = AABB_TREE_NULL_NODE;
+    Tree->FatMargin     = FatMargin;
+
+    for (i32 NodeIndex = 0; NodeIndex < NodesCapacity - 1; ++NodeIndex) {
+        Tree->Nodes[NodeIndex].NextFree = NodeIndex + 1;
+        Tree->Nodes[NodeIndex].Height   = -1;
+    }
+
+    Tree->Nodes[NodesCapacity - 1].NextFree = AABB_TREE_NULL_NODE;
+    Tree->Nodes[NodesCapacity - 1].Height   = -1;
+
+    Tree->FreeList = 0;
+}
+
+// NOTE(ismail): moves nodes into NewNodesMemory, proxy ids stay the same. Old memory can be released after the call
+inline void AABBTreeGrow(AABBTree* Tree, AABBTreeNode* NewNodesMemory, i32 NewNodesCapacity)
+{
+    Assert(NewNodesMemory);
+    Assert(NewNodesCapacity > Tree->NodesCapacity);
+
+    i32 OldNodesCapacity = Tree->NodesCapacity;
+
+    memcpy(NewNodesMemory, Tree->Nodes, sizeof(AABBTreeNode) * OldNodesCapacity);
+
+    for (i32 NodeIndex = OldNodesCapacity; NodeIndex < NewNodesCapacity - 1; ++NodeIndex) {
+        NewNodesMemory[NodeIndex].NextFree  = NodeIndex + 1;
+        NewNodesMemory[NodeIndex].Height    = -1;
+    }
+
+    NewNodesMemory[NewNodesCapacity - 1].NextFree   = Tree->FreeList;
+    NewNodesMemory[NewNodesCapacity - 1].Height     = -1;
+
+    Tree->Nodes         = NewNodesMemory;
+    Tree->NodesCapacity = NewNodesCapacity;
+    Tree->FreeList      = OldNodesCapacity;
+}
+
+// NOTE(ismail): callers check free nodes before they change the tree, so running out here is a bug
+inline i32 AABBTreeAllocateNode(AABBTree* Tree)
+{
+    Assert(Tree->FreeList != AABB_TREE_NULL_NODE);
+
+    i32             NodeIndex   = Tree->FreeList;
+    AABBTreeNode*   Node        = &Tree->Nodes[NodeIndex];
+
+    Tree->FreeList = Node->NextFree;
+    ++Tree->NodesAmount;
+
+    Node->Parent        = AABB_TREE_NULL_NODE;
+    Node->Children[0]   = AABB_TREE_NULL_NODE;
+    Node->Children[1]   = AABB_TREE_NULL_NODE;
+    Node->Height        = 0;
+    Node->UserData      = 0;
+
+    return NodeIndex;
+}
+
+inline void AABBTreeFreeNode(AABBTree* Tree, i32 NodeIndex)
+{
+    Assert(NodeIndex >= 0 && NodeIndex < Tree->NodesCapacity);
+    Assert(Tree->NodesAmount > 0);
+
+    AABBTreeNode* Node = &Tree->Nodes[NodeIndex];
+
+    Node->NextFree  = Tree->FreeList;
+    Node->Height    = -1;
+
+    Tree->FreeList = NodeIndex;
+    --Tree->NodesAmount;
+}
+
+inline void AABBTreeRefit(AABBTree* Tree, i32 NodeIndex)
+{
+    AABBTreeNode* Nodes = Tree->Nodes;
+    AABBTreeNode* Node  = &Nodes[NodeIndex];
+
+    AABBTreeNode* Child0 = &Nodes[Node->Children[0]];
+    AABBTreeNode* Child1 = &Nodes[Node->Children[1]];
+
+    Node->FatBox = AABBUnion(Child0->FatBox, Child1->FatBox);
+    Node->Height = 1 + (Child0->Height > Child1->Height ? Child0->Height : Child1->Height);
+}
+
+// NOTE(ismail): AVL style rotation, promotes the taller grandchild when subtree heights differ by more than one
+inline i32 AABBTreeBalance(AABBTree* Tree, i32 IndexA)
+{
+    AABBTreeNode* Nodes = Tree->Nodes;
+    AABBTreeNode* A     = &Nodes[IndexA];
+
+    if (AABBTreeIsLeaf(A) || A->Height < 2) {
+        return IndexA;
+    }
+
+    i32 IndexB = A->Children[0];
+    i32 IndexC = A->Children[1];
+
+    AABBTreeNode* B = &Nodes[IndexB];
+    AABBTreeNode* C = &Nodes[IndexC];
+
+    i32 Balance = C->Height - B->Height;
+
+    if (Balance > 1 || Balance < -1) {
+        // NOTE(ismail): lift the taller child, A keeps the other one and takes shorter grandchild in its place
+        i32 UpSlot      = Balance > 1 ? 1 : 0;
+        i32 IndexUp     = A->Children[UpSlot];
+
+        AABBTreeNode* Up = &Nodes[IndexUp];
+
+        i32 IndexF = Up->Children[0];
+        i32 IndexG = Up->Children[1];
+
+        AABBTreeNode* F = &Nodes[IndexF];
+        AABBTreeNode* G = &Nodes[IndexG];
+
+        Up->Children[0] = IndexA;
+        Up->Parent      = A->Parent;
+        A->Parent       = IndexUp;
+
+        if (Up->Parent != AABB_TREE_NULL_NODE) {
+            AABBTreeNode* Parent = &Nodes[Up->Parent];
+
+            if (Parent->Children[0] == IndexA) {
+                Parent->Children[0] = IndexUp;
+            }
+            else {
+                Assert(Parent->Children[1] == IndexA);
+                Parent->Children[1] = IndexUp;
+            }
+        }
+        else {
+            Tree->Root = IndexUp;
+        }
+
+        i32 IndexTaller     = F->Height > G->Height ? IndexF : IndexG;
+        i32 IndexShorter    = F->Height > G->Height ? IndexG : IndexF;
+
+        Up->Children[1]     = IndexTaller;
+        A->Children[UpSlot] = IndexShorter;
+        Nodes[IndexShorter].Parent = IndexA;
+
+        AABBTreeRefit(Tree, IndexA);
+        AABBTreeRefit(Tree, IndexUp);
+
+        return IndexUp;
+    }
+
+    return IndexA;
+}
+
+inline void AABBTreeInsertLeaf(AABBTree* Tree, i32 Leaf)
+{
+    AABBTreeNode* Nodes = Tree->Nodes;
+
+    if (Tree->Root == AABB_TREE_NULL_NODE) {
+        Tree->Root = Leaf;
+        Nodes[Leaf].Parent = AABB_TREE_NULL_NODE;
+
+        return;
+    }
+
+    // NOTE(ismail): walk down picking the child that grows the least, stop when making a new parent here is cheaper
+    AABB    LeafBox = Nodes[Leaf].FatBox;
+    i32     Index   = Tree->Root;
+
+    while (!AABBTreeIsLeaf(&Nodes[Index])) {
+        AABBTreeNode* Node = &Nodes[Index];
+
+        real32 Area         = AABBCost(Node->FatBox);
+        real32 CombinedArea = AABBCost(AABBUnion(Node->FatBox, LeafBox));
+
+        real32 Cost             = 2.0f * CombinedArea;
+        real32 InheritanceCost  = 2.0f * (CombinedArea - Area);
+
+        real32 ChildCost[2];
+        for (i32 ChildSlot = 0; ChildSlot < 2; ++ChildSlot) {
+            AABBTreeNode*   Child       = &Nodes[Node->Children[ChildSlot]];
+            real32          UnionCost   = AABBCost(AABBUnion(Child->FatBox, LeafBox));
+
+            if (AABBTreeIsLeaf(Child)) {
+                ChildCost[ChildSlot] = UnionCost + InheritanceCost;
+            }
+            else {
+                ChildCost[ChildSlot] = (UnionCost - AABBCost(Child->FatBox)) + InheritanceCost;
+            }
+        }
+
+        if (Cost < ChildCost[0] && Cost < ChildCost[1]) {
+            break;
+        }
+
+        Index = ChildCost[0] < ChildCost[1] ? Node->Children[0] : Node->Children[1];
+    }
+
+    i32 Sibling     = Index;
+    i32 OldParent   = Nodes[Sibling].Parent;
+    i32 NewParent   = AABBTreeAllocateNode(Tree);
+
+    AABBTreeNode* NewParentNode = &Nodes[NewParent];
+
+    NewParentNode->Parent       = OldParent;
+    NewParentNode->FatBox       = AABBUnion(LeafBox, Nodes[Sibling].FatBox);
+    NewParentNode->Height       = Nodes[Sibling].Height + 1;
+    NewParentNode->Children[0]  = Sibling;
+    NewParentNode->Children[1]  = Leaf;
+
+    Nodes[Sibling].Parent   = NewParent;
+    Nodes[Leaf].Parent      = NewParent;
+
+    if (OldParent != AABB_TREE_NULL_NODE) {
+        AABBTreeNode* OldParentNode = &Nodes[OldParent];
+
+        if (OldParentNode->Children[0] == Sibling) {
+            OldParentNode->Children[0] = NewParent;
+        }
+        else {
+            OldParentNode->Children[1] = NewParent;
+        }
+    }
+    else {
+        Tree->Root = NewParent;
+    }
+
+    for (Index = Nodes[Leaf].Parent; Index != AABB_TREE_NULL_NODE; Index = Nodes[Index].Parent) {
+        Index = AABBTreeBalance(Tree, Index);
+
+        AABBTreeRefit(Tree, Index);
+    }
+}
+
+inline void AABBTreeRemoveLeaf(AABBTree* Tree, i32 Leaf)
+{
+    AABBTreeNode* Nodes = Tree->Nodes;
+
+    if (Leaf == Tree->Root) {
+        Tree->Root = AABB_TREE_NULL_NODE;
+
+        return;
+    }
+
+    i32 Parent      = Nodes[Leaf].Parent;
+    i32 GrandParent = Nodes[Parent].Parent;
+    i32 Sibling     = Nodes[Parent].Children[0] == Leaf ? Nodes[Parent].Children[1] : Nodes[Parent].Children[0];
+
+    if (GrandParent != AABB_TREE_NULL_NODE) {
+        AABBTreeNode* GrandParentNode = &Nodes[GrandParent];
+
+        if (GrandParentNode->Children[0] == Parent) {
+            GrandParentNode->Children[0] = Sibling;
+        }
+        else {
+            GrandParentNode->Children[1] = Sibling;
+        }
+
+        Nodes[Sibling].Parent = GrandParent;
+        AABBTreeFreeNode(Tree, Parent);
+
+        for (i32 Index = GrandParent; Index != AABB_TREE_NULL_NODE; Index = Nodes[Index].Parent) {
+            Index = AABBTreeBalance(Tree, Index);
+
+            AABBTreeRefit(Tree, Index);
+        }
+    }
+    else {
+        Tree->Root = Sibling;
+        Nodes[Sibling].Parent = AABB_TREE_NULL_NODE;
+
+        AABBTreeFreeNode(Tree, Parent);
+    }
+}
+
+inline void AABBTreeFatten(AABBTree* Tree, AABB* Box, const vec3& Displacement)
+{
+    real32 Margin = Tree->FatMargin;
+
+    // NOTE(ismail): box is also stretched along predicted displacement so steady movement reinserts less often
+    for (i32 Axis = 0; Axis < 3; ++Axis) {
+        real32 Predicted = Displacement[Axis] * AABB_TREE_DISPLACEMENT_MULTIPLIER;
+
+        Box->Center[Axis] += Predicted * 0.5f;
+        Box->Extens[Axis] += Margin + Fabs(Predicted) * 0.5f;
+    }
+}
+
+// NOTE(ismail): returns proxy id, it stays valid until AABBTreeRemove. Returns AABB_TREE_NULL_NODE and leaves tree
+// untouched when there are no nodes for the leaf and its new parent
+inline i32 AABBTreeInsert(AABBTree* Tree, BoundingVolume* Volume, void* UserData)
+{
+    i32 NodesNeeded = Tree->Root == AABB_TREE_NULL_NODE ? 1 : 2;
+
+    if (Tree->NodesCapacity - Tree->NodesAmount < NodesNeeded) {
+        return AABB_TREE_NULL_NODE;
+    }
+
+    i32             Proxy   = AABBTreeAllocateNode(Tree);
+    AABBTreeNode*   Node    = &Tree->Nodes[Proxy];
+
+    BoundingVolumeToAABB(Volume, &Node->FatBox);
+    AABBTreeFatten(Tree, &Node->FatBox, vec3{ 0.0f, 0.0f, 0.0f });
+
+    Node->UserData  = UserData;
+    Node->Height    = 0;
+
+    AABBTreeInsertLeaf(Tree, Proxy);
+
+    return Proxy;
+}
+
+inline void AABBTreeRemove(AABBTree* Tree, i32 Proxy)
+{
+    Assert(Proxy >= 0 && Proxy < Tree->NodesCapacity);
+    Assert(AABBTreeIsLeaf(&Tree->Nodes[Proxy]));
+
+    AABBTreeRemoveLeaf(Tree, Proxy);
+    AABBTreeFreeNode(Tree, Proxy);
+}
+
+// NOTE(ismail): returns 1 when proxy left its fat box and was reinserted, removal frees the node reinsertion takes
+inline bool32 AABBTreeMove(AABBTree* Tree, i32 Proxy, BoundingVolume* Volume, const vec3& Displacement)
+{
+    Assert(Proxy >= 0 && Proxy < Tree->NodesCapacity);
+    Assert(AABBTreeIsLeaf(&Tree->Nodes[Proxy]));
+
+    AABB TightBox;
+    BoundingVolumeToAABB(Volume, &TightBox);
+
+    AABBTreeNode* Node = &Tree->Nodes[Proxy];
+
+    if (AABBContains(Node->FatBox, TightBox)) {
+        return 0;
+    }
+
+    AABBTreeRemoveLeaf(Tree, Proxy);
+
+    Node->FatBox = TightBox;
+    AABBTreeFatten(Tree, &Node->FatBox, Displacement);
+
+    AABBTreeInsertLeaf(Tree, Proxy);
+
+    return 1;
+}
+
+inline void* AABBTreeGetUserData(AABBTree* Tree, i32 Proxy)
+{
+    Assert(Proxy >= 0 && Proxy < Tree->NodesCapacity);
+
+    return Tree->Nodes[Proxy].UserData;
+}
+
+// NOTE(ismail): walks subtree of Start with fixed stack. Stack is deeper than any balanced tree needs,
+// if it is full anyway the child is walked by nested call with its own stack
+inline i32 AABBTreeQueryFrom(AABBTree* Tree, i32 Start, AABB* Box, i32* Proxies, i32 MaxProxies, i32 Found)
+{
+    i32 Stack[AABB_TREE_QUERY_STACK_SIZE];
+    i32 StackSize = 0;
+
+    Stack[StackSize++] = Start;
+
+    while (StackSize > 0) {
+        i32             Index   = Stack[--StackSize];
+        AABBTreeNode*   Node    = &Tree->Nodes[Index];
+
+        if (!AABBTreeOverlap(Node->FatBox, *Box)) {
+            continue;
+        }
+
+        if (AABBTreeIsLeaf(Node)) {
+            if (Found < MaxProxies) {
+                Proxies[Found] = Index;
+            }
+
+            ++Found;
+
+            continue;
+        }
+
+        for (i32 ChildSlot = 0; ChildSlot < 2; ++ChildSlot) {
+            if (StackSize < AABB_TREE_QUERY_STACK_SIZE) {
+                Stack[StackSize++] = Node->Children[ChildSlot];
+            }
+            else {
+                Found = AABBTreeQueryFrom(Tree, Node->Children[ChildSlot], Box, Proxies, MaxProxies, Found);
+            }
+        }
+    }
+
+    return Found;
+}
+
+// NOTE(ismail): writes proxies whose fat boxes overlap Box, returns how many were found,
+// anything past MaxProxies is counted but not written
+inline i32 AABBTreeQuery(AABBTree* Tree, AABB* Box, i32* Proxies, i32 MaxProxies)
+{
+    if (Tree->Root == AABB_TREE_NULL_NODE) {
+        return 0;
+    }
+
+    return AABBTreeQueryFrom(Tree, Tree->Root, Box, Proxies, MaxProxies, 0);
+}
+
+inline i32 AABBTreeQueryPairsFrom(AABBTree* Tree, i32 StartA, i32 StartB, BroadPhasePair* Pairs, i32 MaxPairs, i32 Found);
+
+// NOTE(ismail): same as in AABBTreeQueryFrom, full stack spills into nested walk instead of overflowing
+inline void AABBTreePushPair(AABBTree* Tree, i32 (*Stack)[2], i32* StackSize, i32 IndexA, i32 IndexB,
+                             BroadPhasePair* Pairs, i32 MaxPairs, i32* Found)
+{
+    if (*StackSize < AABB_TREE_PAIRS_STACK_SIZE) {
+        Stack[*StackSize][0] = IndexA;
+        Stack[*StackSize][1] = IndexB;
+        ++*StackSize;
+    }
+    else {
+        *Found = AABBTreeQueryPairsFrom(Tree, IndexA, IndexB, Pairs, MaxPairs, *Found);
+    }
+}
+
+// NOTE(ismail): (Node, Node) on the stack means "pairs inside this subtree", (A, B) means "pairs between two subtrees"
+inline i32 AABBTreeQueryPairsFrom(AABBTree* Tree, i32 StartA, i32 StartB, BroadPhasePair* Pairs, i32 MaxPairs, i32 Found)
+{
+    i32 Stack[AABB_TREE_PAIRS_STACK_SIZE][2];
+    i32 StackSize = 0;
+
+    AABBTreeNode* Nodes = Tree->Nodes;
+
+    AABBTreePushPair(Tree, Stack, &StackSize, StartA, StartB, Pairs, MaxPairs, &Found);
+
+    while (StackSize > 0) {
+        --StackSize;
+
+        i32 IndexA = Stack[StackSize][0];
+        i32 IndexB = Stack[StackSize][1];
+
+        AABBTreeNode* A = &Nodes[IndexA];
+        AABBTreeNode* B = &Nodes[IndexB];
+
+        if (IndexA == IndexB) {
+            if (AABBTreeIsLeaf(A)) {
+                continue;
+            }
+
+            i32 Child0 = A->Children[0];
+            i32 Child1 = A->Children[1];
+
+            AABBTreePushPair(Tree, Stack, &StackSize, Child0, Child0, Pairs, MaxPairs, &Found);
+            AABBTreePushPair(Tree, Stack, &StackSize, Child1, Child1, Pairs, MaxPairs, &Found);
+            AABBTreePushPair(Tree, Stack, &StackSize, Child0, Child1, Pairs, MaxPairs, &Found);
+
+            continue;
+        }
+
+        if (!AABBTreeOverlap(A->FatBox, B->FatBox)) {
+            continue;
+        }
+
+        bool32 LeafA = AABBTreeIsLeaf(A);
+        bool32 LeafB = AABBTreeIsLeaf(B);
+
+        if (LeafA && LeafB) {
+            if (Found < MaxPairs) {
+                Pairs[Found].ProxyA = IndexA < IndexB ? IndexA : IndexB;
+                Pairs[Found].ProxyB = IndexA < IndexB ? IndexB : IndexA;
+            }
+
+            ++Found;
+        }
+        else if (LeafB || (!LeafA && AABBCost(A->FatBox) >= AABBCost(B->FatBox))) {
+            // NOTE(ismail): split the bigger box, it prunes more than splitting the deeper one
+            AABBTreePushPair(Tree, Stack, &StackSize, A->Children[0], IndexB, Pairs, MaxPairs, &Found);
+            AABBTreePushPair(Tree, Stack, &StackSize, A->Children[1], IndexB, Pairs, MaxPairs, &Found);
+        }
+        else {
+            AABBTreePushPair(Tree, Stack, &StackSize, IndexA, B->Children[0], Pairs, MaxPairs, &Found);
+            AABBTreePushPair(Tree, Stack, &StackSize, IndexA, B->Children[1], Pairs, MaxPairs, &Found);
+        }
+    }
+
+    return Found;
+}
+
+// NOTE(ismail): descends the tree against itself, so every overlapping pair comes out exactly once and no dedup pass is needed.
+// Anything past MaxPairs is counted but not written
+inline i32 AABBTreeQueryPairs(AABBTree* Tree, BroadPhasePair* Pairs, i32 MaxPairs)
+{
+    if (Tree->Root == AABB_TREE_NULL_NODE) {
+        return 0;
+    }
+
+    return AABBTreeQueryPairsFrom(Tree, Tree->Root, Tree->Root, Pairs, MaxPairs, 0);
+}
+
+// NOTE(ismail): sort-and-sweep along one axis, endpoints stay sorted between frames so
+// insertion sort only has to fix up what moved. Pick the axis objects are most spread along
+// (x or z for units on terrain), y would put everything into one long overlap
+struct SAPEndpoint {
+    real32  Value;
+    u32     Proxy;  // NOTE(ismail): SAP_MAX_ENDPOINT_FLAG set for max endpoint
+};
+
+struct SAPProxy {
+    AABB    Box;
+    void*   UserData;
+    i32     Endpoints[2];   // NOTE(ismail): min and max endpoint indices, or next free proxy in Endpoints[0]
+    i32     ActiveIndex;
+};
+
+struct SweepAndPrune {
+    SAPProxy*       Proxies;
+    SAPEndpoint*    Endpoints;
+    i32*            Active;
+
+    i32             ProxiesCapacity;
+    i32             ProxiesAmount;
+    i32             EndpointsAmount;
+    i32             FreeList;
+    i32             Axis;
+
+    // NOTE(ismail): endpoints added or removed since last sort, past SAP_RESORT_THRESHOLD
+    // a full qsort is cheaper than insertion sort of unsorted tail
+    i32             ChangedAmount;
+    i32             RemovedAmount;
+};
+
+inline u64 SweepAndPruneMemorySize(i32 ProxiesCapacity)
+{
+    u64 Result = (u64)ProxiesCapacity * (sizeof(SAPProxy) + 2 * sizeof(SAPEndpoint) + sizeof(i32));
+
+    return Result;
+}
+
+// NOTE(ismail): Memory must hold SweepAndPruneMemorySize(ProxiesCapacity) bytes
+inline void SweepAndPruneInit(SweepAndPrune* SAP, void* Memory, i32 ProxiesCapacity, i32 Axis)
+{
+    Assert(Memory);
+    Assert(ProxiesCapacity > 0);
+    Assert(Axis >= 0 && Axis < 3);
+
+    SAP->Proxies    = (SAPProxy*)Memory;
+    SAP->Endpoints  = (SAPEndpoint*)(SAP->Proxies + ProxiesCapacity);
+    SAP->Active     = (i32*)(SAP->Endpoints + 2 * ProxiesCapacity);
+
+    SAP->ProxiesCapacity    = ProxiesCapacity;
+    SAP->ProxiesAmount      = 0;
+    SAP->EndpointsAmount    = 0;
+    SAP->Axis               = Axis;
+    SAP->ChangedAmount      = 0;
+    SAP->RemovedAmount      = 0;
+
+    for (i32 ProxyIndex = 0; ProxyIndex < ProxiesCapacity - 1; ++ProxyIndex) {
+        SAP->Proxies[ProxyIndex].Endpoints[0] = ProxyIndex + 1;
+    }
+
+    SAP->Proxies[ProxiesCapacity - 1].Endpoints[0] = SAP_NULL_PROXY;
+
+    SAP->FreeList = 0;
+}
+
+// NOTE(ismail): mins go before maxes on equal values so touching boxes count as overlapping,
+// same as AABBToAABBTestOverlap
+inline bool32 SAPEndpointLess(const SAPEndpoint& A, const SAPEndpoint& B)
+{
+    if (A.Value != B.Value) {
+        return A.Value < B.Value;
+    }
+
+    return !(A.Proxy & SAP_MAX_ENDPOINT_FLAG) && (B.Proxy & SAP_MAX_ENDPOINT_FLAG);
+}
+
+inline void SAPSetEndpoint(SweepAndPrune* SAP, i32 EndpointIndex, const SAPEndpoint& Endpoint)
+{
+    SAP->Endpoints[EndpointIndex] = Endpoint;
+
+    u32 Proxy   = Endpoint.Proxy & ~SAP_MAX_ENDPOINT_FLAG;
+    i32 Side    = (Endpoint.Proxy & SAP_MAX_ENDPOINT_FLAG) ? 1 : 0;
+
+    SAP->Proxies[Proxy].Endpoints[Side] = EndpointIndex;
+}
+
+static int SAPEndpointCompare(const void* A, const void* B)
+{
+    const SAPEndpoint* EndpointA = (const SAPEndpoint*)A;
+    const SAPEndpoint* EndpointB = (const SAPEndpoint*)B;
+
+    if (SAPEndpointLess(*EndpointA, *EndpointB)) {
+        return -1;
+    }
+    if (SAPEndpointLess(*EndpointB, *EndpointA)) {
+        return 1;
+    }
+
+    return 0;
+}
+
+// NOTE(ismail): O(n + swaps), with slow moving objects swaps are few. Removed proxies have
+// both endpoints at INFINITY, they end up at the tail and are released here
+inline void SweepAndPruneSort(SweepAndPrune* SAP)
+{
+    SAPEndpoint* Endpoints = SAP->Endpoints;
+
+    if (SAP->ChangedAmount > SAP_RESORT_THRESHOLD) {
+        qsort(Endpoints, SAP->EndpointsAmount, sizeof(*Endpoints), SAPEndpointCompare);
+
+        for (i32 Index = 0; Index < SAP->EndpointsAmount; ++Index) {
+            SAPSetEndpoint(SAP, Index, Endpoints[Index]);
+        }
+    }
+    else {
+        for (i32 Index = 1; Index < SAP->EndpointsAmount; ++Index) {
+            SAPEndpoint Key = Endpoints[Index];
+
+            if (!SAPEndpointLess(Key, Endpoints[Index - 1])) {
+                continue;
+            }
+
+            i32 Position = Index;
+            while (Position > 0 && SAPEndpointLess(Key, Endpoints[Position - 1])) {
+                SAPSetEndpoint(SAP, Position, Endpoints[Position - 1]);
+                --Position;
+            }
+
+            SAPSetEndpoint(SAP, Position, Key);
+        }
+    }
+
+    for (i32 Trimmed = 0; Trimmed < 2 * SAP->RemovedAmount; ++Trimmed) {
+        SAPEndpoint& Tail = Endpoints[SAP->EndpointsAmount - 1];
+
+        Assert(Tail.Value == INFINITY);
+
+        if (Tail.Proxy & SAP_MAX_ENDPOINT_FLAG) {
+            i32 Proxy = (i32)(Tail.Proxy & ~SAP_MAX_ENDPOINT_FLAG);
+
+            SAP->Proxies[Proxy].Endpoints[0] = SAP->FreeList;
+            SAP->FreeList = Proxy;
+        }
+
+        --SAP->EndpointsAmount;
+    }
+
+    SAP->ChangedAmount      = 0;
+    SAP->RemovedAmount      = 0;
+}
+
+inline void SAPWriteEndpointValues(SweepAndPrune* SAP, i32 Proxy)
+{
+    SAPProxy&   ProxyData   = SAP->Proxies[Proxy];
+    i32         Axis        = SAP->Axis;
+
+    SAP->Endpoints[ProxyData.Endpoints[0]].Value = ProxyData.Box.Center[Axis] - ProxyData.Box.Extens[Axis];
+    SAP->Endpoints[ProxyData.Endpoints[1]].Value = ProxyData.Box.Center[Axis] + ProxyData.Box.Extens[Axis];
+}
+
+// NOTE(ismail): endpoints are appended unsorted and go into place with next sort, returns proxy id
+inline i32 SweepAndPruneInsert(SweepAndPrune* SAP, BoundingVolume* Volume, void* UserData)
+{
+    // NOTE(ismail): removed proxies are reused only after next sort
+    Assert(SAP->FreeList != SAP_NULL_PROXY);
+
+    i32         Proxy       = SAP->FreeList;
+    SAPProxy&   ProxyData   = SAP->Proxies[Proxy];
+
+    SAP->FreeList = ProxyData.Endpoints[0];
+    ++SAP->ProxiesAmount;
+
+    BoundingVolumeToAABB(Volume, &ProxyData.Box);
+    ProxyData.UserData      = UserData;
+    ProxyData.ActiveIndex   = SAP_NULL_PROXY;
+
+    SAPEndpoint MinEndpoint = { 0.0f, (u32)Proxy };
+    SAPEndpoint MaxEndpoint = { 0.0f, (u32)Proxy | SAP_MAX_ENDPOINT_FLAG };
+
+    SAPSetEndpoint(SAP, SAP->EndpointsAmount++, MinEndpoint);
+    SAPSetEndpoint(SAP, SAP->EndpointsAmount++, MaxEndpoint);
+
+    SAPWriteEndpointValues(SAP, Proxy);
+
+    SAP->ChangedAmount += 2;
+
+    return Proxy;
+}
+
+inline void SweepAndPruneRemove(SweepAndPrune* SAP, i32 Proxy)
+{
+    Assert(Proxy >= 0 && Proxy < SAP->ProxiesCapacity);
+
+    SAPProxy& ProxyData = SAP->Proxies[Proxy];
+
+    SAP->Endpoints[ProxyData.Endpoints[0]].Value = INFINITY;
+    SAP->Endpoints[ProxyData.Endpoints[1]].Value = INFINITY;
+
+    SAP->ChangedAmount += 2;
+    ++SAP->RemovedAmount;
+    --SAP->ProxiesAmount;
+}
+
+// NOTE(ismail): only stores new box, endpoints are re-sorted once per SweepAndPruneQueryPairs
+inline void SweepAndPruneMove(SweepAndPrune* SAP, i32 Proxy, BoundingVolume* Volume)
+{
+    Assert(Proxy >= 0 && Proxy < SAP->ProxiesCapacity);
+
+    BoundingVolumeToAABB(Volume, &SAP->Proxies[Proxy].Box);
+    SAPWriteEndpointValues(SAP, Proxy);
+}
+
+inline void* SweepAndPruneGetUserData(SweepAndPrune* SAP, i32 Proxy)
+{
+    Assert(Proxy >= 0 && Proxy < SAP->ProxiesCapacity);
+
+    return SAP->Proxies[Proxy].UserData;
+}
+
+// NOTE(ismail): every pair is reported once, when sweep reaches min endpoint of the second proxy
+// while the first one is still active, so the list needs no dedup
+inline i32 SweepAndPruneQueryPairs(SweepAndPrune* SAP, BroadPhasePair* Pairs, i32 MaxPairs)
+{
+    SweepAndPruneSort(SAP);
+
+    SAPProxy*       Proxies         = SAP->Proxies;
+    SAPEndpoint*    Endpoints       = SAP->Endpoints;
+    i32*            Active          = SAP->Active;
+    i32             ActiveAmount    = 0;
+    i32             Found           = 0;
+
+    for (i32 Index = 0; Index < SAP->EndpointsAmount; ++Index) {
+        u32         Tagged      = Endpoints[Index].Proxy;
+        i32         Proxy       = (i32)(Tagged & ~SAP_MAX_ENDPOINT_FLAG);
+        SAPProxy&   ProxyData   = Proxies[Proxy];
+
+        if (Tagged & SAP_MAX_ENDPOINT_FLAG) {
+            i32 Last = Active[--ActiveAmount];
+
+            Active[ProxyData.ActiveIndex]   = Last;
+            Proxies[Last].ActiveIndex       = ProxyData.ActiveIndex;
+            ProxyData.ActiveIndex           = SAP_NULL_PROXY;
+
+            continue;
+        }
+
+        for (i32 ActiveIndex = 0; ActiveIndex < ActiveAmount; ++ActiveIndex) {
+            i32 Other = Active[ActiveIndex];
+
+            if (AABBToAABBTestOverlap(&ProxyData.Box, &Proxies[Other].Box)) {
+                if (Found < MaxPairs) {
+                    Pairs[Found].ProxyA = Proxy < Other ? Proxy : Other;
+                    Pairs[Found].ProxyB = Proxy < Other ? Other : Proxy;
+                }
+
+                ++Found;
+            }
+        }
+
+        ProxyData.ActiveIndex   = ActiveAmount;
+        Active[ActiveAmount++]  = Proxy;
+    }
+
+    return Found;
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include "Math/Matrix.h"
 
 #define OBB_EPSILON 0.0001f
+#define AABB_SOA_LANES 8
 
 enum BoundingVolumeType {
     SphereVolume,
@@ -31,7 +32,7 @@ struct OBB {
 
 union BoundingVolumes {
     AABB            AxisBox;
-    Sphere          Sphere;
+    ::Sphere        Sphere;
     OBB             OrientedBox;
 };
 
@@ -56,9 +57,44 @@ void AABBRecalculate(mat4 *Rotation, vec3 *Translation, AABB *Original, AABB *Re
     }
 }
 
+// NOTE (ismail): world space box that encloses any volume, used by broad phase
+void BoundingVolumeToAABB(BoundingVolume *Volume, AABB *Result)
+{
+    switch (Volume->VolumeType) {
+        case SphereVolume: {
+            Sphere *Data = &Volume->VolumeData.Sphere;
+
+            Result->Center = Data->Center;
+            Result->Extens = { Data->Radius, Data->Radius, Data->Radius };
+        } break;
+
+        case AABBVolume: {
+            *Result = Volume->VolumeData.AxisBox;
+        } break;
+
+        case OBBVolume: {
+            OBB *Data = &Volume->VolumeData.OrientedBox;
+
+            Result->Center = Data->Center;
+
+            for (i32 i = 0; i < 3; ++i) {
+                Result->Extens[i] = 0.0f;
+
+                for (i32 j = 0; j < 3; ++j) {
+                    Result->Extens[i] += Fabs(Data->Axis[j][i]) * Data->Extens[j];
+                }
+            }
+        } break;
+
+        default: {
+            Assert(0); // NOTE (ismail): unknown bounding volume type
+        } break;
+    }
+}
+
 bool32 AABBToAABBTestOverlap(AABB *A, AABB *B)
 {
-    // TODO (ismail): convert to SIMD
+    // NOTE (ismail): one box against many goes through AABBSoA and AABBToAABBTestOverlap4/8, this is single pair test
     // TODO (ismail): may be calculate A.Center - B.Center one time and use it?
     
     if (Fabs(A->Center.x - B->Center.x) > (A->Extens.x + B->Extens.x)) {
@@ -76,24 +112,19 @@ bool32 AABBToAABBTestOverlap(AABB *A, AABB *B)
 
 bool32 SphereToAABBTestOverlap(AABB *A, Sphere *B)
 {
-    vec3 DistanceVector = A->Center - B->Center;
-    real32 DistanceSquare = vec3::DotProduct(DistanceVector, DistanceVector);
+    // NOTE (ismail): squared distance from sphere center to closest point on box,
+    // per axis only the part of |Cs - Cb| that sticks out of box extent counts
+    real32 DistanceSquare = 0.0f;
 
-    real32 RadiusSumX = A->Extens.x + B->Radius;
-    real32 RadiusSumY = A->Extens.y + B->Radius;
-    real32 RadiusSumZ = A->Extens.z + B->Radius;
+    for (i32 i = 0; i < 3; ++i) {
+        real32 Outside = Fabs(B->Center[i] - A->Center[i]) - A->Extens[i];
 
-    if (DistanceSquare > SQUARE(RadiusSumX)) {
-        return 0;
-    }
-    if (DistanceSquare > SQUARE(RadiusSumY)) {
-        return 0;
-    }
-    if (DistanceSquare > SQUARE(RadiusSumZ)) {
-        return 0;
+        if (Outside > 0.0f) {
+            DistanceSquare += SQUARE(Outside);
+        }
     }
 
-    return 1;
+    return DistanceSquare <= SQUARE(B->Radius);
 }
 
 bool32 SphereToSphereTestOverlap(Sphere *A, Sphere *B)
@@ -107,23 +138,80 @@ bool32 SphereToSphereTestOverlap(Sphere *A, Sphere *B)
     return DistanceSquare < RadiusSquare;
 }
 
-bool32 OBBToOBBTestOverlap(OBB *A, OBB *B)
+// NOTE (ismail): separating axes are numbered 0..2 for Ax..Az, 3..5 for Bx..Bz and
+// 6 + 3 * i + j for Ai X Bj, OBB_NO_SEPARATING_AXIS means boxes overlap
+#define OBB_NO_SEPARATING_AXIS  (-1)
+#define OBB_SEPARATING_AXES     (15)
+
+// NOTE (ismail): test one axis without building whole R, only dot products this axis needs are computed.
+// Formulas are the same as in OBBFindSeparatingAxis so both always agree
+bool32 OBBSeparatedOnAxis(OBB *A, OBB *B, i32 Axis)
 {
-    // TODO (ismail): use this for all magic numbers into this function
-    enum _local { x = 0, y = 1, z = 2 };
+    Assert(Axis >= 0 && Axis < OBB_SEPARATING_AXES);
+
+    real32 ProjT, MaxA, MaxB;
+    vec3 T = B->Center - A->Center;
+
+    if (Axis < 3) {
+        i32 i = Axis;
 
-    // TODO (ismail): T * (Ax X Bx) = (T * Az) * (Ay * Bx) - (T * Ay) * (Az * Bx) optimization
-    // TODO (ismail): refactoring
-    // TODO (ismail): optimization when we aligned any other three axis
+        ProjT = Fabs(vec3::DotProduct(T, A->Axis[i]));
+        MaxA = A->Extens[i];
+        MaxB = 0.0f;
+
+        for (i32 j = 0; j < 3; ++j) {
+            MaxB += B->Extens[j] * (Fabs(vec3::DotProduct(A->Axis[i], B->Axis[j])) + OBB_EPSILON);
+        }
+    }
+    else if (Axis < 6) {
+        i32 j = Axis - 3;
+
+        ProjT = 0.0f;
+        MaxA = 0.0f;
+        MaxB = B->Extens[j];
 
+        for (i32 i = 0; i < 3; ++i) {
+            real32 Rij = vec3::DotProduct(A->Axis[i], B->Axis[j]);
+
+            ProjT += vec3::DotProduct(T, A->Axis[i]) * Rij;
+            MaxA += A->Extens[i] * (Fabs(Rij) + OBB_EPSILON);
+        }
+
+        ProjT = Fabs(ProjT);
+    }
+    else {
+        i32 i = (Axis - 6) / 3;
+        i32 j = (Axis - 6) % 3;
+
+        i32 i1 = (i + 1) % 3;
+        i32 i2 = (i + 2) % 3;
+        i32 j1 = (j + 1) % 3;
+        i32 j2 = (j + 2) % 3;
+
+        real32 Ri1j = vec3::DotProduct(A->Axis[i1], B->Axis[j]);
+        real32 Ri2j = vec3::DotProduct(A->Axis[i2], B->Axis[j]);
+        real32 Rij1 = vec3::DotProduct(A->Axis[i], B->Axis[j1]);
+        real32 Rij2 = vec3::DotProduct(A->Axis[i], B->Axis[j2]);
+
+        ProjT = Fabs(vec3::DotProduct(T, A->Axis[i2]) * Ri1j - vec3::DotProduct(T, A->Axis[i1]) * Ri2j);
+        MaxA = A->Extens[i1] * (Fabs(Ri2j) + OBB_EPSILON) + A->Extens[i2] * (Fabs(Ri1j) + OBB_EPSILON);
+        MaxB = B->Extens[j1] * (Fabs(Rij2) + OBB_EPSILON) + B->Extens[j2] * (Fabs(Rij1) + OBB_EPSILON);
+    }
+
+    return ProjT > MaxA + MaxB;
+}
+
+// NOTE (ismail): returns first separating axis in the order above or OBB_NO_SEPARATING_AXIS
+i32 OBBFindSeparatingAxis(OBB *A, OBB *B)
+{
     mat3 R, AbsR;
     real32 ProjT, MaxA, MaxB;
-    vec3 EdgesCrossProduct;
     vec3 T = B->Center - A->Center;
 
     // NOTE (ismail): compute Ax * Bx, Ax * By, Ax * Bz 
     //                        Ay * Bx, Ay * By, Ay * Bz => AT * B
     //                        Az * Bx, Az * By, Az * Bz
+    // epsilon keeps AbsR away from zero when edges are parallel and cross product degenerates
     for (i32 i = 0; i < 3; ++i) {
         for (i32 j = 0; j < 3; ++j) {
             R[i][j] = vec3::DotProduct(A->Axis[i], B->Axis[j]);
@@ -131,133 +219,501 @@ bool32 OBBToOBBTestOverlap(OBB *A, OBB *B)
         }
     }
 
-    // NOTE (ismail): check A three axis first (Ax, Ay, Az)
-    //  L = Ax
-    // |T * Ax| > Eax + |Ebx * Bx * Ax| + |Eby * By * Ax| + |Ebz * Bz * Ax|
-    //  L = Ay
-    // |T * Ay| > Eay + |Ebx * Bx * Ay| + |Eby * By * Ay| + |Ebz * Bz * Ay|
-    //  L = Az
-    // |T * Az| > Eaz + |Ebx * Bx * Az| + |Eby * By * Az| + |Ebz * Bz * Az|
+    // NOTE (ismail): T in A frame, every other axis projection is built from it and R
+    real32 t[3] = {
+        vec3::DotProduct(T, A->Axis[0]),
+        vec3::DotProduct(T, A->Axis[1]),
+        vec3::DotProduct(T, A->Axis[2]),
+    };
+
+    // NOTE (ismail): L = Ai
+    // |T * Ai| > Eai + |Ebx * Bx * Ai| + |Eby * By * Ai| + |Ebz * Bz * Ai|
     for (i32 i = 0; i < 3; ++i) {
-        ProjT = Fabs(vec3::DotProduct(T, A->Axis[i]));
+        ProjT = Fabs(t[i]);
         MaxA = A->Extens[i];
         MaxB = B->Extens[0] * AbsR[i][0] + B->Extens[1] * AbsR[i][1] + B->Extens[2] * AbsR[i][2];
 
         if (ProjT > MaxA + MaxB) {
-            return 0;
+            return i;
         }
     }
 
-    // NOTE (ismail): check B three axis (Bx, By, Bz)
-    //  L = Bx
-    // |T * Bx| > Ebx + |Eax * Ax * Bx| + |Eay * Ay * Bx| + |Eaz * Az * Bx|
-    //  L = By
-    // |T * By| > Eby + |Eax * Ax * By| + |Eay * Ay * By| + |Eaz * Az * By|
-    //  L = Bz
-    // |T * Bz| > Ebz + |Eax * Ax * Bz| + |Eay * Ay * Bz| + |Eaz * Az * Bz|
-    for (i32 i = 0; i < 3; ++i) {
-        ProjT = Fabs(vec3::DotProduct(T, B->Axis[i]));
-        MaxA = A->Extens[0] * AbsR[0][i] + A->Extens[1] * AbsR[1][i] + A->Extens[2] * AbsR[2][i];
-        MaxB = B->Extens[i];
+    // NOTE (ismail): L = Bj, T * Bj = t * (AT * Bj) = t0 * R0j + t1 * R1j + t2 * R2j
+    // |T * Bj| > Ebj + |Eax * Ax * Bj| + |Eay * Ay * Bj| + |Eaz * Az * Bj|
+    for (i32 j = 0; j < 3; ++j) {
+        ProjT = Fabs(t[0] * R[0][j] + t[1] * R[1][j] + t[2] * R[2][j]);
+        MaxA = A->Extens[0] * AbsR[0][j] + A->Extens[1] * AbsR[1][j] + A->Extens[2] * AbsR[2][j];
+        MaxB = B->Extens[j];
 
         if (ProjT > MaxA + MaxB) {
-            return 0;
+            return 3 + j;
         }
     }
 
-    // NOTE (ismail): check nine edges
+    // NOTE (ismail): L = Ai X Bj, with (i, i1, i2) and (j, j1, j2) cyclic
+    // scalar triple product T * (Ai X Bj) = (T * Ai2) * (Ai1 * Bj) - (T * Ai1) * (Ai2 * Bj) = t[i2] * R[i1][j] - t[i1] * R[i2][j]
+    // |T * (Ai X Bj)| > Eai1 * |R[i2][j]| + Eai2 * |R[i1][j]| + Ebj1 * |R[i][j2]| + Ebj2 * |R[i][j1]|
+    for (i32 i = 0; i < 3; ++i) {
+        i32 i1 = (i + 1) % 3;
+        i32 i2 = (i + 2) % 3;
 
-    //  L = Ax X Bx
-    // |T * (Ax X Bx)| > |-Eay * Bx * Az| + |Eaz * Bx * Ay| + |Eby * Ax * Bz| + |-Ebz * Ax * By|
-    ProjT = vec3::DotProduct(T, A->Axis[0].Cross(B->Axis[0]));
-    MaxA = A->Extens[1] * AbsR[2][0] + A->Extens[2] * AbsR[1][0];
-    MaxB = B->Extens[1] * AbsR[0][2] + B->Extens[2] * AbsR[0][1];
-    
-    if (ProjT > MaxA + MaxB) {
-        return 0;
+        for (i32 j = 0; j < 3; ++j) {
+            i32 j1 = (j + 1) % 3;
+            i32 j2 = (j + 2) % 3;
+
+            ProjT = Fabs(t[i2] * R[i1][j] - t[i1] * R[i2][j]);
+            MaxA = A->Extens[i1] * AbsR[i2][j] + A->Extens[i2] * AbsR[i1][j];
+            MaxB = B->Extens[j1] * AbsR[i][j2] + B->Extens[j2] * AbsR[i][j1];
+
+            if (ProjT > MaxA + MaxB) {
+                return 6 + 3 * i + j;
+            }
+        }
     }
 
-    //  L = Ax X By
-    // |T * (Ax X By)| > |-Eay * By * Az| + |Eaz * By * Ay| + |-Ebx * Ax * Bz| + |Ebz * Ax * Bx|
-    ProjT = vec3::DotProduct(T, A->Axis[x].Cross(B->Axis[y]));
-    MaxA = A->Extens[y] * AbsR[z][y] + A->Extens[z] * AbsR[y][y];
-    MaxB = B->Extens[x] * AbsR[x][z] + B->Extens[z] * AbsR[x][x];
-    
-    if (ProjT > MaxA + MaxB) {
+    return OBB_NO_SEPARATING_AXIS;
+}
+
+bool32 OBBToOBBTestOverlap(OBB *A, OBB *B)
+{
+    return OBBFindSeparatingAxis(A, B) == OBB_NO_SEPARATING_AXIS;
+}
+
+// NOTE (ismail): objects move a little between frames so axis that separated a pair last frame
+// usually still does, checking it first turns most separated pairs into a single axis test
+bool32 OBBToOBBTestOverlapCached(OBB *A, OBB *B, i32 *CachedAxis)
+{
+    if (*CachedAxis != OBB_NO_SEPARATING_AXIS && OBBSeparatedOnAxis(A, B, *CachedAxis)) {
         return 0;
     }
 
-    //  L = Ax X Bz
-    // |T * (Ax X Bz)| > |-Eay * Bz * Az| + |Eaz * Bz * Ay| + |Ebx * Ax * By| + |-Eby * Ax * Bx|
-    ProjT = vec3::DotProduct(T, A->Axis[x].Cross(B->Axis[z]));
-    MaxA = A->Extens[y] * AbsR[z][z] + A->Extens[z] * AbsR[y][z];
-    MaxB = B->Extens[x] * AbsR[x][y] + B->Extens[y] * AbsR[x][x];
-    
-    if (ProjT > MaxA + MaxB) {
-        return 0;
+    *CachedAxis = OBBFindSeparatingAxis(A, B);
+
+    return *CachedAxis == OBB_NO_SEPARATING_AXIS;
+}
+
+// NOTE (ismail): persistent pair, keep it alive between frames (e.g. for every broad phase pair)
+struct OBBPair {
+    i32     BoxA;
+    i32     BoxB;
+    i32     CachedAxis;
+    bool32  Overlap;
+};
+
+void OBBPairInit(OBBPair *Pair, i32 BoxA, i32 BoxB)
+{
+    Pair->BoxA = BoxA;
+    Pair->BoxB = BoxB;
+    Pair->CachedAxis = OBB_NO_SEPARATING_AXIS;
+    Pair->Overlap = 0;
+}
+
+// NOTE (ismail): returns amount of overlapping pairs, result of each pair is in Pair.Overlap
+i32 OBBToOBBTestOverlapBatch(OBB *Boxes, OBBPair *Pairs, i32 PairsAmount)
+{
+    i32 Overlaps = 0;
+
+    for (i32 PairIndex = 0; PairIndex < PairsAmount; ++PairIndex) {
+        OBBPair *Pair = &Pairs[PairIndex];
+
+        Pair->Overlap = OBBToOBBTestOverlapCached(&Boxes[Pair->BoxA], &Boxes[Pair->BoxB], &Pair->CachedAxis);
+        Overlaps += Pair->Overlap;
     }
 
-    //  L = Ay X Bx
-    // |T * (Ay X Bx)| > |Eax * Bx * Az| + |-Eaz * Bx * Ax| + |Eby * Ay * Bz| + |-Ebz * Ay * By|
-    ProjT = vec3::DotProduct(T, A->Axis[y].Cross(B->Axis[x]));
-    MaxA = A->Extens[x] * AbsR[z][x] + A->Extens[z] * AbsR[x][x];
-    MaxB = B->Extens[y] * AbsR[y][z] + B->Extens[z] * AbsR[y][y];
-    
-    if (ProjT > MaxA + MaxB) {
-        return 0;
+    return Overlaps;
+}
+
+// NOTE (ismail): boxes split by component so one box can be tested against AABB_SOA_LANES boxes at once,
+// capacity is rounded up to AABB_SOA_LANES and padding lanes are placed far away so they never overlap
+struct AABBSoA {
+    real32 *CenterX;
+    real32 *CenterY;
+    real32 *CenterZ;
+    real32 *ExtensX;
+    real32 *ExtensY;
+    real32 *ExtensZ;
+
+    i32     Amount;
+    i32     Capacity;
+};
+
+i32 AABBSoARoundCapacity(i32 Capacity)
+{
+    return (Capacity + AABB_SOA_LANES - 1) & ~(AABB_SOA_LANES - 1);
+}
+
+u64 AABBSoAMemorySize(i32 Capacity)
+{
+    return (u64)AABBSoARoundCapacity(Capacity) * 6 * sizeof(real32);
+}
+
+void AABBSoAInit(AABBSoA *Boxes, void *Memory, i32 Capacity)
+{
+    Assert(Memory);
+
+    i32 RoundedCapacity = AABBSoARoundCapacity(Capacity);
+    real32 *Components = (real32*)Memory;
+
+    Boxes->CenterX = Components + 0 * RoundedCapacity;
+    Boxes->CenterY = Components + 1 * RoundedCapacity;
+    Boxes->CenterZ = Components + 2 * RoundedCapacity;
+    Boxes->ExtensX = Components + 3 * RoundedCapacity;
+    Boxes->ExtensY = Components + 4 * RoundedCapacity;
+    Boxes->ExtensZ = Components + 5 * RoundedCapacity;
+
+    Boxes->Amount = 0;
+    Boxes->Capacity = RoundedCapacity;
+
+    for (i32 i = 0; i < RoundedCapacity; ++i) {
+        Boxes->CenterX[i] = INFINITY;
+        Boxes->CenterY[i] = INFINITY;
+        Boxes->CenterZ[i] = INFINITY;
+        Boxes->ExtensX[i] = 0.0f;
+        Boxes->ExtensY[i] = 0.0f;
+        Boxes->ExtensZ[i] = 0.0f;
     }
+}
 
-    // L = Ay X By
-    // |T * (Ay X By)| > |Eax * By * Az| + |-Eaz * By * Ax| + |-Ebx * Ay * Bz| + |Ebz * Ay * Bx|
-    ProjT = vec3::DotProduct(T, A->Axis[y].Cross(B->Axis[y]));
-    MaxA = A->Extens[x] * AbsR[z][y] + A->Extens[z] * AbsR[x][y];
-    MaxB = B->Extens[x] * AbsR[y][z] + B->Extens[z] * AbsR[y][y];
-    
-    if (ProjT > MaxA + MaxB) {
-        return 0;
+void AABBSoASet(AABBSoA *Boxes, i32 Index, AABB *Box)
+{
+    Assert(Index >= 0 && Index < Boxes->Capacity);
+
+    Boxes->CenterX[Index] = Box->Center.x;
+    Boxes->CenterY[Index] = Box->Center.y;
+    Boxes->CenterZ[Index] = Box->Center.z;
+    Boxes->ExtensX[Index] = Box->Extens.x;
+    Boxes->ExtensY[Index] = Box->Extens.y;
+    Boxes->ExtensZ[Index] = Box->Extens.z;
+
+    if (Index >= Boxes->Amount) {
+        Boxes->Amount = Index + 1;
     }
+}
 
-    // L = Ay X Bz
-    // |T * (Ay X Bz)| > |Eax * Bz * Az| + |-Eaz * Bz * Ax| + |Ebx * Ay * By| + |-Eby * Ay * Bx|
-    ProjT = vec3::DotProduct(T, A->Axis[y].Cross(B->Axis[z]));
-    MaxA = A->Extens[x] * AbsR[z][z] + A->Extens[z] * AbsR[x][z];
-    MaxB = B->Extens[x] * AbsR[y][y] + B->Extens[y] * AbsR[y][x];
-    
-    if (ProjT > MaxA + MaxB) {
-        return 0;
+i32 AABBSoAPush(AABBSoA *Boxes, AABB *Box)
+{
+    i32 Index = Boxes->Amount;
+
+    AABBSoASet(Boxes, Index, Box);
+
+    return Index;
+}
+
+// NOTE (ismail): bit i of result is set when A overlaps box First + i, same rule as AABBToAABBTestOverlap
+u32 AABBToAABBTestOverlap4(AABB *A, AABBSoA *Boxes, i32 First)
+{
+    Assert(First >= 0 && First + 4 <= Boxes->Capacity);
+
+#if TEARA_MATH_SSE2
+    __m128 SignMask = _mm_set1_ps(-0.0f);
+
+    __m128 DistanceX = _mm_andnot_ps(SignMask, _mm_sub_ps(_mm_loadu_ps(Boxes->CenterX + First), _mm_set1_ps(A->Center.x)));
+    __m128 DistanceY = _mm_andnot_ps(SignMask, _mm_sub_ps(_mm_loadu_ps(Boxes->CenterY + First), _mm_set1_ps(A->Center.y)));
+    __m128 DistanceZ = _mm_andnot_ps(SignMask, _mm_sub_ps(_mm_loadu_ps(Boxes->CenterZ + First), _mm_set1_ps(A->Center.z)));
+
+    __m128 OverlapX = _mm_cmple_ps(DistanceX, _mm_add_ps(_mm_loadu_ps(Boxes->ExtensX + First), _mm_set1_ps(A->Extens.x)));
+    __m128 OverlapY = _mm_cmple_ps(DistanceY, _mm_add_ps(_mm_loadu_ps(Boxes->ExtensY + First), _mm_set1_ps(A->Extens.y)));
+    __m128 OverlapZ = _mm_cmple_ps(DistanceZ, _mm_add_ps(_mm_loadu_ps(Boxes->ExtensZ + First), _mm_set1_ps(A->Extens.z)));
+
+    return (u32)_mm_movemask_ps(_mm_and_ps(_mm_and_ps(OverlapX, OverlapY), OverlapZ));
+#else
+    u32 Result = 0;
+
+    for (i32 Lane = 0; Lane < 4; ++Lane) {
+        i32 i = First + Lane;
+
+        u32 Overlap = (Fabs(Boxes->CenterX[i] - A->Center.x) <= Boxes->ExtensX[i] + A->Extens.x) &
+                      (Fabs(Boxes->CenterY[i] - A->Center.y) <= Boxes->ExtensY[i] + A->Extens.y) &
+                      (Fabs(Boxes->CenterZ[i] - A->Center.z) <= Boxes->ExtensZ[i] + A->Extens.z);
+
+        Result |= Overlap << Lane;
     }
 
-    //  L = Az X Bx
-    // |T * (Az X Bx)| > |-Eax * Bx * Ay| + |Eay * Bx * Ax| + |Eby * Az * Bz| + |-Ebz * Az * By|
-    ProjT = vec3::DotProduct(T, A->Axis[z].Cross(B->Axis[x]));
-    MaxA = A->Extens[x] * AbsR[y][x] + A->Extens[y] * AbsR[x][x];
-    MaxB = B->Extens[y] * AbsR[z][z] + B->Extens[z] * AbsR[z][y];
-    
-    if (ProjT > MaxA + MaxB) {
-        return 0;
+    return Result;
+#endif
+}
+
+u32 AABBToAABBTestOverlap8(AABB *A, AABBSoA *Boxes, i32 First)
+{
+    Assert(First >= 0 && First + 8 <= Boxes->Capacity);
+
+#if TEARA_MATH_AVX2
+    __m256 SignMask = _mm256_set1_ps(-0.0f);
+
+    __m256 DistanceX = _mm256_andnot_ps(SignMask, _mm256_sub_ps(_mm256_loadu_ps(Boxes->CenterX + First), _mm256_set1_ps(A->Center.x)));
+    __m256 DistanceY = _mm256_andnot_ps(SignMask, _mm256_sub_ps(_mm256_loadu_ps(Boxes->CenterY + First), _mm256_set1_ps(A->Center.y)));
+    __m256 DistanceZ = _mm256_andnot_ps(SignMask, _mm256_sub_ps(_mm256_loadu_ps(Boxes->CenterZ + First), _mm256_set1_ps(A->Center.z)));
+
+    __m256 OverlapX = _mm256_cmp_ps(DistanceX, _mm256_add_ps(_mm256_loadu_ps(Boxes->ExtensX + First), _mm256_set1_ps(A->Extens.x)), _CMP_LE_OQ);
+    __m256 OverlapY = _mm256_cmp_ps(DistanceY, _mm256_add_ps(_mm256_loadu_ps(Boxes->ExtensY + First), _mm256_set1_ps(A->Extens.y)), _CMP_LE_OQ);
+    __m256 OverlapZ = _mm256_cmp_ps(DistanceZ, _mm256_add_ps(_mm256_loadu_ps(Boxes->ExtensZ + First), _mm256_set1_ps(A->Extens.z)), _CMP_LE_OQ);
+
+    return (u32)_mm256_movemask_ps(_mm256_and_ps(_mm256_and_ps(OverlapX, OverlapY), OverlapZ));
+#else
+    return AABBToAABBTestOverlap4(A, Boxes, First) | (AABBToAABBTestOverlap4(A, Boxes, First + 4) << 4);
+#endif
+}
+
+// NOTE (ismail): closest point on box to sphere center, per axis max(|Cs - Cb| - Eb, 0)
+u32 SphereToAABBTestOverlap4(Sphere *A, AABBSoA *Boxes, i32 First)
+{
+    Assert(First >= 0 && First + 4 <= Boxes->Capacity);
+
+#if TEARA_MATH_SSE2
+    __m128 SignMask = _mm_set1_ps(-0.0f);
+    __m128 Zero = _mm_setzero_ps();
+
+    __m128 OutsideX = _mm_sub_ps(_mm_andnot_ps(SignMask, _mm_sub_ps(_mm_loadu_ps(Boxes->CenterX + First), _mm_set1_ps(A->Center.x))), _mm_loadu_ps(Boxes->ExtensX + First));
+    __m128 OutsideY = _mm_sub_ps(_mm_andnot_ps(SignMask, _mm_sub_ps(_mm_loadu_ps(Boxes->CenterY + First), _mm_set1_ps(A->Center.y))), _mm_loadu_ps(Boxes->ExtensY + First));
+    __m128 OutsideZ = _mm_sub_ps(_mm_andnot_ps(SignMask, _mm_sub_ps(_mm_loadu_ps(Boxes->CenterZ + First), _mm_set1_ps(A->Center.z))), _mm_loadu_ps(Boxes->ExtensZ + First));
+
+    OutsideX = _mm_max_ps(OutsideX, Zero);
+    OutsideY = _mm_max_ps(OutsideY, Zero);
+    OutsideZ = _mm_max_ps(OutsideZ, Zero);
+
+    __m128 DistanceSquare = _mm_add_ps(_mm_add_ps(_mm_mul_ps(OutsideX, OutsideX), _mm_mul_ps(OutsideY, OutsideY)), _mm_mul_ps(OutsideZ, OutsideZ));
+
+    return (u32)_mm_movemask_ps(_mm_cmple_ps(DistanceSquare, _mm_set1_ps(SQUARE(A->Radius))));
+#else
+    u32 Result = 0;
+
+    for (i32 Lane = 0; Lane < 4; ++Lane) {
+        i32 i = First + Lane;
+
+        real32 OutsideX = Fabs(Boxes->CenterX[i] - A->Center.x) - Boxes->ExtensX[i];
+        real32 OutsideY = Fabs(Boxes->CenterY[i] - A->Center.y) - Boxes->ExtensY[i];
+        real32 OutsideZ = Fabs(Boxes->CenterZ[i] - A->Center.z) - Boxes->ExtensZ[i];
+
+        OutsideX = OutsideX > 0.0f ? OutsideX : 0.0f;
+        OutsideY = OutsideY > 0.0f ? OutsideY : 0.0f;
+        OutsideZ = OutsideZ > 0.0f ? OutsideZ : 0.0f;
+
+        real32 DistanceSquare = SQUARE(OutsideX) + SQUARE(OutsideY) + SQUARE(OutsideZ);
+
+        Result |= (u32)(DistanceSquare <= SQUARE(A->Radius)) << Lane;
     }
 
-    //  L = Az X By
-    // |T * (Az X By)| > |-Eax * By * Ay| + |Eay * By * Ax| + |-Ebx * Az * Bz| + |Ebz * Az * Bx|
-    ProjT = vec3::DotProduct(T, A->Axis[z].Cross(B->Axis[y]));
-    MaxA = A->Extens[x] * AbsR[y][y] + A->Extens[y] * AbsR[x][y];
-    MaxB = B->Extens[x] * AbsR[z][z] + B->Extens[z] * AbsR[z][x];
-    
-    if (ProjT > MaxA + MaxB) {
-        return 0;
+    return Result;
+#endif
+}
+
+u32 SphereToAABBTestOverlap8(Sphere *A, AABBSoA *Boxes, i32 First)
+{
+    Assert(First >= 0 && First + 8 <= Boxes->Capacity);
+
+#if TEARA_MATH_AVX2
+    __m256 SignMask = _mm256_set1_ps(-0.0f);
+    __m256 Zero = _mm256_setzero_ps();
+
+    __m256 OutsideX = _mm256_sub_ps(_mm256_andnot_ps(SignMask, _mm256_sub_ps(_mm256_loadu_ps(Boxes->CenterX + First), _mm256_set1_ps(A->Center.x))), _mm256_loadu_ps(Boxes->ExtensX + First));
+    __m256 OutsideY = _mm256_sub_ps(_mm256_andnot_ps(SignMask, _mm256_sub_ps(_mm256_loadu_ps(Boxes->CenterY + First), _mm256_set1_ps(A->Center.y))), _mm256_loadu_ps(Boxes->ExtensY + First));
+    __m256 OutsideZ = _mm256_sub_ps(_mm256_andnot_ps(SignMask, _mm256_sub_ps(_mm256_loadu_ps(Boxes->CenterZ + First), _mm256_set1_ps(A->Center.z))), _mm256_loadu_ps(Boxes->ExtensZ + First));
+
+    OutsideX = _mm256_max_ps(OutsideX, Zero);
+    OutsideY = _mm256_max_ps(OutsideY, Zero);
+    OutsideZ = _mm256_max_ps(OutsideZ, Zero);
+
+    __m256 DistanceSquare = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(OutsideX, OutsideX), _mm256_mul_ps(OutsideY, OutsideY)), _mm256_mul_ps(OutsideZ, OutsideZ));
+
+    return (u32)_mm256_movemask_ps(_mm256_cmp_ps(DistanceSquare, _mm256_set1_ps(SQUARE(A->Radius)), _CMP_LE_OQ));
+#else
+    return SphereToAABBTestOverlap4(A, Boxes, First) | (SphereToAABBTestOverlap4(A, Boxes, First + 4) << 4);
+#endif
+}
+
+// NOTE (ismail): same layout as AABBSoA for spheres, padding lanes are at INFINITY with zero radius
+struct SphereSoA {
+    real32 *CenterX;
+    real32 *CenterY;
+    real32 *CenterZ;
+    real32 *Radius;
+
+    i32     Amount;
+    i32     Capacity;
+};
+
+u64 SphereSoAMemorySize(i32 Capacity)
+{
+    return (u64)AABBSoARoundCapacity(Capacity) * 4 * sizeof(real32);
+}
+
+void SphereSoAInit(SphereSoA *Spheres, void *Memory, i32 Capacity)
+{
+    Assert(Memory);
+
+    i32 RoundedCapacity = AABBSoARoundCapacity(Capacity);
+    real32 *Components = (real32*)Memory;
+
+    Spheres->CenterX = Components + 0 * RoundedCapacity;
+    Spheres->CenterY = Components + 1 * RoundedCapacity;
+    Spheres->CenterZ = Components + 2 * RoundedCapacity;
+    Spheres->Radius  = Components + 3 * RoundedCapacity;
+
+    Spheres->Amount = 0;
+    Spheres->Capacity = RoundedCapacity;
+
+    for (i32 i = 0; i < RoundedCapacity; ++i) {
+        Spheres->CenterX[i] = INFINITY;
+        Spheres->CenterY[i] = INFINITY;
+        Spheres->CenterZ[i] = INFINITY;
+        Spheres->Radius[i]  = 0.0f;
     }
+}
 
-    //  L = Az X Bz
-    // |T * (Az X Bz)| > |-Eax * Bz * Ay| + |Eay * Bz * Ax| + |Ebx * Az * By| + |-Eby * Az * Bx|
-    ProjT = vec3::DotProduct(T, A->Axis[z].Cross(B->Axis[z]));
-    MaxA = A->Extens[x] * AbsR[y][z] + A->Extens[y] * AbsR[x][z];
-    MaxB = B->Extens[x] * AbsR[z][y] + B->Extens[y] * AbsR[z][x];
-    
-    if (ProjT > MaxA + MaxB) {
-        return 0;
+void SphereSoASet(SphereSoA *Spheres, i32 Index, Sphere *Data)
+{
+    Assert(Index >= 0 && Index < Spheres->Capacity);
+
+    Spheres->CenterX[Index] = Data->Center.x;
+    Spheres->CenterY[Index] = Data->Center.y;
+    Spheres->CenterZ[Index] = Data->Center.z;
+    Spheres->Radius[Index]  = Data->Radius;
+
+    if (Index >= Spheres->Amount) {
+        Spheres->Amount = Index + 1;
     }
+}
 
-    return 1;
+i32 SphereSoAPush(SphereSoA *Spheres, Sphere *Data)
+{
+    i32 Index = Spheres->Amount;
+
+    SphereSoASet(Spheres, Index, Data);
+
+    return Index;
+}
+
+// NOTE (ismail): many spheres against one box, bit i is set when sphere First + i overlaps A
+u32 AABBToSphereTestOverlap4(AABB *A, SphereSoA *Spheres, i32 First)
+{
+    Assert(First >= 0 && First + 4 <= Spheres->Capacity);
+
+#if TEARA_MATH_SSE2
+    __m128 SignMask = _mm_set1_ps(-0.0f);
+    __m128 Zero = _mm_setzero_ps();
+
+    __m128 OutsideX = _mm_sub_ps(_mm_andnot_ps(SignMask, _mm_sub_ps(_mm_loadu_ps(Spheres->CenterX + First), _mm_set1_ps(A->Center.x))), _mm_set1_ps(A->Extens.x));
+    __m128 OutsideY = _mm_sub_ps(_mm_andnot_ps(SignMask, _mm_sub_ps(_mm_loadu_ps(Spheres->CenterY + First), _mm_set1_ps(A->Center.y))), _mm_set1_ps(A->Extens.y));
+    __m128 OutsideZ = _mm_sub_ps(_mm_andnot_ps(SignMask, _mm_sub_ps(_mm_loadu_ps(Spheres->CenterZ + First), _mm_set1_ps(A->Center.z))), _mm_set1_ps(A->Extens.z));
+
+    OutsideX = _mm_max_ps(OutsideX, Zero);
+    OutsideY = _mm_max_ps(OutsideY, Zero);
+    OutsideZ = _mm_max_ps(OutsideZ, Zero);
+
+    __m128 DistanceSquare = _mm_add_ps(_mm_add_ps(_mm_mul_ps(OutsideX, OutsideX), _mm_mul_ps(OutsideY, OutsideY)), _mm_mul_ps(OutsideZ, OutsideZ));
+    __m128 Radius = _mm_loadu_ps(Spheres->Radius + First);
+
+    return (u32)_mm_movemask_ps(_mm_cmple_ps(DistanceSquare, _mm_mul_ps(Radius, Radius)));
+#else
+    u32 Result = 0;
+
+    for (i32 Lane = 0; Lane < 4; ++Lane) {
+        i32 i = First + Lane;
+
+        real32 OutsideX = Fabs(Spheres->CenterX[i] - A->Center.x) - A->Extens.x;
+        real32 OutsideY = Fabs(Spheres->CenterY[i] - A->Center.y) - A->Extens.y;
+        real32 OutsideZ = Fabs(Spheres->CenterZ[i] - A->Center.z) - A->Extens.z;
+
+        OutsideX = OutsideX > 0.0f ? OutsideX : 0.0f;
+        OutsideY = OutsideY > 0.0f ? OutsideY : 0.0f;
+        OutsideZ = OutsideZ > 0.0f ? OutsideZ : 0.0f;
+
+        real32 DistanceSquare = SQUARE(OutsideX) + SQUARE(OutsideY) + SQUARE(OutsideZ);
+
+        Result |= (u32)(DistanceSquare <= SQUARE(Spheres->Radius[i])) << Lane;
+    }
+
+    return Result;
+#endif
+}
+
+u32 AABBToSphereTestOverlap8(AABB *A, SphereSoA *Spheres, i32 First)
+{
+    Assert(First >= 0 && First + 8 <= Spheres->Capacity);
+
+#if TEARA_MATH_AVX2
+    __m256 SignMask = _mm256_set1_ps(-0.0f);
+    __m256 Zero = _mm256_setzero_ps();
+
+    __m256 OutsideX = _mm256_sub_ps(_mm256_andnot_ps(SignMask, _mm256_sub_ps(_mm256_loadu_ps(Spheres->CenterX + First), _mm256_set1_ps(A->Center.x))), _mm256_set1_ps(A->Extens.x));
+    __m256 OutsideY = _mm256_sub_ps(_mm256_andnot_ps(SignMask, _mm256_sub_ps(_mm256_loadu_ps(Spheres->CenterY + First), _mm256_set1_ps(A->Center.y))), _mm256_set1_ps(A->Extens.y));
+    __m256 OutsideZ = _mm256_sub_ps(_mm256_andnot_ps(SignMask, _mm256_sub_ps(_mm256_loadu_ps(Spheres->CenterZ + First), _mm256_set1_ps(A->Center.z))), _mm256_set1_ps(A->Extens.z));
+
+    OutsideX = _mm256_max_ps(OutsideX, Zero);
+    OutsideY = _mm256_max_ps(OutsideY, Zero);
+    OutsideZ = _mm256_max_ps(OutsideZ, Zero);
+
+    __m256 DistanceSquare = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(OutsideX, OutsideX), _mm256_mul_ps(OutsideY, OutsideY)), _mm256_mul_ps(OutsideZ, OutsideZ));
+    __m256 Radius = _mm256_loadu_ps(Spheres->Radius + First);
+
+    return (u32)_mm256_movemask_ps(_mm256_cmp_ps(DistanceSquare, _mm256_mul_ps(Radius, Radius), _CMP_LE_OQ));
+#else
+    return AABBToSphereTestOverlap4(A, Spheres, First) | (AABBToSphereTestOverlap4(A, Spheres, First + 4) << 4);
+#endif
+}
+
+// NOTE (ismail): writes indices of boxes overlapping A, returns how many were found (only MaxResults written)
+i32 AABBSoAQueryOverlaps(AABBSoA *Boxes, AABB *A, i32 *Result, i32 MaxResults)
+{
+    i32 Found = 0;
+
+    for (i32 First = 0; First < Boxes->Amount; First += AABB_SOA_LANES) {
+        u32 Mask = AABBToAABBTestOverlap8(A, Boxes, First);
+
+        for (i32 Lane = 0; Mask; ++Lane, Mask >>= 1) {
+            if (Mask & 1) {
+                if (Found < MaxResults) {
+                    Result[Found] = First + Lane;
+                }
+
+                ++Found;
+            }
+        }
+    }
+
+    return Found;
+}
+
+i32 AABBSoAQuerySphereOverlaps(AABBSoA *Boxes, Sphere *A, i32 *Result, i32 MaxResults)
+{
+    i32 Found = 0;
+
+    for (i32 First = 0; First < Boxes->Amount; First += AABB_SOA_LANES) {
+        u32 Mask = SphereToAABBTestOverlap8(A, Boxes, First);
+
+        for (i32 Lane = 0; Mask; ++Lane, Mask >>= 1) {
+            if (Mask & 1) {
+                if (Found < MaxResults) {
+                    Result[Found] = First + Lane;
+                }
+
+                ++Found;
+            }
+        }
+    }
+
+    return Found;
+}
+
+i32 SphereSoAQueryAABBOverlaps(SphereSoA *Spheres, AABB *A, i32 *Result, i32 MaxResults)
+{
+    i32 Found = 0;
+
+    for (i32 First = 0; First < Spheres->Amount; First += AABB_SOA_LANES) {
+        u32 Mask = AABBToSphereTestOverlap8(A, Spheres, First);
+
+        for (i32 Lane = 0; Mask; ++Lane, Mask >>= 1) {
+            if (Mask & 1) {
+                if (Found < MaxResults) {
+                    Result[Found] = First + Lane;
+                }
+
+                ++Found;
+            }
+        }
+    }
+
+    return Found;
 }
 
 #endif
\ No newline at end of file
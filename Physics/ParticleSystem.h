@@ -0,0 +1,354 @@
+#ifndef TEARA_PHYSICS_PARTICLE_SYSTEM_H_
+#define TEARA_PHYSICS_PARTICLE_SYSTEM_H_
+
+#include "Core/Types.h"
+#include "Core/Debug.h"
+#include "Core/EnginePlatform.h"
+#include "Core/JobSystem.h"
+#include "Math/Vector.h"
+#include "Math/Matrix.h"
+
+#define PARTICLE_SOA_LANES          8
+#define PARTICLE_EMITTERS_MAX       16
+#define PARTICLES_PER_JOB           (16384)
+#define PARTICLE_LIFETIME_FOREVER   (1e30f) // NOTE(ismail): subtracting frame dt doesn't change it in float
+
+// NOTE(ismail): spawns Rate particles per second at Position, velocity is Velocity +- VelocitySpread per component
+struct ParticleEmitter {
+    vec3    Position;
+    vec3    Velocity;
+    vec3    VelocitySpread;
+    vec3    Acceleration;
+    real32  Rate;
+    real32  Lifetime;
+    real32  SpawnAccumulator;
+    u32     RandomState;
+    bool32  Active;
+};
+
+struct ParticleSystem;
+
+struct ParticleUpdateJob {
+    ParticleSystem*     System;
+    real32              dt;
+    real32              DampingEffect;
+    std::atomic<i32>    RangesAmount;
+};
+
+struct ParticleUpdateStats {
+    real64  UpdateTimeMs;
+    i32     ParticlesAmount;
+    i32     SpawnedAmount;
+    i32     KilledAmount;
+    i32     JobsAmount;
+};
+
+// NOTE(ismail): every component lives in its own array so one kernel iteration moves PARTICLE_SOA_LANES particles,
+// capacity is rounded up to PARTICLE_SOA_LANES and lanes past Amount hold finite garbage the kernel may touch.
+// Dead particles are swap removed, so order of alive particles is not stable
+struct ParticleSystem {
+    real32*             PositionX;
+    real32*             PositionY;
+    real32*             PositionZ;
+    real32*             VelocityX;
+    real32*             VelocityY;
+    real32*             VelocityZ;
+    real32*             AccelerationX;
+    real32*             AccelerationY;
+    real32*             AccelerationZ;
+    real32*             Lifetime;
+
+    i32                 Amount;
+    i32                 Capacity;
+
+    real32              Damping; // NOTE(ismail): shared by all particles so powf runs once per update, not per particle
+
+    ParticleEmitter     Emitters[PARTICLE_EMITTERS_MAX];
+    i32                 EmittersAmount;
+
+    ParticleUpdateStats Stats;
+};
+
+#define PARTICLE_SYSTEM_COMPONENTS  10
+
+inline i32 ParticleSystemRoundCapacity(i32 Capacity)
+{
+    return (Capacity + PARTICLE_SOA_LANES - 1) & ~(PARTICLE_SOA_LANES - 1);
+}
+
+inline u64 ParticleSystemMemorySize(i32 Capacity)
+{
+    return (u64)ParticleSystemRoundCapacity(Capacity) * PARTICLE_SYSTEM_COMPONENTS * sizeof(real32);
+}
+
+// NOTE(ismail): Memory must hold ParticleSystemMemorySize(Capacity) bytes
+inline void ParticleSystemInit(ParticleSystem* System, void* Memory, i32 Capacity, real32 Damping)
+{
+    Assert(Memory);
+    Assert(Capacity > 0);
+
+    i32     RoundedCapacity = ParticleSystemRoundCapacity(Capacity);
+    real32* Components      = (real32*)Memory;
+
+    System->PositionX       = Components + 0 * RoundedCapacity;
+    System->PositionY       = Components + 1 * RoundedCapacity;
+    System->PositionZ       = Components + 2 * RoundedCapacity;
+    System->VelocityX       = Components + 3 * RoundedCapacity;
+    System->VelocityY       = Components + 4 * RoundedCapacity;
+    System->VelocityZ       = Components + 5 * RoundedCapacity;
+    System->AccelerationX   = Components + 6 * RoundedCapacity;
+    System->AccelerationY   = Components + 7 * RoundedCapacity;
+    System->AccelerationZ   = Components + 8 * RoundedCapacity;
+    System->Lifetime        = Components + 9 * RoundedCapacity;
+
+    for (i32 Index = 0; Index < RoundedCapacity * PARTICLE_SYSTEM_COMPONENTS; ++Index) {
+        Components[Index] = 0.0f;
+    }
+
+    System->Amount          = 0;
+    System->Capacity        = RoundedCapacity;
+    System->Damping         = Damping;
+    System->EmittersAmount  = 0;
+    System->Stats           = {};
+}
+
+inline ParticleEmitter* ParticleSystemAddEmitter(ParticleSystem* System)
+{
+    Assert(System->EmittersAmount < PARTICLE_EMITTERS_MAX);
+
+    ParticleEmitter* Emitter = &System->Emitters[System->EmittersAmount];
+
+    *Emitter = {};
+
+    Emitter->RandomState    = 0x9E3779B9u * (u32)(System->EmittersAmount + 1);
+    Emitter->Active         = 1;
+
+    ++System->EmittersAmount;
+
+    return Emitter;
+}
+
+// NOTE(ismail): returns -1 when system is full
+inline i32 ParticleSystemSpawn(ParticleSystem* System, const vec3& Position, const vec3& Velocity, const vec3& Acceleration, real32 Lifetime)
+{
+    if (System->Amount >= System->Capacity) {
+        return -1;
+    }
+
+    i32 Index = System->Amount++;
+
+    System->PositionX[Index]        = Position.x;
+    System->PositionY[Index]        = Position.y;
+    System->PositionZ[Index]        = Position.z;
+    System->VelocityX[Index]        = Velocity.x;
+    System->VelocityY[Index]        = Velocity.y;
+    System->VelocityZ[Index]        = Velocity.z;
+    System->AccelerationX[Index]    = Acceleration.x;
+    System->AccelerationY[Index]    = Acceleration.y;
+    System->AccelerationZ[Index]    = Acceleration.z;
+    System->Lifetime[Index]         = Lifetime;
+
+    return Index;
+}
+
+// NOTE(ismail): xorshift32 mapped to [-1, 1], emitters have own state so spawning is deterministic
+inline real32 ParticleEmitterRandomBilateral(ParticleEmitter* Emitter)
+{
+    u32 x = Emitter->RandomState;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    Emitter->RandomState = x;
+
+    return (real32)(x >> 8) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+inline i32 ParticleSystemEmit(ParticleSystem* System, real32 dt)
+{
+    i32 SpawnedAmount = 0;
+
+    for (i32 EmitterIndex = 0; EmitterIndex < System->EmittersAmount; ++EmitterIndex) {
+        ParticleEmitter* Emitter = &System->Emitters[EmitterIndex];
+
+        if (!Emitter->Active) {
+            continue;
+        }
+
+        Emitter->SpawnAccumulator += Emitter->Rate * dt;
+
+        i32 ToSpawn = (i32)Emitter->SpawnAccumulator;
+        Emitter->SpawnAccumulator -= (real32)ToSpawn;
+
+        for (i32 Index = 0; Index < ToSpawn; ++Index) {
+            vec3 Velocity = {
+                Emitter->Velocity.x + Emitter->VelocitySpread.x * ParticleEmitterRandomBilateral(Emitter),
+                Emitter->Velocity.y + Emitter->VelocitySpread.y * ParticleEmitterRandomBilateral(Emitter),
+                Emitter->Velocity.z + Emitter->VelocitySpread.z * ParticleEmitterRandomBilateral(Emitter),
+            };
+
+            if (ParticleSystemSpawn(System, Emitter->Position, Velocity, Emitter->Acceleration, Emitter->Lifetime) < 0) {
+                break;
+            }
+
+            ++SpawnedAmount;
+        }
+    }
+
+    return SpawnedAmount;
+}
+
+// NOTE(ismail): same math as Particle::Integrate had: x += v * t, v += a * t, v *= d ^ t.
+// First must be multiple of PARTICLE_SOA_LANES, Amount is rounded up to lanes
+inline void ParticleSystemIntegrate(ParticleSystem* System, i32 First, i32 Amount, real32 dt, real32 DampingEffect)
+{
+    Assert((First % PARTICLE_SOA_LANES) == 0);
+    Assert(First + ParticleSystemRoundCapacity(Amount) <= System->Capacity);
+
+    real32* PositionX       = System->PositionX;
+    real32* PositionY       = System->PositionY;
+    real32* PositionZ       = System->PositionZ;
+    real32* VelocityX       = System->VelocityX;
+    real32* VelocityY       = System->VelocityY;
+    real32* VelocityZ       = System->VelocityZ;
+    real32* AccelerationX   = System->AccelerationX;
+    real32* AccelerationY   = System->AccelerationY;
+    real32* AccelerationZ   = System->AccelerationZ;
+    real32* Lifetime        = System->Lifetime;
+
+    i32 Last = First + ParticleSystemRoundCapacity(Amount);
+
+#if TEARA_MATH_AVX2
+    __m256 Dt       = _mm256_set1_ps(dt);
+    __m256 Damping  = _mm256_set1_ps(DampingEffect);
+
+    for (i32 Index = First; Index < Last; Index += 8) {
+        __m256 Vx = _mm256_loadu_ps(VelocityX + Index);
+        __m256 Vy = _mm256_loadu_ps(VelocityY + Index);
+        __m256 Vz = _mm256_loadu_ps(VelocityZ + Index);
+
+        _mm256_storeu_ps(PositionX + Index, _mm256_add_ps(_mm256_loadu_ps(PositionX + Index), _mm256_mul_ps(Vx, Dt)));
+        _mm256_storeu_ps(PositionY + Index, _mm256_add_ps(_mm256_loadu_ps(PositionY + Index), _mm256_mul_ps(Vy, Dt)));
+        _mm256_storeu_ps(PositionZ + Index, _mm256_add_ps(_mm256_loadu_ps(PositionZ + Index), _mm256_mul_ps(Vz, Dt)));
+
+        Vx = _mm256_add_ps(Vx, _mm256_mul_ps(_mm256_loadu_ps(AccelerationX + Index), Dt));
+        Vy = _mm256_add_ps(Vy, _mm256_mul_ps(_mm256_loadu_ps(AccelerationY + Index), Dt));
+        Vz = _mm256_add_ps(Vz, _mm256_mul_ps(_mm256_loadu_ps(AccelerationZ + Index), Dt));
+
+        _mm256_storeu_ps(VelocityX + Index, _mm256_mul_ps(Vx, Damping));
+        _mm256_storeu_ps(VelocityY + Index, _mm256_mul_ps(Vy, Damping));
+        _mm256_storeu_ps(VelocityZ + Index, _mm256_mul_ps(Vz, Damping));
+
+        _mm256_storeu_ps(Lifetime + Index, _mm256_sub_ps(_mm256_loadu_ps(Lifetime + Index), Dt));
+    }
+#elif TEARA_MATH_SSE2
+    __m128 Dt       = _mm_set1_ps(dt);
+    __m128 Damping  = _mm_set1_ps(DampingEffect);
+
+    for (i32 Index = First; Index < Last; Index += 4) {
+        __m128 Vx = _mm_loadu_ps(VelocityX + Index);
+        __m128 Vy = _mm_loadu_ps(VelocityY + Index);
+        __m128 Vz = _mm_loadu_ps(VelocityZ + Index);
+
+        _mm_storeu_ps(PositionX + Index, _mm_add_ps(_mm_loadu_ps(PositionX + Index), _mm_mul_ps(Vx, Dt)));
+        _mm_storeu_ps(PositionY + Index, _mm_add_ps(_mm_loadu_ps(PositionY + Index), _mm_mul_ps(Vy, Dt)));
+        _mm_storeu_ps(PositionZ + Index, _mm_add_ps(_mm_loadu_ps(PositionZ + Index), _mm_mul_ps(Vz, Dt)));
+
+        Vx = _mm_add_ps(Vx, _mm_mul_ps(_mm_loadu_ps(AccelerationX + Index), Dt));
+        Vy = _mm_add_ps(Vy, _mm_mul_ps(_mm_loadu_ps(AccelerationY + Index), Dt));
+        Vz = _mm_add_ps(Vz, _mm_mul_ps(_mm_loadu_ps(AccelerationZ + Index), Dt));
+
+        _mm_storeu_ps(VelocityX + Index, _mm_mul_ps(Vx, Damping));
+        _mm_storeu_ps(VelocityY + Index, _mm_mul_ps(Vy, Damping));
+        _mm_storeu_ps(VelocityZ + Index, _mm_mul_ps(Vz, Damping));
+
+        _mm_storeu_ps(Lifetime + Index, _mm_sub_ps(_mm_loadu_ps(Lifetime + Index), Dt));
+    }
+#else
+    for (i32 Index = First; Index < Last; ++Index) {
+        PositionX[Index] += VelocityX[Index] * dt;
+        PositionY[Index] += VelocityY[Index] * dt;
+        PositionZ[Index] += VelocityZ[Index] * dt;
+
+        VelocityX[Index] = (VelocityX[Index] + AccelerationX[Index] * dt) * DampingEffect;
+        VelocityY[Index] = (VelocityY[Index] + AccelerationY[Index] * dt) * DampingEffect;
+        VelocityZ[Index] = (VelocityZ[Index] + AccelerationZ[Index] * dt) * DampingEffect;
+
+        Lifetime[Index] -= dt;
+    }
+#endif
+}
+
+// NOTE(ismail): last alive particle moves into the dead slot, index is checked again because moved one may be dead too
+inline i32 ParticleSystemRemoveDead(ParticleSystem* System)
+{
+    i32 KilledAmount    = 0;
+    i32 Index           = 0;
+
+    while (Index < System->Amount) {
+        if (System->Lifetime[Index] > 0.0f) {
+            ++Index;
+            continue;
+        }
+
+        i32 LastIndex = --System->Amount;
+
+        System->PositionX[Index]        = System->PositionX[LastIndex];
+        System->PositionY[Index]        = System->PositionY[LastIndex];
+        System->PositionZ[Index]        = System->PositionZ[LastIndex];
+        System->VelocityX[Index]        = System->VelocityX[LastIndex];
+        System->VelocityY[Index]        = System->VelocityY[LastIndex];
+        System->VelocityZ[Index]        = System->VelocityZ[LastIndex];
+        System->AccelerationX[Index]    = System->AccelerationX[LastIndex];
+        System->AccelerationY[Index]    = System->AccelerationY[LastIndex];
+        System->AccelerationZ[Index]    = System->AccelerationZ[LastIndex];
+        System->Lifetime[Index]         = System->Lifetime[LastIndex];
+
+        ++KilledAmount;
+    }
+
+    return KilledAmount;
+}
+
+// NOTE(ismail): ParallelFor ranges are in lane groups so every job starts on a PARTICLE_SOA_LANES boundary
+static TEARA_JOB_FUNCTION(ParticleSystemIntegrateJob)
+{
+    (void)Jobs;
+
+    ParticleUpdateJob* Job = (ParticleUpdateJob*)Data;
+
+    ParticleSystemIntegrate(Job->System, First * PARTICLE_SOA_LANES, Amount * PARTICLE_SOA_LANES, Job->dt, Job->DampingEffect);
+
+    Job->RangesAmount.fetch_add(1, std::memory_order_relaxed);
+}
+
+// NOTE(ismail): emit, integrate in chunks of PARTICLES_PER_JOB on the job system, then swap remove dead ones.
+// Chunks touch disjoint lanes so jobs need no synchronization
+inline void ParticleSystemUpdate(Platform* Platform, ParticleSystem* System, real32 dt)
+{
+    real64 StartTime = Platform->GetWallClock();
+
+    i32     SpawnedAmount   = ParticleSystemEmit(System, dt);
+    real32  DampingEffect   = powf(System->Damping, dt);
+
+    ParticleUpdateJob Job;
+    Job.System          = System;
+    Job.dt              = dt;
+    Job.DampingEffect   = DampingEffect;
+    Job.RangesAmount.store(0);
+
+    i32 LaneGroupsAmount = ParticleSystemRoundCapacity(System->Amount) / PARTICLE_SOA_LANES;
+
+    ParallelFor(Platform->Jobs, LaneGroupsAmount, PARTICLES_PER_JOB / PARTICLE_SOA_LANES, &ParticleSystemIntegrateJob, &Job);
+
+    i32 KilledAmount = ParticleSystemRemoveDead(System);
+
+    System->Stats.UpdateTimeMs      = (Platform->GetWallClock() - StartTime) * 1000.0;
+    System->Stats.ParticlesAmount   = System->Amount;
+    System->Stats.SpawnedAmount     = SpawnedAmount;
+    System->Stats.KilledAmount      = KilledAmount;
+    System->Stats.JobsAmount        = Job.RangesAmount.load();
+}
+
+#endif
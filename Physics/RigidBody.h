@@ -0,0 +1,959 @@
+#ifndef TEARA_PHYSICS_RIGID_BODY_H_
+#define TEARA_PHYSICS_RIGID_BODY_H_
+
+#include "Core/Types.h"
+#include "Core/Debug.h"
+#include "Math/Vector.h"
+#include "Math/Matrix.h"
+#include "Math/Quat.h"
+#include "CollisionDetection.h"
+#include "BroadPhase.h"
+
+#define RIGID_BODY_MAX_CONTACT_POINTS       4
+#define RIGID_BODY_SOLVER_ITERATIONS        10
+#define RIGID_BODY_BAUMGARTE                (0.2f)
+#define RIGID_BODY_PENETRATION_SLOP         (0.01f)
+#define RIGID_BODY_RESTITUTION_THRESHOLD    (1.0f)
+#define RIGID_BODY_CONTACT_MATCH_DISTANCE   (0.05f)
+#define RIGID_BODY_FACE_AXIS_TOLERANCE      (0.95f)
+#define RIGID_BODY_CLIP_MAX_VERTICES        8
+
+// NOTE(ismail): shape lives in world space and is rebuilt from Position and Orientation every step.
+// AABBVolume bodies never rotate (zero inverse inertia) so the box stays axis aligned
+struct RigidBody {
+    vec3            Position;
+    quat            Orientation;
+    vec3            LinearVelocity;
+    vec3            AngularVelocity;
+
+    real32          InverseMass;
+    vec3            InverseInertiaLocal;    // NOTE(ismail): diagonal in body space, all shapes we have are symmetric
+    mat3            InverseInertiaWorld;
+
+    real32          LinearDamping;
+    real32          AngularDamping;
+    real32          Friction;
+    real32          Restitution;
+
+    BoundingVolume  Shape;
+    i32             Proxy;
+};
+
+struct ContactPoint {
+    vec3    Position;
+    real32  Penetration;
+
+    vec3    RelativeA;
+    vec3    RelativeB;
+    real32  NormalMass;
+    real32  TangentMass[2];
+    real32  Bias;
+
+    // NOTE(ismail): accumulated impulses, carried to next step for warm starting
+    real32  NormalImpulse;
+    real32  TangentImpulse[2];
+};
+
+// NOTE(ismail): Normal points from BodyA to BodyB, BodyA < BodyB
+struct ContactManifold {
+    i32             BodyA;
+    i32             BodyB;
+    vec3            Normal;
+    vec3            Tangents[2];
+    real32          Friction;
+    real32          Restitution;
+    i32             PointsAmount;
+    ContactPoint    Points[RIGID_BODY_MAX_CONTACT_POINTS];
+};
+
+struct RigidBodyStats {
+    i32 PairsAmount;
+    i32 ManifoldsAmount;
+    i32 ContactsAmount;
+    i32 WarmStartedAmount;
+    i32 DroppedPairs;
+};
+
+// NOTE(ismail): no threads and no unordered containers, same input gives bit identical steps
+struct RigidBodyWorld {
+    RigidBody*          Bodies;
+    i32                 BodiesAmount;
+    i32                 BodiesCapacity;
+
+    // NOTE(ismail): two buffers, previous step manifolds are read for warm starting while new ones are built
+    ContactManifold*    Manifolds[2];
+    i32                 ManifoldsAmount[2];
+    i32                 CurrentManifolds;
+    i32                 ManifoldsCapacity;
+
+    BroadPhasePair*     Pairs;
+    SweepAndPrune       BroadPhase;
+
+    vec3                Gravity;
+    i32                 Iterations;
+
+    RigidBodyStats      Stats;
+};
+
+inline u64 RigidBodyWorldMemorySize(i32 MaxBodies, i32 MaxManifolds)
+{
+    u64 Result = (u64)MaxBodies * sizeof(RigidBody) +
+                 (u64)MaxManifolds * (2 * sizeof(ContactManifold) + sizeof(BroadPhasePair)) +
+                 SweepAndPruneMemorySize(MaxBodies);
+
+    return Result;
+}
+
+// NOTE(ismail): Memory must hold RigidBodyWorldMemorySize(MaxBodies, MaxManifolds) bytes
+inline void RigidBodyWorldInit(RigidBodyWorld* World, void* Memory, i32 MaxBodies, i32 MaxManifolds)
+{
+    Assert(Memory);
+    Assert(MaxBodies > 0 && MaxManifolds > 0);
+
+    u8* At = (u8*)Memory;
+
+    World->Bodies = (RigidBody*)At;
+    At += (u64)MaxBodies * sizeof(RigidBody);
+
+    World->Manifolds[0] = (ContactManifold*)At;
+    At += (u64)MaxManifolds * sizeof(ContactManifold);
+
+    World->Manifolds[1] = (ContactManifold*)At;
+    At += (u64)MaxManifolds * sizeof(ContactManifold);
+
+    World->Pairs = (BroadPhasePair*)At;
+    At += (u64)MaxManifolds * sizeof(BroadPhasePair);
+
+    SweepAndPruneInit(&World->BroadPhase, At, MaxBodies, 0);
+
+    World->BodiesAmount         = 0;
+    World->BodiesCapacity       = MaxBodies;
+    World->ManifoldsAmount[0]   = 0;
+    World->ManifoldsAmount[1]   = 0;
+    World->CurrentManifolds     = 0;
+    World->ManifoldsCapacity    = MaxManifolds;
+    World->Gravity              = { 0.0f, -10.0f, 0.0f };
+    World->Iterations           = RIGID_BODY_SOLVER_ITERATIONS;
+    World->Stats                = {};
+}
+
+inline void RigidBodyAxes(const quat& Orientation, vec3* Axis)
+{
+    mat3 Rotation;
+    Orientation.Mat3(Rotation);
+
+    for (i32 k = 0; k < 3; ++k) {
+        Axis[k] = { Rotation.mat[0][k], Rotation.mat[1][k], Rotation.mat[2][k] };
+    }
+}
+
+// NOTE(ismail): I^-1 world = R * diag(I^-1 local) * RT = sum of InvI[k] * (Ak * AkT)
+inline void RigidBodyUpdateDerived(RigidBody* Body)
+{
+    vec3 Axis[3];
+    RigidBodyAxes(Body->Orientation, Axis);
+
+    for (i32 Row = 0; Row < 3; ++Row) {
+        for (i32 Column = 0; Column < 3; ++Column) {
+            Body->InverseInertiaWorld.mat[Row][Column] =
+                Body->InverseInertiaLocal.x * Axis[0][Row] * Axis[0][Column] +
+                Body->InverseInertiaLocal.y * Axis[1][Row] * Axis[1][Column] +
+                Body->InverseInertiaLocal.z * Axis[2][Row] * Axis[2][Column];
+        }
+    }
+
+    BoundingVolume* Shape = &Body->Shape;
+
+    switch (Shape->VolumeType) {
+        case SphereVolume: {
+            Shape->VolumeData.Sphere.Center = Body->Position;
+        } break;
+
+        case AABBVolume: {
+            Shape->VolumeData.AxisBox.Center = Body->Position;
+        } break;
+
+        case OBBVolume: {
+            Shape->VolumeData.OrientedBox.Center = Body->Position;
+
+            for (i32 k = 0; k < 3; ++k) {
+                Shape->VolumeData.OrientedBox.Axis[k] = Axis[k];
+            }
+        } break;
+    }
+}
+
+// NOTE(ismail): Shape center is body position, for OBB only Extens is used and axes come from Orientation.
+// Mass 0 makes a static body
+inline i32 RigidBodyAdd(RigidBodyWorld* World, BoundingVolume* Shape, const quat& Orientation, real32 Mass)
+{
+    Assert(World->BodiesAmount < World->BodiesCapacity);
+    Assert(Mass >= 0.0f);
+
+    i32         BodyIndex   = World->BodiesAmount++;
+    RigidBody*  Body        = &World->Bodies[BodyIndex];
+
+    *Body = {};
+
+    Body->Orientation       = Shape->VolumeType == AABBVolume ? quat(1.0f, 0.0f, 0.0f, 0.0f) : Orientation;
+    Body->InverseMass       = Mass > 0.0f ? 1.0f / Mass : 0.0f;
+    Body->LinearDamping     = 0.99f;
+    Body->AngularDamping    = 0.95f;
+    Body->Friction          = 0.5f;
+    Body->Restitution       = 0.0f;
+    Body->Shape             = *Shape;
+
+    vec3 Inertia = {};
+
+    switch (Shape->VolumeType) {
+        case SphereVolume: {
+            Body->Position = Shape->VolumeData.Sphere.Center;
+
+            real32 SphereInertia = 0.4f * Mass * SQUARE(Shape->VolumeData.Sphere.Radius);
+            Inertia = { SphereInertia, SphereInertia, SphereInertia };
+        } break;
+
+        case AABBVolume: {
+            Body->Position = Shape->VolumeData.AxisBox.Center;
+        } break;
+
+        case OBBVolume: {
+            Body->Position = Shape->VolumeData.OrientedBox.Center;
+
+            vec3 e = Shape->VolumeData.OrientedBox.Extens;
+
+            // NOTE(ismail): solid box with half sizes e, m * (h^2 + d^2) / 12 = m * (ey^2 + ez^2) / 3
+            Inertia = {
+                Mass * (SQUARE(e.y) + SQUARE(e.z)) / 3.0f,
+                Mass * (SQUARE(e.x) + SQUARE(e.z)) / 3.0f,
+                Mass * (SQUARE(e.x) + SQUARE(e.y)) / 3.0f,
+            };
+        } break;
+    }
+
+    for (i32 k = 0; k < 3; ++k) {
+        Body->InverseInertiaLocal[k] = Inertia[k] > 0.0f ? 1.0f / Inertia[k] : 0.0f;
+    }
+
+    RigidBodyUpdateDerived(Body);
+
+    Body->Proxy = SweepAndPruneInsert(&World->BroadPhase, &Body->Shape, (void*)Body);
+
+    return BodyIndex;
+}
+
+inline OBB RigidBodyShapeAsOBB(BoundingVolume* Shape)
+{
+    OBB Result;
+
+    if (Shape->VolumeType == AABBVolume) {
+        Result.Center   = Shape->VolumeData.AxisBox.Center;
+        Result.Extens   = Shape->VolumeData.AxisBox.Extens;
+        Result.Axis[0]  = { 1.0f, 0.0f, 0.0f };
+        Result.Axis[1]  = { 0.0f, 1.0f, 0.0f };
+        Result.Axis[2]  = { 0.0f, 0.0f, 1.0f };
+    }
+    else {
+        Assert(Shape->VolumeType == OBBVolume);
+
+        Result = Shape->VolumeData.OrientedBox;
+    }
+
+    return Result;
+}
+
+inline i32 CollideSpheres(Sphere* A, Sphere* B, ContactManifold* Manifold)
+{
+    vec3    Distance        = B->Center - A->Center;
+    real32  DistanceSquare  = vec3::DotProduct(Distance, Distance);
+    real32  RadiusSum       = A->Radius + B->Radius;
+
+    if (DistanceSquare > SQUARE(RadiusSum)) {
+        return 0;
+    }
+
+    real32 DistanceLength = Sqrt(DistanceSquare);
+
+    Manifold->Normal = DistanceLength > 0.0001f ? Distance * (1.0f / DistanceLength) : vec3{ 0.0f, 1.0f, 0.0f };
+
+    ContactPoint* Point = &Manifold->Points[0];
+
+    Point->Penetration  = RadiusSum - DistanceLength;
+    Point->Position     = A->Center + Manifold->Normal * (A->Radius - Point->Penetration * 0.5f);
+
+    return 1;
+}
+
+// NOTE(ismail): Normal points from sphere to box
+inline i32 CollideSphereBox(Sphere* A, OBB* B, vec3* Normal, ContactPoint* Point)
+{
+    vec3 Distance = A->Center - B->Center;
+    vec3 Local;
+    vec3 Closest = B->Center;
+
+    for (i32 k = 0; k < 3; ++k) {
+        Local[k] = vec3::DotProduct(Distance, B->Axis[k]);
+
+        real32 Clamped = Clampf(Local[k], -B->Extens[k], B->Extens[k]);
+
+        Closest += B->Axis[k] * Clamped;
+    }
+
+    vec3    ToClosest       = Closest - A->Center;
+    real32  DistanceSquare  = vec3::DotProduct(ToClosest, ToClosest);
+
+    if (DistanceSquare > SQUARE(A->Radius)) {
+        return 0;
+    }
+
+    if (DistanceSquare > 0.000001f) {
+        real32 DistanceLength = Sqrt(DistanceSquare);
+
+        *Normal = ToClosest * (1.0f / DistanceLength);
+
+        Point->Penetration  = A->Radius - DistanceLength;
+        Point->Position     = Closest;
+    }
+    else {
+        // NOTE(ismail): center is inside the box, push out through the nearest face
+        i32     FaceAxis    = 0;
+        real32  FaceDepth   = INFINITY;
+
+        for (i32 k = 0; k < 3; ++k) {
+            real32 Depth = B->Extens[k] - Fabs(Local[k]);
+
+            if (Depth < FaceDepth) {
+                FaceDepth   = Depth;
+                FaceAxis    = k;
+            }
+        }
+
+        *Normal = B->Axis[FaceAxis] * (Local[FaceAxis] > 0.0f ? -1.0f : 1.0f);
+
+        Point->Penetration  = A->Radius + FaceDepth;
+        Point->Position     = A->Center;
+    }
+
+    return 1;
+}
+
+inline real32 OBBProjectedRadius(OBB* Box, const vec3& Axis)
+{
+    real32 Result = Box->Extens.x * Fabs(vec3::DotProduct(Box->Axis[0], Axis)) +
+                    Box->Extens.y * Fabs(vec3::DotProduct(Box->Axis[1], Axis)) +
+                    Box->Extens.z * Fabs(vec3::DotProduct(Box->Axis[2], Axis));
+
+    return Result;
+}
+
+// NOTE(ismail): polygon part on the side where Dot(Normal, x) <= Offset
+inline i32 ClipPolygon(vec3* In, i32 InAmount, const vec3& Normal, real32 Offset, vec3* Out)
+{
+    i32 OutAmount = 0;
+
+    for (i32 Index = 0; Index < InAmount; ++Index) {
+        vec3& Start = In[Index];
+        vec3& End   = In[(Index + 1) % InAmount];
+
+        real32 StartDistance    = vec3::DotProduct(Normal, Start) - Offset;
+        real32 EndDistance      = vec3::DotProduct(Normal, End) - Offset;
+
+        if (StartDistance <= 0.0f) {
+            Out[OutAmount++] = Start;
+        }
+
+        if ((StartDistance < 0.0f && EndDistance > 0.0f) || (StartDistance > 0.0f && EndDistance < 0.0f)) {
+            real32 t = StartDistance / (StartDistance - EndDistance);
+
+            Out[OutAmount++] = Start + (End - Start) * t;
+        }
+    }
+
+    Assert(OutAmount <= RIGID_BODY_CLIP_MAX_VERTICES);
+
+    return OutAmount;
+}
+
+// NOTE(ismail): keeps deepest point, the one farthest from it and two points spanning the largest area on both sides
+inline i32 ReduceContactPoints(ContactPoint* Points, i32 PointsAmount, const vec3& Normal, ContactPoint* Result)
+{
+    if (PointsAmount <= RIGID_BODY_MAX_CONTACT_POINTS) {
+        for (i32 Index = 0; Index < PointsAmount; ++Index) {
+            Result[Index] = Points[Index];
+        }
+
+        return PointsAmount;
+    }
+
+    i32 Chosen[4] = { 0, 0, 0, 0 };
+
+    for (i32 Index = 1; Index < PointsAmount; ++Index) {
+        if (Points[Index].Penetration > Points[Chosen[0]].Penetration) {
+            Chosen[0] = Index;
+        }
+    }
+
+    real32 BestDistance = -1.0f;
+    for (i32 Index = 0; Index < PointsAmount; ++Index) {
+        vec3    Offset      = Points[Index].Position - Points[Chosen[0]].Position;
+        real32  Distance    = vec3::DotProduct(Offset, Offset);
+
+        if (Distance > BestDistance) {
+            BestDistance    = Distance;
+            Chosen[1]       = Index;
+        }
+    }
+
+    vec3    Edge        = Points[Chosen[1]].Position - Points[Chosen[0]].Position;
+    real32  MaxArea     = 0.0f;
+    real32  MinArea     = 0.0f;
+
+    Chosen[2] = Chosen[0];
+    Chosen[3] = Chosen[1];
+
+    for (i32 Index = 0; Index < PointsAmount; ++Index) {
+        vec3    Offset  = Points[Index].Position - Points[Chosen[0]].Position;
+        real32  Area    = vec3::DotProduct(Edge.Cross(Offset), Normal);
+
+        if (Area > MaxArea) {
+            MaxArea     = Area;
+            Chosen[2]   = Index;
+        }
+        if (Area < MinArea) {
+            MinArea     = Area;
+            Chosen[3]   = Index;
+        }
+    }
+
+    i32 ResultAmount = 0;
+    for (i32 ChosenIndex = 0; ChosenIndex < 4; ++ChosenIndex) {
+        bool32 Duplicate = 0;
+
+        for (i32 Previous = 0; Previous < ChosenIndex; ++Previous) {
+            Duplicate |= Chosen[Previous] == Chosen[ChosenIndex];
+        }
+
+        if (!Duplicate) {
+            Result[ResultAmount++] = Points[Chosen[ChosenIndex]];
+        }
+    }
+
+    return ResultAmount;
+}
+
+// NOTE(ismail): SAT picks axis of least penetration (faces preferred), face contacts clip incident face
+// against reference face sides, edge contacts use closest points of the two edges
+inline i32 CollideBoxes(OBB* A, OBB* B, ContactManifold* Manifold)
+{
+    vec3 T = B->Center - A->Center;
+
+    i32     BestAxis    = -1;
+    real32  BestOverlap = INFINITY;
+    vec3    BestNormal  = {};
+
+    for (i32 Axis = 0; Axis < 6; ++Axis) {
+        vec3    L       = Axis < 3 ? A->Axis[Axis] : B->Axis[Axis - 3];
+        real32  ProjT   = vec3::DotProduct(T, L);
+        real32  Overlap = OBBProjectedRadius(A, L) + OBBProjectedRadius(B, L) - Fabs(ProjT);
+
+        if (Overlap < 0.0f) {
+            return 0;
+        }
+
+        // NOTE(ismail): B faces have to be clearly better than A faces, keeps reference face from flipping between steps
+        real32 Tolerance = Axis < 3 ? 1.0f : RIGID_BODY_FACE_AXIS_TOLERANCE;
+
+        if (Overlap < BestOverlap * Tolerance) {
+            BestAxis    = Axis;
+            BestOverlap = Overlap;
+            BestNormal  = ProjT < 0.0f ? -L : L;
+        }
+    }
+
+    real32 FaceOverlap = BestOverlap;
+
+    for (i32 i = 0; i < 3; ++i) {
+        for (i32 j = 0; j < 3; ++j) {
+            vec3    L               = A->Axis[i].Cross(B->Axis[j]);
+            real32  LengthSquare    = vec3::DotProduct(L, L);
+
+            if (LengthSquare < OBB_EPSILON) {
+                continue;
+            }
+
+            L *= 1.0f / Sqrt(LengthSquare);
+
+            real32 ProjT    = vec3::DotProduct(T, L);
+            real32 Overlap  = OBBProjectedRadius(A, L) + OBBProjectedRadius(B, L) - Fabs(ProjT);
+
+            if (Overlap < 0.0f) {
+                return 0;
+            }
+
+            if (Overlap < FaceOverlap * RIGID_BODY_FACE_AXIS_TOLERANCE && Overlap < BestOverlap) {
+                BestAxis    = 6 + 3 * i + j;
+                BestOverlap = Overlap;
+                BestNormal  = ProjT < 0.0f ? -L : L;
+            }
+        }
+    }
+
+    Manifold->Normal = BestNormal;
+
+    if (BestAxis >= 6) {
+        i32 i = (BestAxis - 6) / 3;
+        i32 j = (BestAxis - 6) % 3;
+
+        // NOTE(ismail): pick edge of A closest to B and edge of B closest to A
+        vec3 PointA = A->Center;
+        vec3 PointB = B->Center;
+
+        for (i32 k = 0; k < 3; ++k) {
+            if (k != i) {
+                PointA += A->Axis[k] * (vec3::DotProduct(A->Axis[k], BestNormal) > 0.0f ? A->Extens[k] : -A->Extens[k]);
+            }
+            if (k != j) {
+                PointB += B->Axis[k] * (vec3::DotProduct(B->Axis[k], BestNormal) > 0.0f ? -B->Extens[k] : B->Extens[k]);
+            }
+        }
+
+        vec3&   DirectionA  = A->Axis[i];
+        vec3&   DirectionB  = B->Axis[j];
+        vec3    Offset      = PointA - PointB;
+
+        real32 DotAB    = vec3::DotProduct(DirectionA, DirectionB);
+        real32 DotAO    = vec3::DotProduct(DirectionA, Offset);
+        real32 DotBO    = vec3::DotProduct(DirectionB, Offset);
+        real32 Denom    = 1.0f - SQUARE(DotAB);
+
+        real32 s = Denom > 0.0001f ? (DotAB * DotBO - DotAO) / Denom : 0.0f;
+        real32 t = DotBO + DotAB * s;
+
+        s = Clampf(s, -A->Extens[i], A->Extens[i]);
+        t = Clampf(t, -B->Extens[j], B->Extens[j]);
+
+        ContactPoint* Point = &Manifold->Points[0];
+
+        Point->Penetration  = BestOverlap;
+        Point->Position     = ((PointA + DirectionA * s) + (PointB + DirectionB * t)) * 0.5f;
+
+        return 1;
+    }
+
+    OBB*    Reference       = BestAxis < 3 ? A : B;
+    OBB*    Incident        = BestAxis < 3 ? B : A;
+    i32     ReferenceAxis   = BestAxis < 3 ? BestAxis : BestAxis - 3;
+    vec3    ReferenceNormal = BestAxis < 3 ? BestNormal : -BestNormal;
+
+    // NOTE(ismail): incident face is the one most anti parallel to reference normal
+    i32     IncidentAxis    = 0;
+    real32  MostParallel    = -1.0f;
+
+    for (i32 k = 0; k < 3; ++k) {
+        real32 Parallel = Fabs(vec3::DotProduct(Incident->Axis[k], ReferenceNormal));
+
+        if (Parallel > MostParallel) {
+            MostParallel    = Parallel;
+            IncidentAxis    = k;
+        }
+    }
+
+    real32  IncidentSign    = vec3::DotProduct(Incident->Axis[IncidentAxis], ReferenceNormal) > 0.0f ? -1.0f : 1.0f;
+    vec3    IncidentCenter  = Incident->Center + Incident->Axis[IncidentAxis] * (Incident->Extens[IncidentAxis] * IncidentSign);
+
+    i32     u = (IncidentAxis + 1) % 3;
+    i32     v = (IncidentAxis + 2) % 3;
+    vec3    U = Incident->Axis[u] * Incident->Extens[u];
+    vec3    V = Incident->Axis[v] * Incident->Extens[v];
+
+    vec3 Polygon[2][RIGID_BODY_CLIP_MAX_VERTICES] = {
+        { IncidentCenter + U + V, IncidentCenter - U + V, IncidentCenter - U - V, IncidentCenter + U - V },
+    };
+
+    i32 PolygonAmount   = 4;
+    i32 Current         = 0;
+
+    for (i32 k = 0; k < 3 && PolygonAmount > 0; ++k) {
+        if (k == ReferenceAxis) {
+            continue;
+        }
+
+        vec3&   Side        = Reference->Axis[k];
+        real32  CenterProj  = vec3::DotProduct(Side, Reference->Center);
+
+        PolygonAmount = ClipPolygon(Polygon[Current], PolygonAmount, Side, CenterProj + Reference->Extens[k], Polygon[1 - Current]);
+        Current = 1 - Current;
+
+        PolygonAmount = ClipPolygon(Polygon[Current], PolygonAmount, -Side, -CenterProj + Reference->Extens[k], Polygon[1 - Current]);
+        Current = 1 - Current;
+    }
+
+    real32 FaceOffset = vec3::DotProduct(ReferenceNormal, Reference->Center) + Reference->Extens[ReferenceAxis];
+
+    ContactPoint    Candidates[RIGID_BODY_CLIP_MAX_VERTICES];
+    i32             CandidatesAmount = 0;
+
+    for (i32 Index = 0; Index < PolygonAmount; ++Index) {
+        vec3&   Vertex  = Polygon[Current][Index];
+        real32  Depth   = FaceOffset - vec3::DotProduct(ReferenceNormal, Vertex);
+
+        if (Depth >= 0.0f) {
+            ContactPoint& Candidate = Candidates[CandidatesAmount++];
+
+            Candidate.Penetration   = Depth;
+            Candidate.Position      = Vertex + ReferenceNormal * (Depth * 0.5f);
+        }
+    }
+
+    return ReduceContactPoints(Candidates, CandidatesAmount, Manifold->Normal, Manifold->Points);
+}
+
+inline i32 RigidBodyCollide(RigidBody* BodyA, RigidBody* BodyB, ContactManifold* Manifold)
+{
+    BoundingVolume* ShapeA = &BodyA->Shape;
+    BoundingVolume* ShapeB = &BodyB->Shape;
+
+    bool32 SphereA = ShapeA->VolumeType == SphereVolume;
+    bool32 SphereB = ShapeB->VolumeType == SphereVolume;
+
+    if (SphereA && SphereB) {
+        return CollideSpheres(&ShapeA->VolumeData.Sphere, &ShapeB->VolumeData.Sphere, Manifold);
+    }
+
+    if (SphereA || SphereB) {
+        OBB     Box         = RigidBodyShapeAsOBB(SphereA ? ShapeB : ShapeA);
+        Sphere* Ball        = SphereA ? &ShapeA->VolumeData.Sphere : &ShapeB->VolumeData.Sphere;
+        vec3    SphereToBox = {};
+
+        i32 PointsAmount = CollideSphereBox(Ball, &Box, &SphereToBox, &Manifold->Points[0]);
+
+        Manifold->Normal = SphereA ? SphereToBox : -SphereToBox;
+
+        return PointsAmount;
+    }
+
+    OBB BoxA = RigidBodyShapeAsOBB(ShapeA);
+    OBB BoxB = RigidBodyShapeAsOBB(ShapeB);
+
+    return CollideBoxes(&BoxA, &BoxB, Manifold);
+}
+
+inline void RigidBodyApplyImpulse(RigidBody* BodyA, RigidBody* BodyB, ContactPoint* Point, const vec3& Impulse)
+{
+    BodyA->LinearVelocity   -= Impulse * BodyA->InverseMass;
+    BodyA->AngularVelocity  -= BodyA->InverseInertiaWorld * Point->RelativeA.Cross(Impulse);
+
+    BodyB->LinearVelocity   += Impulse * BodyB->InverseMass;
+    BodyB->AngularVelocity  += BodyB->InverseInertiaWorld * Point->RelativeB.Cross(Impulse);
+}
+
+inline vec3 RigidBodyRelativeVelocity(RigidBody* BodyA, RigidBody* BodyB, ContactPoint* Point)
+{
+    vec3 VelocityA = BodyA->LinearVelocity + BodyA->AngularVelocity.Cross(Point->RelativeA);
+    vec3 VelocityB = BodyB->LinearVelocity + BodyB->AngularVelocity.Cross(Point->RelativeB);
+
+    return VelocityB - VelocityA;
+}
+
+inline real32 RigidBodyEffectiveMass(RigidBody* BodyA, RigidBody* BodyB, ContactPoint* Point, const vec3& Direction)
+{
+    vec3 CrossA = Point->RelativeA.Cross(Direction);
+    vec3 CrossB = Point->RelativeB.Cross(Direction);
+
+    real32 K = BodyA->InverseMass + BodyB->InverseMass +
+               vec3::DotProduct(CrossA, BodyA->InverseInertiaWorld * CrossA) +
+               vec3::DotProduct(CrossB, BodyB->InverseInertiaWorld * CrossB);
+
+    return K > 0.0f ? 1.0f / K : 0.0f;
+}
+
+static int BroadPhasePairCompare(const void* A, const void* B)
+{
+    const BroadPhasePair* PairA = (const BroadPhasePair*)A;
+    const BroadPhasePair* PairB = (const BroadPhasePair*)B;
+
+    if (PairA->ProxyA != PairB->ProxyA) {
+        return PairA->ProxyA < PairB->ProxyA ? -1 : 1;
+    }
+    if (PairA->ProxyB != PairB->ProxyB) {
+        return PairA->ProxyB < PairB->ProxyB ? -1 : 1;
+    }
+
+    return 0;
+}
+
+// NOTE(ismail): pairs come out of broad phase as proxies, turned into sorted body index pairs so
+// manifolds are built in the same order every step and can be merged with previous step ones
+inline void RigidBodyFindContacts(RigidBodyWorld* World)
+{
+    RigidBody* Bodies = World->Bodies;
+
+    i32 PairsAmount = SweepAndPruneQueryPairs(&World->BroadPhase, World->Pairs, World->ManifoldsCapacity);
+
+    World->Stats.DroppedPairs = PairsAmount > World->ManifoldsCapacity ? PairsAmount - World->ManifoldsCapacity : 0;
+    PairsAmount = PairsAmount > World->ManifoldsCapacity ? World->ManifoldsCapacity : PairsAmount;
+
+    for (i32 PairIndex = 0; PairIndex < PairsAmount; ++PairIndex) {
+        BroadPhasePair& Pair = World->Pairs[PairIndex];
+
+        i32 BodyA = (i32)((RigidBody*)SweepAndPruneGetUserData(&World->BroadPhase, Pair.ProxyA) - Bodies);
+        i32 BodyB = (i32)((RigidBody*)SweepAndPruneGetUserData(&World->BroadPhase, Pair.ProxyB) - Bodies);
+
+        Pair.ProxyA = BodyA < BodyB ? BodyA : BodyB;
+        Pair.ProxyB = BodyA < BodyB ? BodyB : BodyA;
+    }
+
+    qsort(World->Pairs, PairsAmount, sizeof(*World->Pairs), BroadPhasePairCompare);
+
+    i32                 Previous            = World->CurrentManifolds;
+    i32                 Current             = 1 - Previous;
+    ContactManifold*    OldManifolds        = World->Manifolds[Previous];
+    i32                 OldManifoldsAmount  = World->ManifoldsAmount[Previous];
+    ContactManifold*    NewManifolds        = World->Manifolds[Current];
+    i32                 NewManifoldsAmount  = 0;
+    i32                 OldIndex            = 0;
+
+    World->Stats.PairsAmount        = PairsAmount;
+    World->Stats.ContactsAmount     = 0;
+    World->Stats.WarmStartedAmount  = 0;
+
+    for (i32 PairIndex = 0; PairIndex < PairsAmount; ++PairIndex) {
+        BroadPhasePair& Pair    = World->Pairs[PairIndex];
+        RigidBody*      BodyA   = &Bodies[Pair.ProxyA];
+        RigidBody*      BodyB   = &Bodies[Pair.ProxyB];
+
+        if (BodyA->InverseMass == 0.0f && BodyB->InverseMass == 0.0f) {
+            continue;
+        }
+
+        ContactManifold* Manifold = &NewManifolds[NewManifoldsAmount];
+
+        Manifold->BodyA = Pair.ProxyA;
+        Manifold->BodyB = Pair.ProxyB;
+
+        Manifold->PointsAmount = RigidBodyCollide(BodyA, BodyB, Manifold);
+
+        if (!Manifold->PointsAmount) {
+            continue;
+        }
+
+        ++NewManifoldsAmount;
+
+        Manifold->Friction      = Sqrt(BodyA->Friction * BodyB->Friction);
+        Manifold->Restitution   = BodyA->Restitution > BodyB->Restitution ? BodyA->Restitution : BodyB->Restitution;
+
+        for (i32 PointIndex = 0; PointIndex < Manifold->PointsAmount; ++PointIndex) {
+            ContactPoint* Point = &Manifold->Points[PointIndex];
+
+            Point->NormalImpulse        = 0.0f;
+            Point->TangentImpulse[0]    = 0.0f;
+            Point->TangentImpulse[1]    = 0.0f;
+        }
+
+        // NOTE(ismail): both lists are sorted by (BodyA, BodyB), advance old one up to current pair
+        while (OldIndex < OldManifoldsAmount &&
+               (OldManifolds[OldIndex].BodyA < Manifold->BodyA ||
+               (OldManifolds[OldIndex].BodyA == Manifold->BodyA && OldManifolds[OldIndex].BodyB < Manifold->BodyB))) {
+            ++OldIndex;
+        }
+
+        if (OldIndex < OldManifoldsAmount && OldManifolds[OldIndex].BodyA == Manifold->BodyA && OldManifolds[OldIndex].BodyB == Manifold->BodyB) {
+            ContactManifold* OldManifold = &OldManifolds[OldIndex];
+
+            for (i32 PointIndex = 0; PointIndex < Manifold->PointsAmount; ++PointIndex) {
+                ContactPoint*   Point           = &Manifold->Points[PointIndex];
+                ContactPoint*   Match           = 0;
+                real32          MatchDistance   = SQUARE(RIGID_BODY_CONTACT_MATCH_DISTANCE);
+
+                for (i32 OldPointIndex = 0; OldPointIndex < OldManifold->PointsAmount; ++OldPointIndex) {
+                    vec3    Offset      = OldManifold->Points[OldPointIndex].Position - Point->Position;
+                    real32  Distance    = vec3::DotProduct(Offset, Offset);
+
+                    if (Distance < MatchDistance) {
+                        MatchDistance   = Distance;
+                        Match           = &OldManifold->Points[OldPointIndex];
+                    }
+                }
+
+                if (Match) {
+                    Point->NormalImpulse        = Match->NormalImpulse;
+                    Point->TangentImpulse[0]    = Match->TangentImpulse[0];
+                    Point->TangentImpulse[1]    = Match->TangentImpulse[1];
+
+                    ++World->Stats.WarmStartedAmount;
+                }
+            }
+        }
+
+        World->Stats.ContactsAmount += Manifold->PointsAmount;
+    }
+
+    World->ManifoldsAmount[Current] = NewManifoldsAmount;
+    World->CurrentManifolds         = Current;
+    World->Stats.ManifoldsAmount    = NewManifoldsAmount;
+}
+
+inline void RigidBodyPrepareContacts(RigidBodyWorld* World, real32 dt)
+{
+    ContactManifold*    Manifolds       = World->Manifolds[World->CurrentManifolds];
+    i32                 ManifoldsAmount = World->ManifoldsAmount[World->CurrentManifolds];
+    real32              OneOverDt       = 1.0f / dt;
+
+    for (i32 ManifoldIndex = 0; ManifoldIndex < ManifoldsAmount; ++ManifoldIndex) {
+        ContactManifold*    Manifold    = &Manifolds[ManifoldIndex];
+        RigidBody*          BodyA       = &World->Bodies[Manifold->BodyA];
+        RigidBody*          BodyB       = &World->Bodies[Manifold->BodyB];
+        vec3&               Normal      = Manifold->Normal;
+
+        // NOTE(ismail): any tangent basis works, this one never degenerates
+        if (Fabs(Normal.x) >= 0.57735f) {
+            Manifold->Tangents[0] = vec3::Normalize({ Normal.y, -Normal.x, 0.0f });
+        }
+        else {
+            Manifold->Tangents[0] = vec3::Normalize({ 0.0f, Normal.z, -Normal.y });
+        }
+
+        Manifold->Tangents[1] = Normal.Cross(Manifold->Tangents[0]);
+
+        for (i32 PointIndex = 0; PointIndex < Manifold->PointsAmount; ++PointIndex) {
+            ContactPoint* Point = &Manifold->Points[PointIndex];
+
+            Point->RelativeA = Point->Position - BodyA->Position;
+            Point->RelativeB = Point->Position - BodyB->Position;
+
+            Point->NormalMass       = RigidBodyEffectiveMass(BodyA, BodyB, Point, Normal);
+            Point->TangentMass[0]   = RigidBodyEffectiveMass(BodyA, BodyB, Point, Manifold->Tangents[0]);
+            Point->TangentMass[1]   = RigidBodyEffectiveMass(BodyA, BodyB, Point, Manifold->Tangents[1]);
+
+            real32 Penetration = Point->Penetration - RIGID_BODY_PENETRATION_SLOP;
+
+            Point->Bias = Penetration > 0.0f ? RIGID_BODY_BAUMGARTE * OneOverDt * Penetration : 0.0f;
+
+            real32 NormalVelocity = vec3::DotProduct(RigidBodyRelativeVelocity(BodyA, BodyB, Point), Normal);
+
+            if (NormalVelocity < -RIGID_BODY_RESTITUTION_THRESHOLD) {
+                real32 Bounce = -Manifold->Restitution * NormalVelocity;
+
+                Point->Bias = Bounce > Point->Bias ? Bounce : Point->Bias;
+            }
+
+            vec3 WarmStart = Normal * Point->NormalImpulse +
+                             Manifold->Tangents[0] * Point->TangentImpulse[0] +
+                             Manifold->Tangents[1] * Point->TangentImpulse[1];
+
+            RigidBodyApplyImpulse(BodyA, BodyB, Point, WarmStart);
+        }
+    }
+}
+
+inline void RigidBodySolveContacts(RigidBodyWorld* World)
+{
+    ContactManifold*    Manifolds       = World->Manifolds[World->CurrentManifolds];
+    i32                 ManifoldsAmount = World->ManifoldsAmount[World->CurrentManifolds];
+
+    for (i32 ManifoldIndex = 0; ManifoldIndex < ManifoldsAmount; ++ManifoldIndex) {
+        ContactManifold*    Manifold    = &Manifolds[ManifoldIndex];
+        RigidBody*          BodyA       = &World->Bodies[Manifold->BodyA];
+        RigidBody*          BodyB       = &World->Bodies[Manifold->BodyB];
+
+        for (i32 PointIndex = 0; PointIndex < Manifold->PointsAmount; ++PointIndex) {
+            ContactPoint* Point = &Manifold->Points[PointIndex];
+
+            // NOTE(ismail): friction first, its limit uses normal impulse from previous iteration
+            real32 MaxFriction = Manifold->Friction * Point->NormalImpulse;
+
+            for (i32 TangentIndex = 0; TangentIndex < 2; ++TangentIndex) {
+                vec3&   Tangent         = Manifold->Tangents[TangentIndex];
+                real32  TangentVelocity = vec3::DotProduct(RigidBodyRelativeVelocity(BodyA, BodyB, Point), Tangent);
+                real32  Lambda          = -TangentVelocity * Point->TangentMass[TangentIndex];
+
+                real32 OldImpulse = Point->TangentImpulse[TangentIndex];
+                Point->TangentImpulse[TangentIndex] = Clampf(OldImpulse + Lambda, -MaxFriction, MaxFriction);
+
+                RigidBodyApplyImpulse(BodyA, BodyB, Point, Tangent * (Point->TangentImpulse[TangentIndex] - OldImpulse));
+            }
+
+            real32 NormalVelocity   = vec3::DotProduct(RigidBodyRelativeVelocity(BodyA, BodyB, Point), Manifold->Normal);
+            real32 Lambda           = Point->NormalMass * (Point->Bias - NormalVelocity);
+
+            real32 OldImpulse   = Point->NormalImpulse;
+            real32 NewImpulse   = OldImpulse + Lambda;
+
+            Point->NormalImpulse = NewImpulse > 0.0f ? NewImpulse : 0.0f;
+
+            RigidBodyApplyImpulse(BodyA, BodyB, Point, Manifold->Normal * (Point->NormalImpulse - OldImpulse));
+        }
+    }
+}
+
+// NOTE(ismail): one fixed step, call it with constant dt for deterministic results
+inline void RigidBodyWorldStep(RigidBodyWorld* World, real32 dt)
+{
+    Assert(dt > 0.0f);
+
+    RigidBody*  Bodies          = World->Bodies;
+    i32         BodiesAmount    = World->BodiesAmount;
+
+    for (i32 BodyIndex = 0; BodyIndex < BodiesAmount; ++BodyIndex) {
+        RigidBody* Body = &Bodies[BodyIndex];
+
+        if (Body->InverseMass == 0.0f) {
+            continue;
+        }
+
+        Body->LinearVelocity += World->Gravity * dt;
+    }
+
+    RigidBodyFindContacts(World);
+    RigidBodyPrepareContacts(World, dt);
+
+    for (i32 Iteration = 0; Iteration < World->Iterations; ++Iteration) {
+        RigidBodySolveContacts(World);
+    }
+
+    // NOTE(ismail): all bodies share damping in practice, so powf runs only when damping differs from previous body.
+    // Cache starts at damping 1 whose effect is exactly 1, any damping value is valid then
+    real32 LinearDamping        = 1.0f;
+    real32 LinearDampingEffect  = 1.0f;
+    real32 AngularDamping       = 1.0f;
+    real32 AngularDampingEffect = 1.0f;
+
+    for (i32 BodyIndex = 0; BodyIndex < BodiesAmount; ++BodyIndex) {
+        RigidBody* Body = &Bodies[BodyIndex];
+
+        if (Body->InverseMass == 0.0f) {
+            continue;
+        }
+
+        if (LinearDamping != Body->LinearDamping) {
+            LinearDamping       = Body->LinearDamping;
+            LinearDampingEffect = powf(LinearDamping, dt);
+        }
+        if (AngularDamping != Body->AngularDamping) {
+            AngularDamping          = Body->AngularDamping;
+            AngularDampingEffect    = powf(AngularDamping, dt);
+        }
+
+        Body->LinearVelocity    *= LinearDampingEffect;
+        Body->AngularVelocity   *= AngularDampingEffect;
+
+        Body->Position += Body->LinearVelocity * dt;
+
+        // NOTE(ismail): q' = q + dt / 2 * (0, w) * q
+        vec3&   w       = Body->AngularVelocity;
+        quat&   q       = Body->Orientation;
+        quat    Spin    = quat(0.0f, w.x, w.y, w.z) * q;
+        real32  HalfDt  = dt * 0.5f;
+
+        q = quat(q.w + Spin.w * HalfDt, q.x + Spin.x * HalfDt, q.y + Spin.y * HalfDt, q.z + Spin.z * HalfDt);
+
+        real32 OneOverLength = 1.0f / q.Length();
+        q = quat(q.w * OneOverLength, q.x * OneOverLength, q.y * OneOverLength, q.z * OneOverLength);
+
+        RigidBodyUpdateDerived(Body);
+
+        SweepAndPruneMove(&World->BroadPhase, Body->Proxy, &Body->Shape);
+    }
+}
+
+#endif
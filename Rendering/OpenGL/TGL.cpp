@@ -36,6 +36,7 @@ TEARA_glGenFramebuffers             tglGenFramebuffers;
 TEARA_glBindFramebuffer             tglBindFramebuffer;
 TEARA_glFramebufferTexture2D        tglFramebufferTexture2D;
 TEARA_glCheckFramebufferStatus      tglCheckFramebufferStatus;
+TEARA_glCompressedTexImage2D        tglCompressedTexImage2D;
 
 #ifndef TEARA_DEBUG
 
@@ -78,6 +79,7 @@ TEARA_glGenFramebuffers             tglGenFramebuffersOrigin;
 TEARA_glBindFramebuffer             tglBindFramebufferOrigin;
 TEARA_glFramebufferTexture2D        tglFramebufferTexture2DOrigin;
 TEARA_glCheckFramebufferStatus      tglCheckFramebufferStatusOrigin;
+TEARA_glCompressedTexImage2D        tglCompressedTexImage2DOrigin;
 
 #define DECLARE_DEBUG_GL_FUNCTION(return_type, name, args_func, args_to_call) \
     return_type t##name##DEBUG args_func                                      \
@@ -135,6 +137,7 @@ DECLARE_DEBUG_GL_FUNCTION_NO_RET(glGenFramebuffers, (GLsizei n, GLuint *ids), (n
 DECLARE_DEBUG_GL_FUNCTION_NO_RET(glBindFramebuffer, (GLenum target, GLuint framebuffer), (target, framebuffer));
 DECLARE_DEBUG_GL_FUNCTION_NO_RET(glFramebufferTexture2D, (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level), (target, attachment, textarget, texture, level));
 DECLARE_DEBUG_GL_FUNCTION(GLenum, glCheckFramebufferStatus, (GLenum target), (target))
+DECLARE_DEBUG_GL_FUNCTION_NO_RET(glCompressedTexImage2D, (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void *data), (target, level, internalformat, width, height, border, imageSize, data));
 
 void LinkDebugFunction()
 {
@@ -173,6 +176,7 @@ void LinkDebugFunction()
     tglBindFramebuffer          = tglBindFramebufferDEBUG;
     tglFramebufferTexture2D     = tglFramebufferTexture2DDEBUG;
     tglCheckFramebufferStatus   = tglCheckFramebufferStatusDEBUG;
+    tglCompressedTexImage2D     = tglCompressedTexImage2DDEBUG;
 }
 
 #define tglGenBuffers               tglGenBuffersOrigin 
@@ -210,6 +214,7 @@ void LinkDebugFunction()
 #define tglBindFramebuffer          tglBindFramebufferOrigin
 #define tglFramebufferTexture2D     tglFramebufferTexture2DOrigin
 #define tglCheckFramebufferStatus   tglCheckFramebufferStatusOrigin
+#define tglCompressedTexImage2D     tglCompressedTexImage2DOrigin
 
 #endif
 
@@ -427,5 +432,11 @@ Statuses LoadGLFunctions()
         return Statuses::Failed;
     }
 
+    tglCompressedTexImage2D = (TEARA_glCompressedTexImage2D) tglGetProcAddress ("glCompressedTexImage2D");
+    if (!tglCompressedTexImage2D) {
+        // TODO (ismail): diagnostic?
+        return Statuses::Failed;
+    }
+
     return Statuses::Success;
 }
\ No newline at end of file
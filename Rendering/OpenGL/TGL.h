@@ -60,6 +60,7 @@ typedef DEF_GL_FUNCTION(void, GLAPIENTRY, glGenFramebuffers, GLsizei n, GLuint *
 typedef DEF_GL_FUNCTION(void, GLAPIENTRY, glBindFramebuffer, GLenum target, GLuint framebuffer);
 typedef DEF_GL_FUNCTION(void, GLAPIENTRY, glFramebufferTexture2D, GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
 typedef DEF_GL_FUNCTION(GLenum, GLAPIENTRY, glCheckFramebufferStatus, GLenum target);
+typedef DEF_GL_FUNCTION(void, GLAPIENTRY, glCompressedTexImage2D, GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void *data);
 
 EXTERN_FUNCTION(glGenBuffers);
 EXTERN_FUNCTION(glBindBuffer);
@@ -96,6 +97,7 @@ EXTERN_FUNCTION(glGenFramebuffers);
 EXTERN_FUNCTION(glBindFramebuffer);
 EXTERN_FUNCTION(glFramebufferTexture2D);
 EXTERN_FUNCTION(glCheckFramebufferStatus);
+EXTERN_FUNCTION(glCompressedTexImage2D);
 
 Statuses LoadGLFunctions();
 
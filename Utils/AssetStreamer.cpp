@@ -0,0 +1,507 @@
+#include "AssetStreamer.h"
+#include "Core/Debug.h"
+#include "Core/JobSystem.h"
+
+#include <string.h>
+
+#define ASSET_STREAMER_SLOTS_MASK   (ASSET_STREAMER_MAX_ASSETS - 1)
+#define ASSET_STREAMER_PAGE_SIZE    (4096)
+#define ASSET_STREAMER_MAX_BATCH    (16)
+
+struct AssetDecodeTask {
+    AssetStreamer*  Streamer;
+    StreamedAsset*  Asset;
+    File            Source;
+};
+
+static void AssetStreamQueuePush(AssetStreamQueue *Queue, i32 Slot)
+{
+    u32 Write = Queue->Write.load(std::memory_order_relaxed);
+
+    Assert(Write - Queue->Read.load(std::memory_order_acquire) < ASSET_STREAMER_MAX_ASSETS);
+
+    Queue->Slots[Write & ASSET_STREAMER_SLOTS_MASK] = Slot;
+
+    Queue->Write.store(Write + 1, std::memory_order_release);
+}
+
+static bool32 AssetStreamQueuePeek(AssetStreamQueue *Queue, i32 *Slot)
+{
+    u32 Read = Queue->Read.load(std::memory_order_relaxed);
+
+    if (Read == Queue->Write.load(std::memory_order_acquire)) {
+        return 0;
+    }
+
+    *Slot = Queue->Slots[Read & ASSET_STREAMER_SLOTS_MASK];
+
+    return 1;
+}
+
+static void AssetStreamQueuePop(AssetStreamQueue *Queue)
+{
+    Queue->Read.store(Queue->Read.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+// NOTE(ismail): mapping is lazy, without this first touch of every page would happen inside upload on main thread
+static u64 AssetStreamerPrefault(const void *Data, u64 Size)
+{
+    const u8*   Bytes   = (const u8*)Data;
+    u64         Result  = 0;
+
+    for (u64 Offset = 0; Offset < Size; Offset += ASSET_STREAMER_PAGE_SIZE) {
+        Result += Bytes[Offset];
+    }
+
+    return Result;
+}
+
+static u64 AssetStreamerMeshBytes(ObjFile *LoadFile)
+{
+    return sizeof(*LoadFile->Positions)     * (u64)LoadFile->PositionsCount +
+           sizeof(*LoadFile->Normals)       * (u64)LoadFile->NormalsCount   +
+           sizeof(*LoadFile->TextureCoord)  * (u64)LoadFile->TexturesCount  +
+           sizeof(*LoadFile->Indices)       * (u64)LoadFile->IndicesCount;
+}
+
+static void AssetStreamerLoadMesh(AssetStreamer *Streamer, StreamedAsset *Asset)
+{
+    Platform*   Platform    = Streamer->PlatformContext;
+    ObjFile*    LoadFile    = &Asset->MeshFile;
+    char        CookedPath[COOKED_MESH_PATH_MAX];
+
+    // NOTE(ismail): same order InitMeshComponent had, cooked blob first and text as fallback
+    CookedMeshPath(CookedPath, sizeof(CookedPath), Asset->Path);
+
+    if (!Asset->SkipCooked &&
+        OpenCookedMesh(Platform, CookedPath, Asset->Path, CookedMeshFlags(Asset->MeshFlags), &Asset->Cooked) == Statuses::Success) {
+        CookedMeshToObjFile(&Asset->Cooked, LoadFile);
+
+        AssetStreamerPrefault(Asset->Cooked.Mapping.Data, Asset->Cooked.Mapping.Size);
+
+        Asset->Status = Statuses::Success;
+    }
+    else {
+        u64 MeshesSize      = sizeof(Mesh) * ASSET_STREAMER_OBJ_MAX_MESHES;
+        u64 ElementsSize    = (sizeof(vec3) * 2 + sizeof(vec2) + sizeof(u32)) * (u64)ASSET_STREAMER_OBJ_MAX_ELEMENTS;
+        u8* Memory          = (u8*)Platform->AllocMem(MeshesSize + ElementsSize);
+
+        Asset->MeshMemory = Memory;
+
+        LoadFile->Meshes        = (Mesh*)Memory;    Memory += MeshesSize;
+        LoadFile->Positions     = (vec3*)Memory;    Memory += sizeof(vec3) * ASSET_STREAMER_OBJ_MAX_ELEMENTS;
+        LoadFile->Normals       = (vec3*)Memory;    Memory += sizeof(vec3) * ASSET_STREAMER_OBJ_MAX_ELEMENTS;
+        LoadFile->TextureCoord  = (vec2*)Memory;    Memory += sizeof(vec2) * ASSET_STREAMER_OBJ_MAX_ELEMENTS;
+        LoadFile->Indices       = (u32*)Memory;
+
+        LoadFile->MeshesCapacity    = ASSET_STREAMER_OBJ_MAX_MESHES;
+        LoadFile->ElementsCapacity  = ASSET_STREAMER_OBJ_MAX_ELEMENTS;
+
+        Asset->Status = LoadObjFile(Asset->Path, LoadFile, Asset->MeshFlags);
+    }
+
+    Asset->Bytes = AssetStreamerMeshBytes(LoadFile);
+}
+
+// NOTE(ismail): four independent lanes so multiplies don't wait on each other, tail is mixed in byte by byte
+static u64 AssetContentHash(const u8 *Data, u64 Size)
+{
+    u64 Lanes[4]    = { 0x9E3779B97F4A7C15ull, 0xC2B2AE3D27D4EB4Full, 0x165667B19E3779F9ull, 0x27D4EB2F165667C5ull };
+    u64 Offset      = 0;
+
+    for (; Offset + 32 <= Size; Offset += 32) {
+        for (i32 Lane = 0; Lane < 4; ++Lane) {
+            u64 Word;
+            memcpy(&Word, Data + Offset + Lane * 8, sizeof(Word));
+
+            Lanes[Lane] = (Lanes[Lane] ^ Word) * 0x100000001B3ull;
+            Lanes[Lane] ^= Lanes[Lane] >> 29;
+        }
+    }
+
+    u64 Result = Size;
+
+    for (i32 Lane = 0; Lane < 4; ++Lane) {
+        Result = (Result ^ Lanes[Lane]) * 0x9E3779B97F4A7C15ull;
+        Result ^= Result >> 32;
+    }
+
+    for (; Offset < Size; ++Offset) {
+        Result = (Result ^ Data[Offset]) * 0x100000001B3ull;
+    }
+
+    return Result;
+}
+
+// NOTE(ismail): cooked blob with other flip or cooked from older source is ignored, texture is decoded from source then
+static bool32 AssetStreamerLoadCookedTexture(AssetStreamer *Streamer, StreamedAsset *Asset)
+{
+    Platform*   Platform = Streamer->PlatformContext;
+    char        CookedPath[COOKED_TEXTURE_PATH_MAX];
+
+    if (Asset->SkipCooked) {
+        return 0;
+    }
+
+    CookedTexturePath(CookedPath, sizeof(CookedPath), Asset->Path);
+
+    if (OpenCookedTexture(Platform, CookedPath, Asset->Path, Asset->VerticalFlip, &Asset->CookedImage) != Statuses::Success) {
+        return 0;
+    }
+
+    Asset->Status = Statuses::Success;
+
+    // NOTE(ismail): hashing touches every page, so it prefaults too
+    if (Asset->Dedup) {
+        Asset->ContentHash = AssetContentHash(Asset->CookedImage.Mapping.Data, Asset->CookedImage.Mapping.Size);
+
+        if (Asset->Dedup(Streamer, Asset)) {
+            Asset->Deduplicated = 1;
+
+            CloseCookedTexture(Platform, &Asset->CookedImage);
+
+            return 1;
+        }
+    }
+    else {
+        AssetStreamerPrefault(Asset->CookedImage.Mapping.Data, Asset->CookedImage.Mapping.Size);
+    }
+
+    CookedTextureToTextureFile(&Asset->CookedImage, &Asset->Texture);
+
+    return 1;
+}
+
+// NOTE(ismail): runs on streaming thread in request order, so content claimed by Dedup is always uploaded before its duplicates.
+// Returns 1 when texture still has to be decoded, Source then holds file bytes or nothing when there is no Dedup
+static bool32 AssetStreamerPrepareTexture(AssetStreamer *Streamer, StreamedAsset *Asset, File *Source)
+{
+    Platform* Platform = Streamer->PlatformContext;
+
+    *Source = {};
+
+    if (AssetStreamerLoadCookedTexture(Streamer, Asset)) {
+        Asset->Bytes = TextureFileSize(&Asset->Texture);
+
+        return 0;
+    }
+
+    if (!Asset->Dedup) {
+        return 1;
+    }
+
+    *Source = Platform->ReadFile(Asset->Path);
+
+    if (!Source->Data) {
+        Asset->Status = Statuses::FileLoadFailed;
+
+        return 0;
+    }
+
+    Asset->ContentHash = AssetContentHash(Source->Data, Source->Size);
+
+    if (Asset->Dedup(Streamer, Asset)) {
+        Asset->Deduplicated = 1;
+        Asset->Status       = Statuses::Success;
+
+        Platform->FreeFileData(Source);
+
+        return 0;
+    }
+
+    return 1;
+}
+
+// NOTE(ismail): runs on any pool thread, touches nothing but its own asset
+static TEARA_JOB_FUNCTION(AssetStreamerDecodeTexture)
+{
+    (void)Jobs; (void)First; (void)Amount;
+
+    AssetDecodeTask*    Task        = (AssetDecodeTask*)Data;
+    StreamedAsset*      Asset       = Task->Asset;
+    Platform*           Platform    = Task->Streamer->PlatformContext;
+    real64              StartTime   = Platform->GetWallClock();
+
+    if (!Task->Source.Data) {
+        Asset->Status = LoadTextureFile(Asset->Path, &Asset->Texture, Asset->VerticalFlip);
+    }
+    else {
+        Asset->Status = DecodeTextureFile(Task->Source.Data, Task->Source.Size, &Asset->Texture, Asset->VerticalFlip);
+
+        Platform->FreeFileData(&Task->Source);
+    }
+
+    Asset->Bytes    = TextureFileSize(&Asset->Texture);
+    Asset->LoadMs  += (Platform->GetWallClock() - StartTime) * 1000.0;
+}
+
+// NOTE(ismail): texture decodes of a batch go to pool as jobs, meshes are loaded here meanwhile one by one because
+// LoadObjFile isn't reentrant, their text parse fans out to pool by itself. Batch is completed in request order
+static void AssetStreamerLoadBatch(AssetStreamer *Streamer, i32 *Slots, i32 SlotsAmount)
+{
+    Platform*       Platform = Streamer->PlatformContext;
+    JobSystem*      Jobs     = Platform->Jobs;
+    AssetDecodeTask Tasks[ASSET_STREAMER_MAX_BATCH];
+    JobCounter      Decodes;
+
+    Decodes.Value.store(0);
+
+    for (i32 Index = 0; Index < SlotsAmount; ++Index) {
+        StreamedAsset*  Asset       = &Streamer->Assets[Slots[Index]];
+        real64          StartTime   = Platform->GetWallClock();
+
+        Tasks[Index].Streamer   = Streamer;
+        Tasks[Index].Asset      = Asset;
+
+        if (Asset->Kind == AssetStreamTexture) {
+            bool32 Decode = AssetStreamerPrepareTexture(Streamer, Asset, &Tasks[Index].Source);
+
+            Asset->LoadMs = (Platform->GetWallClock() - StartTime) * 1000.0;
+
+            if (Decode) {
+                JobSystemRun(Jobs, AssetStreamerDecodeTexture, &Tasks[Index], &Decodes);
+            }
+        }
+        else if (Asset->Kind != AssetStreamMesh) {
+            Asset->Status = Statuses::Failed;
+        }
+    }
+
+    for (i32 Index = 0; Index < SlotsAmount; ++Index) {
+        StreamedAsset* Asset = &Streamer->Assets[Slots[Index]];
+
+        if (Asset->Kind == AssetStreamMesh) {
+            real64 StartTime = Platform->GetWallClock();
+
+            AssetStreamerLoadMesh(Streamer, Asset);
+
+            Asset->LoadMs = (Platform->GetWallClock() - StartTime) * 1000.0;
+        }
+    }
+
+    JobSystemWait(Jobs, &Decodes);
+
+    for (i32 Index = 0; Index < SlotsAmount; ++Index) {
+        AssetStreamQueuePush(&Streamer->Completed, Slots[Index]);
+    }
+}
+
+static void AssetStreamerThread(AssetStreamer *Streamer)
+{
+    JobSystem* Jobs = Streamer->PlatformContext->Jobs;
+
+    // NOTE(ismail): without free slot streamer stays outside of the pool and loads everything itself, batch is 1 asset then
+    JobSystemAttachThread(Jobs);
+
+    i32 BatchMax = JobSystemFanOut(Jobs) < ASSET_STREAMER_MAX_BATCH ? JobSystemFanOut(Jobs) : ASSET_STREAMER_MAX_BATCH;
+
+    while (Streamer->Running.load(std::memory_order_acquire)) {
+        i32 Slots[ASSET_STREAMER_MAX_BATCH];
+        i32 SlotsAmount = 0;
+
+        while (SlotsAmount < BatchMax && AssetStreamQueuePeek(&Streamer->Requests, &Slots[SlotsAmount])) {
+            AssetStreamQueuePop(&Streamer->Requests);
+
+            ++SlotsAmount;
+        }
+
+        if (!SlotsAmount) {
+            std::unique_lock<std::mutex> Lock(Streamer->WakeMutex);
+
+            Streamer->WakeCondition.wait(Lock, [Streamer] {
+                return Streamer->Requests.Read.load() != Streamer->Requests.Write.load() || !Streamer->Running.load();
+            });
+
+            continue;
+        }
+
+        AssetStreamerLoadBatch(Streamer, Slots, SlotsAmount);
+    }
+
+    JobSystemDetachThread(Jobs);
+}
+
+static void AssetStreamerRelease(AssetStreamer *Streamer, i32 Slot)
+{
+    StreamedAsset* Asset = &Streamer->Assets[Slot];
+
+    CloseCookedMesh(Streamer->PlatformContext, &Asset->Cooked);
+    CloseCookedTexture(Streamer->PlatformContext, &Asset->CookedImage);
+
+    if (Asset->MeshMemory) {
+        Streamer->PlatformContext->ReleaseMem(Asset->MeshMemory);
+    }
+
+    if (Asset->Texture.Data) {
+        FreeTextureFile(&Asset->Texture);
+    }
+
+    *Asset = {};
+
+    Streamer->SlotUsed[Slot] = 0;
+
+    --Streamer->InFlight;
+}
+
+void AssetStreamerInit(AssetStreamer *Streamer, Platform *PlatformContext, u64 BudgetBytes, real64 BudgetMs)
+{
+    Streamer->PlatformContext   = PlatformContext;
+    Streamer->BudgetBytes       = BudgetBytes;
+    Streamer->BudgetMs          = BudgetMs;
+    Streamer->InFlight          = 0;
+    Streamer->Stats             = {};
+
+    for (i32 Slot = 0; Slot < ASSET_STREAMER_MAX_ASSETS; ++Slot) {
+        Streamer->Assets[Slot]      = {};
+        Streamer->SlotUsed[Slot]    = 0;
+    }
+
+    Streamer->Requests.Read.store(0);
+    Streamer->Requests.Write.store(0);
+    Streamer->Completed.Read.store(0);
+    Streamer->Completed.Write.store(0);
+    Streamer->Running.store(1);
+
+    Streamer->Thread = std::thread(AssetStreamerThread, Streamer);
+}
+
+void AssetStreamerShutdown(AssetStreamer *Streamer)
+{
+    {
+        std::lock_guard<std::mutex> Lock(Streamer->WakeMutex);
+
+        Streamer->Running.store(0);
+        Streamer->WakeCondition.notify_all();
+    }
+
+    Streamer->Thread.join();
+
+    // NOTE(ismail): loaded but not uploaded assets and never started requests are dropped
+    for (i32 Slot = 0; Slot < ASSET_STREAMER_MAX_ASSETS; ++Slot) {
+        if (Streamer->SlotUsed[Slot]) {
+            AssetStreamerRelease(Streamer, Slot);
+        }
+    }
+}
+
+bool32 AssetStreamerSubmit(AssetStreamer *Streamer, AssetStreamRequest *Request)
+{
+    Assert(Streamer->Running.load());
+    Assert(strlen(Request->Path) < ASSET_STREAMER_PATH_MAX);
+
+    i32 Slot = 0;
+    while (Slot < ASSET_STREAMER_MAX_ASSETS && Streamer->SlotUsed[Slot]) {
+        ++Slot;
+    }
+
+    if (Slot == ASSET_STREAMER_MAX_ASSETS) {
+        return 0;
+    }
+
+    StreamedAsset* Asset = &Streamer->Assets[Slot];
+
+    *Asset = {};
+
+    Asset->Kind         = Request->Kind;
+    Asset->Upload       = Request->Upload;
+    Asset->Failed       = Request->Failed;
+    Asset->Dedup        = Request->Dedup;
+    Asset->Target       = Request->Target;
+    Asset->TargetSlot   = Request->TargetSlot;
+    Asset->MeshFlags    = Request->MeshFlags;
+    Asset->VerticalFlip = Request->VerticalFlip;
+    Asset->SkipCooked   = Request->SkipCooked;
+    Asset->Status       = Statuses::Failed;
+
+    strncpy(Asset->Path, Request->Path, sizeof(Asset->Path) - 1);
+
+    Streamer->SlotUsed[Slot] = 1;
+
+    ++Streamer->InFlight;
+    ++Streamer->Stats.Submitted;
+
+    AssetStreamQueuePush(&Streamer->Requests, Slot);
+
+    // NOTE(ismail): streaming thread checks queue under WakeMutex before it sleeps, so it sees request or gets notified
+    {
+        std::lock_guard<std::mutex> Lock(Streamer->WakeMutex);
+        Streamer->WakeCondition.notify_one();
+    }
+
+    return 1;
+}
+
+static i32 AssetStreamerUploadBudget(AssetStreamer *Streamer, u64 BudgetBytes, real64 BudgetMs)
+{
+    Platform*   Platform        = Streamer->PlatformContext;
+    real64      StartTime       = Platform->GetWallClock();
+    u64         UploadedBytes   = 0;
+    i32         UploadedAmount  = 0;
+    i32         Slot;
+
+    while (AssetStreamQueuePeek(&Streamer->Completed, &Slot)) {
+        StreamedAsset*  Asset       = &Streamer->Assets[Slot];
+        real64          ElapsedMs   = (Platform->GetWallClock() - StartTime) * 1000.0;
+
+        if (UploadedAmount > 0) {
+            if (BudgetBytes && UploadedBytes + Asset->Bytes > BudgetBytes) {
+                break;
+            }
+            if (BudgetMs > 0.0 && ElapsedMs >= BudgetMs) {
+                break;
+            }
+        }
+
+        AssetStreamQueuePop(&Streamer->Completed);
+
+        if (Asset->Status == Statuses::Success) {
+            Asset->Upload(Streamer, Asset);
+
+            ++Streamer->Stats.Uploaded;
+            Streamer->Stats.UploadedBytes += Asset->Bytes;
+            UploadedBytes                 += Asset->Bytes;
+        }
+        else {
+            if (Asset->Failed) {
+                Asset->Failed(Streamer, Asset);
+            }
+
+            ++Streamer->Stats.Failed;
+        }
+
+        Streamer->Stats.LoadMs += Asset->LoadMs;
+
+        AssetStreamerRelease(Streamer, Slot);
+
+        ++UploadedAmount;
+    }
+
+    if (UploadedAmount) {
+        real64 UploadMs = (Platform->GetWallClock() - StartTime) * 1000.0;
+
+        Streamer->Stats.UploadMs += UploadMs;
+
+        if (UploadMs > Streamer->Stats.MaxUploadMs) {
+            Streamer->Stats.MaxUploadMs = UploadMs;
+        }
+        if (UploadedBytes > Streamer->Stats.MaxUploadBytes) {
+            Streamer->Stats.MaxUploadBytes = UploadedBytes;
+        }
+    }
+
+    return UploadedAmount;
+}
+
+i32 AssetStreamerUpload(AssetStreamer *Streamer)
+{
+    return AssetStreamerUploadBudget(Streamer, Streamer->BudgetBytes, Streamer->BudgetMs);
+}
+
+void AssetStreamerFlush(AssetStreamer *Streamer)
+{
+    while (Streamer->InFlight > 0) {
+        if (!AssetStreamerUploadBudget(Streamer, 0, 0.0)) {
+            std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,136 @@
+#ifndef _TEARA_UTILS_ASSET_STREAMER_H_
+#define _TEARA_UTILS_ASSET_STREAMER_H_
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "Core/EnginePlatform.h"
+#include "Core/Types.h"
+#include "AssetsLoader.h"
+#include "CookedMesh.h"
+#include "CookedTexture.h"
+
+// NOTE(ismail): file reads run on one streaming thread, it attaches to Platform->Jobs and hands texture decodes and .obj
+// chunks to pool threads. Main thread takes finished assets from completion queue and uploads them to GPU inside per frame
+// budget. Only main thread submits and uploads, so slots need no locks.
+// Streaming thread owns LoadObjFile while it runs, nobody else may load .obj text at the same time.
+// Cooked .tmesh / .ttex next to source is preferred, it is mapped instead of parsed or decoded
+
+#define ASSET_STREAMER_MAX_ASSETS           (64) // NOTE(ismail): must be power of two
+#define ASSET_STREAMER_PATH_MAX             (256)
+#define ASSET_STREAMER_OBJ_MAX_ELEMENTS     (140000)
+#define ASSET_STREAMER_OBJ_MAX_MESHES       (10)
+#define ASSET_STREAMER_DEFAULT_BUDGET_BYTES (Megabytes(4))
+#define ASSET_STREAMER_DEFAULT_BUDGET_MS    (2.0)
+
+enum AssetStreamKind {
+    AssetStreamMesh,
+    AssetStreamTexture,
+};
+
+struct AssetStreamer;
+struct StreamedAsset;
+
+// NOTE(ismail): called on main thread for every successfully loaded asset, data is released right after it returns.
+// Same signature is used for optional failure callback
+#define TEARA_ASSET_UPLOAD(Name) void (Name)(AssetStreamer *Streamer, StreamedAsset *Asset)
+typedef TEARA_ASSET_UPLOAD(*TEARA_AssetUpload);
+
+// NOTE(ismail): called on streaming thread when ContentHash of texture file is known, 1 means same pixels are already
+// loaded, decode is skipped and upload gets asset with Deduplicated set and no Texture data
+#define TEARA_ASSET_DEDUP(Name) bool32 (Name)(AssetStreamer *Streamer, StreamedAsset *Asset)
+typedef TEARA_ASSET_DEDUP(*TEARA_AssetDedup);
+
+// NOTE(ismail): Target and TargetSlot are not touched by streamer, upload uses them to find where asset goes.
+// SkipCooked loads source even when cooked blob is next to it, benches use it to time text path
+struct AssetStreamRequest {
+    AssetStreamKind     Kind;
+    const char*         Path;
+    TEARA_AssetUpload   Upload;
+    TEARA_AssetUpload   Failed;
+    TEARA_AssetDedup    Dedup;
+    void*               Target;
+    i32                 TargetSlot;
+    ObjFileLoaderFlags  MeshFlags;
+    bool32              VerticalFlip;
+    bool32              SkipCooked;
+};
+
+struct StreamedAsset {
+    AssetStreamKind     Kind;
+    char                Path[ASSET_STREAMER_PATH_MAX];
+    TEARA_AssetUpload   Upload;
+    TEARA_AssetUpload   Failed;
+    TEARA_AssetDedup    Dedup;
+    void*               Target;
+    i32                 TargetSlot;
+    ObjFileLoaderFlags  MeshFlags;
+    bool32              VerticalFlip;
+    bool32              SkipCooked;
+
+    Statuses            Status;
+    ObjFile             MeshFile;
+    CookedMesh          Cooked;         // NOTE(ismail): mapping behind MeshFile when cooked blob exists
+    void*               MeshMemory;     // NOTE(ismail): buffers behind MeshFile on text path
+    TextureFile         Texture;
+    CookedTexture       CookedImage;    // NOTE(ismail): mapping behind Texture mips when cooked blob exists
+    u64                 ContentHash;    // NOTE(ismail): hash of texture file bytes, set only when Dedup is given
+    bool32              Deduplicated;
+    i32                 DedupOf;        // NOTE(ismail): written by Dedup, streamer doesn't read it
+    u64                 Bytes;          // NOTE(ismail): what upload sends to GPU
+    real64              LoadMs;
+};
+
+// NOTE(ismail): single producer single consumer ring of slot indices, can't overflow because slots are limited too
+struct AssetStreamQueue {
+    i32                 Slots[ASSET_STREAMER_MAX_ASSETS];
+    std::atomic<u32>    Read;
+    std::atomic<u32>    Write;
+};
+
+struct AssetStreamerStats {
+    i64     Submitted;
+    i64     Uploaded;
+    i64     Failed;
+    u64     UploadedBytes;
+    real64  LoadMs;             // NOTE(ismail): load time of uploaded and failed assets, decode on pool threads included
+    real64  UploadMs;           // NOTE(ismail): main thread time inside AssetStreamerUpload
+    real64  MaxUploadMs;        // NOTE(ismail): worst single AssetStreamerUpload call
+    u64     MaxUploadBytes;
+};
+
+struct AssetStreamer {
+    Platform*               PlatformContext;
+    void*                   UserData;       // NOTE(ismail): for callbacks, game keeps GameContext here
+    u64                     BudgetBytes;    // NOTE(ismail): 0 means no limit
+    real64                  BudgetMs;       // NOTE(ismail): 0 means no limit
+    i32                     InFlight;
+
+    StreamedAsset           Assets[ASSET_STREAMER_MAX_ASSETS];
+    bool32                  SlotUsed[ASSET_STREAMER_MAX_ASSETS];
+    AssetStreamQueue        Requests;
+    AssetStreamQueue        Completed;
+    AssetStreamerStats      Stats;
+
+    std::atomic<bool32>     Running;
+    std::mutex              WakeMutex;
+    std::condition_variable WakeCondition;
+    std::thread             Thread;
+};
+
+void AssetStreamerInit(AssetStreamer *Streamer, Platform *PlatformContext, u64 BudgetBytes, real64 BudgetMs);
+void AssetStreamerShutdown(AssetStreamer *Streamer);
+
+// NOTE(ismail): returns 0 when all slots are busy, caller may retry next frame
+bool32 AssetStreamerSubmit(AssetStreamer *Streamer, AssetStreamRequest *Request);
+
+// NOTE(ismail): uploads finished assets until budget runs out and returns how many went up. Budget is checked before
+// every asset and first one always goes, otherwise asset bigger than budget would never be uploaded
+i32 AssetStreamerUpload(AssetStreamer *Streamer);
+
+// NOTE(ismail): blocks until everything submitted, including what uploads submit, is uploaded. Ignores budget
+void AssetStreamerFlush(AssetStreamer *Streamer);
+
+#endif
@@ -1,127 +1,157 @@
 #include "AssetsLoader.h"
 #include "Core/Debug.h"
-#include "3rdparty/fastobj/fast_obj.h"
+#include "ObjParser.h"
+#include "3rdparty/stb/stb_image.h"
 
 #include <string.h>
 
-#define TEARA_MAXIMUM_NEIGHBOURS (20)
 #define VERTEX_PER_FACE (3)
-
-struct MeshCacheData {
-    u32     TextureIndex[TEARA_MAXIMUM_NEIGHBOURS];
-    u32     NormalIndex[TEARA_MAXIMUM_NEIGHBOURS];
-    u32     RealIndex[TEARA_MAXIMUM_NEIGHBOURS];
-    vec3    SmoothNormals;
-    u32     Amount;
+#define MESH_CACHE_MIN_SLOTS (1024)
+
+// NOTE (ismail): open addressing table keyed on (pos, tex, normal) triple, linear probing.
+// Slot is live only when its Generation equals table Generation, so next file starts with ++Generation instead of memset
+struct MeshCacheSlot {
+    u32     PosIndex;
+    u32     TextureIndex;
+    u32     NormalIndex;
+    u32     RealIndex;
+    u32     Generation;
 };
 
 struct MeshCache {
-    MeshCacheData*  Cache;
-    u32*            NormalsCache;
-    u32             CacheSize;
+    Platform*       PlatformContext;
+    MeshCacheSlot*  Slots;
+    u32             SlotsMask;
+    u32             PositionStride;
+    u32             Generation;
+    vec3*           SmoothNormals;      // NOTE (ismail): accumulated per position index
+    u32*            NormalsCache;       // NOTE (ismail): position index of every emitted vertex
+    u32             PositionsCapacity;
+    u32             VerticesCapacity;
 };
 
 MeshCache MeshLoadCache;
 
-static inline bool32 FindInCacheArray(u32 *Array, u32 ArraySize, u32 Offset, u32 FindingIndex, u32 *RealIndex)
+// NOTE (ismail): position picks a run of PositionStride slots and hashed (tex, normal) picks slot inside it.
+// Faces reference nearby positions, so probes walk table almost in order instead of missing cache on every corner
+static inline u32 MeshCacheHash(MeshCache *ThreadCache, u32 PosIndex, u32 TextureIndex, u32 NormalIndex)
 {
-    for (u32 Index = Offset; Index < ArraySize; ++Index) {
-        if (Array[Index] == FindingIndex) {
-            *RealIndex = Index;
-            return 1;
-        }
-    }
-    return 0;
+    u32 Hash = TextureIndex * 0x9E3779B1u ^ NormalIndex * 0x85EBCA77u;
+
+    Hash ^= Hash >> 16;
+    Hash *= 0x7FEB352Du;
+    Hash ^= Hash >> 15;
+
+    return PosIndex * ThreadCache->PositionStride + (Hash & (ThreadCache->PositionStride - 1));
 }
 
-static bool32 FindInCache(MeshCache *ThreadCache, u32 PosIndex, u32 TextureIndex, u32 NormalIndex, u32 *ResultIndex)
+// NOTE (ismail): returns 1 and existing vertex when triple was seen, otherwise remembers it as NewIndex
+static inline bool32 FindOrAddInCache(MeshCache *ThreadCache, u32 PosIndex, u32 TextureIndex, u32 NormalIndex, u32 NewIndex, u32 *ResultIndex)
 {
-    Assert(ThreadCache->CacheSize > PosIndex);
-    
-    u32*            CurrentArray;
-    bool32          IndexFound  = 0;
-    u32             FoundIndex  = 0;
-    u32             Offset = 0;
-    MeshCacheData*  CacheData   = &ThreadCache->Cache[PosIndex - 1]; // NOTE (ismail): -1 because position index starts from 1
-
-    if (CacheData->Amount == 0) {
-        return 0;
-    }
+    u32 Generation  = ThreadCache->Generation;
+    u32 SlotIndex   = MeshCacheHash(ThreadCache, PosIndex, TextureIndex, NormalIndex) & ThreadCache->SlotsMask;
 
     for (;;) {
-        if (TextureIndex > 0) {
-            IndexFound = FindInCacheArray(CacheData->TextureIndex, CacheData->Amount, Offset, TextureIndex, &FoundIndex);
-            if (!IndexFound) {
-                return 0;
-            }
-        }
+        MeshCacheSlot *Slot = &ThreadCache->Slots[SlotIndex];
 
-        if (NormalIndex > 0) {
-            if (!IndexFound) {
-                IndexFound = FindInCacheArray(CacheData->NormalIndex, CacheData->Amount, Offset, NormalIndex, &FoundIndex);
+        if (Slot->Generation != Generation) {
+            Assert(NewIndex < ThreadCache->VerticesCapacity);
 
-                if (!IndexFound) {
-                    return 0;
-                }
-            }
-            else if (CacheData->NormalIndex[FoundIndex] != NormalIndex) {
-                Offset = FoundIndex + 1;
-                continue;
-            }
+            Slot->PosIndex      = PosIndex;
+            Slot->TextureIndex  = TextureIndex;
+            Slot->NormalIndex   = NormalIndex;
+            Slot->RealIndex     = NewIndex;
+            Slot->Generation    = Generation;
+
+            *ResultIndex = NewIndex;
+
+            return 0;
         }
 
-        break;
-    }
+        if (Slot->PosIndex == PosIndex && Slot->TextureIndex == TextureIndex && Slot->NormalIndex == NormalIndex) {
+            *ResultIndex = Slot->RealIndex;
 
-    *ResultIndex = CacheData->RealIndex[FoundIndex];
+            return 1;
+        }
 
-    return 1;
+        SlotIndex = (SlotIndex + 1) & ThreadCache->SlotsMask;
+    }
 }
 
-static inline void AddInCache(MeshCache *ThreadCache, u32 PosIndex, u32 TextureIndex, u32 NormalIndex, u32 RealIndex)
+static inline void AddNormalInCache(MeshCache *ThreadCache, u32 PosIndex, vec3 *Normal)
 {
-    Assert(ThreadCache->CacheSize > (PosIndex - 1));
-    MeshCacheData *CacheData = &ThreadCache->Cache[PosIndex - 1];
+    Assert(ThreadCache->PositionsCapacity > PosIndex);
 
-    Assert(CacheData->Amount < TEARA_MAXIMUM_NEIGHBOURS);
-    
-    CacheData->TextureIndex[CacheData->Amount]  = TextureIndex;
-    CacheData->NormalIndex[CacheData->Amount]   = NormalIndex;
-    CacheData->RealIndex[CacheData->Amount]     = RealIndex;
-    
-    ++CacheData->Amount;
+    ThreadCache->SmoothNormals[PosIndex] += *Normal;
 }
 
-static inline void AddNormalInCache(MeshCache *ThreadCache, u32 PosIndex, vec3 *Normal)
+// NOTE (ismail): table keeps load factor under 0.5 for CornersCount unique vertices, buffers only grow
+static void ReserveCache(MeshCache *ThreadCache, u32 CornersCount, u32 PositionsCount)
 {
-    Assert(ThreadCache->CacheSize > (PosIndex - 1));
+    Platform *PlatformContext = ThreadCache->PlatformContext;
+
+    u32 SlotsAmount = MESH_CACHE_MIN_SLOTS;
+    while (SlotsAmount < CornersCount * 2) {
+        SlotsAmount *= 2;
+    }
+
+    if (!ThreadCache->Slots || SlotsAmount > ThreadCache->SlotsMask + 1) {
+        if (ThreadCache->Slots) {
+            PlatformContext->ReleaseMem(ThreadCache->Slots);
+            PlatformContext->ReleaseMem(ThreadCache->NormalsCache);
+        }
+
+        // NOTE (ismail): fresh pages are zeroed, Generation 0 never matches
+        ThreadCache->Slots              = (MeshCacheSlot*)PlatformContext->AllocMem(sizeof(MeshCacheSlot) * SlotsAmount);
+        ThreadCache->NormalsCache       = (u32*)PlatformContext->AllocMem(sizeof(u32) * SlotsAmount / 2);
+        ThreadCache->SlotsMask          = SlotsAmount - 1;
+        ThreadCache->VerticesCapacity   = SlotsAmount / 2;
+        ThreadCache->Generation         = 0;
+    }
+
+    // NOTE (ismail): stride is sized from this file and not from table, so small file after big one still stays compact
+    ThreadCache->PositionStride = 1;
+    while (ThreadCache->PositionStride * 2 * (u64)PositionsCount <= SlotsAmount) {
+        ThreadCache->PositionStride *= 2;
+    }
 
-    MeshCacheData *CacheData = &ThreadCache->Cache[PosIndex - 1];
+    if (PositionsCount > ThreadCache->PositionsCapacity) {
+        if (ThreadCache->SmoothNormals) {
+            PlatformContext->ReleaseMem(ThreadCache->SmoothNormals);
+        }
 
-    CacheData->SmoothNormals += *Normal;
+        ThreadCache->SmoothNormals      = (vec3*)PlatformContext->AllocMem(sizeof(vec3) * PositionsCount);
+        ThreadCache->PositionsCapacity  = PositionsCount;
+    }
 }
 
 static inline void RenewCache(MeshCache *ThreadCache)
 {
-    memset((void*)ThreadCache->Cache, 0, ThreadCache->CacheSize);
-    memset((void*)ThreadCache->NormalsCache, 0, ThreadCache->CacheSize);
+    ++ThreadCache->Generation;
+
+    // NOTE (ismail): after 2^32 files old slots could look live again
+    if (ThreadCache->Generation == 0) {
+        memset((void*)ThreadCache->Slots, 0, sizeof(MeshCacheSlot) * (ThreadCache->SlotsMask + 1));
+
+        ThreadCache->Generation = 1;
+    }
 }
 
 void AssetsLoaderInit(Platform *PlatformContext, AssetsLoaderVars *LoaderVars)
 {
-    MeshLoadCache.Cache         = (MeshCacheData*)PlatformContext->AllocMem(sizeof(MeshCacheData) * LoaderVars->AssetsLoaderCacheSize);
-    MeshLoadCache.NormalsCache  = (u32*)PlatformContext->AllocMem(sizeof(u32) * LoaderVars->AssetsLoaderCacheSize);
-    MeshLoadCache.CacheSize     = LoaderVars->AssetsLoaderCacheSize;
+    MeshLoadCache = {};
 
-    RenewCache(&MeshLoadCache);
+    MeshLoadCache.PlatformContext = PlatformContext;
+
+    ReserveCache(&MeshLoadCache, LoaderVars->AssetsLoaderCacheSize, LoaderVars->AssetsLoaderCacheSize);
 }
 
 // NOTE (ismail): for now in File variable we must store actual buffers outside of function
 Statuses LoadObjFile(const char *Path, ObjFile *File, ObjFileLoaderFlags Flags)
 {
     // NOTE (ismail): need to hug Alina 
-    // NOTE (ismail): for now we use fast_obj in oreder to read .obj but in future i prefere to use own .obj parser
-    // fast_obj set in every buffer (position, textcoord, normals) a dummy entry so we skip first elemen of every array
+    // NOTE (ismail): text is parsed in parallel by ObjParser, dedup below stays serial because vertex numbering must be stable.
+    // like fast_obj parser puts dummy entry in every buffer (position, textcoord, normals), index 0 means missing attribute
     u32     ElementsCount   = 0;
     u32     IndicesCount    = 0;
     u32     MeshIndex       = 0;
@@ -131,36 +161,51 @@ Statuses LoadObjFile(const char *Path, ObjFile *File, ObjFileLoaderFlags Flags)
     vec2 *TexCoord  = File->TextureCoord;
     u32  *Indices   = File->Indices;
 
-    fastObjMesh *LoadedMesh = fast_obj_read(Path);
+    ObjParsedFile LoadedMesh = {};
 
-    if (!LoadedMesh) {
+    if (ParseObjFile(MeshLoadCache.PlatformContext, Path, &LoadedMesh) != Statuses::Success) {
         // TODO (ismail): diagnostic and write to log some info
-        Assert(LoadedMesh);
+        Assert(false);
         return Statuses::FileLoadFailed;
     }
 
-    real32 *LoadPos             = LoadedMesh->positions;
-    real32 *LoadNormals         = LoadedMesh->normals;
-    real32 *LoadTexCoord        = LoadedMesh->texcoords;
+    // NOTE (ismail): every face corner emits one index and at most one vertex
+    if ((File->ElementsCapacity && LoadedMesh.IndicesCount > File->ElementsCapacity) ||
+        (File->MeshesCapacity && LoadedMesh.ObjectsCount > File->MeshesCapacity)) {
+        FreeObjParsedFile(MeshLoadCache.PlatformContext, &LoadedMesh);
+
+        return Statuses::Failed;
+    }
+
+    vec3        *LoadPos        = LoadedMesh.Positions;
+    vec3        *LoadNormals    = LoadedMesh.Normals;
+    vec2        *LoadTexCoord   = LoadedMesh.TextureCoord;
+    ObjIndex    *LoadIndices    = LoadedMesh.Indices;
+    fastObjMesh *LoadMaterials  = LoadedMesh.Materials;
 
-    fastObjIndex    *LoadIndices    = LoadedMesh->indices;
+    u32 MeshesCount = LoadedMesh.ObjectsCount;
 
-    u32 MeshesCount = LoadedMesh->object_count;
+    // NOTE (ismail): position array has dummy first entry, position indices go up to PositionsCount - 1
+    ReserveCache(&MeshLoadCache, LoadedMesh.IndicesCount, LoadedMesh.PositionsCount);
+    RenewCache(&MeshLoadCache);
+
+    if (Flags.GenerateSmoothNormals) {
+        memset((void*)MeshLoadCache.SmoothNormals, 0, sizeof(vec3) * LoadedMesh.PositionsCount);
+    }
 
     for (; MeshIndex < MeshesCount; ++MeshIndex) {
-        fastObjGroup*   CurrentMesh             = &LoadedMesh->objects[MeshIndex];
-        Mesh*           ObjectMesh              = &File->Meshes[MeshIndex];
-        Material*       CurrentMeshMaterial     = &ObjectMesh->Material;
+        ObjParsedObject*    CurrentMesh             = &LoadedMesh.Objects[MeshIndex];
+        Mesh*               ObjectMesh              = &File->Meshes[MeshIndex];
+        Material*           CurrentMeshMaterial     = &ObjectMesh->Material;
 
-        if (LoadedMesh->material_count > 0) {    
-            u32                 MaterialNum         = LoadedMesh->face_materials[CurrentMesh->face_offset];
-            fastObjMaterial*    LoadMeshMaterial    = &LoadedMesh->materials[MaterialNum];
+        if (LoadMaterials && LoadMaterials->material_count > 0) {    
+            fastObjMaterial*    LoadMeshMaterial    = &LoadMaterials->materials[CurrentMesh->Material];
 
-            if (LoadedMesh->texture_count > 0) {
+            if (LoadMaterials->texture_count > 0) {
                 if (LoadMeshMaterial->map_Kd > 0) {
                     CurrentMeshMaterial->HaveTexture = 1;
 
-                    fastObjTexture  *LoadMeshTexture = &LoadedMesh->textures[LoadMeshMaterial->map_Kd];
+                    fastObjTexture  *LoadMeshTexture = &LoadMaterials->textures[LoadMeshMaterial->map_Kd];
                     memcpy_s(CurrentMeshMaterial->TextureFilePath, 
                             sizeof(ObjectMesh->Material.TextureFilePath), 
                             LoadMeshTexture->path, 
@@ -169,7 +214,7 @@ Statuses LoadObjFile(const char *Path, ObjFile *File, ObjFileLoaderFlags Flags)
                 if (LoadMeshMaterial->map_Ns > 0) {
                     CurrentMeshMaterial->HaveSpecularExponent = 1;
 
-                    fastObjTexture  *LoadMeshSpecularExpMap = &LoadedMesh->textures[LoadMeshMaterial->map_Ns];
+                    fastObjTexture  *LoadMeshSpecularExpMap = &LoadMaterials->textures[LoadMeshMaterial->map_Ns];
                     memcpy_s(CurrentMeshMaterial->SpecularExpFilePath, 
                         sizeof(CurrentMeshMaterial->SpecularExpFilePath), 
                         LoadMeshSpecularExpMap->path, 
@@ -188,7 +233,9 @@ Statuses LoadObjFile(const char *Path, ObjFile *File, ObjFileLoaderFlags Flags)
             CurrentMeshMaterial->SpecularColor  = { 1.0f, 1.0f, 1.0f };
         }
 
-        u32 CurrentMeshIndexCount = CurrentMesh->face_count * VERTEX_PER_FACE;
+        u32 CurrentMeshIndexCount = CurrentMesh->IndicesCount;
+
+        Assert(CurrentMesh->IndexOffset == IndicesCount);
 
         ObjectMesh->IndexOffset = IndicesCount;
 
@@ -198,33 +245,30 @@ Statuses LoadObjFile(const char *Path, ObjFile *File, ObjFileLoaderFlags Flags)
             u32 NormalsIndex    = LoadIndices[IndicesCount].n;
             u32 FoundIndex;
     
-            bool32 Found = FindInCache(&MeshLoadCache, PosIndex, TextIndex, NormalsIndex, &FoundIndex);
+            bool32 Found = FindOrAddInCache(&MeshLoadCache, PosIndex, TextIndex, NormalsIndex, ElementsCount, &FoundIndex);
     
             if (Found) {
                 Indices[IndicesCount] = FoundIndex;
             }
             else {
                 Indices[IndicesCount]   = ElementsCount;
-                Pos[ElementsCount]      = *((vec3*)LoadPos + PosIndex);
+                Pos[ElementsCount]      = LoadPos[PosIndex];
     
                 if (NormalsIndex > 0) { // NOTE (ismail): quick fix but later i need make up something
                     if (Flags.GenerateSmoothNormals) {
                         MeshLoadCache.NormalsCache[ElementsCount] = PosIndex;
     
-                        vec3 *Normal = ((vec3*)LoadNormals + NormalsIndex);
-                        AddNormalInCache(&MeshLoadCache, PosIndex, Normal);
+                        AddNormalInCache(&MeshLoadCache, PosIndex, &LoadNormals[NormalsIndex]);
                     }
                     else {
-                        Normals[ElementsCount]  = *((vec3*)LoadNormals + NormalsIndex);
+                        Normals[ElementsCount]  = LoadNormals[NormalsIndex];
                     }
                 }
     
                 if (TextIndex > 0) { // NOTE (ismail): quick fix but later i need make up something
-                    TexCoord[ElementsCount] = *((vec2*)LoadTexCoord + TextIndex);   
+                    TexCoord[ElementsCount] = LoadTexCoord[TextIndex];   
                 }
     
-                AddInCache(&MeshLoadCache, PosIndex, TextIndex, NormalsIndex, ElementsCount);
-    
                 ++ElementsCount;
             }
         }
@@ -235,15 +279,15 @@ Statuses LoadObjFile(const char *Path, ObjFile *File, ObjFileLoaderFlags Flags)
 
     if (Flags.GenerateSmoothNormals) {
         for (u32 Index = 0; Index < ElementsCount; ++Index) {
-            MeshLoadCache.Cache[MeshLoadCache.NormalsCache[Index] - 1].SmoothNormals.Normalize();
+            MeshLoadCache.SmoothNormals[MeshLoadCache.NormalsCache[Index]].Normalize();
         }
 
         for (u32 Index = 0; Index < ElementsCount; ++Index) {
-            Normals[Index] = MeshLoadCache.Cache[MeshLoadCache.NormalsCache[Index] - 1].SmoothNormals;
+            Normals[Index] = MeshLoadCache.SmoothNormals[MeshLoadCache.NormalsCache[Index]];
         }
     }
 
-    fast_obj_destroy(LoadedMesh);
+    FreeObjParsedFile(MeshLoadCache.PlatformContext, &LoadedMesh);
 
     File->MeshesCount       = MeshesCount;
     File->IndicesCount      = IndicesCount;
@@ -251,8 +295,6 @@ Statuses LoadObjFile(const char *Path, ObjFile *File, ObjFileLoaderFlags Flags)
     File->NormalsCount      = ElementsCount;
     File->TexturesCount     = ElementsCount;
 
-    RenewCache(&MeshLoadCache);
-
     return Statuses::Success;
 }
 
@@ -377,4 +419,59 @@ end:
     LoadedFile->VertexArraySize = VertexArraySize;
     LoadedFile->IndexArraySize = IndexArraySize;
 }
-*/
\ No newline at end of file
+*/
+
+Statuses LoadTextureFile(const char *Path, TextureFile *ReadedFile, bool32 VerticalFlip)
+{
+    stbi_set_flip_vertically_on_load_thread(VerticalFlip);
+
+    u8* ImageData = stbi_load(Path, &ReadedFile->Width, &ReadedFile->Height, &ReadedFile->Channels, STBI_default);
+
+    if (!ImageData) {
+        // TODO (ismail): diagnostic and write to log some info
+        Assert(ImageData);
+        return Statuses::FileLoadFailed;
+    }
+
+    ReadedFile->Data = ImageData;
+
+    return Statuses::Success;
+}
+
+// NOTE (ismail): file bytes already in memory, texture cache hashes them before deciding to decode
+Statuses DecodeTextureFile(const u8 *Data, u64 Size, TextureFile *ReadedFile, bool32 VerticalFlip)
+{
+    stbi_set_flip_vertically_on_load_thread(VerticalFlip);
+
+    u8* ImageData = stbi_load_from_memory(Data, (i32)Size, &ReadedFile->Width, &ReadedFile->Height, &ReadedFile->Channels, STBI_default);
+
+    if (!ImageData) {
+        return Statuses::FileLoadFailed;
+    }
+
+    ReadedFile->Data = ImageData;
+
+    return Statuses::Success;
+}
+
+void FreeTextureFile(TextureFile *ReadedFile)
+{
+    stbi_image_free(ReadedFile->Data);
+
+    ReadedFile->Data = 0;
+}
+
+u64 TextureFileSize(TextureFile *Texture)
+{
+    if (Texture->Format == TextureFormatDecoded) {
+        return Texture->Data ? (u64)Texture->Width * (u64)Texture->Height * (u64)Texture->Channels : 0;
+    }
+
+    u64 Result = 0;
+
+    for (i32 Mip = 0; Mip < Texture->MipsCount; ++Mip) {
+        Result += Texture->Mips[Mip].Size;
+    }
+
+    return Result;
+}
@@ -8,7 +8,7 @@
 #define FILE_NAME_MAX   64
 
 struct AssetsLoaderVars {
-    // NOTE (ismail): cache size per thread
+    // NOTE (ismail): initial vertex dedup capacity in face corners, cache grows for bigger files
     u32 AssetsLoaderCacheSize;
 };
 
@@ -23,7 +23,7 @@ struct Material {
 };
 
 struct Mesh {
-    Material    Material;
+    ::Material  Material;
     u32         IndexOffset;
     u32         VertexOffset;
     u32         IndicesAmount;
@@ -43,6 +43,36 @@ struct ObjFile {
     u32             NormalsCount;
     u32             TexturesCount;
     u32             IndicesCount;
+    u32             MeshesCapacity;     // NOTE (ismail): sizes of caller buffers, LoadObjFile fails instead of writing past them.
+    u32             ElementsCapacity;   // 0 means buffers are trusted to be big enough
+};
+
+#define TEXTURE_MIPS_MAX (16)
+
+// NOTE (ismail): Decoded is stb_image output with Channels bytes per pixel and no mips, others come from cooked texture
+enum TextureFormat {
+    TextureFormatDecoded,
+    TextureFormatR8,
+    TextureFormatRGBA8,
+    TextureFormatBC1,
+    TextureFormatBC3,
+};
+
+struct TextureMip {
+    i32         Width;
+    i32         Height;
+    u64         Size;
+    const u8*   Data;
+};
+
+struct TextureFile {
+    i32             Width;
+    i32             Height;
+    i32             Channels;
+    u8*             Data;       // NOTE (ismail): decoded pixels, 0 when mips point into cooked texture mapping
+    TextureFormat   Format;
+    i32             MipsCount;  // NOTE (ismail): 0 means upload has to generate mips itself
+    TextureMip      Mips[TEXTURE_MIPS_MAX];
 };
 
 // ASSETS TYPES END
@@ -57,4 +87,12 @@ struct ObjFileLoaderFlags {
 // NOTE (ismail): for now in File variable we must store actual buffers outside of function
 Statuses LoadObjFile(const char *Path, ObjFile *ReadedFile, ObjFileLoaderFlags Flags);
 
+// NOTE (ismail): decoding only, no GL here so asset streamer thread can call it. Data is freed by FreeTextureFile
+Statuses LoadTextureFile(const char *Path, TextureFile *ReadedFile, bool32 VerticalFlip);
+Statuses DecodeTextureFile(const u8 *Data, u64 Size, TextureFile *ReadedFile, bool32 VerticalFlip);
+void FreeTextureFile(TextureFile *ReadedFile);
+
+// NOTE (ismail): what upload sends to GPU, whole mip chain for cooked texture
+u64 TextureFileSize(TextureFile *Texture);
+
 #endif
\ No newline at end of file
@@ -1,132 +1,132 @@
 #include "AudioLoader.h"
-#include <AL/alext.h>
 #include "Core/Debug.h"
+#include "Core/Memory.h"
 
+#define DRWAV_MALLOC(sz)        CountedMalloc((sz))
+#define DRWAV_REALLOC(p, sz)    CountedRealloc((p), (sz))
+#define DRWAV_FREE(p)           CountedFree((p))
 #define DR_WAV_IMPLEMENTATION
 #include "3rdparty/audio/dr_wav.h"
 
+#define DRFLAC_MALLOC(sz)       CountedMalloc((sz))
+#define DRFLAC_REALLOC(p, sz)   CountedRealloc((p), (sz))
+#define DRFLAC_FREE(p)          CountedFree((p))
 #define DR_FLAC_IMPLEMENTATION
 #include "3rdparty/audio/dr_flac.h"
 
-// for now it is okay but we need to create only one function that can read both flac and wav
-// we can just simple read in buffer by ourself and provide raw memory to library
-// so also it need to add ogg may be for long audio tracks
-// also check TotalByres value because it can be a lot a bit
+// NOTE(ismail): whole file and streamed playback go through the same decoder, so both formats and both sample types
+// are handled in one place. Long tracks should use audio streamer instead of this
 
-static bool32 LoadWAV(const char *FileName, void *Buffer, u64 BufferSize, AudioFile *FileOutput, bool32 FloatFormatPresent)
+bool32 LoadSound(const char *FileName, void *Buffer, u64 BufferSize, AudioFile *FileOutput, bool32 FloatFormatPresent)
 {
-    drwav WavFileInfo   = {};
-    void *SoundBuffer   = NULL;
-    u64 TotalBytes      = 0;
-    u64 BlockAlign      = 0;
-    i32 SoundFormat     = 0;
-    u64 Read            = 0;
-
-    if (!drwav_init_file(&WavFileInfo, FileName, NULL)) {
-        // TODO error handling
-        Assert(false); // TODO can't read file
+    AudioDecoder Decoder = {};
 
+    if (!AudioDecoderOpen(FileName, FileOutput->Fmt, FloatFormatPresent, &Decoder)) {
         return 0;
     }
 
-    if (WavFileInfo.fmt.formatTag != DR_WAVE_FORMAT_PCM || WavFileInfo.channels < 2) {
-        Assert(false); // TODO need to add support for format
-    }
+    u64 TotalBytes = (u64)AudioDecoderFrameSize(&Decoder) * Decoder.TotalFrames;
 
-    if (FloatFormatPresent) {
-        BlockAlign      = WavFileInfo.channels * 4; // cuz we read 4 bytes numbers then we need to align it correct
-        TotalBytes      = BlockAlign * WavFileInfo.totalPCMFrameCount; // TODO check is it correct number?
-        SoundFormat     = AL_FORMAT_STEREO_FLOAT32;
+    // NOTE(ismail): track doesn't fit, caller gets 0 and should stream it with PlayStream
+    if (TotalBytes > BufferSize) {
+        AudioDecoderClose(&Decoder);
 
-        if (TotalBytes > BufferSize) {
-            Assert(false); // TODO error handling
+        return 0;
+    }
 
-            return 0;
-        }
+    u64 Read = AudioDecoderRead(&Decoder, Decoder.TotalFrames, Buffer);
 
-        Read = drwav_read_pcm_frames_f32(&WavFileInfo, WavFileInfo.totalPCMFrameCount, (real32*)SoundBuffer);
+    AudioDecoderClose(&Decoder);
 
-        if (Read != WavFileInfo.totalPCMFrameCount) {
-            Assert(false); // we need to read whole file now
-        }
-    }
-    else {
-        Assert(false); // not present now mb later?
+    if (Read != Decoder.TotalFrames) {
+        return 0;
     }
 
-    drwav_uninit(&WavFileInfo);
-
-    FileOutput->Buffer      = SoundBuffer;
-    FileOutput->Size        = TotalBytes;
-    FileOutput->SoundFormat = SoundFormat;
-    FileOutput->SampleRate  = WavFileInfo.sampleRate;
+    FileOutput->Buffer          = Buffer;
+    FileOutput->Size            = TotalBytes;
+    FileOutput->SampleRate      = Decoder.SampleRate;
+    FileOutput->Channels        = Decoder.Channels;
+    FileOutput->BytesPerSample  = FloatFormatPresent ? sizeof(real32) : sizeof(i16);
 
     return 1;
 }
 
-static bool32 LoadFLAC(const char *FileName, void *Buffer, u64 BufferSize, AudioFile *FileOutput, bool32 FloatFormatPresent)
+bool32 AudioDecoderOpen(const char *FileName, AudioFormat Fmt, bool32 FloatSamples, AudioDecoder *Decoder)
 {
-    drflac *FlacFileInfo = drflac_open_file(FileName, NULL);
-    void *SoundBuffer   = Buffer;
-    u64 TotalBytes      = 0;
-    u64 BlockAlign      = 0;
-    i32 SoundFormat     = 0;
-    u64 Read            = 0;
+    *Decoder = {};
 
-    if (!FlacFileInfo) {
-        Assert(false); // TODO error handling
+    Decoder->Fmt            = Fmt;
+    Decoder->FloatSamples   = FloatSamples;
 
-        return 0;
-    }
+    switch (Fmt)
+    {
 
-    if (FlacFileInfo->channels < 2) {
-        Assert(false); // TODO need to add support for format
-    }
+    case AudioFormat::WAV: {
+        if (!drwav_init_file(&Decoder->Wav, FileName, NULL)) {
+            return 0;
+        }
 
-    if (FloatFormatPresent) {
-        BlockAlign      = FlacFileInfo->channels * 4; // cuz we read 4 bytes numbers then we need to align it correct
-        TotalBytes      = BlockAlign * FlacFileInfo->totalPCMFrameCount; // TODO check is it correct number?
-        SoundFormat     = AL_FORMAT_STEREO_FLOAT32;
+        Decoder->SampleRate     = Decoder->Wav.sampleRate;
+        Decoder->Channels       = Decoder->Wav.channels;
+        Decoder->TotalFrames    = Decoder->Wav.totalPCMFrameCount;
+    } break;
 
-        if (TotalBytes > BufferSize) {
-            Assert(false); // TODO error handling
+    case AudioFormat::FLAC: {
+        Decoder->Flac = drflac_open_file(FileName, NULL);
 
+        if (!Decoder->Flac) {
             return 0;
         }
 
-        Read = drflac_read_pcm_frames_f32(FlacFileInfo, FlacFileInfo->totalPCMFrameCount, (real32*)SoundBuffer);
+        Decoder->SampleRate     = Decoder->Flac->sampleRate;
+        Decoder->Channels       = Decoder->Flac->channels;
+        Decoder->TotalFrames    = Decoder->Flac->totalPCMFrameCount;
+    } break;
+
+    default: {
+        return 0;
+    }
 
-        if (Read != FlacFileInfo->totalPCMFrameCount) {
-            Assert(false); // TODO we need to read whole file now
-        }
     }
 
-    drflac_close(FlacFileInfo);
+    if (Decoder->Channels == 0 || Decoder->Channels > AUDIO_MAX_CHANNELS) {
+        AudioDecoderClose(Decoder);
 
-    FileOutput->Buffer      = SoundBuffer;
-    FileOutput->Size        = TotalBytes;
-    FileOutput->SoundFormat = SoundFormat;
-    FileOutput->SampleRate  = FlacFileInfo->sampleRate;
+        return 0;
+    }
 
     return 1;
 }
 
-bool32 LoadSound(const char *FileName, void *Buffer, u64 BufferSize, AudioFile *FileOutput, bool32 FloatFormatPresent)
+void AudioDecoderClose(AudioDecoder *Decoder)
 {
-    switch (FileOutput->Fmt)
-    {
-    
-    case AudioFormat::WAV: {
-        return LoadWAV(FileName, Buffer, BufferSize, FileOutput, FloatFormatPresent);
+    if (Decoder->Fmt == AudioFormat::WAV) {
+        drwav_uninit(&Decoder->Wav);
     }
-
-    case AudioFormat::FLAC: {
-        return LoadFLAC(FileName, Buffer, BufferSize, FileOutput, FloatFormatPresent);
+    else if (Decoder->Flac) {
+        drflac_close(Decoder->Flac);
     }
 
-    default: {
-        return 0;
+    Decoder->Wav    = {};
+    Decoder->Flac   = NULL;
+}
+
+u64 AudioDecoderRead(AudioDecoder *Decoder, u64 FramesAmount, void *Output)
+{
+    if (Decoder->Fmt == AudioFormat::WAV) {
+        return Decoder->FloatSamples ? drwav_read_pcm_frames_f32(&Decoder->Wav, FramesAmount, (real32*)Output)
+                                     : drwav_read_pcm_frames_s16(&Decoder->Wav, FramesAmount, (i16*)Output);
     }
-        
+
+    return Decoder->FloatSamples ? drflac_read_pcm_frames_f32(Decoder->Flac, FramesAmount, (real32*)Output)
+                                 : drflac_read_pcm_frames_s16(Decoder->Flac, FramesAmount, (i16*)Output);
+}
+
+bool32 AudioDecoderRewind(AudioDecoder *Decoder)
+{
+    if (Decoder->Fmt == AudioFormat::WAV) {
+        return drwav_seek_to_pcm_frame(&Decoder->Wav, 0);
     }
-}
\ No newline at end of file
+
+    return drflac_seek_to_pcm_frame(Decoder->Flac, 0);
+}
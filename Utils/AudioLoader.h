@@ -3,19 +3,52 @@
 
 #include "Core/Types.h"
 
+#include "3rdparty/audio/dr_wav.h"
+#include "3rdparty/audio/dr_flac.h"
+
+#define AUDIO_MAX_CHANNELS (2) // NOTE(ismail): mono and stereo, what OpenAL core formats take
+
 enum AudioFormat {
     WAV,
     FLAC
 };
 
+// NOTE(ismail): interleaved PCM, 4 byte float samples or 2 byte signed ones
 struct AudioFile {
     void*           Buffer;
     u64             Size;
     AudioFormat     Fmt;
     u32             SampleRate;
-    i32             SoundFormat;
+    u32             Channels;
+    u32             BytesPerSample;
+};
+
+// NOTE(ismail): open WAV or FLAC file, each read decodes next frames only, so memory doesn't depend on track length
+struct AudioDecoder {
+    AudioFormat     Fmt;
+    drwav           Wav;
+    drflac*         Flac;
+    bool32          FloatSamples;
+    u32             SampleRate;
+    u32             Channels;
+    u64             TotalFrames;
 };
 
 bool32 LoadSound(const char *FileName, void *Buffer, u64 BufferSize, AudioFile *FileOutput, bool32 FloatFormatPresent);
 
+// NOTE(ismail): fails on missing file and on more than AUDIO_MAX_CHANNELS channels
+bool32 AudioDecoderOpen(const char *FileName, AudioFormat Fmt, bool32 FloatSamples, AudioDecoder *Decoder);
+void AudioDecoderClose(AudioDecoder *Decoder);
+
+// NOTE(ismail): returns frames written to Output, less than FramesAmount only at the end of track
+u64 AudioDecoderRead(AudioDecoder *Decoder, u64 FramesAmount, void *Output);
+
+// NOTE(ismail): back to first frame, for looped tracks
+bool32 AudioDecoderRewind(AudioDecoder *Decoder);
+
+inline u32 AudioDecoderFrameSize(AudioDecoder *Decoder)
+{
+    return Decoder->Channels * (Decoder->FloatSamples ? sizeof(real32) : sizeof(i16));
+}
+
 #endif
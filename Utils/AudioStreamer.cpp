@@ -0,0 +1,212 @@
+#include "AudioStreamer.h"
+#include "Core/Debug.h"
+
+static bool32 AudioStreamNeedsChunk(AudioStream *Stream)
+{
+    return Stream->Active.load(std::memory_order_acquire) && !Stream->EndReached.load() &&
+           Stream->Write.load() - Stream->Read.load(std::memory_order_acquire) < AUDIO_STREAM_CHUNKS;
+}
+
+// NOTE(ismail): fills whole chunk even across loop point, so only the final chunk of a track is ever short
+static void AudioStreamDecodeChunk(AudioStream *Stream)
+{
+    u32                 Write       = Stream->Write.load(std::memory_order_relaxed);
+    AudioStreamChunk*   Chunk       = &Stream->Chunks[Write & (AUDIO_STREAM_CHUNKS - 1)];
+    u32                 FrameSize   = AudioDecoderFrameSize(&Stream->Decoder);
+    u32                 Frames      = 0;
+    bool32              Rewound     = 0;
+    bool32              End         = 0;
+
+    while (Frames < AUDIO_STREAM_CHUNK_FRAMES) {
+        u64 Read = AudioDecoderRead(&Stream->Decoder, AUDIO_STREAM_CHUNK_FRAMES - Frames, (u8*)Chunk->Data + Frames * FrameSize);
+
+        if (Read == 0) {
+            // NOTE(ismail): nothing right after rewind means empty or broken track, looping it would spin forever
+            if (Stream->Loop && !Rewound && AudioDecoderRewind(&Stream->Decoder)) {
+                Rewound = 1;
+
+                continue;
+            }
+
+            End = 1;
+
+            break;
+        }
+
+        Frames  += (u32)Read;
+        Rewound = 0;
+    }
+
+    Chunk->Frames   = Frames;
+    Chunk->Size     = Frames * FrameSize;
+    Chunk->Last     = End;
+
+    Stream->EndReached.store(End);
+    Stream->Write.store(Write + 1, std::memory_order_release);
+}
+
+static void AudioStreamerThread(AudioStreamer *Streamer)
+{
+    while (Streamer->Running.load(std::memory_order_acquire)) {
+        bool32 Decoded = 0;
+
+        // NOTE(ismail): lock is taken per chunk, so main thread waits for one chunk at most when it opens or closes
+        for (i32 StreamIndex = 0; StreamIndex < AUDIO_STREAMER_MAX_STREAMS; ++StreamIndex) {
+            AudioStream* Stream = &Streamer->Streams[StreamIndex];
+
+            std::lock_guard<std::mutex> Lock(Streamer->DecodeMutex);
+
+            if (AudioStreamNeedsChunk(Stream)) {
+                AudioStreamDecodeChunk(Stream);
+
+                Decoded = 1;
+            }
+        }
+
+        if (!Decoded) {
+            std::unique_lock<std::mutex> Lock(Streamer->WakeMutex);
+
+            Streamer->WakeCondition.wait(Lock, [Streamer] {
+                if (!Streamer->Running.load()) {
+                    return true;
+                }
+
+                for (i32 StreamIndex = 0; StreamIndex < AUDIO_STREAMER_MAX_STREAMS; ++StreamIndex) {
+                    if (AudioStreamNeedsChunk(&Streamer->Streams[StreamIndex])) {
+                        return true;
+                    }
+                }
+
+                return false;
+            });
+        }
+    }
+}
+
+static void AudioStreamerWake(AudioStreamer *Streamer)
+{
+    // NOTE(ismail): audio thread checks streams under WakeMutex before it sleeps, so it sees change or gets notified
+    std::lock_guard<std::mutex> Lock(Streamer->WakeMutex);
+    Streamer->WakeCondition.notify_one();
+}
+
+void AudioStreamerInit(AudioStreamer *Streamer, void *Memory, u64 MemorySize)
+{
+    Assert(MemorySize >= AUDIO_STREAMER_MEMORY_SIZE);
+
+    u8* At = (u8*)Memory;
+
+    for (i32 StreamIndex = 0; StreamIndex < AUDIO_STREAMER_MAX_STREAMS; ++StreamIndex) {
+        AudioStream* Stream = &Streamer->Streams[StreamIndex];
+
+        Stream->Decoder = {};
+        Stream->Loop    = 0;
+        Stream->Memory  = At;
+
+        for (i32 ChunkIndex = 0; ChunkIndex < AUDIO_STREAM_CHUNKS; ++ChunkIndex) {
+            Stream->Chunks[ChunkIndex]      = {};
+            Stream->Chunks[ChunkIndex].Data = At + ChunkIndex * AUDIO_STREAM_CHUNK_SIZE;
+        }
+
+        Stream->Active.store(0);
+        Stream->EndReached.store(0);
+        Stream->Read.store(0);
+        Stream->Write.store(0);
+
+        At += AUDIO_STREAM_CHUNKS * AUDIO_STREAM_CHUNK_SIZE;
+    }
+
+    Streamer->Running.store(1);
+
+    Streamer->Thread = std::thread(AudioStreamerThread, Streamer);
+}
+
+void AudioStreamerShutdown(AudioStreamer *Streamer)
+{
+    {
+        std::lock_guard<std::mutex> Lock(Streamer->WakeMutex);
+
+        Streamer->Running.store(0);
+        Streamer->WakeCondition.notify_all();
+    }
+
+    Streamer->Thread.join();
+
+    for (i32 StreamIndex = 0; StreamIndex < AUDIO_STREAMER_MAX_STREAMS; ++StreamIndex) {
+        if (Streamer->Streams[StreamIndex].Active.load()) {
+            AudioStreamClose(Streamer, StreamIndex);
+        }
+    }
+}
+
+i32 AudioStreamOpen(AudioStreamer *Streamer, const char *FileName, AudioFormat Fmt, bool32 FloatSamples, bool32 Loop)
+{
+    i32 Result = -1;
+
+    {
+        std::lock_guard<std::mutex> Lock(Streamer->DecodeMutex);
+
+        for (i32 StreamIndex = 0; StreamIndex < AUDIO_STREAMER_MAX_STREAMS; ++StreamIndex) {
+            if (!Streamer->Streams[StreamIndex].Active.load()) {
+                Result = StreamIndex;
+
+                break;
+            }
+        }
+
+        if (Result < 0) {
+            return -1;
+        }
+
+        AudioStream* Stream = &Streamer->Streams[Result];
+
+        if (!AudioDecoderOpen(FileName, Fmt, FloatSamples, &Stream->Decoder)) {
+            return -1;
+        }
+
+        Stream->Loop = Loop;
+
+        Stream->EndReached.store(0);
+        Stream->Read.store(0);
+        Stream->Write.store(0);
+        Stream->Active.store(1, std::memory_order_release);
+    }
+
+    AudioStreamerWake(Streamer);
+
+    return Result;
+}
+
+void AudioStreamClose(AudioStreamer *Streamer, i32 StreamIndex)
+{
+    AudioStream* Stream = &Streamer->Streams[StreamIndex];
+
+    std::lock_guard<std::mutex> Lock(Streamer->DecodeMutex);
+
+    Assert(Stream->Active.load());
+
+    Stream->Active.store(0);
+
+    AudioDecoderClose(&Stream->Decoder);
+}
+
+AudioStreamChunk* AudioStreamPeek(AudioStreamer *Streamer, i32 StreamIndex)
+{
+    AudioStream*    Stream  = &Streamer->Streams[StreamIndex];
+    u32             Read    = Stream->Read.load(std::memory_order_relaxed);
+
+    if (Read == Stream->Write.load(std::memory_order_acquire)) {
+        return NULL;
+    }
+
+    return &Stream->Chunks[Read & (AUDIO_STREAM_CHUNKS - 1)];
+}
+
+void AudioStreamPop(AudioStreamer *Streamer, i32 StreamIndex)
+{
+    AudioStream* Stream = &Streamer->Streams[StreamIndex];
+
+    Stream->Read.store(Stream->Read.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+    AudioStreamerWake(Streamer);
+}
@@ -0,0 +1,64 @@
+#ifndef _TEARA_UTILS_AUDIO_STREAMER_H_
+#define _TEARA_UTILS_AUDIO_STREAMER_H_
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "Core/Types.h"
+#include "AudioLoader.h"
+
+// NOTE(ismail): long tracks (music, ambience) are never decoded whole. Audio thread decodes fixed size chunks into
+// small ring per stream and stays ahead of playback, main thread takes ready chunks and hands them to audio API.
+// Memory is AUDIO_STREAMER_MEMORY_SIZE no matter how long tracks are. Only main thread opens, closes and consumes
+
+#define AUDIO_STREAMER_MAX_STREAMS  (4)
+#define AUDIO_STREAM_CHUNKS         (4)     // NOTE(ismail): must be power of two
+#define AUDIO_STREAM_CHUNK_FRAMES   (8192)  // NOTE(ismail): ~170ms at 48kHz, whole ring is ~0.7s ahead of playback
+#define AUDIO_STREAM_CHUNK_SIZE     (AUDIO_STREAM_CHUNK_FRAMES * AUDIO_MAX_CHANNELS * sizeof(real32))
+#define AUDIO_STREAMER_MEMORY_SIZE  (AUDIO_STREAMER_MAX_STREAMS * AUDIO_STREAM_CHUNKS * AUDIO_STREAM_CHUNK_SIZE)
+
+// NOTE(ismail): Last is set on final chunk of not looped track, it may have 0 frames
+struct AudioStreamChunk {
+    void*   Data;
+    u32     Frames;
+    u32     Size;
+    bool32  Last;
+};
+
+struct AudioStream {
+    AudioDecoder            Decoder;
+    bool32                  Loop;
+    u8*                     Memory;
+    AudioStreamChunk        Chunks[AUDIO_STREAM_CHUNKS];
+
+    std::atomic<bool32>     Active;
+    std::atomic<bool32>     EndReached;     // NOTE(ismail): audio thread stops decoding, main thread still drains ring
+    std::atomic<u32>        Read;
+    std::atomic<u32>        Write;
+};
+
+struct AudioStreamer {
+    AudioStream             Streams[AUDIO_STREAMER_MAX_STREAMS];
+
+    std::mutex              DecodeMutex;    // NOTE(ismail): held while chunk is decoded and while stream opens or closes
+    std::atomic<bool32>     Running;
+    std::mutex              WakeMutex;
+    std::condition_variable WakeCondition;
+    std::thread             Thread;
+};
+
+// NOTE(ismail): Memory must be at least AUDIO_STREAMER_MEMORY_SIZE, streamer doesn't own it
+void AudioStreamerInit(AudioStreamer *Streamer, void *Memory, u64 MemorySize);
+void AudioStreamerShutdown(AudioStreamer *Streamer);
+
+// NOTE(ismail): returns stream index or -1 when file can't be opened or all streams are busy
+i32 AudioStreamOpen(AudioStreamer *Streamer, const char *FileName, AudioFormat Fmt, bool32 FloatSamples, bool32 Loop);
+void AudioStreamClose(AudioStreamer *Streamer, i32 StreamIndex);
+
+// NOTE(ismail): oldest decoded chunk or NULL when audio thread is behind, it stays valid until AudioStreamPop
+AudioStreamChunk* AudioStreamPeek(AudioStreamer *Streamer, i32 StreamIndex);
+void AudioStreamPop(AudioStreamer *Streamer, i32 StreamIndex);
+
+#endif
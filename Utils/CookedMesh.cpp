@@ -0,0 +1,240 @@
+#include "CookedMesh.h"
+#include "Core/Debug.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#define COOKED_OBJ_MESHES_MAX (64)
+
+const u32 CookedStreamElementSize[CookedStreamsMax] = {
+    sizeof(vec3),       // CookedPositions
+    sizeof(vec3),       // CookedNormals
+    sizeof(vec2),       // CookedTextureCoord
+    sizeof(i32) * 4,    // CookedBoneIds
+    sizeof(vec4),       // CookedBoneWeights
+    sizeof(u32),        // CookedIndices
+};
+
+static inline u64 CookedAlign(u64 Offset)
+{
+    return (Offset + (COOKED_MESH_ALIGNMENT - 1)) & ~(u64)(COOKED_MESH_ALIGNMENT - 1);
+}
+
+static bool32 CookedWrite(FILE *Output, u64 *Written, u64 Offset, const void *Data, u64 Size)
+{
+    static const u8 Padding[COOKED_MESH_ALIGNMENT] = {};
+
+    Assert(Offset >= *Written && Offset - *Written < COOKED_MESH_ALIGNMENT);
+
+    if (Offset > *Written && fwrite(Padding, 1, Offset - *Written, Output) != Offset - *Written) {
+        return 0;
+    }
+
+    if (Size && fwrite(Data, 1, Size, Output) != Size) {
+        return 0;
+    }
+
+    *Written = Offset + Size;
+
+    return 1;
+}
+
+void CookedMeshPath(char *Result, u32 ResultSize, const char *SourcePath)
+{
+    snprintf(Result, ResultSize, "%s" COOKED_MESH_EXTENSION, SourcePath);
+}
+
+u32 CookedMeshFlags(ObjFileLoaderFlags Flags)
+{
+    return (Flags.GenerateSmoothNormals ? 1u : 0u) | (Flags.SelfGenerateNormals ? 2u : 0u);
+}
+
+// NOTE(ismail): glTF is fingerprinted by .gltf only, edits that touch just its .bin buffers are not seen
+static bool32 CookedSourceFingerprint(const char *SourcePath, u64 *Size, i64 *Modified)
+{
+    struct stat SourceStat;
+
+    if (!SourcePath || stat(SourcePath, &SourceStat) != 0) {
+        return 0;
+    }
+
+    *Size       = (u64)SourceStat.st_size;
+    *Modified   = (i64)SourceStat.st_mtime;
+
+    return 1;
+}
+
+Statuses CookMesh(const char *Path, CookedMeshSource *Source)
+{
+    CookedMeshHeader Header = {};
+
+    Header.Magic            = COOKED_MESH_MAGIC;
+    Header.Version          = COOKED_MESH_VERSION;
+    Header.SubmeshesCount   = Source->SubmeshesCount;
+    Header.LoaderFlags      = Source->LoaderFlags;
+
+    if (!CookedSourceFingerprint(Source->SourcePath, &Header.SourceSize, &Header.SourceModified)) {
+        return Statuses::Failed;
+    }
+
+    u64 Offset = sizeof(Header);
+
+    for (u32 Stream = 0; Stream < CookedStreamsMax; ++Stream) {
+        Offset = CookedAlign(Offset);
+
+        Header.StreamOffset[Stream] = Offset;
+        Header.StreamCount[Stream]  = Source->Streams[Stream] ? Source->StreamCount[Stream] : 0;
+
+        Offset += (u64)Header.StreamCount[Stream] * CookedStreamElementSize[Stream];
+    }
+
+    Offset                  = CookedAlign(Offset);
+    Header.SubmeshesOffset  = Offset;
+    Offset                 += sizeof(Mesh) * Source->SubmeshesCount;
+
+    Offset                  = CookedAlign(Offset);
+    Header.SubmeshInfoOffset = Offset;
+    Offset                 += sizeof(CookedSubmesh) * Source->SubmeshesCount;
+
+    Header.FileSize = Offset;
+
+    FILE *Output = fopen(Path, "wb");
+
+    if (!Output) {
+        return Statuses::Failed;
+    }
+
+    u64     Written = 0;
+    bool32  Result  = CookedWrite(Output, &Written, 0, &Header, sizeof(Header));
+
+    for (u32 Stream = 0; Result && Stream < CookedStreamsMax; ++Stream) {
+        Result = CookedWrite(Output, &Written, Header.StreamOffset[Stream], Source->Streams[Stream],
+                             (u64)Header.StreamCount[Stream] * CookedStreamElementSize[Stream]);
+    }
+
+    Result = Result && CookedWrite(Output, &Written, Header.SubmeshesOffset, Source->Submeshes, sizeof(Mesh) * Source->SubmeshesCount);
+    Result = Result && CookedWrite(Output, &Written, Header.SubmeshInfoOffset, Source->SubmeshInfo, sizeof(CookedSubmesh) * Source->SubmeshesCount);
+
+    Result = (fclose(Output) == 0) && Result;
+
+    if (!Result) {
+        remove(Path);
+
+        return Statuses::Failed;
+    }
+
+    Assert(Written == Header.FileSize);
+
+    return Statuses::Success;
+}
+
+// NOTE(ismail): LoadObjFile writes one shared vertex range for all meshes, so every submesh spans whole stream
+Statuses CookObjFile(const char *Path, const char *SourcePath, ObjFile *File, ObjFileLoaderFlags Flags)
+{
+    CookedSubmesh SubmeshInfo[COOKED_OBJ_MESHES_MAX];
+
+    Assert(File->MeshesCount <= COOKED_OBJ_MESHES_MAX);
+
+    for (u32 MeshIndex = 0; MeshIndex < File->MeshesCount; ++MeshIndex) {
+        SubmeshInfo[MeshIndex].MeshIndex        = 0;
+        SubmeshInfo[MeshIndex].VerticesAmount   = File->PositionsCount;
+    }
+
+    CookedMeshSource Source = {};
+
+    Source.SourcePath                       = SourcePath;
+    Source.LoaderFlags                      = CookedMeshFlags(Flags);
+    Source.Streams[CookedPositions]         = File->Positions;
+    Source.Streams[CookedNormals]           = File->Normals;
+    Source.Streams[CookedTextureCoord]      = File->TextureCoord;
+    Source.Streams[CookedIndices]           = File->Indices;
+    Source.StreamCount[CookedPositions]     = File->PositionsCount;
+    Source.StreamCount[CookedNormals]       = File->NormalsCount;
+    Source.StreamCount[CookedTextureCoord]  = File->TexturesCount;
+    Source.StreamCount[CookedIndices]       = File->IndicesCount;
+    Source.Submeshes                        = File->Meshes;
+    Source.SubmeshInfo                      = SubmeshInfo;
+    Source.SubmeshesCount                   = File->MeshesCount;
+
+    return CookMesh(Path, &Source);
+}
+
+Statuses OpenCookedMesh(Platform *Platform, const char *Path, const char *SourcePath, u32 LoaderFlags, CookedMesh *Result)
+{
+    *Result = {};
+
+    File Mapping = Platform->MapFile(Path);
+
+    if (!Mapping.Data) {
+        return Statuses::FileLoadFailed;
+    }
+
+    CookedMeshHeader *Header = (CookedMeshHeader*)Mapping.Data;
+
+    bool32 Valid = Mapping.Size >= sizeof(*Header)               &&
+                   Header->Magic    == COOKED_MESH_MAGIC            &&
+                   Header->Version  == COOKED_MESH_VERSION          &&
+                   Header->FileSize == Mapping.Size;
+
+    for (u32 Stream = 0; Valid && Stream < CookedStreamsMax; ++Stream) {
+        u64 StreamEnd = Header->StreamOffset[Stream] + (u64)Header->StreamCount[Stream] * CookedStreamElementSize[Stream];
+
+        Valid = (Header->StreamOffset[Stream] & (COOKED_MESH_ALIGNMENT - 1)) == 0 && StreamEnd <= Mapping.Size;
+    }
+
+    Valid = Valid && Header->SubmeshesOffset   + sizeof(Mesh) * (u64)Header->SubmeshesCount          <= Mapping.Size;
+    Valid = Valid && Header->SubmeshInfoOffset + sizeof(CookedSubmesh) * (u64)Header->SubmeshesCount <= Mapping.Size;
+    Valid = Valid && Header->LoaderFlags == LoaderFlags;
+
+    u64 SourceSize;
+    i64 SourceModified;
+
+    if (Valid && CookedSourceFingerprint(SourcePath, &SourceSize, &SourceModified)) {
+        Valid = Header->SourceSize == SourceSize && Header->SourceModified == SourceModified;
+    }
+
+    if (!Valid) {
+        Platform->UnmapFile(&Mapping);
+
+        return Statuses::FileLoadFailed;
+    }
+
+    Result->Mapping = Mapping;
+    Result->Header  = Header;
+
+    for (u32 Stream = 0; Stream < CookedStreamsMax; ++Stream) {
+        Result->Streams[Stream] = Header->StreamCount[Stream] ? Mapping.Data + Header->StreamOffset[Stream] : 0;
+    }
+
+    Result->Submeshes   = (Mesh*)(Mapping.Data + Header->SubmeshesOffset);
+    Result->SubmeshInfo = (CookedSubmesh*)(Mapping.Data + Header->SubmeshInfoOffset);
+
+    return Statuses::Success;
+}
+
+void CloseCookedMesh(Platform *Platform, CookedMesh *Cooked)
+{
+    if (Cooked->Mapping.Data) {
+        Platform->UnmapFile(&Cooked->Mapping);
+    }
+
+    *Cooked = {};
+}
+
+void CookedMeshToObjFile(CookedMesh *Cooked, ObjFile *Result)
+{
+    CookedMeshHeader *Header = Cooked->Header;
+
+    Result->Meshes          = Cooked->Submeshes;
+    Result->Positions       = (vec3*)Cooked->Streams[CookedPositions];
+    Result->Normals         = (vec3*)Cooked->Streams[CookedNormals];
+    Result->TextureCoord    = (vec2*)Cooked->Streams[CookedTextureCoord];
+    Result->Indices         = (u32*)Cooked->Streams[CookedIndices];
+    Result->MeshesCount     = Header->SubmeshesCount;
+    Result->PositionsCount  = Header->StreamCount[CookedPositions];
+    Result->NormalsCount    = Header->StreamCount[CookedNormals];
+    Result->TexturesCount   = Header->StreamCount[CookedTextureCoord];
+    Result->IndicesCount    = Header->StreamCount[CookedIndices];
+}
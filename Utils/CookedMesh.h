@@ -0,0 +1,86 @@
+#ifndef _TEARA_UTILS_COOKED_MESH_H_
+#define _TEARA_UTILS_COOKED_MESH_H_
+
+#include "Core/EnginePlatform.h"
+#include "Core/Types.h"
+#include "AssetsLoader.h"
+
+// NOTE(ismail): offline cooked mesh blob. Layout is
+//   CookedMeshHeader | aligned vertex streams | aligned index stream | Mesh table | CookedSubmesh table
+// file is mapped read only and ObjFile / glTF2Primitives views point straight into the mapping, nothing is copied or parsed.
+// Header keeps loader flags and size/mtime of source file, blob cooked from other source or with other flags is rejected
+
+#define COOKED_MESH_MAGIC       (0x48534D54) // NOTE(ismail): "TMSH"
+#define COOKED_MESH_VERSION     (2)
+#define COOKED_MESH_ALIGNMENT   (64)
+#define COOKED_MESH_EXTENSION   ".tmesh"
+#define COOKED_MESH_PATH_MAX    (256)
+
+enum CookedMeshStream {
+    CookedPositions,
+    CookedNormals,
+    CookedTextureCoord,
+    CookedBoneIds,
+    CookedBoneWeights,
+    CookedIndices,
+
+    CookedStreamsMax
+};
+
+struct CookedMeshHeader {
+    u32     Magic;
+    u32     Version;
+    u64     FileSize;
+    u64     StreamOffset[CookedStreamsMax];
+    u32     StreamCount[CookedStreamsMax];
+    u32     SubmeshesCount;
+    u64     SubmeshesOffset;
+    u64     SubmeshInfoOffset;
+    u64     SourceSize;
+    i64     SourceModified;     // NOTE(ismail): mtime in seconds
+    u32     LoaderFlags;        // NOTE(ismail): CookedMeshFlags of ObjFileLoaderFlags, 0 for glTF
+};
+
+// NOTE(ismail): Mesh keeps material and offsets, this keeps what Mesh can't say: owner mesh and vertex range of submesh
+struct CookedSubmesh {
+    u32     MeshIndex;
+    u32     VerticesAmount;
+};
+
+// NOTE(ismail): streams that are absent have zero count and null pointer, SourcePath is stat'ed for fingerprint
+struct CookedMeshSource {
+    const char*     SourcePath;
+    u32             LoaderFlags;
+    const void*     Streams[CookedStreamsMax];
+    u32             StreamCount[CookedStreamsMax];
+    const Mesh*     Submeshes;
+    CookedSubmesh*  SubmeshInfo;
+    u32             SubmeshesCount;
+};
+
+struct CookedMesh {
+    File                Mapping;
+    CookedMeshHeader*   Header;
+    void*               Streams[CookedStreamsMax];
+    Mesh*               Submeshes;
+    CookedSubmesh*      SubmeshInfo;
+};
+
+extern const u32 CookedStreamElementSize[CookedStreamsMax];
+
+// NOTE(ismail): "data/obj/Golem.obj" -> "data/obj/Golem.obj.tmesh"
+void CookedMeshPath(char *Result, u32 ResultSize, const char *SourcePath);
+
+u32 CookedMeshFlags(ObjFileLoaderFlags Flags);
+
+Statuses CookMesh(const char *Path, CookedMeshSource *Source);
+Statuses CookObjFile(const char *Path, const char *SourcePath, ObjFile *File, ObjFileLoaderFlags Flags);
+
+// NOTE(ismail): fails on missing file, foreign magic, old version, streams out of file bounds, other loader flags or
+// SourcePath changed since cooking, caller falls back to text path then. Missing source is not checked (cooked only data)
+Statuses OpenCookedMesh(Platform *Platform, const char *Path, const char *SourcePath, u32 LoaderFlags, CookedMesh *Result);
+void CloseCookedMesh(Platform *Platform, CookedMesh *Cooked);
+
+void CookedMeshToObjFile(CookedMesh *Cooked, ObjFile *Result);
+
+#endif
@@ -0,0 +1,487 @@
+#include "CookedTexture.h"
+#include "Core/Debug.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#define COOKED_TEXTURE_BLOCK_PIXELS (16)
+
+static inline u64 CookedTextureAlign(u64 Offset)
+{
+    return (Offset + (COOKED_TEXTURE_ALIGNMENT - 1)) & ~(u64)(COOKED_TEXTURE_ALIGNMENT - 1);
+}
+
+static u64 CookedTextureMipSize(TextureFormat Format, i32 Width, i32 Height)
+{
+    u64 BlocksAmount = (u64)((Width + 3) / 4) * (u64)((Height + 3) / 4);
+
+    switch (Format) {
+        case TextureFormatR8:       return (u64)Width * (u64)Height;
+        case TextureFormatRGBA8:    return (u64)Width * (u64)Height * 4;
+        case TextureFormatBC1:      return BlocksAmount * 8;
+        case TextureFormatBC3:      return BlocksAmount * 16;
+        default:                    return 0;
+    }
+}
+
+static inline i32 CookedTextureMin(i32 A, i32 B)
+{
+    return A < B ? A : B;
+}
+
+// NOTE(ismail): 2x2 box filter, last row / column of odd sized level is reused instead of reading past it
+static void CookDownsample(const u8 *Source, i32 SourceWidth, i32 SourceHeight, u8 *Dest, i32 Width, i32 Height, i32 Channels)
+{
+    for (i32 Y = 0; Y < Height; ++Y) {
+        const u8* Row0 = Source + (u64)CookedTextureMin(Y * 2,     SourceHeight - 1) * SourceWidth * Channels;
+        const u8* Row1 = Source + (u64)CookedTextureMin(Y * 2 + 1, SourceHeight - 1) * SourceWidth * Channels;
+
+        for (i32 X = 0; X < Width; ++X) {
+            i32 X0 = CookedTextureMin(X * 2,     SourceWidth - 1) * Channels;
+            i32 X1 = CookedTextureMin(X * 2 + 1, SourceWidth - 1) * Channels;
+
+            for (i32 Channel = 0; Channel < Channels; ++Channel) {
+                i32 Sum = Row0[X0 + Channel] + Row0[X1 + Channel] + Row1[X0 + Channel] + Row1[X1 + Channel];
+
+                Dest[((u64)Y * Width + X) * Channels + Channel] = (u8)((Sum + 2) >> 2);
+            }
+        }
+    }
+}
+
+static inline u16 CookPack565(const i32 *Color)
+{
+    return (u16)(((Color[0] >> 3) << 11) | ((Color[1] >> 2) << 5) | (Color[2] >> 3));
+}
+
+static inline void CookUnpack565(u16 Packed, i32 *Color)
+{
+    i32 R = (Packed >> 11) & 31;
+    i32 G = (Packed >> 5)  & 63;
+    i32 B = Packed         & 31;
+
+    Color[0] = (R << 3) | (R >> 2);
+    Color[1] = (G << 2) | (G >> 4);
+    Color[2] = (B << 3) | (B >> 2);
+}
+
+// NOTE(ismail): Block is 16 RGBA pixels, edge blocks repeat last row / column
+static void CookFetchBlock(const u8 *Pixels, i32 Width, i32 Height, i32 BlockX, i32 BlockY, u8 *Block)
+{
+    for (i32 Y = 0; Y < 4; ++Y) {
+        i32 SourceY = CookedTextureMin(BlockY * 4 + Y, Height - 1);
+
+        for (i32 X = 0; X < 4; ++X) {
+            i32 SourceX = CookedTextureMin(BlockX * 4 + X, Width - 1);
+
+            memcpy(Block + (Y * 4 + X) * 4, Pixels + ((u64)SourceY * Width + SourceX) * 4, 4);
+        }
+    }
+}
+
+// NOTE(ismail): endpoints are bounding box of block shrunk by 1/16 of its size, box diagonal is flipped on red and blue axis
+// when they go against green. Color0 > Color1 always, so block is four color in both BC1 and BC3
+static void CookEncodeColorBlock(const u8 *Block, u8 *Out)
+{
+    i32 Min[3] = { 255, 255, 255 };
+    i32 Max[3] = { 0, 0, 0 };
+
+    for (i32 Pixel = 0; Pixel < COOKED_TEXTURE_BLOCK_PIXELS; ++Pixel) {
+        for (i32 Channel = 0; Channel < 3; ++Channel) {
+            i32 Value = Block[Pixel * 4 + Channel];
+
+            Min[Channel] = Value < Min[Channel] ? Value : Min[Channel];
+            Max[Channel] = Value > Max[Channel] ? Value : Max[Channel];
+        }
+    }
+
+    i32 Center[3];
+
+    for (i32 Channel = 0; Channel < 3; ++Channel) {
+        i32 Inset = (Max[Channel] - Min[Channel]) >> 4;
+
+        Min[Channel]   += Inset;
+        Max[Channel]   -= Inset;
+        Center[Channel] = (Min[Channel] + Max[Channel]) >> 1;
+    }
+
+    i32 CovarianceRG = 0;
+    i32 CovarianceBG = 0;
+
+    for (i32 Pixel = 0; Pixel < COOKED_TEXTURE_BLOCK_PIXELS; ++Pixel) {
+        i32 G = Block[Pixel * 4 + 1] - Center[1];
+
+        CovarianceRG += (Block[Pixel * 4 + 0] - Center[0]) * G;
+        CovarianceBG += (Block[Pixel * 4 + 2] - Center[2]) * G;
+    }
+
+    if (CovarianceRG < 0) {
+        i32 Temp = Min[0]; Min[0] = Max[0]; Max[0] = Temp;
+    }
+
+    if (CovarianceBG < 0) {
+        i32 Temp = Min[2]; Min[2] = Max[2]; Max[2] = Temp;
+    }
+
+    u16 Color0 = CookPack565(Max);
+    u16 Color1 = CookPack565(Min);
+
+    if (Color0 < Color1) {
+        u16 Temp = Color0; Color0 = Color1; Color1 = Temp;
+    }
+
+    u32 Indices = 0;
+
+    if (Color0 != Color1) {
+        i32 Palette[4][3];
+
+        CookUnpack565(Color0, Palette[0]);
+        CookUnpack565(Color1, Palette[1]);
+
+        for (i32 Channel = 0; Channel < 3; ++Channel) {
+            Palette[2][Channel] = (2 * Palette[0][Channel] + Palette[1][Channel]) / 3;
+            Palette[3][Channel] = (Palette[0][Channel] + 2 * Palette[1][Channel]) / 3;
+        }
+
+        for (i32 Pixel = 0; Pixel < COOKED_TEXTURE_BLOCK_PIXELS; ++Pixel) {
+            i32 BestIndex       = 0;
+            i32 BestDistance    = 0x7FFFFFFF;
+
+            for (i32 Index = 0; Index < 4; ++Index) {
+                i32 DR = Block[Pixel * 4 + 0] - Palette[Index][0];
+                i32 DG = Block[Pixel * 4 + 1] - Palette[Index][1];
+                i32 DB = Block[Pixel * 4 + 2] - Palette[Index][2];
+
+                i32 Distance = DR * DR + DG * DG + DB * DB;
+
+                if (Distance < BestDistance) {
+                    BestDistance    = Distance;
+                    BestIndex       = Index;
+                }
+            }
+
+            Indices |= (u32)BestIndex << (Pixel * 2);
+        }
+    }
+
+    memcpy(Out + 0, &Color0, sizeof(Color0));
+    memcpy(Out + 2, &Color1, sizeof(Color1));
+    memcpy(Out + 4, &Indices, sizeof(Indices));
+}
+
+// NOTE(ismail): BC3 alpha half, Alpha0 > Alpha1 selects eight value ramp
+static void CookEncodeAlphaBlock(const u8 *Block, u8 *Out)
+{
+    i32 Min = 255;
+    i32 Max = 0;
+
+    for (i32 Pixel = 0; Pixel < COOKED_TEXTURE_BLOCK_PIXELS; ++Pixel) {
+        i32 Value = Block[Pixel * 4 + 3];
+
+        Min = Value < Min ? Value : Min;
+        Max = Value > Max ? Value : Max;
+    }
+
+    u64 Indices = 0;
+
+    if (Max != Min) {
+        i32 Palette[8];
+
+        Palette[0] = Max;
+        Palette[1] = Min;
+
+        for (i32 Index = 2; Index < 8; ++Index) {
+            Palette[Index] = ((8 - Index) * Max + (Index - 1) * Min) / 7;
+        }
+
+        for (i32 Pixel = 0; Pixel < COOKED_TEXTURE_BLOCK_PIXELS; ++Pixel) {
+            i32 BestIndex       = 0;
+            i32 BestDistance    = 256;
+
+            for (i32 Index = 0; Index < 8; ++Index) {
+                i32 Distance = Block[Pixel * 4 + 3] - Palette[Index];
+                Distance     = Distance < 0 ? -Distance : Distance;
+
+                if (Distance < BestDistance) {
+                    BestDistance    = Distance;
+                    BestIndex       = Index;
+                }
+            }
+
+            Indices |= (u64)BestIndex << (Pixel * 3);
+        }
+    }
+
+    Out[0] = (u8)Max;
+    Out[1] = (u8)Min;
+
+    for (i32 Byte = 0; Byte < 6; ++Byte) {
+        Out[2 + Byte] = (u8)(Indices >> (Byte * 8));
+    }
+}
+
+static void CookEncodeMip(TextureFormat Format, const u8 *Pixels, i32 Width, i32 Height, u8 *Out)
+{
+    if (Format == TextureFormatR8 || Format == TextureFormatRGBA8) {
+        memcpy(Out, Pixels, CookedTextureMipSize(Format, Width, Height));
+
+        return;
+    }
+
+    i32 BlocksX     = (Width + 3) / 4;
+    i32 BlocksY     = (Height + 3) / 4;
+    u64 BlockSize   = Format == TextureFormatBC1 ? 8 : 16;
+
+    u8 Block[COOKED_TEXTURE_BLOCK_PIXELS * 4];
+
+    for (i32 BlockY = 0; BlockY < BlocksY; ++BlockY) {
+        for (i32 BlockX = 0; BlockX < BlocksX; ++BlockX) {
+            u8* BlockOut = Out + ((u64)BlockY * BlocksX + BlockX) * BlockSize;
+
+            CookFetchBlock(Pixels, Width, Height, BlockX, BlockY, Block);
+
+            if (Format == TextureFormatBC3) {
+                CookEncodeAlphaBlock(Block, BlockOut);
+                CookEncodeColorBlock(Block, BlockOut + 8);
+            }
+            else {
+                CookEncodeColorBlock(Block, BlockOut);
+            }
+        }
+    }
+}
+
+void CookedTexturePath(char *Result, u32 ResultSize, const char *SourcePath)
+{
+    snprintf(Result, ResultSize, "%s" COOKED_TEXTURE_EXTENSION, SourcePath);
+}
+
+TextureFormat CookedTextureFormat(i32 Channels, bool32 Compress)
+{
+    switch (Channels) {
+        case 1:     return TextureFormatR8;
+        case 3:     return Compress ? TextureFormatBC1 : TextureFormatRGBA8;
+        case 4:     return Compress ? TextureFormatBC3 : TextureFormatRGBA8;
+        default:    return TextureFormatRGBA8;
+    }
+}
+
+static bool32 CookedTextureSourceFingerprint(const char *SourcePath, u64 *Size, i64 *Modified)
+{
+    struct stat SourceStat;
+
+    if (!SourcePath || stat(SourcePath, &SourceStat) != 0) {
+        return 0;
+    }
+
+    *Size       = (u64)SourceStat.st_size;
+    *Modified   = (i64)SourceStat.st_mtime;
+
+    return 1;
+}
+
+Statuses CookTexture(Platform *Platform, const char *Path, const char *SourcePath, TextureFile *Source, TextureFormat Format,
+                     bool32 VerticalFlip)
+{
+    Assert(Source->Format == TextureFormatDecoded && Source->Data);
+    Assert(Format != TextureFormatDecoded);
+
+    CookedTextureHeader Header = {};
+
+    Header.Magic        = COOKED_TEXTURE_MAGIC;
+    Header.Version      = COOKED_TEXTURE_VERSION;
+    Header.Format       = Format;
+    Header.Width        = Source->Width;
+    Header.Height       = Source->Height;
+    Header.Channels     = Source->Channels;
+    Header.VerticalFlip = VerticalFlip;
+
+    if (!CookedTextureSourceFingerprint(SourcePath, &Header.SourceSize, &Header.SourceModified)) {
+        return Statuses::Failed;
+    }
+
+    i32 WorkChannels    = Format == TextureFormatR8 ? 1 : 4;
+    u64 WorkSize        = 0;
+    u64 Offset          = sizeof(Header);
+    i32 Width           = Source->Width;
+    i32 Height          = Source->Height;
+
+    for (;;) {
+        if (Header.MipsCount == TEXTURE_MIPS_MAX) {
+            return Statuses::Failed;
+        }
+
+        CookedTextureMip* Mip = &Header.Mips[Header.MipsCount++];
+
+        Offset          = CookedTextureAlign(Offset);
+        Mip->Offset     = Offset;
+        Mip->Size       = CookedTextureMipSize(Format, Width, Height);
+        Mip->Width      = Width;
+        Mip->Height     = Height;
+        Offset         += Mip->Size;
+        WorkSize       += (u64)Width * (u64)Height * WorkChannels;
+
+        if (Width == 1 && Height == 1) {
+            break;
+        }
+
+        Width   = Width  > 1 ? Width  / 2 : 1;
+        Height  = Height > 1 ? Height / 2 : 1;
+    }
+
+    Header.FileSize = Offset;
+
+    // NOTE(ismail): whole file is built in memory behind the mip chain and written at once, AllocMem zeroes padding
+    u8* Memory = (u8*)Platform->AllocMem(WorkSize + Header.FileSize);
+
+    if (!Memory) {
+        return Statuses::Failed;
+    }
+
+    u8* Work = Memory;
+    u8* Blob = Memory + WorkSize;
+
+    const u8*   SourcePixels = Source->Data;
+    u64         PixelsAmount = (u64)Source->Width * (u64)Source->Height;
+
+    for (u64 Pixel = 0; Pixel < PixelsAmount; ++Pixel) {
+        const u8*   From    = SourcePixels + Pixel * Source->Channels;
+        u8*         To      = Work + Pixel * WorkChannels;
+
+        if (WorkChannels == 1) {
+            To[0] = From[0];
+        }
+        else if (Source->Channels >= 3) {
+            To[0] = From[0];
+            To[1] = From[1];
+            To[2] = From[2];
+            To[3] = Source->Channels == 4 ? From[3] : 255;
+        }
+        else {
+            To[0] = From[0];
+            To[1] = From[0];
+            To[2] = From[0];
+            To[3] = Source->Channels == 2 ? From[1] : 255;
+        }
+    }
+
+    u8* Level = Work;
+
+    for (u32 MipIndex = 0; MipIndex < Header.MipsCount; ++MipIndex) {
+        CookedTextureMip* Mip = &Header.Mips[MipIndex];
+
+        if (MipIndex > 0) {
+            CookedTextureMip*   Parent      = &Header.Mips[MipIndex - 1];
+            u8*                 ParentLevel = Level;
+
+            Level += (u64)Parent->Width * (u64)Parent->Height * WorkChannels;
+
+            CookDownsample(ParentLevel, Parent->Width, Parent->Height, Level, Mip->Width, Mip->Height, WorkChannels);
+        }
+
+        CookEncodeMip(Format, Level, Mip->Width, Mip->Height, Blob + Mip->Offset);
+    }
+
+    memcpy(Blob, &Header, sizeof(Header));
+
+    FILE *Output = fopen(Path, "wb");
+
+    bool32 Result = Output && fwrite(Blob, 1, Header.FileSize, Output) == Header.FileSize;
+
+    if (Output) {
+        Result = (fclose(Output) == 0) && Result;
+    }
+
+    Platform->ReleaseMem(Memory);
+
+    if (!Result) {
+        remove(Path);
+
+        return Statuses::Failed;
+    }
+
+    return Statuses::Success;
+}
+
+Statuses OpenCookedTexture(Platform *Platform, const char *Path, const char *SourcePath, bool32 VerticalFlip, CookedTexture *Result)
+{
+    *Result = {};
+
+    File Mapping = Platform->MapFile(Path);
+
+    if (!Mapping.Data) {
+        return Statuses::FileLoadFailed;
+    }
+
+    CookedTextureHeader *Header = (CookedTextureHeader*)Mapping.Data;
+
+    bool32 Valid = Mapping.Size >= sizeof(*Header)                  &&
+                   Header->Magic        == COOKED_TEXTURE_MAGIC     &&
+                   Header->Version      == COOKED_TEXTURE_VERSION   &&
+                   Header->FileSize     == Mapping.Size             &&
+                   Header->Format       >  TextureFormatDecoded     &&
+                   Header->Format       <= TextureFormatBC3         &&
+                   Header->MipsCount    >  0                        &&
+                   Header->MipsCount    <= TEXTURE_MIPS_MAX;
+
+    for (u32 MipIndex = 0; Valid && MipIndex < Header->MipsCount; ++MipIndex) {
+        CookedTextureMip* Mip = &Header->Mips[MipIndex];
+
+        Valid = (Mip->Offset & (COOKED_TEXTURE_ALIGNMENT - 1)) == 0                                 &&
+                Mip->Size == CookedTextureMipSize((TextureFormat)Header->Format, Mip->Width, Mip->Height) &&
+                Mip->Offset + Mip->Size <= Mapping.Size;
+    }
+
+    Valid = Valid && (Header->VerticalFlip != 0) == (VerticalFlip != 0);
+
+    u64 SourceSize;
+    i64 SourceModified;
+
+    if (Valid && CookedTextureSourceFingerprint(SourcePath, &SourceSize, &SourceModified)) {
+        Valid = Header->SourceSize == SourceSize && Header->SourceModified == SourceModified;
+    }
+
+    if (!Valid) {
+        Platform->UnmapFile(&Mapping);
+
+        return Statuses::FileLoadFailed;
+    }
+
+    Result->Mapping = Mapping;
+    Result->Header  = Header;
+
+    return Statuses::Success;
+}
+
+void CloseCookedTexture(Platform *Platform, CookedTexture *Cooked)
+{
+    if (Cooked->Mapping.Data) {
+        Platform->UnmapFile(&Cooked->Mapping);
+    }
+
+    *Cooked = {};
+}
+
+void CookedTextureToTextureFile(CookedTexture *Cooked, TextureFile *Result)
+{
+    CookedTextureHeader *Header = Cooked->Header;
+
+    *Result = {};
+
+    Result->Width       = Header->Width;
+    Result->Height      = Header->Height;
+    Result->Channels    = Header->Channels;
+    Result->Format      = (TextureFormat)Header->Format;
+    Result->MipsCount   = Header->MipsCount;
+
+    for (u32 MipIndex = 0; MipIndex < Header->MipsCount; ++MipIndex) {
+        CookedTextureMip* Mip = &Header->Mips[MipIndex];
+
+        Result->Mips[MipIndex].Width    = Mip->Width;
+        Result->Mips[MipIndex].Height   = Mip->Height;
+        Result->Mips[MipIndex].Size     = Mip->Size;
+        Result->Mips[MipIndex].Data     = Cooked->Mapping.Data + Mip->Offset;
+    }
+}
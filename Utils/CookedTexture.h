@@ -0,0 +1,65 @@
+#ifndef _TEARA_UTILS_COOKED_TEXTURE_H_
+#define _TEARA_UTILS_COOKED_TEXTURE_H_
+
+#include "Core/EnginePlatform.h"
+#include "Core/Types.h"
+#include "AssetsLoader.h"
+
+// NOTE(ismail): offline cooked texture blob. Layout is
+//   CookedTextureHeader | aligned mip 0 | aligned mip 1 | ... | aligned last 1x1 mip
+// mips are in GPU format already (BC1 / BC3 blocks or R8 / RGBA8 rows), upload sends them straight out of the mapping
+// and nothing is decoded or generated at runtime. Flip is baked in, so blob is used only for matching VerticalFlip.
+// Size and modification time of source image are stored too, blob cooked from older source is stale
+
+#define COOKED_TEXTURE_MAGIC        (0x58455454) // NOTE(ismail): "TTEX"
+#define COOKED_TEXTURE_VERSION      (2)
+#define COOKED_TEXTURE_ALIGNMENT    (64)
+#define COOKED_TEXTURE_EXTENSION    ".ttex"
+#define COOKED_TEXTURE_PATH_MAX     (256)
+
+struct CookedTextureMip {
+    u64     Offset;
+    u64     Size;
+    i32     Width;
+    i32     Height;
+};
+
+struct CookedTextureHeader {
+    u32                 Magic;
+    u32                 Version;
+    u64                 FileSize;
+    u32                 Format;         // NOTE(ismail): TextureFormat, never TextureFormatDecoded
+    i32                 Width;
+    i32                 Height;
+    i32                 Channels;       // NOTE(ismail): of source image
+    u32                 VerticalFlip;
+    u32                 MipsCount;
+    u64                 SourceSize;
+    i64                 SourceModified;
+    CookedTextureMip    Mips[TEXTURE_MIPS_MAX];
+};
+
+struct CookedTexture {
+    File                    Mapping;
+    CookedTextureHeader*    Header;
+};
+
+// NOTE(ismail): "data/textures/grass_texture.jpg" -> "data/textures/grass_texture.jpg.ttex"
+void CookedTexturePath(char *Result, u32 ResultSize, const char *SourcePath);
+
+// NOTE(ismail): BC1 for 3 channels, BC3 for 4, R8 for 1 and RGBA8 for 2. Without Compress BC formats become RGBA8
+TextureFormat CookedTextureFormat(i32 Channels, bool32 Compress);
+
+// NOTE(ismail): Source is decoded image of SourcePath, scratch for mip chain and blocks comes from AllocMem and is released
+// before return. Fails when SourcePath can't be fingerprinted
+Statuses CookTexture(Platform *Platform, const char *Path, const char *SourcePath, TextureFile *Source, TextureFormat Format,
+                     bool32 VerticalFlip);
+
+// NOTE(ismail): fails on missing file, foreign magic, old version, mips out of file bounds, other VerticalFlip or source
+// changed since cooking, caller decodes source then. Missing source is not stale, shipped builds may have only blobs
+Statuses OpenCookedTexture(Platform *Platform, const char *Path, const char *SourcePath, bool32 VerticalFlip, CookedTexture *Result);
+void CloseCookedTexture(Platform *Platform, CookedTexture *Cooked);
+
+void CookedTextureToTextureFile(CookedTexture *Cooked, TextureFile *Result);
+
+#endif
@@ -0,0 +1,874 @@
+#include "ObjParser.h"
+#include "Core/Debug.h"
+#include "Core/Memory.h"
+#include "Core/JobSystem.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define OBJ_MAX_POWER               (20)
+#define OBJ_CHUNKS_PER_WORKER       (4)
+#define OBJ_MATERIAL_LINE_EXTRA     (8) // NOTE(ismail): "usemtl " or "mtllib " plus '\n'
+#define OBJ_RELATIVE_INDEX          (0x80000000u)
+#define OBJ_ARRAY_MIN_CAPACITY      (64)
+
+// NOTE(ismail): same tables and float parsing as fast_obj, so positions come out bit identical to fast_obj_read
+static const real64 ObjPower10Pos[OBJ_MAX_POWER] = {
+    1.0e0,  1.0e1,  1.0e2,  1.0e3,  1.0e4,  1.0e5,  1.0e6,  1.0e7,  1.0e8,  1.0e9,
+    1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15, 1.0e16, 1.0e17, 1.0e18, 1.0e19,
+};
+
+static const real64 ObjPower10Neg[OBJ_MAX_POWER] = {
+    1.0e0,   1.0e-1,  1.0e-2,  1.0e-3,  1.0e-4,  1.0e-5,  1.0e-6,  1.0e-7,  1.0e-8,  1.0e-9,
+    1.0e-10, 1.0e-11, 1.0e-12, 1.0e-13, 1.0e-14, 1.0e-15, 1.0e-16, 1.0e-17, 1.0e-18, 1.0e-19,
+};
+
+enum ObjLineType {
+    ObjLineOther,
+    ObjLinePosition,
+    ObjLineTexture,
+    ObjLineNormal,
+    ObjLineFace,
+    ObjLineObject,
+    ObjLineUseMaterial,
+    ObjLineMaterialLibrary
+};
+
+// NOTE(ismail): o/usemtl/mtllib lines in file order, IndexOffset is amount of corners parsed before the line
+struct ObjDirective {
+    ObjLineType     Type;
+    u32             IndexOffset;
+    const char*     Name;
+    u32             NameLength;
+};
+
+enum ObjChunkArrayType {
+    ObjArrayPositions,
+    ObjArrayTextures,
+    ObjArrayNormals,
+    ObjArrayIndices,
+    ObjArrayDirectives,
+
+    ObjArrayTypesMax
+};
+
+static const u32 ObjArrayElementSize[ObjArrayTypesMax] = {
+    sizeof(vec3),           // ObjArrayPositions
+    sizeof(vec2),           // ObjArrayTextures
+    sizeof(vec3),           // ObjArrayNormals
+    sizeof(ObjIndex),       // ObjArrayIndices
+    sizeof(ObjDirective),   // ObjArrayDirectives
+};
+
+// NOTE(ismail): bytes of text per element used as first capacity guess, arrays double when guess is wrong
+static const u32 ObjArrayBytesPerElement[ObjArrayTypesMax] = {
+    64,     // ObjArrayPositions
+    64,     // ObjArrayTextures
+    64,     // ObjArrayNormals
+    16,     // ObjArrayIndices
+    4096,   // ObjArrayDirectives
+};
+
+struct ObjChunkArray {
+    u8*     Data;
+    u32     Count;
+    u32     Capacity;
+};
+
+// NOTE(ismail): chunk is parsed into own arrays in one pass since it can't know how much precedes it. Negative .obj
+// indices are stored chunk local with OBJ_RELATIVE_INDEX bit, merge rebases them once prefix sums give Offsets.
+// First chunk starts its arrays with dummy elements, so Offsets already count them
+struct ObjChunk {
+    const char*     Start;
+    const char*     End;
+    ObjChunkArray   Arrays[ObjArrayTypesMax];
+    u32             Offsets[ObjArrayTypesMax];
+    bool32          HasDummies;
+    bool32          HasRelative;
+};
+
+struct ObjParseContext {
+    ::Platform*     Platform;
+    ObjChunk*       Chunks;
+    ObjParsedFile*  Result;
+    ObjDirective*   Directives;
+};
+
+// NOTE(ismail): fast_obj reads synthetic .obj from memory, .mtl files it asks for come from disk
+struct ObjMaterialReader {
+    const char* ObjPath;
+    const char* Buffer;
+    u64         Size;
+    u64         ReadOffset;
+};
+
+// NOTE(ismail): every chunk ends with '\n' (last line without one is copied out, see ParseObjFile), so '\n' is sentinel
+// and line parsing below never checks chunk end. '\n' is neither whitespace nor digit, every loop stops on it
+static inline bool32 ObjIsWhitespace(char Sym)
+{
+    return Sym == ' ' || Sym == '\t' || Sym == '\r';
+}
+
+static inline bool32 ObjIsDigit(char Sym)
+{
+    return Sym >= '0' && Sym <= '9';
+}
+
+static inline const char* ObjSkipWhitespace(const char* At)
+{
+    while (ObjIsWhitespace(*At)) {
+        ++At;
+    }
+
+    return At;
+}
+
+static inline const char* ObjSkipToken(const char* At)
+{
+    while (*At != '\n' && !ObjIsWhitespace(*At)) {
+        ++At;
+    }
+
+    return At;
+}
+
+// NOTE(ismail): returns position after '\n'
+static inline const char* ObjNextLine(const char* At, const char* End)
+{
+    const char* NewLine = (const char*)memchr(At, '\n', (size_t)(End - At));
+
+    Assert(NewLine);
+
+    return NewLine + 1;
+}
+
+static const char* ObjParseInt(const char* At, i32* Value)
+{
+    i32 Sign    = 1;
+    i32 Number  = 0;
+
+    if (*At == '-') {
+        Sign = -1;
+        ++At;
+    }
+
+    while (ObjIsDigit(*At)) {
+        Number = 10 * Number + (*At++ - '0');
+    }
+
+    *Value = Sign * Number;
+
+    return At;
+}
+
+static const char* ObjParseFloat(const char* At, real32* Value)
+{
+    real64 Sign = 1.0;
+
+    At = ObjSkipWhitespace(At);
+
+    if (*At == '+') {
+        ++At;
+    }
+    else if (*At == '-') {
+        Sign = -1.0;
+        ++At;
+    }
+
+    real64 Number = 0.0;
+    while (ObjIsDigit(*At)) {
+        Number = 10.0 * Number + (real64)(*At++ - '0');
+    }
+
+    if (*At == '.') {
+        ++At;
+    }
+
+    real64 Fraction = 0.0;
+    real64 Divisor  = 1.0;
+    while (ObjIsDigit(*At)) {
+        Fraction    = 10.0 * Fraction + (real64)(*At++ - '0');
+        Divisor    *= 10.0;
+    }
+
+    Number += Fraction / Divisor;
+
+    if (*At == 'e' || *At == 'E') {
+        const real64* Powers = ObjPower10Pos;
+
+        ++At;
+
+        if (*At == '+') {
+            ++At;
+        }
+        else if (*At == '-') {
+            Powers = ObjPower10Neg;
+            ++At;
+        }
+
+        u32 Exponent = 0;
+        while (ObjIsDigit(*At)) {
+            Exponent = 10 * Exponent + (u32)(*At++ - '0');
+        }
+
+        Number *= Exponent >= OBJ_MAX_POWER ? 0.0 : Powers[Exponent];
+    }
+
+    *Value = (real32)(Sign * Number);
+
+    return At;
+}
+
+// NOTE(ismail): compares byte by byte, mismatch on '\n' stops it before line end
+static inline bool32 ObjMatchKeyword(const char* At, const char* Keyword, u32 Length)
+{
+    for (u32 Index = 0; Index < Length; ++Index) {
+        if (At[Index] != Keyword[Index]) {
+            return 0;
+        }
+    }
+
+    return ObjIsWhitespace(At[Length]);
+}
+
+// NOTE(ismail): same keyword rules as fast_obj parse_buffer, At is moved past keyword
+static ObjLineType ObjClassifyLine(const char** Line)
+{
+    const char* At = *Line;
+
+    ObjLineType Result = ObjLineOther;
+    u32         Skip   = 2;
+
+    switch (At[0]) {
+        case 'v': {
+            if (ObjIsWhitespace(At[1])) {
+                Result = ObjLinePosition;
+            }
+            else if (At[1] == 't') {
+                Result = ObjLineTexture;
+            }
+            else if (At[1] == 'n') {
+                Result = ObjLineNormal;
+            }
+        } break;
+        case 'f': {
+            if (ObjIsWhitespace(At[1])) {
+                Result = ObjLineFace;
+            }
+        } break;
+        case 'o': {
+            if (ObjIsWhitespace(At[1])) {
+                Result = ObjLineObject;
+            }
+        } break;
+        case 'u': {
+            if (ObjMatchKeyword(At, "usemtl", 6)) {
+                Result  = ObjLineUseMaterial;
+                Skip    = 6;
+            }
+        } break;
+        case 'm': {
+            if (ObjMatchKeyword(At, "mtllib", 6)) {
+                Result  = ObjLineMaterialLibrary;
+                Skip    = 6;
+            }
+        } break;
+    }
+
+    if (Result != ObjLineOther) {
+        *Line = At + Skip;
+    }
+
+    return Result;
+}
+
+static void ObjArrayGrow(Platform* Platform, ObjChunkArray* Array, u32 ElementSize, u32 Capacity)
+{
+    if (Capacity < OBJ_ARRAY_MIN_CAPACITY) {
+        Capacity = OBJ_ARRAY_MIN_CAPACITY;
+    }
+
+    u8* Data = (u8*)Platform->AllocMem((u64)Capacity * ElementSize);
+
+    if (Array->Data) {
+        memcpy(Data, Array->Data, (u64)Array->Count * ElementSize);
+        Platform->ReleaseMem(Array->Data);
+    }
+
+    Array->Data     = Data;
+    Array->Capacity = Capacity;
+}
+
+static inline void* ObjArrayPush(Platform* Platform, ObjChunkArray* Array, u32 ElementSize, u32 Amount)
+{
+    if (Array->Count + Amount > Array->Capacity) {
+        u32 Capacity = Array->Capacity * 2;
+
+        ObjArrayGrow(Platform, Array, ElementSize, Capacity > Array->Count + Amount ? Capacity : Array->Count + Amount);
+    }
+
+    void* Result = Array->Data + (u64)Array->Count * ElementSize;
+
+    Array->Count += Amount;
+
+    return Result;
+}
+
+// NOTE(ismail): negative index is relative to elements parsed so far, chunk knows only its own LocalCount so it keeps
+// 31 bit signed chunk local index and merge turns it into chunk offset + local
+static inline u32 ObjChunkIndex(i32 Value, u32 LocalCount, bool32* HasRelative)
+{
+    if (Value >= 0) {
+        return (u32)Value;
+    }
+
+    *HasRelative = 1;
+
+    return OBJ_RELATIVE_INDEX | ((u32)((i32)LocalCount + Value) & ~OBJ_RELATIVE_INDEX);
+}
+
+static inline u32 ObjRebaseIndex(u32 Index, u32 Offset)
+{
+    if (!(Index & OBJ_RELATIVE_INDEX)) {
+        return Index;
+    }
+
+    i32 Local = (i32)(Index << 1) >> 1;
+
+    return (u32)((i32)Offset + Local);
+}
+
+// NOTE(ismail): polygon is fan triangulated. Vertex with index 0 ends the face like in fast_obj
+static void ObjParseFace(Platform* Platform, ObjChunk* Chunk, const char* At)
+{
+    ObjChunkArray*  Indices     = &Chunk->Arrays[ObjArrayIndices];
+    u32             Positions   = Chunk->Arrays[ObjArrayPositions].Count;
+    u32             Textures    = Chunk->Arrays[ObjArrayTextures].Count;
+    u32             Normals     = Chunk->Arrays[ObjArrayNormals].Count;
+
+    ObjIndex    First       = {};
+    ObjIndex    Previous    = {};
+    u32         Vertices    = 0;
+
+    At = ObjSkipWhitespace(At);
+
+    while (*At != '\n') {
+        i32 v = 0;
+        i32 t = 0;
+        i32 n = 0;
+
+        At = ObjParseInt(At, &v);
+
+        if (*At == '/') {
+            ++At;
+
+            if (*At != '/') {
+                At = ObjParseInt(At, &t);
+            }
+
+            if (*At == '/') {
+                ++At;
+                At = ObjParseInt(At, &n);
+            }
+        }
+
+        if (v == 0) {
+            break;
+        }
+
+        ObjIndex Current;
+        Current.p = ObjChunkIndex(v, Positions, &Chunk->HasRelative);
+        Current.t = ObjChunkIndex(t, Textures,  &Chunk->HasRelative);
+        Current.n = ObjChunkIndex(n, Normals,   &Chunk->HasRelative);
+
+        if (Vertices == 0) {
+            First = Current;
+        }
+        else if (Vertices >= 2) {
+            ObjIndex* Triangle = (ObjIndex*)ObjArrayPush(Platform, Indices, sizeof(ObjIndex), 3);
+
+            Triangle[0] = First;
+            Triangle[1] = Previous;
+            Triangle[2] = Current;
+        }
+
+        Previous = Current;
+        ++Vertices;
+
+        At = ObjSkipWhitespace(At);
+    }
+}
+
+// NOTE(ismail): name runs till end of line without trailing whitespace, like fast_obj skip_name
+static inline u32 ObjNameLength(const char* Name)
+{
+    const char* End = Name;
+
+    while (*End != '\n') {
+        ++End;
+    }
+
+    while (End > Name && ObjIsWhitespace(*(End - 1))) {
+        --End;
+    }
+
+    return (u32)(End - Name);
+}
+
+static void ObjParseChunk(Platform* Platform, ObjChunk* Chunk)
+{
+    u32 ChunkBytes = (u32)(Chunk->End - Chunk->Start);
+
+    for (u32 Type = 0; Type < ObjArrayTypesMax; ++Type) {
+        ObjArrayGrow(Platform, &Chunk->Arrays[Type], ObjArrayElementSize[Type], ChunkBytes / ObjArrayBytesPerElement[Type]);
+    }
+
+    ObjChunkArray* PositionsArray   = &Chunk->Arrays[ObjArrayPositions];
+    ObjChunkArray* TexturesArray    = &Chunk->Arrays[ObjArrayTextures];
+    ObjChunkArray* NormalsArray     = &Chunk->Arrays[ObjArrayNormals];
+    ObjChunkArray* DirectivesArray  = &Chunk->Arrays[ObjArrayDirectives];
+
+    if (Chunk->HasDummies) {
+        *(vec3*)ObjArrayPush(Platform, PositionsArray,  sizeof(vec3), 1) = { 0.0f, 0.0f, 0.0f };
+        *(vec2*)ObjArrayPush(Platform, TexturesArray,   sizeof(vec2), 1) = { 0.0f, 0.0f };
+        *(vec3*)ObjArrayPush(Platform, NormalsArray,    sizeof(vec3), 1) = { 0.0f, 0.0f, 1.0f };
+    }
+
+    const char* At  = Chunk->Start;
+    const char* End = Chunk->End;
+
+    while (At < End) {
+        const char* Line = ObjSkipWhitespace(At);
+
+        ObjLineType Type = ObjClassifyLine(&Line);
+
+        switch (Type) {
+            case ObjLinePosition: {
+                vec3* Position = (vec3*)ObjArrayPush(Platform, PositionsArray, sizeof(vec3), 1);
+
+                Line = ObjParseFloat(Line, &Position->x);
+                Line = ObjParseFloat(Line, &Position->y);
+                Line = ObjParseFloat(Line, &Position->z);
+            } break;
+            case ObjLineTexture: {
+                vec2* Texture = (vec2*)ObjArrayPush(Platform, TexturesArray, sizeof(vec2), 1);
+
+                Line = ObjParseFloat(Line, &Texture->x);
+                Line = ObjParseFloat(Line, &Texture->y);
+            } break;
+            case ObjLineNormal: {
+                vec3* Normal = (vec3*)ObjArrayPush(Platform, NormalsArray, sizeof(vec3), 1);
+
+                Line = ObjParseFloat(Line, &Normal->x);
+                Line = ObjParseFloat(Line, &Normal->y);
+                Line = ObjParseFloat(Line, &Normal->z);
+            } break;
+            case ObjLineFace: {
+                ObjParseFace(Platform, Chunk, Line);
+            } break;
+            case ObjLineObject:
+            case ObjLineUseMaterial:
+            case ObjLineMaterialLibrary: {
+                ObjDirective* Directive = (ObjDirective*)ObjArrayPush(Platform, DirectivesArray, sizeof(ObjDirective), 1);
+
+                Line = ObjSkipWhitespace(Line);
+
+                Directive->Type         = Type;
+                Directive->IndexOffset  = Chunk->Arrays[ObjArrayIndices].Count;
+                Directive->Name         = Line;
+                Directive->NameLength   = ObjNameLength(Line);
+            } break;
+            default: {
+            } break;
+        }
+
+        At = ObjNextLine(Line, End);
+    }
+}
+
+static void ObjRebaseChunkIndices(ObjChunk* Chunk, ObjIndex* Indices)
+{
+    if (!Chunk->HasRelative) {
+        return;
+    }
+
+    for (u32 Index = 0; Index < Chunk->Arrays[ObjArrayIndices].Count; ++Index) {
+        Indices[Index].p = ObjRebaseIndex(Indices[Index].p, Chunk->Offsets[ObjArrayPositions]);
+        Indices[Index].t = ObjRebaseIndex(Indices[Index].t, Chunk->Offsets[ObjArrayTextures]);
+        Indices[Index].n = ObjRebaseIndex(Indices[Index].n, Chunk->Offsets[ObjArrayNormals]);
+    }
+}
+
+// NOTE(ismail): copies chunk arrays to places prefix sums gave them and releases chunk memory
+static void ObjMergeChunk(ObjParseContext* Context, ObjChunk* Chunk)
+{
+    ObjParsedFile*  Result = Context->Result;
+    u8*             Destination[ObjArrayTypesMax];
+
+    Destination[ObjArrayPositions]  = (u8*)(Result->Positions     + Chunk->Offsets[ObjArrayPositions]);
+    Destination[ObjArrayTextures]   = (u8*)(Result->TextureCoord  + Chunk->Offsets[ObjArrayTextures]);
+    Destination[ObjArrayNormals]    = (u8*)(Result->Normals       + Chunk->Offsets[ObjArrayNormals]);
+    Destination[ObjArrayIndices]    = (u8*)(Result->Indices       + Chunk->Offsets[ObjArrayIndices]);
+    Destination[ObjArrayDirectives] = (u8*)(Context->Directives   + Chunk->Offsets[ObjArrayDirectives]);
+
+    for (u32 Type = 0; Type < ObjArrayTypesMax; ++Type) {
+        ObjChunkArray* Array = &Chunk->Arrays[Type];
+
+        memcpy(Destination[Type], Array->Data, (u64)Array->Count * ObjArrayElementSize[Type]);
+    }
+
+    ObjRebaseChunkIndices(Chunk, (ObjIndex*)Destination[ObjArrayIndices]);
+
+    ObjDirective* Directives = (ObjDirective*)Destination[ObjArrayDirectives];
+
+    for (u32 Index = 0; Index < Chunk->Arrays[ObjArrayDirectives].Count; ++Index) {
+        Directives[Index].IndexOffset += Chunk->Offsets[ObjArrayIndices];
+    }
+
+    for (u32 Type = 0; Type < ObjArrayTypesMax; ++Type) {
+        Context->Platform->ReleaseMem(Chunk->Arrays[Type].Data);
+
+        Chunk->Arrays[Type] = {};
+    }
+}
+
+static TEARA_JOB_FUNCTION(ObjParseChunksJob)
+{
+    (void)Jobs;
+
+    ObjParseContext* Context = (ObjParseContext*)Data;
+
+    for (i32 ChunkIndex = First; ChunkIndex < First + Amount; ++ChunkIndex) {
+        ObjParseChunk(Context->Platform, &Context->Chunks[ChunkIndex]);
+    }
+}
+
+static TEARA_JOB_FUNCTION(ObjMergeChunksJob)
+{
+    (void)Jobs;
+
+    ObjParseContext* Context = (ObjParseContext*)Data;
+
+    for (i32 ChunkIndex = First; ChunkIndex < First + Amount; ++ChunkIndex) {
+        ObjMergeChunk(Context, &Context->Chunks[ChunkIndex]);
+    }
+}
+
+static void* ObjMaterialFileOpen(const char* Path, void* UserData)
+{
+    ObjMaterialReader* Reader = (ObjMaterialReader*)UserData;
+
+    if (strcmp(Path, Reader->ObjPath) == 0) {
+        Reader->ReadOffset = 0;
+
+        return Reader;
+    }
+
+    return fopen(Path, "rb");
+}
+
+static void ObjMaterialFileClose(void* FileHandle, void* UserData)
+{
+    if (FileHandle != UserData) {
+        fclose((FILE*)FileHandle);
+    }
+}
+
+static size_t ObjMaterialFileRead(void* FileHandle, void* Dest, size_t Bytes, void* UserData)
+{
+    ObjMaterialReader* Reader = (ObjMaterialReader*)UserData;
+
+    if (FileHandle != UserData) {
+        return fread(Dest, 1, Bytes, (FILE*)FileHandle);
+    }
+
+    u64 Left = Reader->Size - Reader->ReadOffset;
+    if (Bytes > Left) {
+        Bytes = (size_t)Left;
+    }
+
+    memcpy(Dest, Reader->Buffer + Reader->ReadOffset, Bytes);
+
+    Reader->ReadOffset += Bytes;
+
+    return Bytes;
+}
+
+static unsigned long ObjMaterialFileSize(void* FileHandle, void* UserData)
+{
+    ObjMaterialReader* Reader = (ObjMaterialReader*)UserData;
+
+    if (FileHandle == UserData) {
+        return (unsigned long)Reader->Size;
+    }
+
+    FILE* MaterialFile = (FILE*)FileHandle;
+
+    long Position = ftell(MaterialFile);
+    fseek(MaterialFile, 0, SEEK_END);
+    long Size = ftell(MaterialFile);
+    fseek(MaterialFile, Position, SEEK_SET);
+
+    return (unsigned long)Size;
+}
+
+static fastObjMesh* ObjReadMaterials(Platform* Platform, const char* Path, ObjDirective* Directives, u32 DirectivesCount)
+{
+    u64 BufferSize = 0;
+
+    for (u32 DirectiveIndex = 0; DirectiveIndex < DirectivesCount; ++DirectiveIndex) {
+        if (Directives[DirectiveIndex].Type != ObjLineObject) {
+            BufferSize += Directives[DirectiveIndex].NameLength + OBJ_MATERIAL_LINE_EXTRA;
+        }
+    }
+
+    if (!BufferSize) {
+        return 0;
+    }
+
+    char*   Buffer  = (char*)Platform->AllocMem(BufferSize);
+    char*   At      = Buffer;
+
+    for (u32 DirectiveIndex = 0; DirectiveIndex < DirectivesCount; ++DirectiveIndex) {
+        ObjDirective* Directive = &Directives[DirectiveIndex];
+
+        if (Directive->Type == ObjLineObject) {
+            continue;
+        }
+
+        memcpy(At, Directive->Type == ObjLineUseMaterial ? "usemtl " : "mtllib ", 7);
+        memcpy(At + 7, Directive->Name, Directive->NameLength);
+
+        At += 7 + Directive->NameLength;
+        *At++ = '\n';
+    }
+
+    ObjMaterialReader Reader = { Path, Buffer, (u64)(At - Buffer), 0 };
+
+    fastObjCallbacks Callbacks;
+    Callbacks.file_open     = ObjMaterialFileOpen;
+    Callbacks.file_close    = ObjMaterialFileClose;
+    Callbacks.file_read     = ObjMaterialFileRead;
+    Callbacks.file_size     = ObjMaterialFileSize;
+
+    fastObjMesh* Result = fast_obj_read_with_callbacks(Path, &Callbacks, &Reader);
+
+    Platform->ReleaseMem(Buffer);
+
+    return Result;
+}
+
+// NOTE(ismail): same lookup as fast_obj parse_usemtl, fallback materials are created by fast_obj for unknown names
+static u32 ObjFindMaterial(fastObjMesh* Materials, ObjDirective* UseMaterial)
+{
+    if (!UseMaterial || !Materials) {
+        return 0;
+    }
+
+    for (u32 MaterialIndex = 0; MaterialIndex < Materials->material_count; ++MaterialIndex) {
+        const char* Name = Materials->materials[MaterialIndex].name;
+
+        if (Name && strlen(Name) == UseMaterial->NameLength && memcmp(Name, UseMaterial->Name, UseMaterial->NameLength) == 0) {
+            return MaterialIndex;
+        }
+    }
+
+    return 0;
+}
+
+// NOTE(ismail): objects are split on 'o' lines and empty ones are dropped like fast_obj does. Material of object
+// is the last usemtl seen before its first face
+static void ObjBuildObjects(ObjParsedFile* Result, ObjDirective* Directives, u32 DirectivesCount)
+{
+    ObjDirective*   ActiveMaterial  = 0;
+    u32             ObjectStart     = 0;
+    u32             DirectiveIndex  = 0;
+
+    Result->ObjectsCount = 0;
+
+    for (u32 BoundaryIndex = 0; BoundaryIndex <= DirectivesCount; ++BoundaryIndex) {
+        bool32 LastBoundary = BoundaryIndex == DirectivesCount;
+
+        if (!LastBoundary && Directives[BoundaryIndex].Type != ObjLineObject) {
+            continue;
+        }
+
+        u32 ObjectEnd = LastBoundary ? Result->IndicesCount : Directives[BoundaryIndex].IndexOffset;
+
+        if (ObjectEnd > ObjectStart) {
+            while (DirectiveIndex < DirectivesCount && Directives[DirectiveIndex].IndexOffset <= ObjectStart) {
+                if (Directives[DirectiveIndex].Type == ObjLineUseMaterial) {
+                    ActiveMaterial = &Directives[DirectiveIndex];
+                }
+
+                ++DirectiveIndex;
+            }
+
+            ObjParsedObject* Object = &Result->Objects[Result->ObjectsCount++];
+
+            Object->IndexOffset     = ObjectStart;
+            Object->IndicesCount    = ObjectEnd - ObjectStart;
+            Object->Material        = ObjFindMaterial(Result->Materials, ActiveMaterial);
+        }
+
+        ObjectStart = ObjectEnd;
+    }
+}
+
+Statuses ParseObjFile(Platform *Platform, const char *Path, ObjParsedFile *Result)
+{
+    *Result = {};
+
+    File Source = Platform->MapFile(Path);
+
+    if (!Source.Data) {
+        return Statuses::FileLoadFailed;
+    }
+
+    JobSystem* Jobs = Platform->Jobs;
+
+    // NOTE(ismail): caller that can't fan out (no pool or thread outside of it) gains nothing from chunks,
+    // whole file in one chunk skips merge copy
+    i32 Workers     = JobSystemFanOut(Jobs);
+    u64 ChunkSize   = Workers > 1 ? Source.Size / (u64)(Workers * OBJ_CHUNKS_PER_WORKER) : Source.Size;
+    if (ChunkSize < OBJ_PARSER_MIN_CHUNK_SIZE) {
+        ChunkSize = OBJ_PARSER_MIN_CHUNK_SIZE;
+    }
+
+    ObjChunk    Chunks[OBJ_PARSER_MAX_CHUNKS];
+    i32         ChunksAmount    = 0;
+    const char* At              = (const char*)Source.Data;
+    const char* End             = At + Source.Size;
+
+    // NOTE(ismail): line without '\n' at the end of file gets own chunk in a copy with '\n' appended, so sentinel holds
+    const char* TextEnd = End;
+    while (TextEnd > At && *(TextEnd - 1) != '\n') {
+        --TextEnd;
+    }
+
+    while (At < TextEnd) {
+        const char* ChunkEnd = TextEnd;
+
+        if (ChunksAmount < OBJ_PARSER_MAX_CHUNKS - 2 && (u64)(TextEnd - At) > ChunkSize) {
+            ChunkEnd = ObjNextLine(At + ChunkSize - 1, TextEnd);
+        }
+
+        Chunks[ChunksAmount]        = {};
+        Chunks[ChunksAmount].Start  = At;
+        Chunks[ChunksAmount].End    = ChunkEnd;
+
+        ++ChunksAmount;
+
+        At = ChunkEnd;
+    }
+
+    char* Tail = 0;
+
+    if (TextEnd < End) {
+        u64 TailSize = (u64)(End - TextEnd);
+
+        Tail = (char*)Platform->AllocMem(TailSize + 1);
+        memcpy(Tail, TextEnd, TailSize);
+        Tail[TailSize] = '\n';
+
+        Chunks[ChunksAmount]        = {};
+        Chunks[ChunksAmount].Start  = Tail;
+        Chunks[ChunksAmount].End    = Tail + TailSize + 1;
+
+        ++ChunksAmount;
+    }
+
+    Chunks[0].HasDummies = 1;
+
+    ObjParseContext Context = { Platform, Chunks, Result, 0 };
+
+    ParallelFor(Jobs, ChunksAmount, 1, ObjParseChunksJob, &Context);
+
+    u32 Totals[ObjArrayTypesMax] = {};
+
+    for (i32 ChunkIndex = 0; ChunkIndex < ChunksAmount; ++ChunkIndex) {
+        ObjChunk* Chunk = &Chunks[ChunkIndex];
+
+        for (u32 Type = 0; Type < ObjArrayTypesMax; ++Type) {
+            Chunk->Offsets[Type]    = Totals[Type];
+            Totals[Type]           += Chunk->Arrays[Type].Count;
+        }
+    }
+
+    u32 ObjectsMax = Totals[ObjArrayDirectives] + 1;
+
+    if (ChunksAmount == 1) {
+        ObjChunk* Chunk = &Chunks[0];
+
+        for (u32 Type = 0; Type < ObjArrayTypesMax; ++Type) {
+            Result->Memory[Type] = Chunk->Arrays[Type].Data;
+        }
+
+        Result->Positions       = (vec3*)Chunk->Arrays[ObjArrayPositions].Data;
+        Result->TextureCoord    = (vec2*)Chunk->Arrays[ObjArrayTextures].Data;
+        Result->Normals         = (vec3*)Chunk->Arrays[ObjArrayNormals].Data;
+        Result->Indices         = (ObjIndex*)Chunk->Arrays[ObjArrayIndices].Data;
+        Context.Directives      = (ObjDirective*)Chunk->Arrays[ObjArrayDirectives].Data;
+        Result->Objects         = (ObjParsedObject*)Platform->AllocMem(sizeof(ObjParsedObject) * ObjectsMax);
+
+        Result->Memory[ObjArrayTypesMax] = Result->Objects;
+
+        ObjRebaseChunkIndices(Chunk, Result->Indices);
+    }
+    else {
+        u64 MemorySize = ARENA_DEFAULT_ALIGNMENT * (ObjArrayTypesMax + 1) + sizeof(ObjParsedObject) * ObjectsMax;
+
+        for (u32 Type = 0; Type < ObjArrayTypesMax; ++Type) {
+            MemorySize += (u64)ObjArrayElementSize[Type] * Totals[Type];
+        }
+
+        MemoryArena Arena;
+        ArenaInit(&Arena, Platform->AllocMem(MemorySize), MemorySize);
+
+        Result->Memory[0]       = Arena.Base;
+        Result->Positions       = PushArray(&Arena, vec3,               Totals[ObjArrayPositions]);
+        Result->TextureCoord    = PushArray(&Arena, vec2,               Totals[ObjArrayTextures]);
+        Result->Normals         = PushArray(&Arena, vec3,               Totals[ObjArrayNormals]);
+        Result->Indices         = PushArray(&Arena, ObjIndex,           Totals[ObjArrayIndices]);
+        Result->Objects         = PushArray(&Arena, ObjParsedObject,    ObjectsMax);
+        Context.Directives      = PushArray(&Arena, ObjDirective,       Totals[ObjArrayDirectives]);
+
+        ParallelFor(Jobs, ChunksAmount, 1, ObjMergeChunksJob, &Context);
+    }
+
+    u32 DirectivesCount = Totals[ObjArrayDirectives];
+
+    Result->PositionsCount  = Totals[ObjArrayPositions];
+    Result->TexturesCount   = Totals[ObjArrayTextures];
+    Result->NormalsCount    = Totals[ObjArrayNormals];
+    Result->IndicesCount    = Totals[ObjArrayIndices];
+    Result->ChunksAmount    = ChunksAmount;
+
+    Result->Materials = ObjReadMaterials(Platform, Path, Context.Directives, DirectivesCount);
+
+    ObjBuildObjects(Result, Context.Directives, DirectivesCount);
+
+    // NOTE(ismail): directive names point into mapping and tail, nothing uses them after this point
+    if (Tail) {
+        Platform->ReleaseMem(Tail);
+    }
+
+    Platform->UnmapFile(&Source);
+
+    return Statuses::Success;
+}
+
+void FreeObjParsedFile(Platform *Platform, ObjParsedFile *Parsed)
+{
+    if (Parsed->Materials) {
+        fast_obj_destroy(Parsed->Materials);
+    }
+
+    for (u32 Block = 0; Block < OBJ_PARSER_MEMORY_BLOCKS; ++Block) {
+        if (Parsed->Memory[Block]) {
+            Platform->ReleaseMem(Parsed->Memory[Block]);
+        }
+    }
+
+    *Parsed = {};
+}
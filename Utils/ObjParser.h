@@ -0,0 +1,51 @@
+#ifndef _TEARA_UTILS_OBJ_PARSER_H_
+#define _TEARA_UTILS_OBJ_PARSER_H_
+
+#include "Core/EnginePlatform.h"
+#include "Core/Types.h"
+#include "Math/Vector.h"
+#include "3rdparty/fastobj/fast_obj.h"
+
+// NOTE(ismail): parallel .obj reader. File is split at line boundaries, every chunk is parsed on its own job into
+// own arrays, prefix sums of per chunk counts give every chunk its place in shared arrays and merge jobs copy it there.
+// Materials are still read by fast_obj, it gets only mtllib/usemtl lines, so material indices match fast_obj
+
+#define OBJ_PARSER_MAX_CHUNKS       (256)
+#define OBJ_PARSER_MIN_CHUNK_SIZE   (64 * 1024)
+#define OBJ_PARSER_MEMORY_BLOCKS    (6)
+
+struct ObjIndex {
+    u32 p;
+    u32 t;
+    u32 n;
+};
+
+// NOTE(ismail): polygons are fan triangulated, so IndicesCount is always multiple of 3
+struct ObjParsedObject {
+    u32 IndexOffset;
+    u32 IndicesCount;
+    u32 Material;
+};
+
+// NOTE(ismail): like fast_obj element 0 of Positions/TextureCoord/Normals is a dummy and indices are used as is.
+// Counts include dummy element
+struct ObjParsedFile {
+    vec3*               Positions;
+    vec2*               TextureCoord;
+    vec3*               Normals;
+    ObjIndex*           Indices;
+    ObjParsedObject*    Objects;
+    u32                 PositionsCount;
+    u32                 TexturesCount;
+    u32                 NormalsCount;
+    u32                 IndicesCount;
+    u32                 ObjectsCount;
+    fastObjMesh*        Materials;      // NOTE(ismail): only materials and textures are filled, 0 when file has no mtllib/usemtl
+    i32                 ChunksAmount;
+    void*               Memory[OBJ_PARSER_MEMORY_BLOCKS]; // NOTE(ismail): one merged block, or arrays of single chunk taken as is
+};
+
+Statuses ParseObjFile(Platform *Platform, const char *Path, ObjParsedFile *Result);
+void FreeObjParsedFile(Platform *Platform, ObjParsedFile *Parsed);
+
+#endif
@@ -0,0 +1,339 @@
+#include "TextureCache.h"
+#include "Core/Debug.h"
+
+#include <string.h>
+
+#define TEXTURE_CACHE_FLIP_BIT (0x80000000u)
+
+static inline u32 TextureCacheKey(u32 Variant, bool32 VerticalFlip)
+{
+    Assert((Variant & TEXTURE_CACHE_FLIP_BIT) == 0);
+
+    return Variant | (VerticalFlip ? TEXTURE_CACHE_FLIP_BIT : 0);
+}
+
+// NOTE(ismail): FNV-1a of path and key, 0 is reserved for free slots
+static u64 TextureCachePathHash(const char *Path, u32 Key)
+{
+    u64 Result = 0xCBF29CE484222325ull;
+
+    for (const char *At = Path; *At; ++At) {
+        Result = (Result ^ (u8)*At) * 0x100000001B3ull;
+    }
+
+    Result = (Result ^ Key) * 0x100000001B3ull;
+
+    return Result ? Result : 1;
+}
+
+static i32 TextureCacheFind(TextureCache *Cache, u64 PathHash, const char *Path, u32 Key)
+{
+    for (i32 EntryIndex = 0; EntryIndex < TEXTURE_CACHE_MAX_ENTRIES; ++EntryIndex) {
+        if (Cache->PathHashes[EntryIndex] == PathHash) {
+            TextureCacheEntry* Entry = &Cache->Entries[EntryIndex];
+
+            if (Entry->Key == Key && strcmp(Entry->Path, Path) == 0) {
+                return EntryIndex;
+            }
+        }
+    }
+
+    return -1;
+}
+
+static bool32 TextureCacheAddWaiter(TextureCache *Cache, TextureCacheEntry *Entry, TEARA_TextureBind Bind, void *Target, i32 TargetSlot)
+{
+    i32 WaiterIndex = Cache->FreeWaiter;
+
+    if (WaiterIndex < 0) {
+        return 0;
+    }
+
+    TextureCacheWaiter* Waiter = &Cache->Waiters[WaiterIndex];
+
+    Cache->FreeWaiter = Waiter->Next;
+
+    Waiter->Bind        = Bind;
+    Waiter->Target      = Target;
+    Waiter->TargetSlot  = TargetSlot;
+    Waiter->Next        = Entry->FirstWaiter;
+
+    Entry->FirstWaiter = WaiterIndex;
+
+    return 1;
+}
+
+// NOTE(ismail): Bind is 0 when entry failed, waiters are only returned to free list then
+static void TextureCacheWakeWaiters(TextureCache *Cache, TextureCacheEntry *Entry, bool32 Bind)
+{
+    i32 WaiterIndex = Entry->FirstWaiter;
+
+    while (WaiterIndex >= 0) {
+        TextureCacheWaiter* Waiter  = &Cache->Waiters[WaiterIndex];
+        i32                 Next    = Waiter->Next;
+
+        if (Bind) {
+            Waiter->Bind(Waiter->Target, Waiter->TargetSlot, Entry->Handle);
+        }
+
+        Waiter->Next        = Cache->FreeWaiter;
+        Cache->FreeWaiter   = WaiterIndex;
+
+        WaiterIndex = Next;
+    }
+
+    Entry->FirstWaiter = -1;
+}
+
+static void TextureCacheFreeEntry(TextureCache *Cache, i32 EntryIndex)
+{
+    TextureCacheEntry* Entry = &Cache->Entries[EntryIndex];
+
+    {
+        std::lock_guard<std::mutex> Lock(Cache->ContentMutex);
+
+        // NOTE(ismail): alias of this entry is in flight, it takes a reference when uploaded so entry stays
+        if (Cache->ContentPins[EntryIndex] > 0) {
+            return;
+        }
+
+        Cache->ContentClaimed[EntryIndex] = 0;
+    }
+
+    if (Entry->AliasOf >= 0) {
+        TextureCacheEntry* Original = &Cache->Entries[Entry->AliasOf];
+
+        if (--Original->RefCount == 0) {
+            TextureCacheFreeEntry(Cache, Entry->AliasOf);
+        }
+    }
+    else {
+        Cache->Destroy(Entry->Handle);
+
+        --Cache->Stats.Textures;
+    }
+
+    Cache->PathHashes[EntryIndex] = 0;
+
+    *Entry = {};
+
+    Entry->AliasOf      = -1;
+    Entry->FirstWaiter  = -1;
+}
+
+static TEARA_ASSET_DEDUP(TextureCacheDedup)
+{
+    (void)Streamer;
+
+    TextureCache*   Cache       = (TextureCache*)Asset->Target;
+    i32             Self        = Asset->TargetSlot;
+    u32             Key         = Cache->Entries[Self].Key; // NOTE(ismail): immutable while entry is pending
+
+    std::lock_guard<std::mutex> Lock(Cache->ContentMutex);
+
+    for (i32 EntryIndex = 0; EntryIndex < TEXTURE_CACHE_MAX_ENTRIES; ++EntryIndex) {
+        if (EntryIndex != Self && Cache->ContentClaimed[EntryIndex] &&
+            Cache->ContentHashes[EntryIndex] == Asset->ContentHash && Cache->ContentKeys[EntryIndex] == Key) {
+            ++Cache->ContentPins[EntryIndex];
+
+            Asset->DedupOf = EntryIndex;
+
+            return 1;
+        }
+    }
+
+    Cache->ContentClaimed[Self] = 1;
+    Cache->ContentHashes[Self]  = Asset->ContentHash;
+    Cache->ContentKeys[Self]    = Key;
+
+    return 0;
+}
+
+static TEARA_ASSET_UPLOAD(TextureCacheLoadFailed)
+{
+    (void)Streamer;
+
+    TextureCache*       Cache = (TextureCache*)Asset->Target;
+    TextureCacheEntry*  Entry = &Cache->Entries[Asset->TargetSlot];
+
+    // NOTE(ismail): entry stays so later requests for the same path fail at once instead of reading file again
+    Entry->State = TextureCacheFailed;
+
+    TextureCacheWakeWaiters(Cache, Entry, 0);
+
+    ++Cache->Stats.Failed;
+}
+
+static TEARA_ASSET_UPLOAD(TextureCacheUpload)
+{
+    TextureCache*       Cache = (TextureCache*)Asset->Target;
+    TextureCacheEntry*  Entry = &Cache->Entries[Asset->TargetSlot];
+
+    Assert(Entry->State == TextureCachePending);
+
+    if (Asset->Deduplicated) {
+        TextureCacheEntry* Original = &Cache->Entries[Asset->DedupOf];
+
+        {
+            std::lock_guard<std::mutex> Lock(Cache->ContentMutex);
+
+            --Cache->ContentPins[Asset->DedupOf];
+        }
+
+        // NOTE(ismail): original claimed content before this asset was hashed, streamer completes in request order so it went up first
+        Assert(Original->State != TextureCachePending);
+
+        if (Original->State != TextureCacheReady) {
+            TextureCacheLoadFailed(Streamer, Asset);
+
+            return;
+        }
+
+        ++Original->RefCount;
+
+        Entry->Handle   = Original->Handle;
+        Entry->Bytes    = Original->Bytes;
+        Entry->AliasOf  = Asset->DedupOf;
+
+        ++Cache->Stats.ContentHits;
+        Cache->Stats.BytesSaved += Entry->Bytes * (u64)Entry->RefCount;
+    }
+    else {
+        Entry->Handle   = Cache->Create(&Asset->Texture, Entry->Variant);
+        Entry->Bytes    = Asset->Bytes;
+
+        ++Cache->Stats.Misses;
+        ++Cache->Stats.Textures;
+        Cache->Stats.BytesUploaded  += Entry->Bytes;
+        Cache->Stats.BytesSaved     += Entry->Bytes * (u64)(Entry->RefCount - 1);
+    }
+
+    Entry->State = TextureCacheReady;
+
+    TextureCacheWakeWaiters(Cache, Entry, 1);
+}
+
+void TextureCacheInit(TextureCache *Cache, AssetStreamer *Streamer, TEARA_TextureCreate Create, TEARA_TextureDestroy Destroy)
+{
+    Cache->Streamer = Streamer;
+    Cache->Create   = Create;
+    Cache->Destroy  = Destroy;
+    Cache->Stats    = {};
+
+    for (i32 EntryIndex = 0; EntryIndex < TEXTURE_CACHE_MAX_ENTRIES; ++EntryIndex) {
+        Cache->PathHashes[EntryIndex]       = 0;
+        Cache->Entries[EntryIndex]          = {};
+        Cache->Entries[EntryIndex].AliasOf      = -1;
+        Cache->Entries[EntryIndex].FirstWaiter  = -1;
+        Cache->ContentHashes[EntryIndex]    = 0;
+        Cache->ContentKeys[EntryIndex]      = 0;
+        Cache->ContentClaimed[EntryIndex]   = 0;
+        Cache->ContentPins[EntryIndex]      = 0;
+    }
+
+    for (i32 WaiterIndex = 0; WaiterIndex < TEXTURE_CACHE_MAX_WAITERS; ++WaiterIndex) {
+        Cache->Waiters[WaiterIndex]         = {};
+        Cache->Waiters[WaiterIndex].Next    = WaiterIndex + 1 < TEXTURE_CACHE_MAX_WAITERS ? WaiterIndex + 1 : -1;
+    }
+
+    Cache->FreeWaiter = 0;
+}
+
+bool32 TextureCacheRequest(TextureCache *Cache, const char *Path, u32 Variant, bool32 VerticalFlip,
+                           TEARA_TextureBind Bind, void *Target, i32 TargetSlot)
+{
+    u32 Key         = TextureCacheKey(Variant, VerticalFlip);
+    u64 PathHash    = TextureCachePathHash(Path, Key);
+    i32 EntryIndex  = TextureCacheFind(Cache, PathHash, Path, Key);
+
+    ++Cache->Stats.Requests;
+
+    if (EntryIndex >= 0) {
+        TextureCacheEntry* Entry = &Cache->Entries[EntryIndex];
+
+        if (Entry->State == TextureCacheFailed) {
+            return 0;
+        }
+
+        if (Entry->State == TextureCachePending && !TextureCacheAddWaiter(Cache, Entry, Bind, Target, TargetSlot)) {
+            Assert(false); // NOTE(ismail): TEXTURE_CACHE_MAX_WAITERS is too small
+            return 0;
+        }
+
+        ++Entry->RefCount;
+        ++Cache->Stats.PathHits;
+
+        if (Entry->State == TextureCacheReady) {
+            Cache->Stats.BytesSaved += Entry->Bytes;
+
+            Bind(Target, TargetSlot, Entry->Handle);
+        }
+
+        return 1;
+    }
+
+    for (EntryIndex = 0; EntryIndex < TEXTURE_CACHE_MAX_ENTRIES && Cache->PathHashes[EntryIndex]; ++EntryIndex) {
+    }
+
+    if (EntryIndex == TEXTURE_CACHE_MAX_ENTRIES) {
+        Assert(false); // NOTE(ismail): TEXTURE_CACHE_MAX_ENTRIES is too small
+        return 0;
+    }
+
+    TextureCacheEntry* Entry = &Cache->Entries[EntryIndex];
+
+    Assert(strlen(Path) < sizeof(Entry->Path));
+
+    strncpy(Entry->Path, Path, sizeof(Entry->Path) - 1);
+
+    Entry->Variant  = Variant;
+    Entry->Key      = Key;
+    Entry->State    = TextureCachePending;
+    Entry->RefCount = 1;
+
+    if (!TextureCacheAddWaiter(Cache, Entry, Bind, Target, TargetSlot)) {
+        Assert(false);
+
+        *Entry = {};
+        Entry->AliasOf      = -1;
+        Entry->FirstWaiter  = -1;
+
+        return 0;
+    }
+
+    AssetStreamRequest Request = {};
+    Request.Kind            = AssetStreamTexture;
+    Request.Path            = Entry->Path;
+    Request.Upload          = &TextureCacheUpload;
+    Request.Failed          = &TextureCacheLoadFailed;
+    Request.Dedup           = &TextureCacheDedup;
+    Request.Target          = Cache;
+    Request.TargetSlot      = EntryIndex;
+    Request.VerticalFlip    = VerticalFlip;
+
+    if (!AssetStreamerSubmit(Cache->Streamer, &Request)) {
+        TextureCacheWakeWaiters(Cache, Entry, 0);
+
+        *Entry = {};
+        Entry->AliasOf      = -1;
+        Entry->FirstWaiter  = -1;
+
+        return 0;
+    }
+
+    Cache->PathHashes[EntryIndex] = PathHash;
+
+    return 1;
+}
+
+void TextureCacheRelease(TextureCache *Cache, const char *Path, u32 Variant, bool32 VerticalFlip)
+{
+    u32 Key         = TextureCacheKey(Variant, VerticalFlip);
+    i32 EntryIndex  = TextureCacheFind(Cache, TextureCachePathHash(Path, Key), Path, Key);
+
+    Assert(EntryIndex >= 0 && Cache->Entries[EntryIndex].State == TextureCacheReady);
+
+    if (EntryIndex >= 0 && --Cache->Entries[EntryIndex].RefCount == 0) {
+        TextureCacheFreeEntry(Cache, EntryIndex);
+    }
+}
@@ -0,0 +1,96 @@
+#ifndef _TEARA_UTILS_TEXTURE_CACHE_H_
+#define _TEARA_UTILS_TEXTURE_CACHE_H_
+
+#include <mutex>
+
+#include "Core/Types.h"
+#include "AssetsLoader.h"
+#include "AssetStreamer.h"
+
+// NOTE(ismail): shared GPU textures on top of asset streamer. Same path and variant is found before anything is read,
+// different path with same file bytes is found by streaming thread after hashing the file, before stb_image decodes it.
+// Both cases share one GPU texture and count a reference on it. Cache is main thread only except content table.
+// Variant is what makes one file produce different GPU textures (format, sampler, flip), game decides what it means
+
+#define TEXTURE_CACHE_MAX_ENTRIES   (512)
+#define TEXTURE_CACHE_MAX_WAITERS   (1024)
+
+// NOTE(ismail): Create makes GPU texture out of decoded file and returns its handle, Destroy frees it when last user is gone
+#define TEARA_TEXTURE_CREATE(Name) u32 (Name)(TextureFile *Texture, u32 Variant)
+typedef TEARA_TEXTURE_CREATE(*TEARA_TextureCreate);
+
+#define TEARA_TEXTURE_DESTROY(Name) void (Name)(u32 Handle)
+typedef TEARA_TEXTURE_DESTROY(*TEARA_TextureDestroy);
+
+// NOTE(ismail): hands handle to its user, right away for loaded texture or on upload for one still in flight
+#define TEARA_TEXTURE_BIND(Name) void (Name)(void *Target, i32 TargetSlot, u32 Handle)
+typedef TEARA_TEXTURE_BIND(*TEARA_TextureBind);
+
+enum TextureCacheState {
+    TextureCacheEmpty,
+    TextureCachePending,
+    TextureCacheReady,
+    TextureCacheFailed,
+};
+
+struct TextureCacheWaiter {
+    TEARA_TextureBind   Bind;
+    void*               Target;
+    i32                 TargetSlot;
+    i32                 Next;
+};
+
+// NOTE(ismail): AliasOf >= 0 means file bytes matched another entry, Handle is borrowed and entry holds a reference on it
+struct TextureCacheEntry {
+    char                Path[ASSET_STREAMER_PATH_MAX];
+    u32                 Variant;
+    u32                 Key;                // NOTE(ismail): Variant with flip bit
+    TextureCacheState   State;
+    u32                 Handle;
+    i32                 RefCount;
+    i32                 AliasOf;
+    u64                 Bytes;
+    i32                 FirstWaiter;
+};
+
+// NOTE(ismail): PathHits and ContentHits skipped both decode and GPU allocation, BytesSaved is decoded size they didn't upload
+struct TextureCacheStats {
+    i64     Requests;
+    i64     PathHits;
+    i64     ContentHits;
+    i64     Misses;
+    i64     Failed;
+    u64     BytesSaved;
+    u64     BytesUploaded;
+    i32     Textures;
+};
+
+struct TextureCache {
+    AssetStreamer*          Streamer;
+    TEARA_TextureCreate     Create;
+    TEARA_TextureDestroy    Destroy;
+
+    u64                     PathHashes[TEXTURE_CACHE_MAX_ENTRIES]; // NOTE(ismail): 0 is free slot, lookup scans only this array
+    TextureCacheEntry       Entries[TEXTURE_CACHE_MAX_ENTRIES];
+    TextureCacheWaiter      Waiters[TEXTURE_CACHE_MAX_WAITERS];
+    i32                     FreeWaiter;
+    TextureCacheStats       Stats;
+
+    // NOTE(ismail): written by streaming thread, entries are pinned while an alias of them is in flight
+    std::mutex              ContentMutex;
+    u64                     ContentHashes[TEXTURE_CACHE_MAX_ENTRIES];
+    u32                     ContentKeys[TEXTURE_CACHE_MAX_ENTRIES];
+    bool32                  ContentClaimed[TEXTURE_CACHE_MAX_ENTRIES];
+    i32                     ContentPins[TEXTURE_CACHE_MAX_ENTRIES];
+};
+
+void TextureCacheInit(TextureCache *Cache, AssetStreamer *Streamer, TEARA_TextureCreate Create, TEARA_TextureDestroy Destroy);
+
+// NOTE(ismail): returns 0 when texture failed to load before or cache is full, Bind is not called then
+bool32 TextureCacheRequest(TextureCache *Cache, const char *Path, u32 Variant, bool32 VerticalFlip,
+                           TEARA_TextureBind Bind, void *Target, i32 TargetSlot);
+
+// NOTE(ismail): drops one reference taken by TextureCacheRequest, texture must be bound already
+void TextureCacheRelease(TextureCache *Cache, const char *Path, u32 Variant, bool32 VerticalFlip);
+
+#endif
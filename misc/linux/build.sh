@@ -0,0 +1,20 @@
+#!/bin/sh
+
+# NOTE(ismail): headless build, no window, GL or audio device. Run the binary from TEARA_HOME so data/ paths resolve
+
+TEARA_HOME=${TEARA_HOME:-$(cd "$(dirname "$0")/../.." && pwd)/}
+
+FILES_TO_COMPILE="${TEARA_HOME}Core/LinuxMain.cpp ${TEARA_HOME}Core/JobSystem.cpp ${TEARA_HOME}Core/Memory.cpp ${TEARA_HOME}Utils/AssetsLoader.cpp ${TEARA_HOME}Utils/CookedMesh.cpp ${TEARA_HOME}Utils/CookedTexture.cpp ${TEARA_HOME}Utils/ObjParser.cpp ${TEARA_HOME}Utils/AssetStreamer.cpp ${TEARA_HOME}Utils/TextureCache.cpp ${TEARA_HOME}Utils/AudioLoader.cpp ${TEARA_HOME}Utils/AudioStreamer.cpp ${TEARA_HOME}3rdparty/stb/stb_image_implementation.cpp ${TEARA_HOME}3rdparty/fastobj/fast_obj.cpp ${TEARA_HOME}3rdparty/cgltf/cgltf.cpp"
+BUILD_LOG_FILE=build.log
+
+mkdir -p "${TEARA_HOME}build"
+cd "${TEARA_HOME}build" || exit 1
+
+rm -f ${BUILD_LOG_FILE}
+
+# NOTE(ismail): warnings are on and build should stay clean. Members named like their type spell it as ::Type (::Input Input),
+# g++ rejects the plain form that MSVC accepts. -ffp-contract=off keeps scalar math from being fused into FMA under -mfma,
+# so SIMD kernels and scalar code round the same way and --math-test can check them bit for bit
+g++ -std=c++17 -O2 -g -mavx2 -mfma -ffp-contract=off -Wall -Wextra -pthread -I "${TEARA_HOME}" ${FILES_TO_COMPILE} -o teara_headless >> ${BUILD_LOG_FILE} 2>&1
+
+grep "error\|warning" ${BUILD_LOG_FILE}
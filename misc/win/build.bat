@@ -1,6 +1,6 @@
 @echo off
 
-set FILES_TO_COMPILE=%TEARA_HOME%Core\WinMain.cpp %TEARA_HOME%Utils\AssetsLoader.cpp %TEARA_HOME%3rdparty\stb\stb_image_implementation.cpp %TEARA_HOME%Utils\AudioLoader.cpp %TEARA_HOME%3rdparty\fastobj\fast_obj.cpp %TEARA_HOME%Audio\OpenALSoft\OpenALAudioSystem.cpp %TEARA_HOME%Rendering\OpenGL\TGL.cpp %TEARA_HOME%3rdparty\ufbx\ufbx.c %TEARA_HOME%3rdparty\cgltf\cgltf.cpp %TEARA_HOME%Assets\GltfLoader.cpp
+set FILES_TO_COMPILE=%TEARA_HOME%Core\WinMain.cpp %TEARA_HOME%Core\JobSystem.cpp %TEARA_HOME%Core\Memory.cpp %TEARA_HOME%Utils\AssetsLoader.cpp %TEARA_HOME%Utils\CookedMesh.cpp %TEARA_HOME%Utils\CookedTexture.cpp %TEARA_HOME%Utils\ObjParser.cpp %TEARA_HOME%Utils\AssetStreamer.cpp %TEARA_HOME%Utils\TextureCache.cpp %TEARA_HOME%3rdparty\stb\stb_image_implementation.cpp %TEARA_HOME%Utils\AudioLoader.cpp %TEARA_HOME%Utils\AudioStreamer.cpp %TEARA_HOME%3rdparty\fastobj\fast_obj.cpp %TEARA_HOME%Audio\OpenALSoft\OpenALAudioSystem.cpp %TEARA_HOME%Rendering\OpenGL\TGL.cpp %TEARA_HOME%3rdparty\ufbx\ufbx.c %TEARA_HOME%3rdparty\cgltf\cgltf.cpp %TEARA_HOME%Assets\GltfLoader.cpp
 set COMMON_LINK_LIBRARIES=user32.lib ole32.lib shell32.lib gdi32.lib version.lib winmm.lib advapi32.lib imm32.lib oleAut32.lib setupapi.lib opengl32.lib OpenAL32.lib E:/Engine/vcpkg/installed/x64-windows/debug/lib/assimp-vc143-mtd.lib imguid.lib stc.lib
 set BUILD_LOG_FILE=build.log
 